@@ -0,0 +1,444 @@
+#ifndef URTS_PRIVATE_CBOR_READER_HPP
+#define URTS_PRIVATE_CBOR_READER_HPP
+#ifdef URTS_SRC
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <span>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+namespace
+{
+/// @brief A minimal, streaming Concise Binary Object Representation (CBOR)
+///        reader.  This is the counterpart to the CBORWriter.  Rather than
+///        building a JSON document, items are read in place from the
+///        message.  Notably, numeric arrays are decoded straight into a
+///        std::vector<double>.
+/// @note This reads messages produced by the CBORWriter as well as by
+///       nlohmann::json::to_cbor.  The latter may write integers, half,
+///       single, or double precision numbers so all are accepted wherever
+///       a number is expected.  Indefinite length items are not supported.
+class CBORReader
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] data    The CBOR message.  This must outlive the reader.
+    /// @param[in] length  The length of data.
+    CBORReader(const uint8_t *data, const size_t length) :
+        mData(data),
+        mEnd(data + length)
+    {
+        if (data == nullptr && length > 0)
+        {
+            throw std::invalid_argument("data is NULL");
+        }
+    }
+    /// @result The number of key/value pairs in the map starting here.
+    [[nodiscard]] uint64_t readMapSize()
+    {
+        return readHeader(MAP);
+    }
+    /// @result The number of elements in the array starting here.
+    [[nodiscard]] uint64_t readArraySize()
+    {
+        return readHeader(ARRAY);
+    }
+    /// @result A view of the text string.  This points into the message.
+    [[nodiscard]] std::string_view readStringView()
+    {
+        auto n = readHeader(TEXT);
+        require(n);
+        std::string_view result(reinterpret_cast<const char *> (mData), n);
+        mData = mData + n;
+        return result;
+    }
+    /// @result A view of the byte string.  This points into the message.
+    [[nodiscard]] std::string_view readBytesView()
+    {
+        auto n = readHeader(BYTES);
+        require(n);
+        std::string_view result(reinterpret_cast<const char *> (mData), n);
+        mData = mData + n;
+        return result;
+    }
+    /// @result The text string.
+    [[nodiscard]] std::string readString()
+    {
+        return std::string {readStringView()};
+    }
+    /// @result The signed integer.
+    [[nodiscard]] int64_t readInteger()
+    {
+        auto majorType = peekMajorType();
+        if (majorType == UNSIGNED)
+        {
+            auto value = readHeader(UNSIGNED);
+            if (value > static_cast<uint64_t>
+                        (std::numeric_limits<int64_t>::max()))
+            {
+                throw std::runtime_error("Integer overflows int64_t");
+            }
+            return static_cast<int64_t> (value);
+        }
+        if (majorType == NEGATIVE)
+        {
+            auto value = readHeader(NEGATIVE);
+            if (value > static_cast<uint64_t>
+                        (std::numeric_limits<int64_t>::max()))
+            {
+                throw std::runtime_error("Integer overflows int64_t");
+            }
+            return -1 - static_cast<int64_t> (value);
+        }
+        // -2^63 is exact but int64_t's maximum rounds up to 2^63
+        constexpr auto lowest
+            = static_cast<double> (std::numeric_limits<int64_t>::lowest());
+        auto value = readDouble();
+        if (!std::isfinite(value) || value < lowest || value >= -lowest)
+        {
+            throw std::runtime_error("Number cannot be represented as int64_t");
+        }
+        return static_cast<int64_t> (value);
+    }
+    /// @result The unsigned integer.
+    [[nodiscard]] uint64_t readUnsigned()
+    {
+        if (peekMajorType() == UNSIGNED){return readHeader(UNSIGNED);}
+        auto value = readInteger();
+        if (value < 0){throw std::runtime_error("Integer is negative");}
+        return static_cast<uint64_t> (value);
+    }
+    /// @result The number as a double.
+    [[nodiscard]] double readDouble()
+    {
+        require(1);
+        auto initialByte = *mData;
+        auto majorType = initialByte >> 5;
+        if (majorType == UNSIGNED)
+        {
+            return static_cast<double> (readHeader(UNSIGNED));
+        }
+        if (majorType == NEGATIVE)
+        {
+            return -1 - static_cast<double> (readHeader(NEGATIVE));
+        }
+        if (initialByte == 0xFB)
+        {
+            require(9);
+            auto bits = readBigEndian(mData + 1, 8);
+            mData = mData + 9;
+            double value;
+            std::memcpy(&value, &bits, sizeof(double));
+            return value;
+        }
+        if (initialByte == 0xFA)
+        {
+            require(5);
+            auto bits = static_cast<uint32_t> (readBigEndian(mData + 1, 4));
+            mData = mData + 5;
+            float value;
+            std::memcpy(&value, &bits, sizeof(float));
+            return static_cast<double> (value);
+        }
+        if (initialByte == 0xF9)
+        {
+            require(3);
+            auto half = static_cast<uint16_t> (readBigEndian(mData + 1, 2));
+            mData = mData + 3;
+            return halfToDouble(half);
+        }
+        throw std::runtime_error("CBOR item is not a number");
+    }
+    /// @result The boolean.
+    [[nodiscard]] bool readBoolean()
+    {
+        require(1);
+        auto initialByte = *mData;
+        if (initialByte != 0xF4 && initialByte != 0xF5)
+        {
+            throw std::runtime_error("CBOR item is not a boolean");
+        }
+        mData = mData + 1;
+        return initialByte == 0xF5;
+    }
+    /// @result True indicates the next item is a byte string.
+    [[nodiscard]] bool peekBytes() const
+    {
+        return peekMajorType() == BYTES;
+    }
+    /// @result True indicates the next item is null.  If so, it is consumed.
+    [[nodiscard]] bool readNull()
+    {
+        require(1);
+        if (*mData != 0xF6){return false;}
+        mData = mData + 1;
+        return true;
+    }
+    /// @brief Reads an array of numbers.
+    /// @param[out] values  The numbers.  A null item results in no values.
+    ///                     The existing storage is reused.
+    void readDoubles(std::vector<double> *values)
+    {
+        values->clear();
+        appendDoubles(values);
+    }
+    /// @brief Reads an array of numbers and appends them to values.
+    /// @param[in,out] values  The numbers are appended to this.
+    /// @result The number of values read.  A null item has no values.
+    size_t appendDoubles(std::vector<double> *values)
+    {
+        if (readNull()){return 0;}
+        auto n = readArraySize();
+        // Every element occupies at least one byte
+        require(n);
+        auto offset = values->size();
+        values->resize(offset + n);
+        auto *__restrict__ destination = values->data() + offset;
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            // Fast path for the CBORWriter's doubles
+            if (mEnd - mData >= 9 && *mData == 0xFB)
+            {
+                auto bits = readBigEndian(mData + 1, 8);
+                std::memcpy(destination + i, &bits, sizeof(double));
+                mData = mData + 9;
+            }
+            else
+            {
+                destination[i] = readDouble();
+            }
+        }
+        return static_cast<size_t> (n);
+    }
+    /// @brief Reads samples written by CBORWriter::writeSamples() or
+    ///        written as an array of numbers.
+    /// @param[in,out] values  Samples that cannot be used in place are
+    ///                        appended to this.
+    /// @result A view of the samples in the message.  This is only possible
+    ///         when the samples were written by CBORWriter::writeSamples()
+    ///         and are suitably aligned in memory.  Otherwise, this is
+    ///         std::nullopt and the samples were appended to values.
+    [[nodiscard]] std::optional<std::span<const double>>
+        readSamples(std::vector<double> *values)
+    {
+        if (!peekBytes())
+        {
+            appendDoubles(values);
+            return std::nullopt;
+        }
+        auto bytes = readBytesView();
+        auto padding = bytes.size() % sizeof(double);
+        auto n = bytes.size()/sizeof(double);
+        const auto *source = bytes.data() + padding;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (reinterpret_cast<uintptr_t> (source) % alignof(double) == 0)
+            {
+                return std::span<const double>
+                       (reinterpret_cast<const double *> (source), n);
+            }
+        }
+        auto offset = values->size();
+        values->resize(offset + n);
+        auto *destination = values->data() + offset;
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t bits{0};
+            for (size_t j = 0; j < sizeof(double); ++j)
+            {
+                bits = bits | (static_cast<uint64_t>
+                               (static_cast<uint8_t>
+                                (source[sizeof(double)*i + j])) << (8*j));
+            }
+            destination[i] = std::bit_cast<double> (bits);
+        }
+        return std::nullopt;
+    }
+    /// @brief Skips the next item, including any nested items.
+    /// @throws std::runtime_error if the message is truncated or the items
+    ///         are nested more than MAXIMUM_DEPTH deep.
+    void skip()
+    {
+        skip(0);
+    }
+    /// @brief Reads a map.  For each key the handler is called with the key
+    ///        and must either read the value and return true or return
+    ///        false in which case the value is skipped.
+    /// @throws std::runtime_error if this is the root item of the message
+    ///         and bytes remain after it.
+    template<typename F>
+    void readMap(F &&handler)
+    {
+        auto nPairs = readMapSize();
+        // Each pair is at least a key byte and a value byte
+        if (nPairs > static_cast<uint64_t> (mEnd - mData)/2)
+        {
+            throw std::runtime_error("CBOR message is truncated");
+        }
+        mMapDepth = mMapDepth + 1;
+        for (uint64_t i = 0; i < nPairs; ++i)
+        {
+            auto key = readStringView();
+            if (!handler(key)){skip();}
+        }
+        mMapDepth = mMapDepth - 1;
+        if (mMapDepth == 0 && !atEnd())
+        {
+            throw std::runtime_error("Trailing bytes after CBOR message");
+        }
+    }
+    /// @result True indicates the entire message was read.
+    [[nodiscard]] bool atEnd() const noexcept
+    {
+        return mData == mEnd;
+    }
+private:
+    static constexpr uint8_t UNSIGNED{0};
+    static constexpr uint8_t NEGATIVE{1};
+    static constexpr uint8_t BYTES{2};
+    static constexpr uint8_t TEXT{3};
+    static constexpr uint8_t ARRAY{4};
+    static constexpr uint8_t MAP{5};
+    static constexpr uint8_t TAG{6};
+    static constexpr uint8_t SIMPLE{7};
+    /// Messages nest a few items deep so anything deeper is malformed.
+    static constexpr int MAXIMUM_DEPTH{64};
+    /// Skips the next item which is nested depth items deep.
+    void skip(const int depth)
+    {
+        if (depth > MAXIMUM_DEPTH)
+        {
+            throw std::runtime_error("CBOR items are nested too deeply");
+        }
+        require(1);
+        auto majorType = peekMajorType();
+        if (majorType == SIMPLE)
+        {
+            auto additional = *mData & 0x1F;
+            auto n = (additional == 25) ? 3 :
+                     (additional == 26) ? 5 :
+                     (additional == 27) ? 9 :
+                     (additional == 24) ? 2 : 1;
+            require(n);
+            mData = mData + n;
+            return;
+        }
+        auto argument = readHeader(majorType);
+        if (majorType == BYTES || majorType == TEXT)
+        {
+            require(argument);
+            mData = mData + argument;
+        }
+        else if (majorType == ARRAY)
+        {
+            // Every element occupies at least one byte
+            require(argument);
+            for (uint64_t i = 0; i < argument; ++i){skip(depth + 1);}
+        }
+        else if (majorType == MAP)
+        {
+            // Bound the number of pairs before doubling it so a huge count
+            // cannot overflow
+            if (argument > static_cast<uint64_t> (mEnd - mData)/2)
+            {
+                throw std::runtime_error("CBOR message is truncated");
+            }
+            for (uint64_t i = 0; i < 2*argument; ++i){skip(depth + 1);}
+        }
+        else if (majorType == TAG)
+        {
+            skip(depth + 1);
+        }
+    }
+    /// @throws std::runtime_error if fewer than n bytes remain.
+    void require(const uint64_t n) const
+    {
+        if (static_cast<uint64_t> (mEnd - mData) < n)
+        {
+            throw std::runtime_error("CBOR message is truncated");
+        }
+    }
+    [[nodiscard]] uint8_t peekMajorType() const
+    {
+        require(1);
+        return *mData >> 5;
+    }
+    /// Reads the initial byte and argument of an item of the given type.
+    [[nodiscard]] uint64_t readHeader(const uint8_t majorType)
+    {
+        require(1);
+        if ((*mData >> 5) != majorType)
+        {
+            throw std::runtime_error("Unexpected CBOR major type "
+                                   + std::to_string(*mData >> 5));
+        }
+        auto additional = *mData & 0x1F;
+        mData = mData + 1;
+        if (additional < 24){return additional;}
+        int nBytes = 0;
+        if (additional == 24){nBytes = 1;}
+        else if (additional == 25){nBytes = 2;}
+        else if (additional == 26){nBytes = 4;}
+        else if (additional == 27){nBytes = 8;}
+        else
+        {
+            throw std::runtime_error("Indefinite length CBOR not supported");
+        }
+        require(nBytes);
+        auto argument = readBigEndian(mData, nBytes);
+        mData = mData + nBytes;
+        return argument;
+    }
+    [[nodiscard]] static uint64_t readBigEndian(const uint8_t *data,
+                                                const int nBytes) noexcept
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < nBytes; ++i)
+        {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+    [[nodiscard]] static double halfToDouble(const uint16_t half) noexcept
+    {
+        auto exponent = (half >> 10) & 0x1F;
+        auto mantissa = half & 0x3FF;
+        double value;
+        if (exponent == 0)
+        {
+            value = std::ldexp(mantissa, -24);
+        }
+        else if (exponent != 31)
+        {
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        }
+        else
+        {
+            value = (mantissa == 0) ? std::numeric_limits<double>::infinity() :
+                                      std::numeric_limits<double>::quiet_NaN();
+        }
+        return (half & 0x8000) ? -value : value;
+    }
+    const uint8_t *mData{nullptr};
+    const uint8_t *mEnd{nullptr};
+    int mMapDepth{0};
+};
+/// @result The value of a required field that was read from a message.
+/// @throws std::runtime_error if the field was not in the message.
+template<typename T>
+[[nodiscard]] T &requireField(std::optional<T> &value, const char *name)
+{
+    if (!value)
+    {
+        throw std::runtime_error(std::string {name} + " not in message");
+    }
+    return *value;
+}
+}
+#endif
+#endif
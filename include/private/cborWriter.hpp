@@ -0,0 +1,229 @@
+#ifndef URTS_PRIVATE_CBOR_WRITER_HPP
+#define URTS_PRIVATE_CBOR_WRITER_HPP
+#ifdef URTS_SRC
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <bit>
+namespace
+{
+/// @brief A minimal Concise Binary Object Representation (CBOR) writer that
+///        appends directly to an output string.  This produces messages that
+///        nlohmann::json::from_cbor can read but avoids building a JSON
+///        document first, which, for large numeric arrays, is very
+///        expensive.
+class CBORWriter
+{
+public:
+    /// @brief Constructor.
+    /// @param[in,out] buffer  The buffer to which the CBOR is appended.
+    explicit CBORWriter(std::string *buffer) :
+        mBuffer(buffer)
+    {
+    }
+    /// @brief Begins a map with nPairs key/value pairs.
+    void startMap(const uint64_t nPairs)
+    {
+        writeHeader(0xA0, nPairs);
+    }
+    /// @brief Begins an array with nElements elements.
+    void startArray(const uint64_t nElements)
+    {
+        writeHeader(0x80, nElements);
+    }
+    /// @brief Writes a text string.
+    void write(const std::string_view &s)
+    {
+        writeHeader(0x60, s.size());
+        mBuffer->append(s.data(), s.size());
+    }
+    void write(const std::string &s)
+    {
+        write(std::string_view {s});
+    }
+    void write(const char *s)
+    {
+        write(std::string_view {s});
+    }
+    /// @brief Writes a signed integer.
+    void write(const int64_t value)
+    {
+        if (value >= 0)
+        {
+            writeHeader(0x00, static_cast<uint64_t> (value));
+        }
+        else
+        {
+            writeHeader(0x20, static_cast<uint64_t> (-1 - value));
+        }
+    }
+    void write(const int value)
+    {
+        write(static_cast<int64_t> (value));
+    }
+    /// @brief Writes an unsigned integer.
+    void write(const uint64_t value)
+    {
+        writeHeader(0x00, value);
+    }
+    /// @brief Writes a double precision number.
+    void write(const double value)
+    {
+        mBuffer->push_back(static_cast<char> (0xFB));
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(double));
+        writeBigEndian(bits, 8);
+    }
+    /// @brief Writes a boolean.
+    void write(const bool value)
+    {
+        mBuffer->push_back(static_cast<char> (value ? 0xF5 : 0xF4));
+    }
+    /// @brief Writes null.
+    void writeNull()
+    {
+        mBuffer->push_back(static_cast<char> (0xF6));
+    }
+    /// @brief Writes a byte string.
+    void writeBytes(const void *data, const size_t n)
+    {
+        writeHeader(0x40, n);
+        mBuffer->append(static_cast<const char *> (data), n);
+    }
+    /// @brief Begins a byte string of n bytes.
+    /// @result A pointer to the n bytes of the byte string's content which
+    ///         the caller must fill in.  This is invalidated by the next
+    ///         write.
+    [[nodiscard]] char *startBytes(const size_t n)
+    {
+        writeHeader(0x40, n);
+        auto i0 = mBuffer->size();
+        mBuffer->resize(i0 + n);
+        return mBuffer->data() + i0;
+    }
+    /// @brief Writes an array of doubles.
+    void write(const double *values, const size_t n)
+    {
+        startArray(n);
+        auto i0 = mBuffer->size();
+        mBuffer->resize(i0 + 9*n);
+        auto *__restrict__ out = mBuffer->data() + i0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, values + i, sizeof(double));
+            out[9*i] = static_cast<char> (0xFB);
+            for (int j = 0; j < 8; ++j)
+            {
+                out[9*i + 1 + j] = static_cast<char> (bits >> (56 - 8*j));
+            }
+        }
+    }
+    /// @brief Writes doubles as a byte string of little-endian values.
+    ///        Unlike an array, a reader can use these samples in place - see
+    ///        CBORReader::readSamples().  To that end, the byte string
+    ///        begins with 0 to 7 padding bytes that align the samples to 8
+    ///        bytes relative to the start of the buffer.  The padding is the
+    ///        byte string's length modulo 8.
+    void writeSamples(const double *values, const size_t n)
+    {
+        copySamples(values, n, startSamples(n));
+    }
+    /// @brief Starts a byte string of n samples as written by writeSamples().
+    ///        This allows samples from several sources to be written into
+    ///        one byte string without first gathering them.
+    /// @result The destination of the samples.  The caller must fill all
+    ///         8*n bytes - e.g., with copySamples().
+    /// @note The destination is invalidated by the next write.
+    [[nodiscard]] char *startSamples(const size_t n)
+    {
+        auto nBytes = sizeof(double)*n;
+        size_t padding = 0;
+        for (size_t pad = 0; pad < sizeof(double); ++pad)
+        {
+            auto start = mBuffer->size() + getHeaderSize(nBytes + pad) + pad;
+            if (start % sizeof(double) == 0)
+            {
+                padding = pad;
+                break;
+            }
+        }
+        auto *destination = startBytes(nBytes + padding);
+        std::memset(destination, 0, padding);
+        return destination + padding;
+    }
+    /// @brief Copies n samples as little-endian values to destination.
+    static void copySamples(const double *values, const size_t n,
+                            char *destination) noexcept
+    {
+        if (n == 0){return;}
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(destination, values, sizeof(double)*n);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto bits = std::bit_cast<uint64_t> (values[i]);
+                for (size_t j = 0; j < sizeof(double); ++j)
+                {
+                    destination[sizeof(double)*i + j]
+                        = static_cast<char> (bits >> (8*j));
+                }
+            }
+        }
+    }
+private:
+    /// @result The size of the header writeHeader() writes.
+    [[nodiscard]] static size_t getHeaderSize(const uint64_t argument) noexcept
+    {
+        if (argument < 24){return 1;}
+        if (argument <= std::numeric_limits<uint8_t>::max()){return 2;}
+        if (argument <= std::numeric_limits<uint16_t>::max()){return 3;}
+        if (argument <= std::numeric_limits<uint32_t>::max()){return 5;}
+        return 9;
+    }
+    /// Writes the major type and argument with the shortest encoding.
+    void writeHeader(const uint8_t majorType, const uint64_t argument)
+    {
+        if (argument < 24)
+        {
+            mBuffer->push_back(static_cast<char> (majorType | argument));
+        }
+        else if (argument <= std::numeric_limits<uint8_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (majorType | 24));
+            writeBigEndian(argument, 1);
+        }
+        else if (argument <= std::numeric_limits<uint16_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (majorType | 25));
+            writeBigEndian(argument, 2);
+        }
+        else if (argument <= std::numeric_limits<uint32_t>::max())
+        {
+            mBuffer->push_back(static_cast<char> (majorType | 26));
+            writeBigEndian(argument, 4);
+        }
+        else
+        {
+            mBuffer->push_back(static_cast<char> (majorType | 27));
+            writeBigEndian(argument, 8);
+        }
+    }
+    void writeBigEndian(const uint64_t value, const int nBytes)
+    {
+        for (int i = nBytes - 1; i >= 0; --i)
+        {
+            mBuffer->push_back(static_cast<char> (value >> (8*i)));
+        }
+    }
+    std::string *mBuffer{nullptr};
+};
+}
+#endif
+#endif
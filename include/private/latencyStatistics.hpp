@@ -0,0 +1,81 @@
+#ifndef URTS_PRIVATE_LATENCY_STATISTICS_HPP
+#define URTS_PRIVATE_LATENCY_STATISTICS_HPP
+#ifdef URTS_SRC
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <string>
+namespace
+{
+/// @brief Tallies latencies over a reporting window, e.g., the time from
+///        when a packet was ingested to when it was published.  One thread
+///        adds the latencies and ends the windows while any thread may read
+///        the statistics of the last complete window.
+class LatencyStatistics
+{
+public:
+    /// @brief Adds a latency to the current window.
+    void add(const std::chrono::microseconds &latency) noexcept
+    {
+        auto value = std::max<int64_t> (0, latency.count());
+        mSum = mSum + value;
+        mMaximum = std::max(mMaximum, value);
+        mCount = mCount + 1;
+    }
+    /// @brief Ends the current window.  Its statistics are made available
+    ///        to the readers and a new window is started.
+    void endWindow() noexcept
+    {
+        mLastMean.store(mCount > 0 ? mSum/mCount : 0,
+                        std::memory_order_relaxed);
+        mLastMaximum.store(mMaximum, std::memory_order_relaxed);
+        mLastCount.store(mCount, std::memory_order_relaxed);
+        mSum = 0;
+        mMaximum = 0;
+        mCount = 0;
+    }
+    /// @brief Discards all statistics.
+    void clear() noexcept
+    {
+        mSum = 0;
+        mMaximum = 0;
+        mCount = 0;
+        mLastMean.store(0, std::memory_order_relaxed);
+        mLastMaximum.store(0, std::memory_order_relaxed);
+        mLastCount.store(0, std::memory_order_relaxed);
+    }
+    /// @result The mean latency in the last window.
+    [[nodiscard]] std::chrono::microseconds getMean() const noexcept
+    {
+        return std::chrono::microseconds
+               {mLastMean.load(std::memory_order_relaxed)};
+    }
+    /// @result The largest latency in the last window.
+    [[nodiscard]] std::chrono::microseconds getMaximum() const noexcept
+    {
+        return std::chrono::microseconds
+               {mLastMaximum.load(std::memory_order_relaxed)};
+    }
+    /// @result The number of latencies in the last window.
+    [[nodiscard]] int64_t getCount() const noexcept
+    {
+        return mLastCount.load(std::memory_order_relaxed);
+    }
+    /// @result A summary of the last window suitable for a command response.
+    [[nodiscard]] std::string toString() const
+    {
+        return "mean " + std::to_string(getMean().count())
+             + " us, max " + std::to_string(getMaximum().count())
+             + " us over " + std::to_string(getCount()) + " packets";
+    }
+private:
+    int64_t mSum{0};
+    int64_t mMaximum{0};
+    int64_t mCount{0};
+    std::atomic<int64_t> mLastMean{0};
+    std::atomic<int64_t> mLastMaximum{0};
+    std::atomic<int64_t> mLastCount{0};
+};
+}
+#endif
+#endif
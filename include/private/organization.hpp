@@ -0,0 +1,4 @@
+#ifndef PRIVATE_ORGANIZATION_HPP
+#define PRIVATE_ORGANIZATION_HPP
+#define ORGANIZATION "UUSS"
+#endif
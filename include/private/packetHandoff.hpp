@@ -0,0 +1,123 @@
+#ifndef URTS_PRIVATE_PACKET_HANDOFF_HPP
+#define URTS_PRIVATE_PACKET_HANDOFF_HPP
+#ifdef URTS_SRC
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include "private/spscRing.hpp"
+namespace
+{
+/// @brief Hands values from a reader thread to a consumer thread through an
+///        \c SPSCRing.  The consumer can sleep until values arrive and the
+///        values that arrive while the ring is full are dropped and counted.
+/// @note As with the ring, exactly one thread may call \c try_push() and
+///       exactly one thread may call \c pop_all() and \c waitFor().
+template<typename T>
+class PacketHandoff
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] capacity  The maximum number of values in the ring.  This
+    ///                      is rounded up to a power of two.
+    explicit PacketHandoff(const size_t capacity = 1) :
+        mRing(capacity)
+    {
+    }
+    /// @brief Resizes the ring and resets the overflow count.  This must not
+    ///        be called while either thread is active.
+    /// @throws std::invalid_argument if capacity is 0 or too large.
+    void setCapacity(const size_t capacity)
+    {
+        mRing.setCapacity(capacity);
+        mOverflowed.store(0, std::memory_order_relaxed);
+    }
+    /// @brief Discards any values in the ring and resets the overflow count
+    ///        without reallocating the ring.  This must not be called while
+    ///        either thread is active.
+    void clear() noexcept
+    {
+        mRing.clear();
+        mOverflowed.store(0, std::memory_order_relaxed);
+    }
+    /// @brief Moves a value to the back of the ring and wakes the consumer
+    ///        if it is waiting.  This is called by the producer.
+    /// @result True indicates the value was added.  False indicates the ring
+    ///         was full so the value was dropped and counted.
+    [[nodiscard]] bool try_push(T &&value)
+    {
+        if (mRing.try_push(std::move(value)))
+        {
+            // Only take the lock when the consumer may be asleep.  The fence
+            // pairs with the one in waitFor() so either the consumer sees
+            // the value or we see that the consumer is waiting.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mConsumerWaiting.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(mWakeUpMutex);
+                mWakeUp.notify_one();
+            }
+            return true;
+        }
+        mOverflowed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    /// @brief Moves up to maxValues values from the front of the ring to the
+    ///        back of the container.  This is called by the consumer.
+    /// @result The number of values moved.
+    template<typename Container>
+    size_t pop_all(Container *values,
+                   const size_t maxValues = std::numeric_limits<size_t>::max())
+    {
+        return mRing.pop_all(values, maxValues);
+    }
+    /// @brief Blocks until the ring has values or the time out elapses.
+    ///        This is called by the consumer.
+    /// @result True indicates the ring has values.
+    [[nodiscard]] bool waitFor(const std::chrono::milliseconds &timeOut)
+    {
+        if (!mRing.empty()){return true;}
+        std::unique_lock<std::mutex> lock(mWakeUpMutex);
+        mConsumerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto haveValues = mWakeUp.wait_for(lock, timeOut, [this]
+                          {
+                              return !mRing.empty();
+                          });
+        mConsumerWaiting.store(false, std::memory_order_relaxed);
+        return haveValues;
+    }
+    /// @result The number of values dropped because the ring was full.
+    [[nodiscard]] uint64_t getNumberOfOverflowedValues() const noexcept
+    {
+        return mOverflowed.load(std::memory_order_relaxed);
+    }
+    /// @result The number of values in the ring.  When called while the
+    ///         threads are active this is only a snapshot.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return mRing.size();
+    }
+    /// @result True indicates the ring is empty.  When called while the
+    ///         threads are active this is only a snapshot.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return mRing.empty();
+    }
+    /// @result The maximum number of values the ring can hold.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return mRing.capacity();
+    }
+private:
+    ::SPSCRing<T> mRing;
+    std::mutex mWakeUpMutex;
+    std::condition_variable mWakeUp;
+    std::atomic<bool> mConsumerWaiting{false};
+    std::atomic<uint64_t> mOverflowed{0};
+};
+}
+#endif
+#endif
@@ -0,0 +1,9 @@
+#ifdef URTS_SRC
+#ifndef PRIVATE_PATHS_HPP
+#define PRIVATE_PATHS_HPP
+#define DATA_PATH "/root/.local/share/UUSS/urts"
+#define CACHE_PATH "/root/.cache/UUSS/urts"
+#define CONFIG_PATH "/root/.config/UUSS"
+#define DATABASE_PATH "/root/.local/share/UUSS/urts/tables/"
+#endif
+#endif
@@ -0,0 +1,63 @@
+#ifndef URTS_PRIVATE_RECEIVE_BATCH_HPP
+#define URTS_PRIVATE_RECEIVE_BATCH_HPP
+#ifdef URTS_SRC
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+namespace
+{
+/// @brief Drains the messages available on a subscriber.  This receives
+///        until maxMessages have been received, a receive times out, or
+///        the time out has elapsed.
+/// @param[in] receive      Receives at most the given number of messages,
+///                         appends them to the caller's container, and
+///                         returns the number received.  Returning 0
+///                         indicates the receive timed out.  A message that
+///                         cannot be deserialized should be consumed before
+///                         this throws so that draining can continue.
+/// @param[in] onError      Reports a receive that threw, e.g., a message
+///                         that could not be deserialized.  The messages
+///                         received before and after it are kept.
+/// @param[in] maxMessages  The maximum number of messages to receive.
+/// @param[in] timeOut      The approximate maximum time to spend draining.
+///                         Since each receive waits for up to the
+///                         subscriber's time out, this can be exceeded by
+///                         up to the subscriber's time out.
+/// @result The number of received messages.
+/// @throws std::invalid_argument if maxMessages is not positive.
+template<typename F, typename E>
+[[nodiscard]] [[maybe_unused]]
+int receiveBatch(F &&receive,
+                 E &&onError,
+                 const int maxMessages,
+                 const std::chrono::milliseconds &timeOut)
+{
+    if (maxMessages < 1)
+    {
+        throw std::invalid_argument("maxMessages must be positive");
+    }
+    auto deadline = std::chrono::steady_clock::now() + timeOut;
+    int nReceived = 0;
+    int nFailed = 0;
+    // Failures count toward the limit so a stream of bad messages cannot
+    // hold the caller here for the full time out.
+    while (nReceived + nFailed < maxMessages)
+    {
+        try
+        {
+            auto n = receive(maxMessages - nReceived - nFailed);
+            if (n == 0){break;} // Nothing more available
+            nReceived = nReceived + n;
+        }
+        catch (const std::exception &e)
+        {
+            nFailed = nFailed + 1;
+            onError(e);
+        }
+        if (std::chrono::steady_clock::now() >= deadline){break;}
+    }
+    return nReceived;
+}
+}
+#endif
+#endif
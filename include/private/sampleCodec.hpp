@@ -0,0 +1,265 @@
+#ifndef URTS_PRIVATE_SAMPLE_CODEC_HPP
+#define URTS_PRIVATE_SAMPLE_CODEC_HPP
+#ifdef URTS_SRC
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+namespace
+{
+/// @brief Lossless compression of a packet's samples.  The first byte of an
+///        encoded packet identifies the encoding.
+///        - Integer valued samples, which is what digitizers produce, are
+///          stored as the first sample followed by the first differences in
+///          the spirit of Steim compression.  Each value is zig-zag mapped
+///          then written as a variable length integer so that small
+///          differences occupy a single byte.
+///        - Other samples are XOR'd with the previous sample.  Only the
+///          bytes between the leading and trailing zero bytes of the result
+///          are written after a byte that records how many were dropped.
+///        - If neither encoding helps then the samples are copied.
+enum class SampleEncoding : uint8_t
+{
+    Raw = 0,
+    IntegerDelta = 1,
+    FloatXOR = 2
+};
+/// Integers beyond this are not exactly representable as doubles.
+constexpr double MAX_EXACT_INTEGER{9007199254740992.0}; // 2^53
+[[nodiscard]] inline uint64_t zigZagEncode(const int64_t value) noexcept
+{
+    return (static_cast<uint64_t> (value) << 1)
+         ^ static_cast<uint64_t> (value >> 63);
+}
+[[nodiscard]] inline int64_t zigZagDecode(const uint64_t value) noexcept
+{
+    return static_cast<int64_t> (value >> 1)
+         ^ -static_cast<int64_t> (value & 1);
+}
+/// @tparam Container  A byte container - e.g., std::vector<uint8_t> or
+///                    std::string.
+template<typename Container>
+void writeVarint(uint64_t value, Container *output)
+{
+    using ValueType = typename Container::value_type;
+    while (value >= 0x80)
+    {
+        output->push_back(static_cast<ValueType> (value | 0x80));
+        value = value >> 7;
+    }
+    output->push_back(static_cast<ValueType> (value));
+}
+[[nodiscard]] inline uint64_t readVarint(const uint8_t **data,
+                                         const uint8_t *end)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift = shift + 7)
+    {
+        if (*data == end)
+        {
+            throw std::runtime_error("Encoded samples are truncated");
+        }
+        auto byte = **data;
+        *data = *data + 1;
+        value = value | (static_cast<uint64_t> (byte & 0x7F) << shift);
+        if ((byte & 0x80) == 0){return value;}
+    }
+    throw std::runtime_error("Encoded samples have an invalid varint");
+}
+/// @result True indicates the samples can be exactly stored as integers.
+[[nodiscard]] inline bool isIntegral(const double *x, const int n) noexcept
+{
+    for (int i = 0; i < n; ++i)
+    {
+        // This also rejects NaNs, infinities, and negative zero
+        if (x[i] != std::trunc(x[i]) || std::abs(x[i]) > MAX_EXACT_INTEGER)
+        {
+            return false;
+        }
+        if (x[i] == 0 && std::signbit(x[i])){return false;}
+    }
+    return true;
+}
+[[nodiscard]] inline uint64_t toBits(const double x) noexcept
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(double));
+    return bits;
+}
+[[nodiscard]] inline double fromBits(const uint64_t bits) noexcept
+{
+    double x;
+    std::memcpy(&x, &bits, sizeof(double));
+    return x;
+}
+/// @brief Appends the integer valued samples as zig-zag mapped, variable
+///        length first differences.  Unlike \c encodeSamples() no encoding
+///        byte is written.
+/// @param[in] x          The samples.  This is an array whose dimension
+///                       is [n].  The caller must verify the samples are
+///                       integral with \c isIntegral().
+/// @param[in] n          The number of samples.
+/// @param[in,out] output  The container to which the encoded samples are
+///                        appended.
+template<typename Container>
+void appendIntegerDeltas(const double *x, const int n, Container *output)
+{
+    int64_t previous = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        auto value = static_cast<int64_t> (x[i]);
+        ::writeVarint(::zigZagEncode(value - previous), output);
+        previous = value;
+    }
+}
+/// @brief Decodes n samples written by \c appendIntegerDeltas().
+/// @param[in,out] data  On input, the start of the encoded samples.  On
+///                      exit, the byte following the last decoded sample.
+/// @param[in] end       The end of the encoded samples.
+/// @param[in] n         The number of samples to decode.
+/// @param[out] x        The decoded samples.  This is an array whose
+///                      dimension is [n].
+/// @throws std::runtime_error if the encoded samples are malformed.
+inline void decodeIntegerDeltas(const uint8_t **data, const uint8_t *end,
+                                const int n, double *x)
+{
+    // Accumulate with unsigned arithmetic since the deltas of a malformed
+    // message can overflow a signed integer.
+    uint64_t value = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        auto delta = ::zigZagDecode(::readVarint(data, end));
+        value = value + static_cast<uint64_t> (delta);
+        x[i] = static_cast<double> (static_cast<int64_t> (value));
+    }
+}
+/// @brief Decodes all the samples written by \c appendIntegerDeltas().
+/// @param[in] data      The encoded samples.
+/// @param[in] size      The number of bytes in data.
+/// @param[in,out] x     The decoded samples are appended to this.
+/// @throws std::runtime_error if the encoded samples are malformed.
+[[maybe_unused]]
+void decodeIntegerDeltas(const uint8_t *data, const size_t size,
+                         std::vector<double> *x)
+{
+    const auto *end = data + size;
+    uint64_t value = 0; // Unsigned so malformed deltas cannot overflow
+    while (data != end)
+    {
+        auto delta = ::zigZagDecode(::readVarint(&data, end));
+        value = value + static_cast<uint64_t> (delta);
+        x->push_back(static_cast<double> (static_cast<int64_t> (value)));
+    }
+}
+/// @result The encoded samples.
+[[maybe_unused]] [[nodiscard]]
+std::vector<uint8_t> encodeSamples(const double *x, const int n)
+{
+    const auto rawSize = 1 + sizeof(double)*static_cast<size_t> (n);
+    std::vector<uint8_t> result;
+    result.reserve(rawSize);
+    if (::isIntegral(x, n))
+    {
+        result.push_back(static_cast<uint8_t> (SampleEncoding::IntegerDelta));
+        ::appendIntegerDeltas(x, n, &result);
+    }
+    else
+    {
+        result.push_back(static_cast<uint8_t> (SampleEncoding::FloatXOR));
+        uint64_t previous = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            auto bits = ::toBits(x[i]);
+            auto difference = bits ^ previous;
+            previous = bits;
+            if (difference == 0)
+            {
+                result.push_back(0x80); // 8 leading zero bytes
+                continue;
+            }
+            int leading = __builtin_clzll(difference)/8;
+            int trailing = __builtin_ctzll(difference)/8;
+            result.push_back(static_cast<uint8_t> ((leading << 4) | trailing));
+            for (int j = 7 - leading; j >= trailing; --j)
+            {
+                result.push_back(static_cast<uint8_t> (difference >> (8*j)));
+            }
+        }
+    }
+    if (result.size() >= rawSize)
+    {
+        result.resize(rawSize);
+        result[0] = static_cast<uint8_t> (SampleEncoding::Raw);
+        std::memcpy(result.data() + 1, x, sizeof(double)*n);
+    }
+    result.shrink_to_fit();
+    return result;
+}
+/// @brief Decodes the samples.
+/// @param[in] data   The encoded samples.
+/// @param[in] size   The number of bytes in data.
+/// @param[in] n      The number of samples.
+/// @param[out] x     The decoded samples.  This is an array whose dimension
+///                   is [n].
+/// @throws std::runtime_error if the encoded samples are malformed.
+[[maybe_unused]]
+void decodeSamples(const uint8_t *data, const size_t size,
+                   const int n, double *x)
+{
+    if (size == 0){throw std::runtime_error("No encoded samples");}
+    const auto *end = data + size;
+    auto encoding = static_cast<SampleEncoding> (*data);
+    data = data + 1;
+    if (encoding == SampleEncoding::IntegerDelta)
+    {
+        ::decodeIntegerDeltas(&data, end, n, x);
+    }
+    else if (encoding == SampleEncoding::FloatXOR)
+    {
+        uint64_t previous = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            if (data == end)
+            {
+                throw std::runtime_error("Encoded samples are truncated");
+            }
+            int leading = *data >> 4;
+            int trailing = *data & 0x0F;
+            data = data + 1;
+            if (leading + trailing > 8)
+            {
+                throw std::runtime_error("Encoded samples are corrupt");
+            }
+            auto nBytes = 8 - leading - trailing;
+            if (end - data < nBytes)
+            {
+                throw std::runtime_error("Encoded samples are truncated");
+            }
+            uint64_t difference = 0;
+            for (int j = 0; j < nBytes; ++j)
+            {
+                difference = (difference << 8) | data[j];
+            }
+            data = data + nBytes;
+            if (nBytes > 0){difference = difference << (8*trailing);}
+            previous = previous ^ difference;
+            x[i] = ::fromBits(previous);
+        }
+    }
+    else if (encoding == SampleEncoding::Raw)
+    {
+        if (static_cast<size_t> (end - data) < sizeof(double)*n)
+        {
+            throw std::runtime_error("Encoded samples are truncated");
+        }
+        std::memcpy(x, data, sizeof(double)*n);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown sample encoding");
+    }
+}
+}
+#endif
+#endif
@@ -0,0 +1,83 @@
+#ifndef URTS_PRIVATE_SERIALIZED_MESSAGE_HPP
+#define URTS_PRIVATE_SERIALIZED_MESSAGE_HPP
+#ifdef URTS_SRC
+#include <string>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <umps/messageFormats/message.hpp>
+namespace
+{
+/// @brief Serializes a broadcast message into a buffer that is reused by
+///        every send on the calling thread.  The UMPS publisher only
+///        accepts a message and copies the result of \c toMessage() into
+///        the outgoing frame so this presents the serialized buffer as a
+///        message.  This avoids regrowing a new string, or building
+///        intermediate documents, on every send at the cost of copying the
+///        finished buffer into the exactly sized payload UMPS requires.
+/// @note Use this only for messages whose encoders grow their output, e.g.,
+///       the CBOR messages and the data packet batch.  A message that
+///       writes its payload once into an exactly sized string, e.g., a
+///       single data packet, should be sent directly since this would
+///       only add a copy.
+/// @tparam T  The message type.  This must define
+///            serializeInto(std::string *buffer, Args...).
+/// @note This is write-only and must not outlive the wrapped message.
+template<typename T>
+class SerializedMessage : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// @brief Serializes the message into this thread's buffer.
+    /// @param[in] message  The message to serialize.
+    /// @param[in] args     Any additional serialization options, e.g., the
+    ///                     data packet batch's sample encoding.
+    /// @throws std::runtime_error if the message cannot be serialized.
+    template<typename... Args>
+    explicit SerializedMessage(const T &message, Args&&... args) :
+        mMessage(message)
+    {
+        mMessage.serializeInto(&getBuffer(), std::forward<Args> (args)...);
+    }
+    /// @result The serialized message.
+    [[nodiscard]] std::string toMessage() const final
+    {
+        return getBuffer();
+    }
+    [[nodiscard]] std::string getMessageType() const noexcept final
+    {
+        return mMessage.getMessageType();
+    }
+    [[nodiscard]] std::string getMessageVersion() const noexcept final
+    {
+        return mMessage.getMessageVersion();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        clone() const final
+    {
+        return mMessage.clone();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createInstance() const noexcept final
+    {
+        return mMessage.createInstance();
+    }
+    void fromMessage(const std::string &) final
+    {
+        throw std::runtime_error("Serialized messages are write-only");
+    }
+    void fromMessage(const char *, const size_t) final
+    {
+        throw std::runtime_error("Serialized messages are write-only");
+    }
+private:
+    /// @result The calling thread's serialization buffer for this type.
+    [[nodiscard]] static std::string &getBuffer() noexcept
+    {
+        thread_local std::string buffer;
+        return buffer;
+    }
+    const T &mMessage;
+};
+}
+#endif
+#endif
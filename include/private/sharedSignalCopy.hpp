@@ -0,0 +1,64 @@
+#ifndef URTS_PRIVATE_SHARED_SIGNAL_COPY_HPP
+#define URTS_PRIVATE_SHARED_SIGNAL_COPY_HPP
+#ifdef URTS_SRC
+#include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
+namespace
+{
+/// @brief Holds a vector copy of a signal that is otherwise viewed, e.g.,
+///        in a received message, so that a const accessor can return a
+///        reference to a std::vector.  The copy is made on the first
+///        request, concurrent const requests are safe, and copies of the
+///        owner share rather than duplicate the samples.
+class SharedSignalCopy
+{
+public:
+    /// @brief Constructor.
+    SharedSignalCopy() = default;
+    /// @brief Copy constructor.  The copy of the signal is shared.
+    SharedSignalCopy(const SharedSignalCopy &copy)
+    {
+        *this = copy;
+    }
+    /// @brief Copy assignment.  The copy of the signal is shared.
+    SharedSignalCopy& operator=(const SharedSignalCopy &copy)
+    {
+        if (&copy == this){return *this;}
+        std::shared_ptr<const std::vector<double>> signal;
+        {
+        std::lock_guard<std::mutex> lock(copy.mMutex);
+        signal = copy.mSignal;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSignal = std::move(signal);
+        return *this;
+    }
+    /// @param[in] signal  The signal to copy if this has no copy yet.
+    /// @result A reference to the copy of the signal.  This is valid until
+    ///         \c reset() is called or this is destroyed.
+    [[nodiscard]] const std::vector<double> &
+        get(const std::span<const double> &signal) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mSignal == nullptr)
+        {
+            mSignal = std::make_shared<const std::vector<double>>
+                      (signal.begin(), signal.end());
+        }
+        return *mSignal;
+    }
+    /// @brief Releases the copy.  Call this when the signal changes.
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSignal = nullptr;
+    }
+private:
+    mutable std::mutex mMutex;
+    mutable std::shared_ptr<const std::vector<double>> mSignal{nullptr};
+};
+}
+#endif
+#endif
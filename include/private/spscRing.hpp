@@ -0,0 +1,130 @@
+#ifndef URTS_PRIVATE_SPSC_RING_HPP
+#define URTS_PRIVATE_SPSC_RING_HPP
+#ifdef URTS_SRC
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+namespace
+{
+/// @brief A bounded, lock-free ring for handing values from exactly one
+///        producer thread to exactly one consumer thread.  The slots are
+///        allocated up front and values are moved in and out of them so,
+///        once the values' own storage is warm, nothing is copied or
+///        allocated.
+/// @note The producer may only call \c try_push() and the consumer may only
+///       call \c pop_all().  The remaining functions are not safe while
+///       either thread is active unless noted otherwise.
+template<typename T>
+class SPSCRing
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] capacity  The maximum number of values in the ring.  This
+    ///                      is rounded up to a power of two.
+    explicit SPSCRing(const size_t capacity = 1)
+    {
+        setCapacity(capacity);
+    }
+    /// @brief Resizes the ring.  Any values in the ring are released.
+    /// @param[in] capacity  The maximum number of values in the ring.  This
+    ///                      is rounded up to a power of two.
+    /// @throws std::invalid_argument if capacity is 0 or too large.
+    void setCapacity(const size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("Capacity must be positive");
+        }
+        if (capacity > (std::numeric_limits<size_t>::max() >> 2))
+        {
+            throw std::invalid_argument("Capacity is too large");
+        }
+        auto nSlots = std::bit_ceil(capacity);
+        std::vector<T> slots(nSlots);
+        mSlots.swap(slots);
+        mMask = nSlots - 1;
+        mHead.store(0, std::memory_order_relaxed);
+        mTail.store(0, std::memory_order_relaxed);
+        mCachedTail = 0;
+    }
+    /// @brief Discards any values in the ring.  Unlike \c setCapacity() the
+    ///        slots, and whatever storage their values hold, are kept.
+    void clear() noexcept
+    {
+        mTail.store(mHead.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+        mCachedTail = mTail.load(std::memory_order_relaxed);
+    }
+    /// @brief Moves a value to the back of the ring.  This is called by the
+    ///        producer.
+    /// @param[in,out] value  The value to add.  If the value was added then
+    ///                       on exit value's behavior is undefined.
+    /// @result True indicates the value was added.  False indicates the ring
+    ///         was full and value is unchanged.
+    [[nodiscard]] bool try_push(T &&value)
+    {
+        auto head = mHead.load(std::memory_order_relaxed);
+        if (head - mCachedTail > mMask)
+        {
+            // Only look at the consumer's index when the ring appears full
+            mCachedTail = mTail.load(std::memory_order_acquire);
+            if (head - mCachedTail > mMask){return false;}
+        }
+        mSlots[head & mMask] = std::move(value);
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    /// @brief Moves up to maxValues values from the front of the ring to the
+    ///        back of the container.  This is called by the consumer.
+    /// @param[in,out] values  The values are appended to this.
+    /// @param[in] maxValues   The maximum number of values to move.
+    /// @result The number of values moved.
+    template<typename Container>
+    size_t pop_all(Container *values,
+                   const size_t maxValues = std::numeric_limits<size_t>::max())
+    {
+        auto tail = mTail.load(std::memory_order_relaxed);
+        auto head = mHead.load(std::memory_order_acquire);
+        auto nValues = std::min(static_cast<size_t> (head - tail), maxValues);
+        for (size_t i = 0; i < nValues; ++i)
+        {
+            values->push_back(std::move(mSlots[(tail + i) & mMask]));
+        }
+        mTail.store(tail + nValues, std::memory_order_release);
+        return nValues;
+    }
+    /// @result The number of values in the ring.  When called while the
+    ///         threads are active this is only a snapshot.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        auto tail = mTail.load(std::memory_order_acquire);
+        auto head = mHead.load(std::memory_order_acquire);
+        return static_cast<size_t> (head - tail);
+    }
+    /// @result True indicates the ring is empty.  When called while the
+    ///         threads are active this is only a snapshot.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+    /// @result The maximum number of values the ring can hold.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return mSlots.size();
+    }
+private:
+    // The indices only grow.  They are on separate cache lines so the
+    // producer and consumer do not contend.
+    alignas(64) std::atomic<size_t> mHead{0};
+    /// The producer's last view of mTail.
+    size_t mCachedTail{0};
+    alignas(64) std::atomic<size_t> mTail{0};
+    alignas(64) std::vector<T> mSlots;
+    size_t mMask{0};
+};
+}
+#endif
+#endif
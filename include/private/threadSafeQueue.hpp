@@ -1,14 +1,19 @@
 #ifndef URTS_PRIVATE_THREAD_SAFE_QUEUE_HPP
 #define URTS_PRIVATE_THREAD_SAFE_QUEUE_HPP
 #ifdef URTS_SRC
-#include <queue>
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
+#include <boost/circular_buffer.hpp>
 namespace
 {
 /// @brief This is a thread-safe queue based on listing 4.5 of C++ Concurrency
 ///        in Action, 2nd Edition. 
+/// @note The values are held in a ring that only grows.  Hence, once the
+///       queue has seen its working depth, pushing and popping do not
+///       allocate.  Values are moved in and out of the queue when possible.
 template<typename T>
 class ThreadSafeQueue
 {
@@ -61,12 +66,42 @@ public:
     void push(const T &value)
     {
         std::lock_guard<std::mutex> lockGuard(mMutex);
-        mDataQueue.push(value);
+        reserveOne();
+        mDataQueue.push_back(value);
         mConditionVariable.notify_one(); // Let waiting thread know 
     }
-    /// @brief Copies the value from the front of the queue and removes that
+    /// @brief Adds a value to the back of the queue.
+    /// @param[in,out] value  The value to move to the back of the queue.
+    ///                       On exit, value's behavior is undefined.
+    void push(T &&value)
+    {
+        std::lock_guard<std::mutex> lockGuard(mMutex);
+        reserveOne();
+        mDataQueue.push_back(std::move(value));
+        mConditionVariable.notify_one(); // Let waiting thread know 
+    }
+    /// @brief Moves a batch of values to the back of the queue.  This takes
+    ///        the lock and wakes the waiting threads once for the whole batch.
+    /// @param[in,out] values  The values to move to the back of the queue.
+    ///                        On exit, this is empty but retains its storage.
+    template<typename Container>
+    void push_all(Container *values)
+    {
+        if (values->empty()){return;}
+        {
+            std::lock_guard<std::mutex> lockGuard(mMutex);
+            for (auto &value : *values)
+            {
+                reserveOne();
+                mDataQueue.push_back(std::move(value));
+            }
+        }
+        values->clear();
+        mConditionVariable.notify_all(); // Let waiting threads know
+    }
+    /// @brief Moves the value from the front of the queue and removes that
     ///        value from the front of the queue.
-    /// @param[out] value  A copy of the value at the front of the queue.
+    /// @param[out] value  The value at the front of the queue.
     void wait_and_pop(T *value)
     {
         // Waiting thread needs to unlock mutex while waiting and lock again
@@ -76,10 +111,10 @@ public:
                                 {
                                     return !mDataQueue.empty();
                                 });
-        *value = mDataQueue.front();
-        mDataQueue.pop();
+        *value = std::move(mDataQueue.front());
+        mDataQueue.pop_front();
     }
-    /// @brief Copies the value from the front of the queue and removes that
+    /// @brief Moves the value from the front of the queue and removes that
     ///        value from the front of the queue.
     /// @param[out] value  The value from the front of the queue.  Or, if the
     ///                    function times out, then a NULL pointer.
@@ -98,8 +133,8 @@ public:
                                              return !mDataQueue.empty();
                                          }))
         {
-            *value = mDataQueue.front();
-            mDataQueue.pop();
+            *value = std::move(mDataQueue.front());
+            mDataQueue.pop_front();
             return true;
         }
         return false;
@@ -109,7 +144,7 @@ public:
     void pop()
     {
         std::lock_guard<std::mutex> lockGuard(mMutex);
-        mDataQueue.pop();
+        mDataQueue.pop_front();
     }
     /// @result A container with the value from the front of the queue.  The
     ///         value at front of the queue is removed.
@@ -121,8 +156,9 @@ public:
                                 {
                                     return !mDataQueue.empty();
                                 });
-        std::shared_ptr<T> result(std::make_shared<T> (mDataQueue.front()));
-        mDataQueue.pop();
+        std::shared_ptr<T> result(
+            std::make_shared<T> (std::move(mDataQueue.front())));
+        mDataQueue.pop_front();
         return result;
     }
     /// @brief Attempts to copy the value of the value at the front of the queue
@@ -137,8 +173,8 @@ public:
         *value = nullptr;
         std::lock_guard<std::mutex> lockGuard(mMutex);
         if (mDataQueue.empty()){return false;}
-        *value = mDataQueue.front();
-        mDataQueue.pop();
+        *value = std::move(mDataQueue.front());
+        mDataQueue.pop_front();
         return true;
     }
     /// @brief A container with the value at the front of the queue provided
@@ -155,8 +191,8 @@ public:
             result = nullptr;
             return result;
         }
-        result = std::make_shared<T> (mDataQueue.front());
-        mDataQueue.pop();
+        result = std::make_shared<T> (std::move(mDataQueue.front()));
+        mDataQueue.pop_front();
         return result;
     }
     /// @result True indicates that the queue is empty.
@@ -184,8 +220,20 @@ public:
     ~ThreadSafeQueue() = default;
     /// @}
 private:
+    /// Doubles the ring's capacity if it is full.  Unlike a std::deque, the
+    /// ring does not release its storage as values are popped.
+    void reserveOne()
+    {
+        if (mDataQueue.full())
+        {
+            mDataQueue.set_capacity(
+                std::max<size_t> (2*mDataQueue.capacity(),
+                                  INITIAL_CAPACITY));
+        }
+    }
+    static constexpr size_t INITIAL_CAPACITY{64};
     mutable std::mutex mMutex;
-    std::queue<T> mDataQueue;
+    boost::circular_buffer<T> mDataQueue;
     std::condition_variable mConditionVariable;
 };
 }
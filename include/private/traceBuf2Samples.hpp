@@ -0,0 +1,133 @@
+#ifndef URTS_PRIVATE_TRACEBUF2_SAMPLES_HPP
+#define URTS_PRIVATE_TRACEBUF2_SAMPLES_HPP
+#ifdef URTS_SRC
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+namespace
+{
+/// @result The unsigned integer with the same width as U.
+template<typename U>
+using SameWidthUnsigned
+    = std::conditional_t<sizeof(U) == 2, uint16_t,
+      std::conditional_t<sizeof(U) == 4, uint32_t, uint64_t>>;
+
+/// @result The value with its bytes reversed.
+template<typename W>
+[[nodiscard]] inline W reverseBytes(const W value) noexcept
+{
+    if constexpr (sizeof(W) == 2)
+    {
+        return __builtin_bswap16(value);
+    }
+    else if constexpr (sizeof(W) == 4)
+    {
+        return __builtin_bswap32(value);
+    }
+    else
+    {
+        return __builtin_bswap64(value);
+    }
+}
+
+/// @brief Converts a block of TraceBuf2 samples of type U to T.
+/// @param[in] cIn       The packed samples.  This need not be aligned.
+/// @param[in] nSamples  The number of samples.
+/// @param[out] out      The converted samples.  This has dimension
+///                      [nSamples].
+/// @note The loops have a fixed-size copy and no branches so the compiler
+///       vectorizes them, including the byte reversal, for whichever
+///       instruction set it targets.
+template<typename T, typename U, bool Swap>
+void convertSamples(const char *__restrict__ cIn, const int nSamples,
+                    T *__restrict__ out) noexcept
+{
+    static_assert(sizeof(U) == 2 || sizeof(U) == 4 || sizeof(U) == 8,
+                  "Samples must be 2, 4, or 8 bytes");
+    if constexpr (!Swap && std::is_same_v<T, U>)
+    {
+        std::memcpy(out, cIn, nSamples*sizeof(U));
+        return;
+    }
+    using W = SameWidthUnsigned<U>;
+    for (int i = 0; i < nSamples; ++i)
+    {
+        W word;
+        std::memcpy(&word, cIn + i*sizeof(U), sizeof(U));
+        if constexpr (Swap){word = reverseBytes(word);}
+        out[i] = static_cast<T> (std::bit_cast<U> (word));
+    }
+}
+
+/// @brief Converts a block of TraceBuf2 samples of type U to T.
+template<typename T, typename U>
+void convertSamples(const char *__restrict__ cIn, const int nSamples,
+                    const bool swap, T *__restrict__ out) noexcept
+{
+    if (swap)
+    {
+        convertSamples<T, U, true>(cIn, nSamples, out);
+    }
+    else
+    {
+        convertSamples<T, U, false>(cIn, nSamples, out);
+    }
+}
+
+/// @brief Unpacks the samples of a TraceBuf2 message.
+/// @param[in] cIn       The packed samples.
+/// @param[in] nSamples  The number of samples.
+/// @param[in] dataType  'i' for integers or 'f' for floating point.
+/// @param[in] nBytes    The size of a sample in bytes: 2, 4, or 8.
+/// @param[in] swap      True indicates the samples' byte order differs from
+///                      this machine's.
+/// @param[out] samples  The unpacked samples.  This is resized to nSamples.
+/// @result False indicates the data type and size are not supported.
+template<typename T>
+[[nodiscard]]
+bool unpackSamples(const char *cIn, const int nSamples,
+                   const char dataType, const int nBytes, const bool swap,
+                   std::vector<T> *samples)
+{
+    samples->resize(nSamples);
+    auto out = samples->data();
+    if (dataType == 'i')
+    {
+        if (nBytes == 2)
+        {
+            convertSamples<T, int16_t>(cIn, nSamples, swap, out);
+            return true;
+        }
+        if (nBytes == 4)
+        {
+            convertSamples<T, int32_t>(cIn, nSamples, swap, out);
+            return true;
+        }
+        if (nBytes == 8)
+        {
+            convertSamples<T, int64_t>(cIn, nSamples, swap, out);
+            return true;
+        }
+    }
+    else if (dataType == 'f')
+    {
+        if (nBytes == 4)
+        {
+            convertSamples<T, float>(cIn, nSamples, swap, out);
+            return true;
+        }
+        if (nBytes == 8)
+        {
+            convertSamples<T, double>(cIn, nSamples, swap, out);
+            return true;
+        }
+    }
+    samples->clear();
+    return false;
+}
+
+}
+#endif
+#endif
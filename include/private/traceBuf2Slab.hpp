@@ -0,0 +1,97 @@
+#ifndef URTS_PRIVATE_TRACEBUF2_SLAB_HPP
+#define URTS_PRIVATE_TRACEBUF2_SLAB_HPP
+#ifdef URTS_SRC
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "urts/broadcasts/external/earthworm/traceBuf2.hpp"
+#include "private/workerPool.hpp"
+namespace
+{
+/// @brief Unpacks the traceBuf2 messages that were copied off a ring into
+///        a slab of fixed-size slots.
+/// @param[in] slab           The messages.  Message i starts at byte
+///                           i*slotSize.
+/// @param[in] slotSize       The size of a slot in bytes.
+/// @param[in] messageSizes   The number of bytes copied into each slot.
+///                           The slots are reused between reads so any
+///                           bytes past this are left over from an earlier
+///                           message and are never read.
+/// @param[in] messageTypes   The type of the message in each slot.
+/// @param[in] traceBuf2Type  The type of a traceBuf2 message.
+/// @param[in] nThreads       The number of threads to unpack with.  Each
+///                           unpacks a contiguous range of slots.  This is
+///                           limited to the pool's workers plus the calling
+///                           thread.
+/// @param[in,out] pool       The persistent threads that help the calling
+///                           thread unpack.  If this is NULL then the
+///                           calling thread unpacks every message.
+/// @param[out] messages      The unpacked messages.  This is resized to the
+///                           number of slots.  A slot that does not hold a
+///                           traceBuf2 message, or whose message cannot be
+///                           unpacked, yields an empty message.
+/// @result The number of traceBuf2 messages that could not be unpacked.
+template<typename T>
+[[nodiscard]] [[maybe_unused]]
+int unpackTraceBuf2Slab(
+    const std::vector<char> &slab,
+    const size_t slotSize,
+    const std::vector<long> &messageSizes,
+    const std::vector<unsigned char> &messageTypes,
+    const unsigned char traceBuf2Type,
+    const int nThreads,
+    ::WorkerPool *pool,
+    std::vector<URTS::Broadcasts::External::Earthworm::TraceBuf2<T>> *messages)
+{
+    auto nMessages = static_cast<int> (messageTypes.size());
+    messages->resize(nMessages);
+    // Each thread unpacks into the corresponding messages so the threads
+    // never share an output.
+    std::atomic<int> nFailed{0};
+    auto unpack = [&](const int i1, const int i2)
+    {
+        for (int it = i1; it < i2; ++it)
+        {
+            auto &message = (*messages)[it];
+            if (messageTypes[it] != traceBuf2Type)
+            {
+                message.clear();
+                continue;
+            }
+            try
+            {
+                message.fromEarthworm(slab.data() + it*slotSize,
+                                      static_cast<size_t> (messageSizes[it]));
+            }
+            catch (const std::exception &e)
+            {
+                message.clear();
+                nFailed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+    auto nParts = 1;
+    if (pool != nullptr)
+    {
+        nParts = std::min(std::max(1, nThreads),
+                          pool->getNumberOfWorkers() + 1);
+    }
+    auto chunkSize = (nMessages + nParts - 1)/nParts;
+    if (nParts > 1 && chunkSize > 0)
+    {
+        pool->run(nParts, [&](const int part)
+                  {
+                      auto i1 = std::min(nMessages, part*chunkSize);
+                      auto i2 = std::min(nMessages, i1 + chunkSize);
+                      unpack(i1, i2);
+                  });
+    }
+    else
+    {
+        unpack(0, nMessages);
+    }
+    return nFailed.load();
+}
+}
+#endif
+#endif
@@ -0,0 +1,139 @@
+#ifndef URTS_PRIVATE_WORKER_POOL_HPP
+#define URTS_PRIVATE_WORKER_POOL_HPP
+#ifdef URTS_SRC
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+namespace
+{
+/// @brief A fixed set of threads that are started once and then split
+///        work with the calling thread.  This avoids creating and joining
+///        threads every time a task is parallelized.
+/// @note Only one thread may call \c run() at a time.
+class WorkerPool
+{
+public:
+    /// @brief Constructor.  No workers are started.
+    WorkerPool() = default;
+    /// @brief Starts the workers.  Any existing workers are stopped first.
+    /// @param[in] nWorkers  The number of worker threads.  With the calling
+    ///                      thread, \c run() can execute nWorkers + 1 parts
+    ///                      at once.
+    /// @throws std::invalid_argument if nWorkers is negative.
+    void start(const int nWorkers)
+    {
+        if (nWorkers < 0)
+        {
+            throw std::invalid_argument("Number of workers cannot be negative");
+        }
+        stop();
+        mThreads.reserve(nWorkers);
+        for (int i = 0; i < nWorkers; ++i)
+        {
+            mThreads.push_back(std::thread(&WorkerPool::work, this,
+                                           i + 1, mGeneration));
+        }
+    }
+    /// @brief Stops and joins the workers.
+    void stop() noexcept
+    {
+        {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+        }
+        mWorkAvailable.notify_all();
+        for (auto &thread : mThreads){if (thread.joinable()){thread.join();}}
+        mThreads.clear();
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = false;
+    }
+    /// @result The number of worker threads.
+    [[nodiscard]] int getNumberOfWorkers() const noexcept
+    {
+        return static_cast<int> (mThreads.size());
+    }
+    /// @brief Calls task(i) for i = 0, 1, ..., nParts - 1 and returns when
+    ///        every call is done.  The calling thread does part 0 and the
+    ///        workers do the rest.
+    /// @param[in] nParts  The number of parts.  This cannot exceed
+    ///                    \c getNumberOfWorkers() + 1.
+    /// @param[in] task    The task.  This must not throw.
+    /// @throws std::invalid_argument if nParts is out of range.
+    void run(const int nParts, const std::function<void (int)> &task)
+    {
+        if (nParts < 1 || nParts > getNumberOfWorkers() + 1)
+        {
+            throw std::invalid_argument("Number of parts out of range");
+        }
+        if (nParts > 1)
+        {
+            {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTask = &task;
+            mParts = nParts;
+            mRemaining = nParts - 1;
+            mGeneration = mGeneration + 1;
+            }
+            mWorkAvailable.notify_all();
+        }
+        task(0);
+        if (nParts > 1)
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkDone.wait(lock, [this]{return mRemaining == 0;});
+            mTask = nullptr;
+        }
+    }
+    /// @brief Destructor.  This joins the workers.
+    ~WorkerPool()
+    {
+        stop();
+    }
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool& operator=(const WorkerPool &) = delete;
+private:
+    /// Does the given part of every task posted after the generation.
+    void work(const int part, uint64_t generation)
+    {
+        while (true)
+        {
+            const std::function<void (int)> *task{nullptr};
+            {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkAvailable.wait(lock, [&]
+                                {
+                                    return mStop || mGeneration != generation;
+                                });
+            if (mStop){return;}
+            generation = mGeneration;
+            if (part >= mParts){continue;}
+            task = mTask;
+            }
+            (*task)(part);
+            bool done{false};
+            {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRemaining = mRemaining - 1;
+            done = (mRemaining == 0);
+            }
+            if (done){mWorkDone.notify_one();}
+        }
+    }
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::condition_variable mWorkDone;
+    std::vector<std::thread> mThreads;
+    const std::function<void (int)> *mTask{nullptr};
+    uint64_t mGeneration{0};
+    int mParts{0};
+    int mRemaining{0};
+    bool mStop{false};
+};
+}
+#endif
+#endif
@@ -185,9 +185,18 @@ public:
     /// @{
 
     /// @brief Unpacks a tracebuf2 message from the earthworm ring.
-    /// @param[in] message   The earthworm message.
+    /// @param[in] message   The earthworm message.  This is assumed to
+    ///                      span a full MAX_TRACEBUF_SIZ buffer.
     /// @throws std::runtime_error if the message is invalid or NULL.
     void fromEarthworm(const char *message);
+    /// @brief Unpacks a tracebuf2 message from the earthworm ring.
+    /// @param[in] message   The earthworm message.
+    /// @param[in] length    The number of bytes in the message, e.g., the
+    ///                      size returned by tport_copyfrom.  Bytes beyond
+    ///                      this are never read.
+    /// @throws std::invalid_argument if the message is NULL, is smaller
+    ///         than the header, or its samples extend beyond length.
+    void fromEarthworm(const char *message, size_t length);
     /// @brief Converts this class to a JSON message.
     /// @param[in] nIndent  The number of spaces to indent.
     /// @note -1 disables indentation which is preferred for message
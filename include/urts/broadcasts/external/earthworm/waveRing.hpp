@@ -2,6 +2,7 @@
 #define URTS_BROADCASTS_EXTERNAL_EARTHWORM_WAVE_RING_HPP
 #include <memory>
 #include <vector>
+#include <chrono>
 namespace UMPS::Logging
 {
  class ILog;
@@ -72,9 +73,28 @@ public:
     /// @brief Flushes the ring.  This is usually a good thing to do on startup.
     /// @throws std::runtime_error if \c isConnected() is false.
     void flush();
+    /// @brief Sets the number of threads used to unpack the messages.  The
+    ///        messages are only split across threads when a read returns
+    ///        many messages, e.g., when catching up.  The helper threads
+    ///        are started by \c connect(), or here when already connected,
+    ///        and joined by \c disconnect().  This must not be called
+    ///        during a \c read().
+    /// @param[in] nThreads  The number of unpacking threads, including the
+    ///                      thread calling \c read().
+    /// @throws std::invalid_argument if nThreads is not positive.
+    void setNumberOfUnpackThreads(int nThreads);
+    /// @result The number of threads used to unpack the messages.
+    [[nodiscard]] int getNumberOfUnpackThreads() const noexcept;
     /// @brief Reads the ring.
     /// @throws std::runtime_error if \c isConnected() is false.
     void read();
+    /// @result The number of messages copied off the ring in the last read.
+    [[nodiscard]] int getNumberOfMessagesRead() const noexcept;
+    /// @result The time spent copying messages off the ring in the last read.
+    [[nodiscard]] std::chrono::microseconds getCopyTime() const noexcept;
+    /// @result The time spent unpacking the traceBuf2 messages in the last
+    ///         read.
+    [[nodiscard]] std::chrono::microseconds getUnpackTime() const noexcept;
 
     /// @result The traceBuf2 messages read from the ring.
     [[nodiscard]] std::vector<TraceBuf2<double>>
@@ -2,6 +2,9 @@
 #define URTS_BROADCASTS_EXTERNAL_SEEDLINK_CLIENT_HPP
 #include <memory>
 #include <vector>
+#include <limits>
+#include <chrono>
+#include <cstdint>
 namespace UMPS::Logging
 {
  class ILog;
@@ -69,9 +72,36 @@ public:
     void start();
     /// @result The packets read from the SEEDLink client.
     [[nodiscard]] std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> getPackets() const;
-    /// @result The packet at the front of the queue (i.e., the oldest packet).
-    ///         If NULL then the queue is empty.
-    [[nodiscard]] std::shared_ptr<URTS::Broadcasts::Internal::DataPacket::DataPacket> try_pop();
+    /// @brief Moves the oldest packets read from the SEEDLink client out of
+    ///        the queue.  The reader thread hands packets over through a
+    ///        lock-free ring so this never blocks the reader.
+    /// @param[out] packets    On exit, this holds up to maxPackets packets
+    ///                        in the order they were read.  The vector's
+    ///                        existing storage is reused.
+    /// @param[in] maxPackets  The maximum number of packets to get.
+    /// @param[out] ingestTimes  If not NULL then on exit this holds the time
+    ///                          the reader thread queued each packet.  This
+    ///                          is useful for measuring latency.
+    /// @result The number of packets.
+    /// @throws std::invalid_argument if packets is NULL or maxPackets is
+    ///         not positive.
+    /// @note Only one thread may get packets at a time.
+    int getPackets(std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> *packets,
+                   int maxPackets = std::numeric_limits<int>::max(),
+                   std::vector<std::chrono::steady_clock::time_point> *ingestTimes = nullptr) const;
+    /// @brief Blocks until the reader thread has queued packets or the
+    ///        time out elapses.  The reader only signals when a consumer
+    ///        is waiting so this is cheap when packets are plentiful.
+    /// @param[in] timeOut  The maximum time to wait.
+    /// @result True indicates packets are available.
+    /// @throws std::invalid_argument if timeOut is negative.
+    /// @note Only the thread getting packets may call this.
+    bool waitForPackets(const std::chrono::milliseconds &timeOut) const;
+    /// @result The number of packets dropped because the queue was full
+    ///         since the client was last started.  When the queue is full
+    ///         the newest packet is dropped.
+    /// @sa ClientOptions::setMaximumInternalQueueSize()
+    [[nodiscard]] uint64_t getNumberOfOverflowedPackets() const noexcept;
     /// @result The size of the queue.
     [[nodiscard]] size_t size() const;
     /// @result True indicates the queue is empty.
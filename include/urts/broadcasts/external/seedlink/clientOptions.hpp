@@ -62,8 +62,10 @@ public:
 
     /// @brief Packets are read from SEED Link, put onto an internal queue,
     ///        then sent out via the databroadcast.  This sets the maximum
-    ///        internal queue size.  After this point, the oldest packets
-    ///        are popped from the queue.
+    ///        internal queue size.  After this point, newly read packets
+    ///        are dropped and counted - see
+    ///        \c Client::getNumberOfOverflowedPackets().
+    /// @note The queue size is rounded up to a power of two.
     /// @param[in] maximumQueueSize  The maximum queue size in number of
     ///                              packets.
     /// @throws std::invalid_argument if this is not positive.
@@ -8,10 +8,30 @@ namespace URTS::Broadcasts::Internal::DataPacket
 {
 /// @class DataPacket "dataPacket.hpp" "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 /// @brief Defines a seismic data packet.
+/// @note Packets are created and destroyed at the rate data arrives.  To
+///       avoid heap traffic, a destroyed packet's storage, including its
+///       sample buffer, is returned to a shared pool from which new packets
+///       are created.
 /// @copyright Ben Baker (University of Utah) distributed under the MIT license.
 /// @ingroup Modules_Broadcasts_Internal_DataPacket
 class DataPacket : public UMPS::MessageFormats::IMessage
 {
+public:
+    /// @brief Defines how the samples are encoded in the binary message.
+    ///        Regardless of the encoding, the samples are read from the
+    ///        packet as doubles.
+    enum class Encoding
+    {
+        Float64 = 0,     /*!< Little-endian 8 byte doubles. */
+        IntegerDelta = 1 /*!< Lossless compression of integer valued samples,
+                              which is what digitizers produce.  The first
+                              sample and subsequent first differences are
+                              zig-zag mapped and written as variable length
+                              integers so that small differences occupy a
+                              single byte.  Packets whose samples are not
+                              integers, or that would not get smaller, are
+                              written as Float64. */
+    };
 public:
     /// @name Constructors
     /// @{
@@ -36,7 +56,8 @@ public:
     DataPacket& operator=(const DataPacket &packet);
     /// @brief Move assignment.
     /// @param[in,out] packet  The packet whose memory will be moved to
-    ///                        this class.
+    ///                        this class.  On exit, packet is empty but
+    ///                        holds this class's previous storage.
     /// @result The memory from packet moved to this.
     DataPacket& operator=(DataPacket &&packet) noexcept; 
     /// @}
@@ -50,7 +71,7 @@ public:
     void setNetwork(const std::string &network);
     /// @result The network code.
     /// @throws std::runtime_error if \c haveNetwork() is false.
-    [[nodiscard]] std::string getNetwork() const;
+    [[nodiscard]] const std::string &getNetwork() const;
     /// @result True indicates that the network was set.
     [[nodiscard]] bool haveNetwork() const noexcept;
 
@@ -60,7 +81,7 @@ public:
     void setStation(const std::string &station);
     /// @result The station name.
     /// @throws std::runtime_error if \c haveStation() is false.
-    [[nodiscard]] std::string getStation() const;
+    [[nodiscard]] const std::string &getStation() const;
     /// @result True indicates that the station name was set.
     [[nodiscard]] bool haveStation() const noexcept;
 
@@ -70,7 +91,7 @@ public:
     void setChannel(const std::string &channel);
     /// @result The channel name.
     /// @throws std::runtime_error if the channel was not set.
-    [[nodiscard]] std::string getChannel() const;
+    [[nodiscard]] const std::string &getChannel() const;
     /// @result True indicates that the channel was set.
     [[nodiscard]] bool haveChannel() const noexcept;
 
@@ -80,7 +101,7 @@ public:
     void setLocationCode(const std::string &location);
     /// @brief Sets the location code.
     /// @throws std::runtime_error if \c haveLocationCode() is false.
-    [[nodiscard]] std::string getLocationCode() const;
+    [[nodiscard]] const std::string &getLocationCode() const;
     /// @result True indicates that the location code was set.
     [[nodiscard]] bool haveLocationCode() const noexcept;
 
@@ -141,6 +162,15 @@ public:
     [[nodiscard]] const double *getDataPointer() const noexcept;
     /// @result The number of data samples in the packet.
     [[nodiscard]] int getNumberOfSamples() const noexcept;
+    /// @brief Sets the encoding of the samples in the binary message.  This
+    ///        trades a little CPU on the publisher and subscribers for
+    ///        considerably less bandwidth.
+    /// @param[in] encoding  The encoding.
+    void setEncoding(Encoding encoding) noexcept;
+    /// @result The encoding of the samples in the binary message.  By
+    ///         default this is Float64.  After \c fromBinary() this is the
+    ///         encoding of the received message.
+    [[nodiscard]] Encoding getEncoding() const noexcept;
     /// @}
 
     /// @name Message Abstract Base Class Properties
@@ -151,11 +181,19 @@ public:
     /// @result An instance of an uninitialized class.
     [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> createInstance() const noexcept final;
     /// @brief Converts the packet class to a string message.
-    /// @result The class expressed as a string message.
+    /// @result The class expressed as a string message.  This is the
+    ///         binary format produced by \c toBinary().
     /// @throws std::runtime_error if the required information is not set. 
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Serializes the packet into the given buffer.  This writes the
+    ///        same message as \c toMessage() but reuses the buffer's
+    ///        storage so repeated serialization need not allocate.
+    /// @param[out] buffer  On exit, this holds the message.
+    /// @throws std::invalid_argument if buffer is NULL.
+    /// @throws std::runtime_error if the required information is not set.
+    void serializeInto(std::string *buffer) const;
     /// @brief Creates the class from a message.
     void fromMessage(const std::string &message) final;
     /// @brief Creates the class from a message.
@@ -164,6 +202,8 @@ public:
     /// @param[in] length  The length of data.
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argument if data is NULL or length is 0. 
+    /// @note Both the binary format and the CBOR format of version 1.0.0
+    ///       messages are accepted.
     void fromMessage(const char *data, size_t length) final;
     /// @result The message type - e.g., "DataPacket".
     [[nodiscard]] std::string getMessageType() const noexcept final;
@@ -171,6 +211,43 @@ public:
     [[nodiscard]] std::string getMessageVersion() const noexcept final;
     /// @}
 
+    /// @name Binary Wire Format
+    /// @{
+
+    /// @brief Converts the packet to the binary wire format.  This is a
+    ///        fixed size header followed by the network, station, channel,
+    ///        and location code then the samples encoded as specified by
+    ///        \c getEncoding().
+    /// @param[out] message  On exit, this holds the binary message.  The
+    ///                      message's existing storage is reused so callers
+    ///                      that keep the buffer avoid reallocating.
+    /// @throws std::runtime_error if the required information is not set. 
+    /// @throws std::invalid_argument if message is NULL or a name is longer
+    ///         than 255 characters.
+    void toBinary(std::string *message) const;
+    /// @brief Converts the packet to the binary wire format with the given
+    ///        sample encoding rather than \c getEncoding().  This lets a
+    ///        publisher re-encode a packet without copying it.
+    /// @param[out] message   On exit, this holds the binary message.
+    /// @param[in] encoding   The encoding of the samples.
+    /// @throws std::runtime_error if the required information is not set. 
+    /// @throws std::invalid_argument if message is NULL or a name is longer
+    ///         than 255 characters.
+    void toBinary(std::string *message, Encoding encoding) const;
+    /// @result The packet in the binary wire format.
+    /// @throws std::runtime_error if the required information is not set. 
+    [[nodiscard]] std::string toBinary() const;
+    /// @brief Creates the class from a binary message.  This packet's
+    ///        existing storage is reused.
+    /// @param[in] data    The contents of the binary message.  This is an
+    ///                    array whose dimension is [length].
+    /// @param[in] length  The length of data.
+    /// @throws std::invalid_argument if data is NULL or length is 0. 
+    /// @throws std::runtime_error if the message is invalid or has an
+    ///         unsupported version.  In this case the packet is unchanged.
+    void fromBinary(const uint8_t *data, size_t length);
+    /// @}
+
     /// @name Debugging Utilities
     /// @{
 
@@ -206,14 +283,20 @@ public:
     /// @name Destructors
     /// @{
 
-    /// @brief Resets the class and releases all memory.
+    /// @brief Resets the class.  The sample storage is retained so that
+    ///        the packet can be refilled without allocating.
     void clear() noexcept;
     /// @brief Destructor.
     ~DataPacket() override;
     /// @}
 private:
     class DataPacketImpl;
-    std::unique_ptr<DataPacketImpl> pImpl;
+    /// Returns the implementation to the pool.
+    struct DataPacketImplDeleter
+    {
+        void operator()(DataPacketImpl *impl) const noexcept;
+    };
+    std::unique_ptr<DataPacketImpl, DataPacketImplDeleter> pImpl;
 };
 }
 #endif
@@ -0,0 +1,154 @@
+#ifndef URTS_BROADCASTS_INTERNAL_DATA_PACKET_DATA_PACKET_BATCH_HPP
+#define URTS_BROADCASTS_INTERNAL_DATA_PACKET_DATA_PACKET_BATCH_HPP
+#include <vector>
+#include <memory>
+#include <umps/messageFormats/message.hpp>
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+namespace URTS::Broadcasts::Internal::DataPacket
+{
+/// @class DataPacketBatch "dataPacketBatch.hpp" "urts/broadcasts/internal/dataPacket/dataPacketBatch.hpp"
+/// @brief Defines a batch of data packets that are sent as a single message.
+///        This amortizes the per-message framing and serialization overhead
+///        when many packets are broadcast each second.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+/// @ingroup Modules_Broadcasts_Internal_DataPacket
+class DataPacketBatch : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    DataPacketBatch();
+    /// @brief Copy constructor.
+    /// @param[in] batch  The batch from which to initialize this class.
+    DataPacketBatch(const DataPacketBatch &batch);
+    /// @brief Move constructor.
+    /// @param[in,out] batch  The batch from which to initialize this class.
+    ///                       On exit, batch's behavior is undefined.
+    DataPacketBatch(DataPacketBatch &&batch) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment.
+    /// @param[in] batch  The batch to copy to this class.
+    /// @result A deep copy of the input batch.
+    DataPacketBatch& operator=(const DataPacketBatch &batch);
+    /// @brief Move assignment.
+    /// @param[in,out] batch  The batch whose memory will be moved to this
+    ///                       class.  On exit, batch's behavior is undefined.
+    /// @result The memory from batch moved to this.
+    DataPacketBatch& operator=(DataPacketBatch &&batch) noexcept;
+    /// @}
+
+    /// @name Packets
+    /// @{
+
+    /// @brief Adds a packet to the batch.
+    /// @param[in] packet  The packet to add.
+    /// @throws std::invalid_argument if the network, station, channel,
+    ///         location code, or sampling rate is not set.
+    void addPacket(const DataPacket &packet);
+    /// @brief Adds a packet to the batch.
+    /// @param[in,out] packet  The packet to add.  On exit, packet's behavior
+    ///                        is undefined.
+    /// @throws std::invalid_argument if the network, station, channel,
+    ///         location code, or sampling rate is not set.
+    void addPacket(DataPacket &&packet);
+    /// @brief Sets the packets in the batch.
+    /// @param[in,out] packets  The packets whose memory will be moved to
+    ///                         this class.  On exit, packets's behavior is
+    ///                         undefined.
+    /// @throws std::invalid_argument if any packet is missing its network,
+    ///         station, channel, location code, or sampling rate.
+    void setPackets(std::vector<DataPacket> &&packets);
+    /// @result The packets in the batch.
+    [[nodiscard]] std::vector<DataPacket> getPackets() const;
+    /// @result A reference to the packets in the batch.
+    [[nodiscard]] const std::vector<DataPacket> &getPacketsReference() const noexcept;
+    /// @result The packets in the batch.  On exit, the batch is empty.
+    [[nodiscard]] std::vector<DataPacket> movePackets() noexcept;
+    /// @result The number of packets in the batch.
+    [[nodiscard]] int getNumberOfPackets() const noexcept;
+    /// @result True indicates there are no packets in the batch.
+    [[nodiscard]] bool empty() const noexcept;
+    /// @}
+
+    /// @name Message Abstract Base Class Properties
+    /// @{
+
+    /// @result A copy of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> clone() const final;
+    /// @result An instance of an uninitialized class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> createInstance() const noexcept final;
+    /// @brief Converts the batch to a message.
+    /// @result The batch expressed in the binary format produced by
+    ///         \c toBinary().
+    [[nodiscard]] std::string toMessage() const final;
+    /// @brief Serializes the batch into the given buffer.  This writes the
+    ///        same message as \c toMessage() but reuses the buffer's
+    ///        storage so repeated serialization need not allocate.
+    /// @param[out] buffer  On exit, this holds the message.
+    /// @throws std::invalid_argument if buffer is NULL.
+    /// @throws std::runtime_error if the required information is not set.
+    void serializeInto(std::string *buffer) const;
+    /// @brief Serializes the batch into the given buffer with every
+    ///        packet's samples written with the given encoding.
+    /// @param[out] buffer   On exit, this holds the message.
+    /// @param[in] encoding  The encoding of every packet's samples.
+    /// @throws std::invalid_argument if buffer is NULL.
+    /// @throws std::runtime_error if the required information is not set.
+    void serializeInto(std::string *buffer,
+                       DataPacket::Encoding encoding) const;
+    /// @brief Creates the class from a message.
+    void fromMessage(const std::string &message) final;
+    /// @brief Creates the class from a message.
+    /// @param[in] data    The contents of the message.  This is an
+    ///                    array whose dimension is [length].
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.  In this case
+    ///         the batch is unchanged.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromMessage(const char *data, size_t length) final;
+    /// @result The message type.
+    [[nodiscard]] std::string getMessageType() const noexcept final;
+    /// @result The message version.
+    [[nodiscard]] std::string getMessageVersion() const noexcept final;
+    /// @}
+
+    /// @name Binary Wire Format
+    /// @{
+
+    /// @brief Converts the batch to the binary wire format.  This is a
+    ///        small header followed by each packet's length and binary
+    ///        representation - see \c DataPacket::toBinary().
+    /// @param[out] message  On exit, this holds the binary message.  The
+    ///                      message's existing storage is reused.
+    /// @throws std::invalid_argument if message is NULL.
+    void toBinary(std::string *message) const;
+    /// @brief Converts the batch to the binary wire format with every
+    ///        packet's samples written with the given encoding rather than
+    ///        the packet's own encoding.
+    /// @param[out] message   On exit, this holds the binary message.
+    /// @param[in] encoding   The encoding of every packet's samples.
+    /// @throws std::invalid_argument if message is NULL.
+    void toBinary(std::string *message, DataPacket::Encoding encoding) const;
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Removes all packets from the batch.  The batch's storage is
+    ///        retained.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~DataPacketBatch() override;
+    /// @}
+private:
+    class DataPacketBatchImpl;
+    std::unique_ptr<DataPacketBatchImpl> pImpl;
+};
+}
+#endif
@@ -65,12 +65,35 @@ public:
     /// @param[in] message  The message to send.
     /// @throws std::runtime_error if the class is not initialized.
     /// @throws std::invalid_argument if the message cannot be serialized.
+    /// @note If batching is enabled in the publisher options then the
+    ///       message is added to the current batch.  The batch is sent once
+    ///       it is full or, when a later packet is sent, its oldest packet
+    ///       exceeds the maximum batch age.  There is no timer so producers
+    ///       must call \c flush() when they go idle.
+    /// @note The packet is sent with the publisher options' sample
+    ///       encoding.  Packets with a different encoding are re-encoded
+    ///       while serializing rather than copied.
     void send(const DataPacket &message);
+    /// @brief Sends a message.  This will serialize the message.
+    /// @param[in,out] message  The message to send.  On exit, message's
+    ///                         behavior is undefined.
+    /// @throws std::runtime_error if the class is not initialized.
+    /// @throws std::invalid_argument if the message cannot be serialized.
+    void send(DataPacket &&message);
+    /// @brief Sends any packets in the current batch.  When batching, producers
+    ///        must call this when no more packets are immediately available
+    ///        since otherwise a partial batch waits for the next packet.
+    /// @throws std::runtime_error if the class is not initialized.
+    void flush();
+    /// @result The number of packets in the current batch waiting to be sent.
+    [[nodiscard]] int getNumberOfPendingPackets() const noexcept;
 
     /// @name Destructors
     /// @{
 
-    /// @brief Destructor.
+    /// @brief Destructor.  This sends any packets in the current batch.
+    ///        Since a destructor cannot throw, a failure is logged and the
+    ///        packets are dropped.  Call \c flush() first to handle errors.
     ~Publisher();
     /// @}
 
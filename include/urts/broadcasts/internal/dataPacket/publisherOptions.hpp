@@ -5,6 +5,7 @@
 #include <chrono>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/messaging/xPublisherXSubscriber/publisherOptions.hpp>
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 namespace URTS::Broadcasts::Internal::DataPacket
 {
 /// @class PublisherOptions "publisherOptions.hpp" "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
@@ -79,6 +80,42 @@ public:
     [[nodiscard]] std::chrono::milliseconds getTimeOut() const noexcept;
     /// @}
 
+    /// @name Batching
+    /// @{
+
+    /// @brief Enables batching whereby up to this many packets are sent as
+    ///        a single \c DataPacketBatch message.
+    /// @param[in] maximumBatchSize  The maximum number of packets in a batch.
+    ///                              1 disables batching.
+    /// @throws std::invalid_argument if maximumBatchSize is not positive.
+    void setMaximumBatchSize(int maximumBatchSize);
+    /// @result The maximum number of packets in a batch.  The default is 1
+    ///         which indicates every packet is sent individually.
+    [[nodiscard]] int getMaximumBatchSize() const noexcept;
+    /// @brief When batching, a batch is sent by the next send once its
+    ///        oldest packet has waited this long.  This bounds the latency
+    ///        added by batching while packets keep arriving.  When packets
+    ///        stop, the producer must call Publisher::flush().
+    /// @param[in] maximumBatchAge  The maximum batch age.
+    /// @throws std::invalid_argument if maximumBatchAge is negative.
+    void setMaximumBatchAge(const std::chrono::milliseconds &maximumBatchAge);
+    /// @result The maximum batch age.  The default is 100 milliseconds.
+    [[nodiscard]] std::chrono::milliseconds getMaximumBatchAge() const noexcept;
+    /// @}
+
+    /// @name Compression
+    /// @{
+
+    /// @brief Sets the encoding of the samples of every packet sent by the
+    ///        publisher.  IntegerDelta losslessly compresses the integer
+    ///        valued samples produced by digitizers and is typically a
+    ///        fraction of the size of Float64.
+    /// @param[in] encoding  The sample encoding.
+    void setSampleEncoding(DataPacket::Encoding encoding) noexcept;
+    /// @result The sample encoding.  By default this is Float64.
+    [[nodiscard]] DataPacket::Encoding getSampleEncoding() const noexcept;
+    /// @}
+
     /// @name ZeroMQ Authentication Protocol Options
     /// @{
 
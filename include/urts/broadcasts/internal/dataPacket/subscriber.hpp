@@ -1,6 +1,8 @@
 #ifndef URTS_BROADCASTS_INTERNAL_DATA_PACKET_SUBSCRIBER_HPP
 #define URTS_BROADCASTS_INTERNAL_DATA_PACKET_SUBSCRIBER_HPP
 #include <memory>
+#include <vector>
+#include <chrono>
 #include <umps/logging/log.hpp>
 #include <umps/messaging/context.hpp>
 namespace URTS::Broadcasts::Internal::DataPacket
@@ -62,7 +64,50 @@ public:
     /// @brief Receives a data packet message.
     /// @throws std::invalid_argument if the message cannot be serialized.
     /// @throws std::runtime_error if \c isIinitialized() is false.
+    /// @note When the publisher sends batches the remaining packets of a
+    ///       received batch are returned by subsequent calls.
     [[nodiscard]] std::unique_ptr<DataPacket> receive() const;
+    /// @brief Receives a message and returns all of its data packets.  This
+    ///        drains an entire \c DataPacketBatch at once.
+    /// @result The received packets.  This is empty if the receive timed out.
+    /// @throws std::invalid_argument if the message cannot be serialized.
+    /// @throws std::runtime_error if \c isIinitialized() is false.
+    [[nodiscard]] std::vector<DataPacket> receivePackets() const;
+    /// @brief Receives a message and returns all of its data packets.
+    /// @param[out] packets  On exit, this holds the received packets.  This
+    ///                      is empty if the receive timed out.  The vector's
+    ///                      existing storage is reused.
+    /// @throws std::invalid_argument if packets is NULL or the message
+    ///         cannot be serialized.
+    /// @throws std::runtime_error if \c isIinitialized() is false.
+    void receivePackets(std::vector<DataPacket> *packets) const;
+    /// @brief Receives all the data packets that are available, up to a
+    ///        limit, in one call.  This lets a consumer hand a burst of
+    ///        packets to, e.g., a queue with a single lock and wakeup.
+    /// @param[out] packets     On exit, this holds the received packets.
+    ///                         The vector's existing storage is reused.
+    /// @param[in] maxPackets   The maximum number of packets to receive.
+    /// @param[in] timeOut      Receiving stops once this much time has
+    ///                         elapsed.  Additionally, receiving stops when
+    ///                         the subscriber's time out passes without a
+    ///                         message so this returns promptly when the
+    ///                         broadcast is idle.
+    /// @result The number of received packets.  This is 0 if the receive
+    ///         timed out.
+    /// @throws std::invalid_argument if packets is NULL, maxPackets is not
+    ///         positive.
+    /// @throws std::runtime_error if \c isIinitialized() is false.
+    /// @note A message that cannot be deserialized is logged and skipped
+    ///       so the other messages in the batch are still returned.
+    /// @note Packets of a batch beyond maxPackets are returned by
+    ///       subsequent calls.
+    int receiveBatch(std::vector<DataPacket> *packets,
+                     int maxPackets,
+                     const std::chrono::milliseconds &timeOut) const;
+    /// @result Up to maxPackets available data packets.
+    /// @sa receiveBatch()
+    [[nodiscard]] std::vector<DataPacket> receiveBatch(
+        int maxPackets, const std::chrono::milliseconds &timeOut) const;
 
     /// @brief Destructor. 
     ~Subscriber();
@@ -155,6 +155,13 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Serializes the origin into the given buffer.  This writes the
+    ///        same message as \c toMessage() but reuses the buffer's
+    ///        storage so repeated serialization need not allocate.
+    /// @param[out] buffer  On exit, this holds the message.
+    /// @throws std::invalid_argument if buffer is NULL.
+    /// @throws std::runtime_error if the required information is not set.
+    void serializeInto(std::string *buffer) const;
     /// @brief Creates the class from a message.
     /// @param[in] message  The contents of the message.
     /// @throws std::runtime_error if the message is invalid.
@@ -13,6 +13,17 @@ namespace URTS::Broadcasts::Internal::ProbabilityPacket
 /// @ingroup Modules_Broadcasts_Internal_ProbabilityPacket
 class ProbabilityPacket : public UMPS::MessageFormats::IMessage
 {
+public:
+    /// @brief Defines how the probabilities are encoded in the message.
+    enum class Encoding
+    {
+        Float64 = 0, /*!< 8 byte doubles.  This is the version 1.0.0 message
+                          and is lossless. */
+        Float32 = 1, /*!< 4 byte floats.  This is a version 2.0.0 message. */
+        UInt16 = 2   /*!< 2 byte fixed-point numbers with a resolution of
+                          1/65535.  Probabilities are clamped to [0,1].
+                          This is a version 2.0.0 message. */
+    };
 public:
     /// @name Constructors
     /// @{
@@ -168,6 +179,17 @@ public:
     [[nodiscard]] const std::vector<double> &getDataReference() const noexcept;
     /// @result The number of data samples in the packet.
     [[nodiscard]] int getNumberOfSamples() const noexcept;
+
+    /// @brief Sets the encoding of the probabilities in the message.  The
+    ///        compact encodings reduce the bandwidth and decoding cost for
+    ///        subscribers.  Regardless of the encoding, the data is read
+    ///        from the packet as doubles.
+    /// @param[in] encoding  The encoding.
+    void setEncoding(Encoding encoding) noexcept;
+    /// @result The encoding of the probabilities in the message.  By default
+    ///         this is Float64.  After \c fromMessage() this is the
+    ///         encoding of the received message.
+    [[nodiscard]] Encoding getEncoding() const noexcept;
     /// @}
 
     /// @name Message Abstract Base Class Properties
@@ -183,6 +205,13 @@ public:
     /// @note Though the container is a string the message need not be
     ///       human readable.
     [[nodiscard]] std::string toMessage() const final;
+    /// @brief Serializes the packet into the given buffer.  This writes the
+    ///        same message as \c toMessage() but reuses the buffer's
+    ///        storage so repeated serialization need not allocate.
+    /// @param[out] buffer  On exit, this holds the message.
+    /// @throws std::invalid_argument if buffer is NULL.
+    /// @throws std::runtime_error if the required information is not set.
+    void serializeInto(std::string *buffer) const;
     /// @brief Creates the class from a message.
     void fromMessage(const std::string &message) final;
     /// @brief Creates the class from a message.
@@ -194,7 +223,8 @@ public:
     void fromMessage(const char *data, size_t length) final;
     /// @result The message type - e.g., "ProbabilityPacket".
     [[nodiscard]] std::string getMessageType() const noexcept final;
-    /// @result The message version.
+    /// @result The message version.  This is 1.0.0 for the Float64 encoding
+    ///         and 2.0.0 for the compact encodings.
     [[nodiscard]] std::string getMessageVersion() const noexcept final;
     /// @}
 
@@ -1,6 +1,8 @@
 #ifndef URTS_BROADCASTS_INTERNAL_PROBABILITY_PACKET_SUBSCRIBER_HPP
 #define URTS_BROADCASTS_INTERNAL_PROBABILITY_PACKET_SUBSCRIBER_HPP
 #include <memory>
+#include <vector>
+#include <chrono>
 #include <umps/logging/log.hpp>
 #include <umps/messaging/context.hpp>
 namespace URTS::Broadcasts::Internal::ProbabilityPacket
@@ -63,6 +65,25 @@ public:
     /// @throws std::invalid_argument if the message cannot be serialized.
     /// @throws std::runtime_error if \c isIinitialized() is false.
     [[nodiscard]] std::unique_ptr<ProbabilityPacket> receive() const;
+    /// @brief Receives all the available probability packets, up to a
+    ///        limit, in one call.  This lets a consumer handle a burst of
+    ///        messages with, e.g., a single lock and wakeup of a queue.
+    /// @param[out] packets  On exit, this holds the received packets.  The
+    ///                      vector's existing storage is reused.
+    /// @param[in] maxMessages  The maximum number of messages to receive.
+    /// @param[in] timeOut      Receiving stops once this much time has
+    ///                         elapsed or when the subscriber's time out
+    ///                         passes without a message.
+    /// @result The number of received messages.  This is 0 if the receive
+    ///         timed out.
+    /// @throws std::invalid_argument if packets is NULL, maxMessages is not
+    ///         positive.
+    /// @throws std::runtime_error if \c isIinitialized() is false.
+    /// @note A message that cannot be deserialized is logged and skipped
+    ///       so the other messages in the batch are still returned.
+    int receiveBatch(std::vector<ProbabilityPacket> *packets,
+                     int maxMessages,
+                     const std::chrono::milliseconds &timeOut) const;
 
     /// @brief Destructor. 
     ~Subscriber();
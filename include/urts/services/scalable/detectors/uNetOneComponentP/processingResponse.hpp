@@ -2,6 +2,7 @@
 #define URTS_SERVICES_SCALABLE_DETECTORS_UNET_ONE_COMPONENT_P_PROCESSING_RESPONSE_HPP
 #include <memory>
 #include <vector>
+#include <span>
 #include <umps/messageFormats/message.hpp>
 namespace URTS::Services::Scalable::Detectors::UNetOneComponentP
 {
@@ -54,14 +55,33 @@ public:
     ///                                   On exit, probabilitySignal's behavior
     ///                                   is undefined.
     void setProbabilitySignal(std::vector<double> &&probabilitySignal);
+    /// @brief Sets the posterior probability signal without copying it.
+    /// @param[in] probabilitySignal  The probability of each sample
+    ///                               corresponding to a phase arrival.  This
+    ///                               is an array whose dimension is
+    ///                               [nSamples].  The class shares ownership
+    ///                               of, and does not modify, the signal.
+    /// @param[in] nSamples           The number of samples in the signal.
+    /// @throws std::invalid_argument if probabilitySignal is NULL or nSamples
+    ///         is not positive.
+    void setProbabilitySignal(std::shared_ptr<const double> probabilitySignal,
+                              int nSamples);
     /// @result The probability signal.
     /// @throws std::runtime_error if \c haveProbabilitySignal() is false.
     [[nodiscard]] std::vector<double> getProbabilitySignal() const;
     /// @result A reference to the probability signal.
     /// @throws std::runtime_error if \c haveProbabilitySignal() is false.
-    /// @note This exists for performance reasons.  It is recommended to use
-    ///       \c getProbabilitySignal().
+    /// @note When the signal is a view, e.g., into a received message, the
+    ///       first call copies it into a vector that copies of this class
+    ///       share.  Use \c getProbabilitySignalView() to read the signal
+    ///       without a copy.
     [[nodiscard]] const std::vector<double> &getProbabilitySignalReference() const;
+    /// @result A view of the probability signal.  When the class was
+    ///         created from a message this typically points into the
+    ///         message so no samples are copied.  The view is valid until
+    ///         the probability signal is changed or the class is destroyed.
+    /// @throws std::runtime_error if \c haveProbabilitySignal() is false.
+    [[nodiscard]] std::span<const double> getProbabilitySignalView() const;
     /// @result True indicates the signals were set.
     [[nodiscard]] bool haveProbabilitySignal() const noexcept;
     /// @}
@@ -122,7 +142,17 @@ public:
     /// @param[in] length  The length of data.
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argument if data is NULL or length is 0. 
+    /// @note The message is copied once and, where possible, the
+    ///       probability signal is a view into that copy.
     void fromMessage(const char *data, size_t length) final;
+    /// @brief Creates the class from a message and takes ownership of the
+    ///        message.  Where possible, the probability signal is a view into
+    ///        the message so no samples are copied.
+    /// @param[in,out] message  The message.  On exit, message's behavior is
+    ///                         undefined.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(std::string &&message);
     /// @result Uniquely defines this message type.
     [[nodiscard]] std::string getMessageType() const noexcept final;
     /// @result The message version.
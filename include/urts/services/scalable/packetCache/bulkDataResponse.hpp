@@ -92,6 +92,23 @@ public:
     void setIdentifier(uint64_t identifier) noexcept;
     /// @result The request identifier.
     [[nodiscard]] uint64_t getIdentifier() const noexcept;
+
+    /// @brief Enables or disables lossless compression of the integer valued
+    ///        samples of every data response in the message.
+    /// @param[in] compress  True indicates the samples are to be compressed.
+    /// @sa DataResponse::setSampleCompression()
+    void setSampleCompression(bool compress) noexcept;
+    /// @result True indicates the samples of every data response are
+    ///         compressed in the message.  By default this is false.
+    [[nodiscard]] bool useSampleCompression() const noexcept;
+    /// @brief Enables or disables the compact layout of every data response
+    ///        in the message.
+    /// @param[in] compact  True indicates the compact layout is to be used.
+    /// @sa DataResponse::setCompactLayout()
+    void setCompactLayout(bool compact) noexcept;
+    /// @result True indicates every data response is written in the
+    ///         compact layout.  By default this is false.
+    [[nodiscard]] bool useCompactLayout() const noexcept;
     /// @}
 
     /// @name Message Properties
@@ -114,7 +131,18 @@ public:
     /// @param[in] length  The length of data.
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argument if data is NULL or length is 0. 
+    /// @note The message is copied once and, where possible, the packet
+    ///       views point into that copy rather than each sample being
+    ///       decoded.
     void fromMessage(const char *data, size_t length) final;
+    /// @brief Creates the class from a message and takes ownership of the
+    ///        message.  Where possible, the packet views point into, and
+    ///        keep alive, the message so no samples are copied.
+    /// @param[in,out] message  The message.  On exit, message's behavior is
+    ///                         undefined.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(std::string &&message);
     /// @result A message type indicating this is a pick message.
     [[nodiscard]] std::string getMessageType() const noexcept final;
     /// @result The message version.
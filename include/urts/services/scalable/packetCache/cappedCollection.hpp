@@ -1,9 +1,15 @@
 #ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_CAPPED_COLLECTION_HPP
 #define URTS_SERVICES_SCALABLE_PACKET_CACHE_CAPPED_COLLECTION_HPP
 #include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <tuple>
 #include <set>
 #include <chrono>
 #include <unordered_set>
+#include <functional>
 namespace UMPS::Logging
 {
  class ILog;
@@ -13,6 +19,11 @@ namespace URTS::Broadcasts::Internal::DataPacket
  class DataPacket;
 }
 namespace URTS::Services::Scalable::PacketCache
+{
+ class PacketView;
+ struct PacketSummary;
+}
+namespace URTS::Services::Scalable::PacketCache
 {
 /// @class CappedCollection "cappedCollection.hpp" "urts/services/scalable/packetCache/cappedCollection.hpp"
 /// @brief This is a thread-safe fixed-size collection of data packets for a
@@ -39,10 +50,17 @@ public:
     ///                              this collection.
     /// @param[in] channelBlackList  This is a list of wildcarded channels that
     ///                              will not be added to the packet cache. 
+    /// @param[in] compress          If true then the samples are losslessly
+    ///                              compressed in memory and decoded when
+    ///                              queried.  This is useful for retaining
+    ///                              more data in the same memory.
     void initialize(int maxPackets,
-                    const std::set<std::string> &channelBlackList = std::set<std::string> {});
+                    const std::set<std::string> &channelBlackList = std::set<std::string> {},
+                    bool compress = false);
     /// @result True indicates the class is initialized.
     [[nodiscard]] bool isInitialized() const noexcept;
+    /// @result True indicates the samples are stored compressed.
+    [[nodiscard]] bool isCompressed() const noexcept;
     /// @}
 
     /// @name Adding Packets 
@@ -66,6 +84,19 @@ public:
     /// @note If the underlying buffer is full and the data is expired this
     ///       packet will not be added.
     void addPacket(URTS::Broadcasts::Internal::DataPacket::DataPacket &&packet);
+    /// @brief Sets a function that is called after a packet is stored in
+    ///        the collection.  This includes new and backfilled packets.
+    /// @param[in] callback  The function to call.  Its arguments are the
+    ///                      stored packet, the sensor identifier, and the
+    ///                      packet's sequence number.  Sequence numbers for a
+    ///                      sensor increase by one for every stored packet so
+    ///                      a consumer can detect missed packets.
+    /// @note The callback is invoked on the thread adding the packet.  This
+    ///       should be set before packets are added.
+    void setInsertionCallback(
+        const std::function<void (const URTS::Broadcasts::Internal::DataPacket::DataPacket &packet,
+                                  uint64_t sensorIdentifier,
+                                  uint64_t sequenceNumber)> &callback);
     /// @result True indicates that the sensor exists in the collection.
     [[nodiscard]] bool haveSensor(const std::string &network,
                                   const std::string &station,
@@ -75,6 +106,23 @@ public:
     ///                  NETWORK.STATION.CHANNEL.LOCATION_CODE format.
     /// @result True indicates that the sensor exists in the collection.
     [[nodiscard]] bool haveSensor(const std::string &name) const noexcept;
+    /// @param[in] identifier  The sensor identifier.
+    /// @result True indicates that the sensor exists in the collection.
+    [[nodiscard]] bool haveSensor(uint64_t identifier) const noexcept;
+    /// @brief Each sensor is interned to an integer identifier the first
+    ///        time it is seen.  Requests can use this identifier to bypass
+    ///        looking up the sensor by name.
+    /// @param[in] name  The name of the station in 
+    ///                  NETWORK.STATION.CHANNEL.LOCATION_CODE format.
+    /// @result The sensor's identifier.  This is only valid for this
+    ///         initialization of the collection.
+    /// @throws std::invalid_argument if \c haveSensor(name) is false.
+    [[nodiscard]] uint64_t getSensorIdentifier(const std::string &name) const;
+    /// @param[in] identifier  The sensor identifier.
+    /// @result The name of the sensor in
+    ///         NETWORK.STATION.CHANNEL.LOCATION_CODE format.
+    /// @throws std::invalid_argument if \c haveSensor(identifier) is false.
+    [[nodiscard]] std::string getSensorName(uint64_t identifier) const;
     /// @result All the sensors currently in the capped collection.
     /// @note The names of each sensor are formatted as:
     ///       NETWORK.STATION.CHANNEL.LOCATION_CODE.
@@ -130,10 +178,130 @@ public:
     /// @throws std::runtime_error if \c isInitialized() is false.
     [[nodiscard]] std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket>
         getPackets(const std::string &name) const;
+    /// @brief Gets shared views of all packets between time t0 and t1.
+    ///        Unlike \c getPackets() this does not copy the samples.
+    /// @param[in] name  The name of the channel.
+    /// @param[in] t0    The UTC start time of the query in microseconds
+    ///                  since the epoch.
+    /// @param[in] t1    The UTC end time of the query in micrsoseconds
+    ///                  since the epoch.
+    /// @result Views of all packets from t0 to t1.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c haveSensor(name) is false.
+    [[nodiscard]] std::vector<PacketView>
+        getPacketViews(const std::string &name,
+                       const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1) const;
+    /// @brief Gets shared views of all packets between time t0 and t1.
+    /// @param[in] identifier  The sensor identifier.
+    /// @param[in] t0          The UTC start time of the query in
+    ///                        microseconds since the epoch.
+    /// @param[in] t1          The UTC end time of the query in microseconds
+    ///                        since the epoch.
+    /// @result Views of all packets from t0 to t1.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c haveSensor(identifier) is false.
+    [[nodiscard]] std::vector<PacketView>
+        getPacketViews(uint64_t identifier,
+                       const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1) const;
+    /// @brief Gets shared views of the packets between time t0 and t1 that
+    ///        were added or backfilled since the cursor.
+    /// @param[in] identifier  The sensor identifier.
+    /// @param[in] t0          The UTC start time of the query in
+    ///                        microseconds since the epoch.
+    /// @param[in] t1          The UTC end time of the query in microseconds
+    ///                        since the epoch.
+    /// @param[in] cursor      The cursor from a previous query of this
+    ///                        sensor.  Use 0 to obtain all packets from t0
+    ///                        to t1.
+    /// @result result.first are views of the new packets from t0 to t1.
+    ///         result.second is the cursor to use in the next query.
+    /// @note Like the sensor identifier, cursors are only valid for this
+    ///       initialization of the collection.
+    /// @note No packet is returned twice for a chain of cursors.  Packets
+    ///       outside of [t0, t1] may therefore be skipped by later queries;
+    ///       see \c CircularBuffer::getPacketViews().
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c haveSensor(identifier) is false.
+    [[nodiscard]] std::pair<std::vector<PacketView>, uint64_t>
+        getPacketViews(uint64_t identifier,
+                       const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1,
+                       uint64_t cursor) const;
+    /// @brief Gets shared views of the packets between time t0 and t1 that
+    ///        were added or backfilled since the cursor or that were not in
+    ///        the window of the query that returned the cursor.
+    /// @param[in] identifier     The sensor identifier.
+    /// @param[in] t0             The UTC start time of the query in
+    ///                           microseconds since the epoch.
+    /// @param[in] t1             The UTC end time of the query in
+    ///                           microseconds since the epoch.
+    /// @param[in] cursor         The cursor from a previous query of this
+    ///                           sensor.
+    /// @param[in] cursorEndTime  The cursor end time from that query.
+    /// @result The views of the new packets from t0 to t1, the cursor, and
+    ///         the cursor end time to use in the next query.
+    /// @note Every packet is returned exactly once for a chain of cursors
+    ///       provided the start and end times of the windows do not
+    ///       decrease; see \c CircularBuffer::getPacketViews().
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c haveSensor(identifier) is false.
+    [[nodiscard]] std::tuple<std::vector<PacketView>, uint64_t,
+                             std::chrono::microseconds>
+        getPacketViews(uint64_t identifier,
+                       const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1,
+                       uint64_t cursor,
+                       const std::chrono::microseconds &cursorEndTime) const;
+    /// @brief Describes the packets between time t0 and t1 without decoding
+    ///        or sharing their samples.
+    /// @param[in] identifier  The sensor identifier.
+    /// @param[in] t0          The UTC start time of the query in
+    ///                        microseconds since the epoch.
+    /// @param[in] t1          The UTC end time of the query in microseconds
+    ///                        since the epoch.
+    /// @result Summaries of the packets that
+    ///         \c getPacketViews(identifier, t0, t1) would return.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c haveSensor(identifier) is false.
+    [[nodiscard]] std::vector<PacketSummary>
+        getPacketSummaries(uint64_t identifier,
+                           const std::chrono::microseconds &t0,
+                           const std::chrono::microseconds &t1) const;
     /// @}
 
     /// @result The total number of packets in all of the circular buffers.
     [[nodiscard]] int getTotalNumberOfPackets() const noexcept;
+    /// @result The total number of bytes used to store the samples in all of
+    ///         the circular buffers.
+    [[nodiscard]] size_t getSampleMemoryUsage() const noexcept;
+
+    /// @name Snapshots
+    /// @{
+
+    /// @brief Writes every buffered packet to a binary snapshot file so that
+    ///        a restarted service can quickly refill its buffers.
+    /// @param[in] fileName  The snapshot file.  The snapshot is written to
+    ///                      fileName.tmp and then renamed so that an
+    ///                      interrupted write does not clobber the previous
+    ///                      snapshot.
+    /// @result The number of packets written.
+    /// @throws std::runtime_error if \c isInitialized() is false or the file
+    ///         cannot be written.
+    /// @note Packets can be added while the snapshot is written.  Each buffer
+    ///       is only briefly locked while views of its packets are taken.
+    int writeSnapshot(const std::string &fileName) const;
+    /// @brief Adds the packets in a snapshot file to the collection.
+    /// @param[in] fileName  The snapshot file written by \c writeSnapshot().
+    /// @result The number of packets read from the snapshot.
+    /// @throws std::invalid_argument if the file does not exist.
+    /// @throws std::runtime_error if \c isInitialized() is false or the file
+    ///         is not a valid snapshot.
+    /// @note The snapshot is memory mapped so the samples are copied directly
+    ///       from the file into the buffers.
+    int loadSnapshot(const std::string &fileName);
+    /// @}
 
     /// @name Destructors
     /// @{
@@ -3,6 +3,9 @@
 #include <memory>
 #include <chrono>
 #include <vector>
+#include <utility>
+#include <tuple>
+#include <cstdint>
 namespace URTS::Broadcasts::Internal::DataPacket
 {
  class DataPacket;
@@ -10,12 +13,17 @@ namespace URTS::Broadcasts::Internal::DataPacket
 namespace URTS::Services::Scalable::PacketCache
 {
  template<class T> class CircularBufferImpl;
+ class PacketView;
+ struct PacketSummary;
 }
 namespace URTS::Services::Scalable::PacketCache
 {
 /// @class CircularBuffer "circularBuffer.hpp" "urts/services/scalable//packetCache/circularBuffer.hpp"
 /// @brief This is a thread-safe circular buffer for storing data packets for
 ///        a given station's channel.
+/// @note Internally, the samples are stored in a single contiguous ring and
+///       the packet boundaries are tracked in a small side index.  Packets
+///       are therefore only materialized when they are queried.
 /// @copyright Ben Baker (University of Utah) distributed under the MIT license.
 class CircularBuffer
 {
@@ -60,6 +68,10 @@ public:
     /// @param[in] locationCode  The location code - e.g., 01.
     /// @param[in] maxPackets    The maximum number of packets in the circular
     ///                          buffer.
+    /// @param[in] compress      If true then the samples are losslessly
+    ///                          compressed.  This lowers the memory usage
+    ///                          at the expense of decoding the samples on
+    ///                          every query.
     /// @throws std::invalid_argument if maxPackets is not positive or either
     ///         the network, station, channel, or locationCode is emtpy
     ///         or blank.
@@ -67,9 +79,12 @@ public:
                     const std::string &station,
                     const std::string &channel,
                     const std::string &locationCode,
-                    int maxPackets);
+                    int maxPackets,
+                    bool compress = false);
     /// @result True indicates that the class is initialized.
     [[nodiscard]] bool isInitialized() const noexcept;
+    /// @result True indicates the samples are stored compressed.
+    [[nodiscard]] bool isCompressed() const noexcept;
     /// @result The network code.
     /// @throws std::runtime_error if \c isInitialized() is false.
     [[nodiscard]] std::string getNetwork() const;
@@ -86,6 +101,8 @@ public:
     [[nodiscard]] int getMaximumNumberOfPackets() const;
     /// @result The number of packets the cicrular buffer is currently holding.
     [[nodiscard]] int getNumberOfPackets() const noexcept;
+    /// @result The number of bytes used to store the samples.
+    [[nodiscard]] size_t getSampleMemoryUsage() const noexcept;
     /// @}
 
     /// @name Adding Packets
@@ -98,7 +115,10 @@ public:
     ///       during initialization.  Additionally, the data packet must have
     ///       a positive sampling rate and data must actually exist on the
     ///       packet.
-    void addPacket(const URTS::Broadcasts::Internal::DataPacket::DataPacket &packet);
+    /// @result The packet's sequence number.  This increases by one for every
+    ///         packet stored in this buffer.  If the packet expired and was
+    ///         not added then this is 0.
+    uint64_t addPacket(const URTS::Broadcasts::Internal::DataPacket::DataPacket &packet);
     /// @brief Attempts to add the given packet to the buffer.
     /// @param[in,out] packet   The packet to add to the buffer.  On exit,
     ///                         packet's behavior is undefined.
@@ -107,7 +127,8 @@ public:
     ///       during initialization.  Additionally, the data packet must have
     ///       a positive sampling rate and data must actually exist on the
     ///       packet.
-    void addPacket(URTS::Broadcasts::Internal::DataPacket::DataPacket &&packet);
+    /// @result The packet's sequence number or 0 if the packet was not added.
+    uint64_t addPacket(URTS::Broadcasts::Internal::DataPacket::DataPacket &&packet);
     /// @}
 
     /// @name Querying Packets
@@ -150,6 +171,90 @@ public:
     /// @result All the datapackets in the buffer.
     /// @throws std::runtime_error if \c isInitialized() is false.
     [[nodiscard]] std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> getPackets() const;
+    /// @brief Gets shared views of all packets beginning at time t0.
+    /// @param[in] t0  The UTC start time of the query in microseconds since
+    ///                the epoch.
+    /// @result Views of all packets from time t0 to the most recent packet.
+    ///         The samples are not copied and remain valid for the lifetime
+    ///         of the views.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::vector<PacketView>
+        getPacketViews(const std::chrono::microseconds &t0) const;
+    /// @brief Gets shared views of all packets between time t0 and t1.
+    /// @param[in] t0  The UTC start time of the query in microseconds
+    ///                since the epoch.
+    /// @param[in] t1  The UTC end time of the query in micrsoseconds
+    ///                since the epoch.
+    /// @result Views of all packets from t0 to t1.  The samples are not copied
+    ///         and remain valid for the lifetime of the views.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::vector<PacketView>
+        getPacketViews(const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1) const;
+    /// @brief Gets shared views of the packets between time t0 and t1 that
+    ///        were added or backfilled after the given cursor.
+    /// @param[in] t0      The UTC start time of the query in microseconds
+    ///                    since the epoch.
+    /// @param[in] t1      The UTC end time of the query in micrsoseconds
+    ///                    since the epoch.
+    /// @param[in] cursor  The cursor returned by a previous query.  Use 0
+    ///                    to obtain all packets from t0 to t1.
+    /// @result result.first are views of the new packets from t0 to t1.
+    ///         result.second is the cursor to use in the next query.  This
+    ///         is the highest sequence number delivered, or the input
+    ///         cursor if nothing was delivered, so no packet is returned
+    ///         twice.
+    /// @note Packets outside of [t0, t1] are not delivered.  Those stored
+    ///       before the last delivered packet are also skipped by later
+    ///       queries with the returned cursor so a caller whose window moves
+    ///       should use the overload with a cursor end time.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::pair<std::vector<PacketView>, uint64_t>
+        getPacketViews(const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1,
+                       uint64_t cursor) const;
+    /// @brief Gets shared views of the packets between time t0 and t1 that
+    ///        were added or backfilled after the given cursor or that were
+    ///        not in the window of the query that returned the cursor.
+    /// @param[in] t0             The UTC start time of the query in
+    ///                           microseconds since the epoch.
+    /// @param[in] t1             The UTC end time of the query in
+    ///                           microseconds since the epoch.
+    /// @param[in] cursor         The cursor returned by a previous query.
+    ///                           Use 0 to obtain all packets from t0 to t1.
+    /// @param[in] cursorEndTime  The cursor end time returned by the
+    ///                           previous query.  Packets beginning after
+    ///                           this are delivered regardless of the cursor.
+    /// @result std::get<0>(result) are views of the new packets from t0 to
+    ///         t1.  std::get<1>(result) is the cursor and std::get<2>(result)
+    ///         is the cursor end time to use in the next query.
+    /// @note For a chain of queries to return every packet exactly once the
+    ///       start and end times of the windows must not decrease.  This is
+    ///       the case for a window that trails the current time and it also
+    ///       allows the window to widen.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::tuple<std::vector<PacketView>, uint64_t,
+                             std::chrono::microseconds>
+        getPacketViews(const std::chrono::microseconds &t0,
+                       const std::chrono::microseconds &t1,
+                       uint64_t cursor,
+                       const std::chrono::microseconds &cursorEndTime) const;
+    /// @brief Describes the packets between time t0 and t1 without decoding
+    ///        or sharing their samples.
+    /// @param[in] t0  The UTC start time of the query in microseconds
+    ///                since the epoch.
+    /// @param[in] t1  The UTC end time of the query in micrsoseconds
+    ///                since the epoch.
+    /// @result Summaries of the packets that \c getPacketViews(t0, t1) would
+    ///         return.
+    /// @throws std::invalid_argument if t0 >= t1.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::vector<PacketSummary>
+        getPacketSummaries(const std::chrono::microseconds &t0,
+                           const std::chrono::microseconds &t1) const;
     /// @}
 
     /// @name Cleaning
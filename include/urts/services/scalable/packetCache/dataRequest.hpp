@@ -1,6 +1,7 @@
 #ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_DATA_REQUEST_HPP
 #define URTS_SERVICES_SCALABLE_PACKET_CACHE_DATA_REQUEST_HPP
 #include <memory>
+#include <chrono>
 #include <umps/messageFormats/message.hpp>
 namespace URTS::Services::Scalable::PacketCache
 {
@@ -121,6 +122,55 @@ public:
     void setIdentifier(uint64_t identifier) noexcept;
     /// @result Trhe message identifier.
     [[nodiscard]] uint64_t getIdentifier() const noexcept;
+
+    /// @brief Sets the packet cache's identifier for this sensor.  This is
+    ///        returned in a previous \c DataResponse and allows the packet
+    ///        cache to skip looking up the sensor by name.
+    /// @param[in] identifier  The sensor identifier.
+    /// @note If the packet cache does not recognize this identifier, e.g.,
+    ///       the cache was restarted, then the sensor will be looked up by
+    ///       name.
+    void setSensorIdentifier(uint64_t identifier) noexcept;
+    /// @result The sensor identifier.
+    /// @throws std::runtime_error if \c haveSensorIdentifier() is false.
+    [[nodiscard]] uint64_t getSensorIdentifier() const;
+    /// @result True indicates the sensor identifier was set.
+    [[nodiscard]] bool haveSensorIdentifier() const noexcept;
+
+    /// @brief Sets the cursor returned in a previous \c DataResponse for
+    ///        this sensor.  The packet cache will then only return the
+    ///        packets in the query window that were added or backfilled
+    ///        since that response.  This also unsets the cursor end time.
+    /// @param[in] cursor  The cursor.
+    /// @note The cursor is only honored when the sensor identifier is also
+    ///       set and recognized by the packet cache.  Otherwise, all the
+    ///       packets in the query window are returned.
+    /// @note Without an end time, packets that were outside of the previous
+    ///       window but stored before its newest packet are not returned.
+    ///       Use the overload below when the query window moves.
+    void setCursor(uint64_t cursor) noexcept;
+    /// @brief Sets the cursor and cursor end time returned in a previous
+    ///        \c DataResponse for this sensor.  The packet cache will then
+    ///        return the packets in the query window that were added or
+    ///        backfilled since that response as well as those beginning
+    ///        after that response's query window.
+    /// @param[in] cursor   The cursor.
+    /// @param[in] endTime  The cursor end time in UTC microseconds since the
+    ///                     epoch.
+    /// @note For no packet to be skipped or returned twice the start and end
+    ///       times of successive query windows must not decrease.
+    void setCursor(uint64_t cursor,
+                   const std::chrono::microseconds &endTime) noexcept;
+    /// @result The cursor.
+    /// @throws std::runtime_error if \c haveCursor() is false.
+    [[nodiscard]] uint64_t getCursor() const;
+    /// @result True indicates the cursor was set.
+    [[nodiscard]] bool haveCursor() const noexcept;
+    /// @result The cursor end time in UTC microseconds since the epoch.
+    /// @throws std::runtime_error if \c haveCursorEndTime() is false.
+    [[nodiscard]] std::chrono::microseconds getCursorEndTime() const;
+    /// @result True indicates the cursor end time was set.
+    [[nodiscard]] bool haveCursorEndTime() const noexcept;
     /// @}
 
     /// @name Message Properties
@@ -1,13 +1,19 @@
 #ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_HPP
 #define URTS_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_HPP
 #include <memory>
+#include <string>
 #include <vector>
+#include <chrono>
 #include <umps/messageFormats/message.hpp>
 namespace URTS::Broadcasts::Internal::DataPacket
 {
  class DataPacket;
 }
 namespace URTS::Services::Scalable::PacketCache
+{
+ class PacketView;
+}
+namespace URTS::Services::Scalable::PacketCache
 {
 /// @name DataResponse "dataResponse.hpp" "urts/services/scalable/packetCache/dataResponse.hpp"
 /// @brief This represents the packet data for a sensor.
@@ -71,16 +77,61 @@ public:
     /// @throws std::invalid_argument if any packet's network, station, channel,
     ///         location code, or sampling rate is not set.
     void setPackets(std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> &&packets);
+    /// @brief Sets the data packets as shared views of the samples.  This
+    ///        is how the packet cache fills a response without copying.
+    /// @param[in] network       The network code - e.g., UU.
+    /// @param[in] station       The station name - e.g., FSU.
+    /// @param[in] channel       The channel name - e.g., EHZ.
+    /// @param[in] locationCode  The location code - e.g., 01.
+    /// @param[in,out] packets   The packet views corresponding to the request.
+    ///                          On exit, packets's behavior is undefined.
+    /// @throws std::invalid_argument if there are packets and the network,
+    ///         station, channel, or location code is empty.
+    void setPacketViews(const std::string &network,
+                        const std::string &station,
+                        const std::string &channel,
+                        const std::string &locationCode,
+                        std::vector<PacketView> &&packets);
+    /// @brief Merges a subsequent response for this sensor into this
+    ///        response.  This is how a requester that uses cursors
+    ///        reassembles its query window from incremental responses.
+    /// @param[in] response   The newer response.  Its packets replace the
+    ///                       packets in this response with the same start
+    ///                       time.  Its identifiers, cursor, and return code
+    ///                       are also adopted.
+    /// @param[in] startTime  Packets ending before this UTC time in
+    ///                       microseconds since the epoch are discarded.
+    /// @throws std::invalid_argument if both responses have packets but
+    ///         the packets are for different sensors.
+    void merge(const DataResponse &response,
+               const std::chrono::microseconds &startTime);
     /// @result The number of packets.
     [[nodiscard]] int getNumberOfPackets() const noexcept;
     /// @result A pointer to the data packets.  This is an array with dimensions
     ///         [\c getNumberOfPackets()].
-    [[nodiscard]] const URTS::Broadcasts::Internal::DataPacket::DataPacket *getPacketsPointer() const noexcept;
+    /// @note If the packets were set as views then the data packets are
+    ///       created on the first call.
+    [[nodiscard]] const URTS::Broadcasts::Internal::DataPacket::DataPacket *getPacketsPointer() const;
     /// @result The data packets corresponding to the data request. 
     /// @note If result.empty() then a problem was likely detected and you
     ///       should check the return code.
-    [[nodiscard]] std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> getPackets() const noexcept;
-    [[nodiscard]] const std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> &getPacketsReference() const noexcept;
+    [[nodiscard]] std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> getPackets() const;
+    [[nodiscard]] const std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> &getPacketsReference() const;
+    /// @result Shared views of the packets' samples sorted on start time.
+    ///         These are always available and never copy the samples.
+    [[nodiscard]] const std::vector<PacketView> &getPacketViewsReference() const noexcept;
+    /// @result The network code of the packets.
+    /// @throws std::runtime_error if \c getNumberOfPackets() is 0.
+    [[nodiscard]] std::string getNetwork() const;
+    /// @result The station name of the packets.
+    /// @throws std::runtime_error if \c getNumberOfPackets() is 0.
+    [[nodiscard]] std::string getStation() const;
+    /// @result The channel name of the packets.
+    /// @throws std::runtime_error if \c getNumberOfPackets() is 0.
+    [[nodiscard]] std::string getChannel() const;
+    /// @result The location code of the packets.
+    /// @throws std::runtime_error if \c getNumberOfPackets() is 0.
+    [[nodiscard]] std::string getLocationCode() const;
     /// @}
 
     /// @name Additional Information
@@ -101,6 +152,69 @@ public:
     void setIdentifier(uint64_t identifier) noexcept;
     /// @result The request identifier.
     [[nodiscard]] uint64_t getIdentifier() const noexcept;
+
+    /// @brief Sets the packet cache's identifier for this sensor.
+    /// @param[in] identifier  The sensor identifier.
+    /// @note Subsequent requests can set this on the \c DataRequest so the
+    ///       packet cache can skip looking up the sensor by name.
+    void setSensorIdentifier(uint64_t identifier) noexcept;
+    /// @result The sensor identifier.
+    /// @throws std::runtime_error if \c haveSensorIdentifier() is false.
+    [[nodiscard]] uint64_t getSensorIdentifier() const;
+    /// @result True indicates the sensor identifier was set.
+    [[nodiscard]] bool haveSensorIdentifier() const noexcept;
+
+    /// @brief Sets the cursor for this sensor.  Subsequent requests can set
+    ///        this on the \c DataRequest so that the packet cache only
+    ///        returns the packets added or backfilled since this response.
+    ///        This also unsets the cursor end time.
+    /// @param[in] cursor  The cursor.
+    void setCursor(uint64_t cursor) noexcept;
+    /// @brief Sets the cursor and the cursor end time for this sensor.
+    ///        Packets beginning after the end time were not considered by
+    ///        this response so subsequent requests will also obtain those,
+    ///        e.g., when the query window moves forward.
+    /// @param[in] cursor   The cursor.
+    /// @param[in] endTime  The cursor end time in UTC microseconds since the
+    ///                     epoch.
+    void setCursor(uint64_t cursor,
+                   const std::chrono::microseconds &endTime) noexcept;
+    /// @result The cursor.
+    /// @throws std::runtime_error if \c haveCursor() is false.
+    [[nodiscard]] uint64_t getCursor() const;
+    /// @result True indicates the cursor was set.
+    [[nodiscard]] bool haveCursor() const noexcept;
+    /// @result The cursor end time in UTC microseconds since the epoch.
+    /// @throws std::runtime_error if \c haveCursorEndTime() is false.
+    [[nodiscard]] std::chrono::microseconds getCursorEndTime() const;
+    /// @result True indicates the cursor end time was set.
+    [[nodiscard]] bool haveCursorEndTime() const noexcept;
+
+    /// @brief Enables or disables lossless compression of the samples in
+    ///        the message.  Integer valued samples, which is what digitizers
+    ///        produce, are written as zig-zag mapped, variable length first
+    ///        differences which typically reduces the message size by a
+    ///        factor of three or more.  Other samples are written as doubles.
+    /// @param[in] compress  True indicates the samples are to be compressed.
+    /// @note Compressed samples must be decoded so the packet views of a
+    ///       received message cannot point directly into the message.
+    void setSampleCompression(bool compress) noexcept;
+    /// @result True indicates the samples are compressed in the message.
+    ///         By default this is false.  After \c fromMessage() this
+    ///         indicates whether the received message was compressed.
+    [[nodiscard]] bool useSampleCompression() const noexcept;
+    /// @brief Enables or disables the compact layout of the message.  When
+    ///        all packets share a sampling rate, the message holds the
+    ///        sampling rate once, arrays of the packets' start times and
+    ///        sample counts, and one block with the samples of all packets.
+    ///        This is smaller and faster to read than a map per packet.
+    ///        Otherwise, the packets are written as usual.
+    /// @param[in] compact  True indicates the compact layout is to be used.
+    void setCompactLayout(bool compact) noexcept;
+    /// @result True indicates the compact layout is used.  By default this
+    ///         is false.  After \c fromMessage() this indicates whether the
+    ///         received message used the compact layout.
+    [[nodiscard]] bool useCompactLayout() const noexcept;
     /// @}
 
     /// @name Message Properties
@@ -123,7 +237,18 @@ public:
     /// @param[in] length  The length of data.
     /// @throws std::runtime_error if the message is invalid.
     /// @throws std::invalid_argument if data is NULL or length is 0. 
+    /// @note The message is copied once and, where possible, the packet
+    ///       views point into that copy rather than each sample being
+    ///       decoded.
     void fromMessage(const char *data, size_t length) final;
+    /// @brief Creates the class from a message and takes ownership of the
+    ///        message.  Where possible, the packet views point into, and
+    ///        keep alive, the message so no samples are copied.
+    /// @param[in,out] message  The message.  On exit, message's behavior is
+    ///                         undefined.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(std::string &&message);
     /// @result A message type indicating this is a pick message.
     [[nodiscard]] std::string getMessageType() const noexcept final;
     /// @result The message version.
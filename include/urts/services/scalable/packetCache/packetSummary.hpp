@@ -0,0 +1,25 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_PACKET_SUMMARY_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_PACKET_SUMMARY_HPP
+#include <chrono>
+#include <cstdint>
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @struct PacketSummary "packetSummary.hpp" "urts/services/scalable/packetCache/packetSummary.hpp"
+/// @brief Describes a stored packet without its samples.  Since this neither
+///        decodes nor holds on to the samples it is a cheap way to learn
+///        whether the packets in a window have changed.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+struct PacketSummary
+{
+    /// The UTC time in microseconds since the epoch of the first sample.
+    std::chrono::microseconds startTime{0};
+    /// The UTC time in microseconds since the epoch of the last sample.
+    std::chrono::microseconds endTime{0};
+    /// The order in which the packet was stored.  A packet that replaces
+    /// another receives a new sequence number.
+    uint64_t sequence{0};
+    /// The number of samples.
+    int nSamples{0};
+};
+}
+#endif
@@ -0,0 +1,57 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_PACKET_VIEW_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_PACKET_VIEW_HPP
+#include <memory>
+#include <chrono>
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @class PacketView "packetView.hpp" "urts/services/scalable/packetCache/packetView.hpp"
+/// @brief This is a read-only, reference-counted view of a packet's samples.
+///        The samples are shared with (and kept alive by) the view so the
+///        packet cache can hand out query results without copying.
+/// @note Unlike most classes this is a small value type and intentionally
+///       does not use a pImpl since views are copied often.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class PacketView
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    PacketView() = default;
+    /// @brief Constructs a view.
+    /// @param[in] startTime     The UTC time in microseconds since the epoch
+    ///                          of the first sample.
+    /// @param[in] samplingRate  The sampling rate in Hz.
+    /// @param[in] nSamples      The number of samples.
+    /// @param[in] data          The shared, immutable samples.  This is an
+    ///                          array whose dimension is [nSamples].
+    /// @throws std::invalid_argument if the sampling rate is not positive,
+    ///         nSamples is negative, or data is NULL and nSamples is positive.
+    PacketView(const std::chrono::microseconds &startTime,
+               double samplingRate,
+               int nSamples,
+               std::shared_ptr<const double> data);
+    /// @}
+
+    /// @result The UTC start time in microseconds since the epoch.
+    [[nodiscard]] std::chrono::microseconds getStartTime() const noexcept;
+    /// @result The UTC time in microseconds since the epoch of the last
+    ///         sample.
+    [[nodiscard]] std::chrono::microseconds getEndTime() const noexcept;
+    /// @result The sampling rate in Hz.
+    [[nodiscard]] double getSamplingRate() const noexcept;
+    /// @result The number of samples.
+    [[nodiscard]] int getNumberOfSamples() const noexcept;
+    /// @result A pointer to the samples.  This is an array whose dimension is
+    ///         [\c getNumberOfSamples()].
+    [[nodiscard]] const double *getDataPointer() const noexcept;
+private:
+    std::shared_ptr<const double> mData{nullptr};
+    std::chrono::microseconds mStartTime{0};
+    std::chrono::microseconds mEndTime{0};
+    double mSamplingRate{0};
+    int mSamples{0};
+};
+}
+#endif
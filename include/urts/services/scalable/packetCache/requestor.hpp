@@ -22,6 +22,8 @@ namespace URTS::Services::Scalable::PacketCache
  class DataResponse;
  class SensorRequest;
  class SensorResponse;
+ class ThreeComponentWaveformRequest;
+ class ThreeComponentWaveformResponse;
 }
 namespace URTS::Services::Scalable::PacketCache
 {
@@ -100,6 +102,14 @@ public:
     ///         bulk request.
     /// @throws std::runtime_error if \c isInitialized() is false.
     [[nodiscard]] std::unique_ptr<BulkDataResponse> request(const BulkDataRequest &request);
+    /// @brief Performs a blocking request for an aligned three-component
+    ///        waveform.  The packet cache interpolates the three channels
+    ///        so the requester does not have to.
+    /// @param[in] request  The three-component waveform request to make to
+    ///                     the server via the router.
+    /// @result The response to the request from the server.
+    /// @throws std::runtime_error if \c isInitialized() is false.
+    [[nodiscard]] std::unique_ptr<ThreeComponentWaveformResponse> request(const ThreeComponentWaveformRequest &request);
     /// @}
 
     /// @name Step 3: Disconnecting
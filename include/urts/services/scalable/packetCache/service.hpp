@@ -62,6 +62,13 @@ public:
     [[nodiscard]] bool isRunning() const noexcept;
     /// @result The total number of packets in the packet cache.
     [[nodiscard]] int getTotalNumberOfPackets() const noexcept;
+    /// @result When response compression is enabled, this is the number of
+    ///         bytes the replied samples occupy as doubles divided by the
+    ///         number of bytes in the data and bulk data replies.  As the
+    ///         replies' headers are included this slightly understates the
+    ///         compression of the samples.  This is 1 if nothing has been
+    ///         replied or compression is disabled.
+    [[nodiscard]] double getResponseCompressionRatio() const noexcept;
     /// @}
 
     /// @name Step 3: Stop
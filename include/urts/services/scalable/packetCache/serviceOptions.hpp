@@ -1,6 +1,7 @@
 #ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_SERVICE_OPTIONS_HPP
 #define URTS_SERVICES_SCALABLE_PACKET_CACHE_SERVICE_OPTIONS_HPP
 #include <memory>
+#include <string>
 #include <chrono>
 namespace UMPS::Authentication
 {
@@ -9,6 +10,7 @@ namespace UMPS::Authentication
 namespace URTS::Broadcasts::Internal::DataPacket
 {
  class SubscriberOptions;
+ class PublisherOptions;
 }
 namespace URTS::Services::Scalable::PacketCache
 {
@@ -76,6 +78,27 @@ public:
     [[nodiscard]] bool haveDataPacketSubscriberOptions() const noexcept;
     /// @}
 
+    /// @name Subscription Publisher Options
+    /// @{
+
+    /// @brief Sets the options for the publisher that pushes packets to
+    ///        subscribers as the packet cache stores them.
+    /// @param[in] options  The subscription publisher options.
+    /// @throws std::invalid_argument if the address is not set.
+    /// @note Only one packet cache instance should publish to a given
+    ///       broadcast otherwise subscribers will receive duplicate packets.
+    void setSubscriptionPublisherOptions(
+        const URTS::Broadcasts::Internal::DataPacket::PublisherOptions &options);
+    /// @result The subscription publisher options.
+    /// @throws std::runtime_error if \c haveSubscriptionPublisherOptions()
+    ///         is false.
+    [[nodiscard]] URTS::Broadcasts::Internal::DataPacket::PublisherOptions
+        getSubscriptionPublisherOptions() const;
+    /// @result True indicates the subscription publisher options were set.
+    ///         By default the packet cache does not publish packets.
+    [[nodiscard]] bool haveSubscriptionPublisherOptions() const noexcept;
+    /// @}
+
     /// @name Replier Required Options
     /// @{
  
@@ -130,6 +153,15 @@ public:
     void setReplierSendHighWaterMark(int highWaterMark);
     /// @result The send high water mark.  The default is 8192.
     [[nodiscard]] int getReplierSendHighWaterMark() const noexcept;
+    /// @brief Sets the number of threads that handle requests.  Each thread
+    ///        connects its own replier to the proxy's backend and the proxy
+    ///        balances the requests across them.  The request envelope
+    ///        routes each reply back to the requesting client.
+    /// @param[in] nThreads  The number of replier threads.
+    /// @throws std::invalid_argument if nThreads is not positive.
+    void setNumberOfReplierThreads(int nThreads);
+    /// @result The number of replier threads.  The default is 1.
+    [[nodiscard]] int getNumberOfReplierThreads() const noexcept;
     /// @}
 
     /// @name Capped Collection Options
@@ -146,6 +178,65 @@ public:
     /// @result The maximum number of packets that a channel in the packet cache
     ///         can hold. 
     [[nodiscard]] int getMaximumNumberOfPackets() const noexcept;
+    /// @brief Enables or disables lossless compression of the cached samples.
+    ///        Integer valued samples typically compress by a factor of
+    ///        three or more which lengthens the cache's retention for the
+    ///        same memory.  The cost is that samples are decoded on
+    ///        every query.
+    /// @param[in] compress  True indicates the samples are to be compressed.
+    void setSampleCompression(bool compress) noexcept;
+    /// @result True indicates the samples are to be compressed.  By default
+    ///         this is false.
+    [[nodiscard]] bool useSampleCompression() const noexcept;
+    /// @brief Enables or disables lossless compression of the integer valued
+    ///        samples in data and bulk data responses.  This considerably
+    ///        reduces the bandwidth to the requesters at the cost of
+    ///        encoding each reply and decoding it on receipt.
+    /// @param[in] compress  True indicates the responses' samples are to be
+    ///                      compressed.
+    /// @note Requesters must be built with a version of URTS that
+    ///       understands compressed responses.
+    void setResponseCompression(bool compress) noexcept;
+    /// @result True indicates the responses' samples are to be compressed.
+    ///         By default this is false.
+    [[nodiscard]] bool useResponseCompression() const noexcept;
+    /// @brief Enables or disables the compact layout of data and bulk data
+    ///        responses.  This writes each channel's packets as arrays of
+    ///        start times and sample counts followed by one block of samples
+    ///        which requesters can read without per-packet overhead.
+    /// @param[in] compact  True indicates the responses are to be compact.
+    /// @note Requesters must be built with a version of URTS that
+    ///       understands compact responses.
+    void setCompactResponses(bool compact) noexcept;
+    /// @result True indicates the responses are to be compact.  By default
+    ///         this is false.
+    [[nodiscard]] bool useCompactResponses() const noexcept;
+    /// @}
+
+    /// @name Snapshot Options
+    /// @{
+
+    /// @brief Sets the file to which the packet cache is periodically
+    ///        written.  On initialization the packet cache is refilled from
+    ///        this file so that a restarted service can immediately serve
+    ///        full windows.
+    /// @param[in] fileName  The snapshot file.
+    /// @throws std::invalid_argument if fileName is empty or its parent
+    ///         directory does not exist.
+    void setSnapshotFile(const std::string &fileName);
+    /// @result The snapshot file.
+    /// @throws std::runtime_error if \c haveSnapshotFile() is false.
+    [[nodiscard]] std::string getSnapshotFile() const;
+    /// @result True indicates the snapshot file was set.  By default
+    ///         snapshots are not written.
+    [[nodiscard]] bool haveSnapshotFile() const noexcept;
+    /// @brief Sets the interval at which snapshots are written.  A final
+    ///        snapshot is also written when the service stops.
+    /// @param[in] interval  The snapshot interval.
+    /// @throws std::invalid_argument if the interval is not positive.
+    void setSnapshotInterval(const std::chrono::seconds &interval);
+    /// @result The snapshot interval.  By default this is 60 seconds.
+    [[nodiscard]] std::chrono::seconds getSnapshotInterval() const noexcept;
     /// @}
 
     /// @name Destructors
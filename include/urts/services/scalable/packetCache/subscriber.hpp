@@ -0,0 +1,103 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_SUBSCRIBER_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_SUBSCRIBER_HPP
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <umps/logging/log.hpp>
+#include <umps/messaging/context.hpp>
+namespace URTS::Broadcasts::Internal::DataPacket
+{
+ class SubscriberOptions;
+}
+namespace URTS::Services::Scalable::PacketCache
+{
+ class DataRequest;
+ class SubscriptionPacket;
+}
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @class Subscriber "subscriber.hpp" "urts/services/scalable/packetCache/subscriber.hpp"
+/// @brief Receives the packets that the packet cache pushes as it stores
+///        them.  This is an alternative to repeatedly querying the packet
+///        cache for new data.
+/// @note The subscriber subscribes to each sensor's topic so the broadcast
+///       only sends it the sensors of interest.  Additionally, the subscriber
+///       tracks each sensor's sequence numbers.  When a jump is detected
+///       a \c DataRequest that will recover the missed packets from the
+///       packet cache is made available by \c popGapRequests().
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Subscriber
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    Subscriber();
+    /// @brief Constructs a subscriber with the given logger.
+    /// @param[in] logger  A pointer to the application's logger.
+    explicit Subscriber(std::shared_ptr<UMPS::Logging::ILog> &logger);
+    /// @brief Constructs a subscriber with a given ZeroMQ context.
+    /// @param[in] context  The context from which to initialize.
+    explicit Subscriber(std::shared_ptr<UMPS::Messaging::Context> &context);
+    /// @brief Constructs a subscriber with a given ZeroMQ context and logger.
+    Subscriber(std::shared_ptr<UMPS::Messaging::Context> &context,
+               std::shared_ptr<UMPS::Logging::ILog> &logger);
+    /// @brief Move constructor.
+    /// @param[in,out] subscriber  The subscriber from which to initialize this
+    ///                            class.  On exit, subscriber's behavior is
+    ///                            undefined.
+    Subscriber(Subscriber &&subscriber) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Move assignment.
+    /// @param[in,out] subscriber  The subscriber whose memory will be moved to
+    ///                            this.  On exit, subscriber's behavior is
+    ///                            undefined.
+    Subscriber& operator=(Subscriber &&subscriber) noexcept;
+    /// @}
+
+    /// @brief Connects to the packet cache's subscription broadcast.
+    /// @param[in] options  The subscriber options.
+    /// @param[in] sensors  The sensors of interest.  Each sensor is
+    ///                     specified as NETWORK.STATION.CHANNEL.LOCATION_CODE.
+    ///                     The packet cache's sensors can be obtained with a
+    ///                     \c SensorRequest.
+    /// @throws std::invalid_argument if options.haveAddress() is false,
+    ///         sensors is empty, or a sensor is empty.
+    /// @throws std::runtime_error if the connection cannot be established.
+    void initialize(const URTS::Broadcasts::Internal::DataPacket::SubscriberOptions &options,
+                    const std::unordered_set<std::string> &sensors);
+    /// @result True indicates that the subscriber is initialized.
+    [[nodiscard]] bool isInitialized() const noexcept;
+
+    /// @brief Receives the next packet for a sensor of interest.
+    /// @result The next packet.  If the receive timed out then this is NULL.
+    /// @throws std::runtime_error if \c isInitialized() is false or the
+    ///         message cannot be deserialized.
+    [[nodiscard]] std::unique_ptr<SubscriptionPacket> receive();
+    /// @result The requests that will recover packets that were missed since
+    ///         the last call.  Each request carries the packet cache's sensor
+    ///         identifier and a cursor so that only the missed (and any
+    ///         newer) packets are returned.
+    /// @note By default the requests' query times span all time so the
+    ///       cursor alone selects the packets.
+    [[nodiscard]] std::vector<DataRequest> popGapRequests();
+    /// @result The number of gaps detected since initialization.
+    [[nodiscard]] int64_t getNumberOfGaps() const noexcept;
+
+    /// @brief Destructor.
+    ~Subscriber();
+
+    Subscriber(const Subscriber &) = delete;
+    Subscriber& operator=(const Subscriber &) = delete;
+private:
+    class SubscriberImpl;
+    std::unique_ptr<SubscriberImpl> pImpl;
+};
+}
+#endif
@@ -0,0 +1,172 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_SUBSCRIPTION_PACKET_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_SUBSCRIPTION_PACKET_HPP
+#include <memory>
+#include <cstdint>
+#include <umps/messageFormats/message.hpp>
+namespace URTS::Broadcasts::Internal::DataPacket
+{
+ class DataPacket;
+}
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @class SubscriptionPacket "subscriptionPacket.hpp" "urts/services/scalable/packetCache/subscriptionPacket.hpp"
+/// @brief This is a data packet that was stored in the packet cache.  The
+///        packet cache publishes these as it stores new and backfilled
+///        packets so clients need not poll the packet cache.
+/// @note The sequence number of a sensor's packets increases by one for every
+///       packet the packet cache stores.  If a subscriber observes a jump
+///       then it missed packets and can recover them with a \c DataRequest
+///       whose sensor identifier is this packet's sensor identifier and
+///       whose cursor is the last sequence number received.
+/// @note The message type includes the sensor's topic, e.g.,
+///       URTS::Services::Scalable::PacketCache::SubscriptionPacket::UU.CTU.HHZ.01.
+///       Since UMPS subscribes by message type, the broadcast drops the
+///       packets of sensors that a subscriber did not ask for before they
+///       are sent to, or deserialized by, that subscriber.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class SubscriptionPacket : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    SubscriptionPacket();
+    /// @brief Copy constructor.
+    /// @param[in] packet  The packet from which to initialize this class.
+    SubscriptionPacket(const SubscriptionPacket &packet);
+    /// @brief Move constructor.
+    /// @param[in,out] packet  The packet from which to initialize this class.
+    ///                        On exit, packet's behavior is undefined.
+    SubscriptionPacket(SubscriptionPacket &&packet) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] packet  The packet to copy to this.
+    /// @result A deep copy of the input packet.
+    SubscriptionPacket& operator=(const SubscriptionPacket &packet);
+    /// @brief Move assignment operator.
+    /// @param[in,out] packet  The packet whose memory will be moved to this.
+    ///                        On exit, packet's behavior is undefined.
+    /// @result The memory from packet moved to this.
+    SubscriptionPacket& operator=(SubscriptionPacket &&packet) noexcept;
+    /// @}
+
+    /// @name Packet
+    /// @{
+
+    /// @brief Sets the data packet.
+    /// @param[in] packet  The data packet stored in the packet cache.
+    /// @throws std::invalid_argument if the network, station, channel,
+    ///         location code, or sampling rate is not set.
+    void setPacket(const URTS::Broadcasts::Internal::DataPacket::DataPacket &packet);
+    /// @brief Sets the data packet.
+    /// @param[in,out] packet  The data packet stored in the packet cache.
+    ///                        On exit, packet's behavior is undefined.
+    /// @throws std::invalid_argument if the network, station, channel,
+    ///         location code, or sampling rate is not set.
+    void setPacket(URTS::Broadcasts::Internal::DataPacket::DataPacket &&packet);
+    /// @result The data packet.
+    /// @throws std::runtime_error if \c havePacket() is false.
+    [[nodiscard]] URTS::Broadcasts::Internal::DataPacket::DataPacket getPacket() const;
+    /// @result A reference to the data packet.
+    /// @throws std::runtime_error if \c havePacket() is false.
+    [[nodiscard]] const URTS::Broadcasts::Internal::DataPacket::DataPacket &getPacketReference() const;
+    /// @result True indicates the packet was set.
+    [[nodiscard]] bool havePacket() const noexcept;
+
+    /// @brief Sets the packet cache's identifier for this packet's sensor.
+    /// @param[in] identifier  The sensor identifier.
+    void setSensorIdentifier(uint64_t identifier) noexcept;
+    /// @result The sensor identifier.
+    [[nodiscard]] uint64_t getSensorIdentifier() const noexcept;
+
+    /// @brief Sets the packet's sequence number.
+    /// @param[in] sequenceNumber  The sequence number.
+    void setSequenceNumber(uint64_t sequenceNumber) noexcept;
+    /// @result The packet's sequence number.
+    [[nodiscard]] uint64_t getSequenceNumber() const noexcept;
+
+    /// @brief Sets the topic.  This is set by \c setPacket() so it is only
+    ///        set directly to create the message type that a subscriber
+    ///        listens for.
+    /// @param[in] sensor  The sensor specified as
+    ///                    NETWORK.STATION.CHANNEL.LOCATION_CODE.
+    /// @throws std::invalid_argument if sensor is empty.
+    void setTopic(const std::string &sensor);
+    /// @result The sensor specified as NETWORK.STATION.CHANNEL.LOCATION_CODE.
+    ///         If the topic is not set then this is empty.
+    [[nodiscard]] std::string getTopic() const noexcept;
+    /// @}
+
+    /// @name Message Properties
+    /// @{
+
+    /// @brief Converts this class to a string message.
+    /// @result The class expressed as a string message.
+    /// @throws std::runtime_error if \c havePacket() is false.
+    /// @note Though the container is a string the message need not be
+    ///       human readable.
+    [[nodiscard]] std::string toMessage() const final;
+    /// @brief Creates the class from a message.
+    /// @param[in] message  The message from which to create this class.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(const std::string &message) final;
+    /// @brief Creates the class from a message.
+    /// @param[in] data    The contents of the message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromMessage(const char *data, size_t length) final;
+    /// @result A message type indicating this is a subscription packet.
+    ///         When the topic is set this is followed by two colons, the
+    ///         topic, and a period.  The period ensures one sensor's message
+    ///         type is never a prefix of another's.
+    [[nodiscard]] std::string getMessageType() const noexcept final;
+    /// @result The message version.
+    [[nodiscard]] std::string getMessageVersion() const noexcept final;
+    /// @result A copy of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> clone() const final;
+    /// @result An uninitialized instance of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> createInstance() const noexcept final;
+    /// @}
+
+    /// @name Debugging Utilities
+    /// @{
+
+    /// @brief Converts the packet to a CBOR message.
+    /// @result The class expressed in Compressed Binary Object Representation
+    ///         (CBOR) format.
+    /// @throws std::runtime_error if \c havePacket() is false.
+    [[nodiscard]] std::string toCBOR() const;
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] cbor  The CBOR message.
+    void fromCBOR(const std::string &cbor);
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] data    The contents of the CBOR message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromCBOR(const uint8_t *data, size_t length);
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Resets the class.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~SubscriptionPacket() override;
+    /// @}
+private:
+    class SubscriptionPacketImpl;
+    std::unique_ptr<SubscriptionPacketImpl> pImpl;
+};
+}
+#endif
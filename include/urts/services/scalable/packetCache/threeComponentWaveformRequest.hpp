@@ -0,0 +1,235 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_REQUEST_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_REQUEST_HPP
+#include <memory>
+#include <chrono>
+#include <umps/messageFormats/message.hpp>
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @name ThreeComponentWaveformRequest "threeComponentWaveformRequest.hpp" "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+/// @brief This is a request message for querying the packetCache for an
+///        aligned three-component waveform.  Rather than return the raw
+///        packets for each channel, the packet cache will interpolate the
+///        vertical, north, and east channels onto a common time grid.
+///        Since many detectors and pickers query the same station at the
+///        same time this work is done once by the packet cache.
+/// @note Since the underlying messaging is asynchronous it is to your advantage
+///       to provide your request a unique identifier since the requests are
+///       not required to filled in the order that they are put on the wire.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class ThreeComponentWaveformRequest : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    ThreeComponentWaveformRequest();
+    /// @brief Copy constructor.
+    /// @param[in] request  The request from which to initialize this class.
+    ThreeComponentWaveformRequest(const ThreeComponentWaveformRequest &request);
+    /// @brief Move constructor.
+    /// @param[in,out] request  The request from which to initialize this class.
+    ///                         On exit, requests's behavior is undefined.
+    ThreeComponentWaveformRequest(ThreeComponentWaveformRequest &&request) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] request  The request to copy to this.
+    /// @result A deep copy of the input request.
+    ThreeComponentWaveformRequest& operator=(const ThreeComponentWaveformRequest &request);
+    /// @brief Move assignment operator.
+    /// @param[in,out] request  The request whose memory will be moved to this.
+    ///                         On exit, request's behavior is undefined.
+    /// @result The memory from request moved to this.
+    ThreeComponentWaveformRequest& operator=(ThreeComponentWaveformRequest &&request) noexcept;
+    /// @}
+
+    /// @name Required Parameters
+    /// @{
+
+    /// @brief Sets the network code.
+    /// @param[in] network  The network code - e.g., UU.
+    /// @throws std::invalid_argument if network is empty.
+    void setNetwork(const std::string &network);
+    /// @result The network code.
+    /// @throws std::runtime_error if \c haveNetwork() is false.
+    [[nodiscard]] std::string getNetwork() const;
+    /// @result True indicates that the network was set.
+    [[nodiscard]] bool haveNetwork() const noexcept;
+
+    /// @brief Sets the station name.
+    /// @param[in] station   The station name - e.g., FORK.
+    /// @throws std::invalid_argument if station is empty.
+    void setStation(const std::string &station);
+    /// @result The station name.
+    /// @throws std::runtime_error if \c haveStation() is false.
+    [[nodiscard]] std::string getStation() const;
+    /// @result True indicates that the station name was set.
+    [[nodiscard]] bool haveStation() const noexcept;
+
+    /// @brief Sets the vertical channel code.
+    /// @param[in] verticalChannel  The vertical channel code - e.g., HHZ.
+    /// @throws std::invalid_argument if the channel code is empty.
+    void setVerticalChannel(const std::string &verticalChannel);
+    /// @result The vertical channel code.
+    /// @throws std::runtime_error if \c haveVerticalChannel() is false.
+    [[nodiscard]] std::string getVerticalChannel() const;
+    /// @result True indicates the vertical channel code was set.
+    [[nodiscard]] bool haveVerticalChannel() const noexcept;
+
+    /// @brief Sets the north (or 1) channel code.
+    /// @param[in] northChannel  The north channel code - e.g., HHN or HH1.
+    /// @throws std::invalid_argument if the channel code is empty.
+    void setNorthChannel(const std::string &northChannel);
+    /// @result The north channel code.
+    /// @throws std::runtime_error if \c haveNorthChannel() is false.
+    [[nodiscard]] std::string getNorthChannel() const;
+    /// @result True indicates the north channel code was set.
+    [[nodiscard]] bool haveNorthChannel() const noexcept;
+
+    /// @brief Sets the east (or 2) channel code.
+    /// @param[in] eastChannel  The east channel code - e.g., HHE or HH2.
+    /// @throws std::invalid_argument if the channel code is empty.
+    void setEastChannel(const std::string &eastChannel);
+    /// @result The east channel code.
+    /// @throws std::runtime_error if \c haveEastChannel() is false.
+    [[nodiscard]] std::string getEastChannel() const;
+    /// @result True indicates the east channel code was set.
+    [[nodiscard]] bool haveEastChannel() const noexcept;
+
+    /// @brief Sets the location code.
+    /// @param[in] location  The location code - e.g., 01.
+    /// @throws std::invalid_argument if location is empty.
+    void setLocationCode(const std::string &location);
+    /// @result The location code.
+    /// @throws std::runtime_error if \c haveLocationCode() is false.
+    [[nodiscard]] std::string getLocationCode() const;
+    /// @result True indicates that the location code was set.
+    [[nodiscard]] bool haveLocationCode() const noexcept;
+
+    /// @brief Sets the time window to interpolate.
+    /// @param[in] queryTimes  queryTimes.first is the start time in UTC
+    ///                        seconds since the epoch of the interpolated
+    ///                        signals.
+    ///                        queryTimes.second is the end time in UTC seconds
+    ///                        since the epoch of the interpolated signals.
+    /// @note If the packet cache does not have data spanning this window
+    ///       then the interpolated signals will be truncated to the available
+    ///       data.
+    /// @throws std::invalid_argument if queryTimes.first >= queryTimes.second.
+    void setQueryTimes(const std::pair<double, double> &queryTimes);
+    /// @result The start and end time of the query in UTC seconds since the
+    ///         epoch.
+    /// @throws std::runtime_error if \c haveQueryTimes() is false.
+    [[nodiscard]] std::pair<double, double> getQueryTimes() const;
+    /// @result True indicates the query times were set.
+    [[nodiscard]] bool haveQueryTimes() const noexcept;
+    /// @}
+
+    /// @name Optional Parameters
+    /// @{
+
+    /// @brief Sets the sampling rate of the interpolated signals.
+    /// @param[in] samplingRate  The sampling rate in Hz.
+    /// @throws std::invalid_argument if samplingRate is not positive.
+    void setSamplingRate(double samplingRate);
+    /// @result The sampling rate in Hz.  By default this is 100 Hz.
+    [[nodiscard]] double getSamplingRate() const noexcept;
+
+    /// @brief Sets the gap tolerance between packets.
+    /// @param[in] gapTolerance  If the time between the end of a packet and
+    ///                          the start of the subsequent packet exceeds
+    ///                          this then the interpolated samples between
+    ///                          the packets are flagged in the gap indicator.
+    /// @sa \c ThreeComponentWaveform::setGapTolerance()
+    void setGapTolerance(const std::chrono::microseconds &gapTolerance) noexcept;
+    /// @result The gap tolerance.  By default this is 50000 microseconds.
+    [[nodiscard]] std::chrono::microseconds getGapTolerance() const noexcept;
+
+    /// @brief Sets the message identifier.
+    /// @param[in] identifier  The message identifier.
+    /// @note ThreeComponentWaveformResponse will return this identifier so
+    ///       you can determine which requests have been filled.
+    void setIdentifier(uint64_t identifier) noexcept;
+    /// @result The message identifier.
+    [[nodiscard]] uint64_t getIdentifier() const noexcept;
+    /// @}
+
+    /// @name Message Properties
+    /// @{
+
+    /// @brief Converts this class to a string message.
+    /// @result The class expressed as a string message.
+    /// @throws std::runtime_error if the required information is not set.
+    /// @note Though the container is a string the message need not be
+    ///       human readable.
+    [[nodiscard]] std::string toMessage() const final;
+    /// @brief Creates the class from a message.
+    /// @param[in] message  The message from which to create this class.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(const std::string &message) final;
+    /// @brief Creates the class from a message.
+    /// @param[in] data    The contents of the message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromMessage(const char *data, size_t length) final;
+    /// @result A message type indicating this is a three-component waveform
+    ///         request message.
+    [[nodiscard]] std::string getMessageType() const noexcept final;
+    /// @result The message version.
+    [[nodiscard]] std::string getMessageVersion() const noexcept final;
+    /// @result A copy of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> clone() const final;
+    /// @result An uninitialized instance of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> createInstance() const noexcept final;
+    /// @}
+
+    /// @name Debugging Utilities
+    /// @{
+
+    /// @brief Creates the class from a JSON request message.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromJSON(const std::string &message);
+    /// @brief Converts the request class to a JSON message.
+    /// @param[in] nIndent  The number of spaces to indent.
+    /// @note -1 disables indentation which is preferred for message
+    ///       transmission.
+    /// @result A JSON representation of this class.
+    [[nodiscard]] std::string toJSON(int nIndent =-1) const;
+    /// @brief Converts the request class to a CBOR message.
+    /// @result The class expressed in Compressed Binary Object Representation
+    ///         (CBOR) format.
+    /// @throws std::runtime_error if the required information is not set.
+    [[nodiscard]] std::string toCBOR() const;
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] cbor  The CBOR message.
+    void fromCBOR(const std::string &cbor);
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] data    The contents of the CBOR message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromCBOR(const uint8_t *data, size_t length);
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Resets the class.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~ThreeComponentWaveformRequest() override;
+    /// @}
+private:
+    class ThreeComponentWaveformRequestImpl;
+    std::unique_ptr<ThreeComponentWaveformRequestImpl> pImpl;
+};
+}
+#endif
@@ -0,0 +1,222 @@
+#ifndef URTS_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_RESPONSE_HPP
+#define URTS_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_RESPONSE_HPP
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <umps/messageFormats/message.hpp>
+namespace URTS::Services::Scalable::PacketCache
+{
+/// @class ThreeComponentWaveformResponse "threeComponentWaveformResponse.hpp" "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
+/// @brief This is the packet cache's response to a
+///        \c ThreeComponentWaveformRequest.  It contains the vertical, north,
+///        and east signals interpolated onto a common time grid as well as
+///        an indicator of which samples were interpolated across a data gap.
+/// @note Copies of this class share the (immutable) signals.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class ThreeComponentWaveformResponse : public UMPS::MessageFormats::IMessage
+{
+public:
+    /// @brief Defines the return code for a three-component waveform request.
+    enum ReturnCode
+    {
+        Success = 0,             /*!< No errors were detected; the request was successful. */
+        NoSensor = 1,            /*!< The data for at least one of the requested sensors
+                                      (Network, Station, Channel, Location Code) does not exist. */
+        InvalidMessageType = 2,  /*!< The received message type is not supported. */
+        InvalidMessage = 3,      /*!< The request message could not be parsed. */
+        InvalidTimeQuery = 4,    /*!< The time query parameters are invalid. */
+        AlgorithmicFailure = 5   /*!< An internal error was detected .*/
+    };
+public:
+    /// @name Constructors
+    /// @{
+
+    /// @brief Constructor.
+    ThreeComponentWaveformResponse();
+    /// @brief Copy constructor.
+    /// @param[in] response  The response from which to initialize this class.
+    ThreeComponentWaveformResponse(const ThreeComponentWaveformResponse &response);
+    /// @brief Move constructor.
+    /// @param[in,out] response  The response from which to initialize
+    ///                          this class.  On exit, responses' behavior is
+    ///                          undefined.
+    ThreeComponentWaveformResponse(ThreeComponentWaveformResponse &&response) noexcept;
+    /// @}
+
+    /// @name Operators
+    /// @{
+
+    /// @brief Copy assignment operator.
+    /// @param[in] response  The response to copy to this.
+    /// @result A copy of the input response.
+    ThreeComponentWaveformResponse& operator=(const ThreeComponentWaveformResponse &response);
+    /// @brief Move assignment operator.
+    /// @param[in,out] response  The response whose memory will be moved to
+    ///                          this.  On exit, response's behavior is
+    ///                          undefined.
+    /// @result The memory from response moved to this.
+    ThreeComponentWaveformResponse& operator=(ThreeComponentWaveformResponse &&response) noexcept;
+    /// @}
+
+    /// @name Signals
+    /// @{
+
+    /// @brief Sets the interpolated signals.
+    /// @param[in] verticalSignal  The interpolated vertical signal.
+    /// @param[in] northSignal     The interpolated north (or 1) signal.
+    /// @param[in] eastSignal      The interpolated east (or 2) signal.
+    /// @param[in] gapIndicator    A non-zero value indicates the
+    ///                            corresponding sample was interpolated
+    ///                            across a gap between packets.
+    /// @throws std::invalid_argument if the signals and gap indicator do not
+    ///         all have the same length.
+    void setSignals(const std::vector<double> &verticalSignal,
+                    const std::vector<double> &northSignal,
+                    const std::vector<double> &eastSignal,
+                    const std::vector<int8_t> &gapIndicator);
+    /// @brief Sets the interpolated signals.  This uses move semantics.
+    /// @param[in,out] verticalSignal  The interpolated vertical signal.  On
+    ///                                exit, verticalSignal's behavior is
+    ///                                undefined.
+    /// @param[in,out] northSignal     The interpolated north (or 1) signal.
+    ///                                On exit, northSignal's behavior is
+    ///                                undefined.
+    /// @param[in,out] eastSignal      The interpolated east (or 2) signal.
+    ///                                On exit, eastSignal's behavior is
+    ///                                undefined.
+    /// @param[in,out] gapIndicator    A non-zero value indicates the
+    ///                                corresponding sample was interpolated
+    ///                                across a gap between packets.  On exit,
+    ///                                gapIndicator's behavior is undefined.
+    /// @throws std::invalid_argument if the signals and gap indicator do not
+    ///         all have the same length.
+    void setSignals(std::vector<double> &&verticalSignal,
+                    std::vector<double> &&northSignal,
+                    std::vector<double> &&eastSignal,
+                    std::vector<int8_t> &&gapIndicator);
+    /// @result The number of samples in each signal.
+    [[nodiscard]] int getNumberOfSamples() const noexcept;
+    /// @result The interpolated signal on the vertical channel.
+    [[nodiscard]] const std::vector<double> &getVerticalSignalReference() const noexcept;
+    /// @result The interpolated signal on the north channel.
+    [[nodiscard]] const std::vector<double> &getNorthSignalReference() const noexcept;
+    /// @result The interpolated signal on the east channel.
+    [[nodiscard]] const std::vector<double> &getEastSignalReference() const noexcept;
+    /// @result An array whose non-zero values indicate the corresponding
+    ///         sample was interpolated across a gap between packets.
+    [[nodiscard]] const std::vector<int8_t> &getGapIndicatorReference() const noexcept;
+    /// @result True indicates that there are non-zeros in the gap indicator.
+    [[nodiscard]] bool haveGaps() const noexcept;
+
+    /// @brief Sets the time of the first sample.
+    /// @param[in] startTime  The UTC time of the first sample in microseconds
+    ///                       since the epoch.
+    void setStartTime(const std::chrono::microseconds &startTime) noexcept;
+    /// @result The UTC time of the first sample in microseconds since the
+    ///         epoch.
+    [[nodiscard]] std::chrono::microseconds getStartTime() const noexcept;
+    /// @result The UTC time of the last sample in microseconds since the
+    ///         epoch.
+    /// @throws std::runtime_error if there are no samples.
+    [[nodiscard]] std::chrono::microseconds getEndTime() const;
+
+    /// @brief Sets the sampling rate of the signals.
+    /// @param[in] samplingRate  The sampling rate in Hz.
+    /// @throws std::invalid_argument if samplingRate is not positive.
+    void setSamplingRate(double samplingRate);
+    /// @result The sampling rate in Hz.  By default this is 100 Hz.
+    [[nodiscard]] double getSamplingRate() const noexcept;
+    /// @}
+
+    /// @name Response Information
+    /// @{
+
+    /// @brief Sets the return code.
+    /// @param[in] code  The return code.
+    void setReturnCode(ReturnCode code) noexcept;
+    /// @result The return code from the service.
+    [[nodiscard]] ReturnCode getReturnCode() const noexcept;
+
+    /// @brief For asynchronous messaging this allows the requester to index
+    ///        the request.  This value will be returned so the requester
+    ///        can track which request was filled by the response.
+    /// @param[in] identifier   The request identifier.
+    void setIdentifier(uint64_t identifier) noexcept;
+    /// @result The request identifier.
+    [[nodiscard]] uint64_t getIdentifier() const noexcept;
+    /// @}
+
+    /// @name Message Properties
+    /// @{
+
+    /// @brief Converts this class to a string message.
+    /// @result The class expressed as a string message.
+    /// @note Though the container is a string the message need not be
+    ///       human readable.
+    [[nodiscard]] std::string toMessage() const final;
+    /// @brief Creates the class from a message.
+    /// @param[in] message  The message from which to create this class.
+    /// @throws std::invalid_argument if message.empty() is true.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromMessage(const std::string &message) final;
+    /// @brief Creates the class from a message.
+    /// @param[in] data    The contents of the message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromMessage(const char *data, size_t length) final;
+    /// @result A message type indicating this is a three-component waveform
+    ///         response message.
+    [[nodiscard]] std::string getMessageType() const noexcept final;
+    /// @result The message version.
+    [[nodiscard]] std::string getMessageVersion() const noexcept final;
+    /// @result A copy of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> clone() const final;
+    /// @result An uninitialized instance of this class.
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage> createInstance() const noexcept final;
+    /// @}
+
+    /// @name Debugging Utilities
+    /// @{
+
+    /// @brief Creates the class from a JSON response message.
+    /// @throws std::runtime_error if the message is invalid.
+    void fromJSON(const std::string &message);
+    /// @brief Converts the response class to a JSON message.
+    /// @param[in] nIndent  The number of spaces to indent.
+    /// @note -1 disables indentation which is preferred for message
+    ///       transmission.
+    /// @result A JSON representation of this class.
+    [[nodiscard]] std::string toJSON(int nIndent =-1) const;
+    /// @brief Converts the response class to a CBOR message.
+    /// @result The class expressed in Compressed Binary Object Representation
+    ///         (CBOR) format.
+    [[nodiscard]] std::string toCBOR() const;
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] cbor  The CBOR message.
+    void fromCBOR(const std::string &cbor);
+    /// @brief Creates the class from a CBOR message.
+    /// @param[in] data    The contents of the CBOR message.  This is an
+    ///                    array whose dimension is [length]
+    /// @param[in] length  The length of data.
+    /// @throws std::runtime_error if the message is invalid.
+    /// @throws std::invalid_argument if data is NULL or length is 0.
+    void fromCBOR(const uint8_t *data, size_t length);
+    /// @}
+
+    /// @name Destructors
+    /// @{
+
+    /// @brief Resets the class.
+    void clear() noexcept;
+    /// @brief Destructor.
+    ~ThreeComponentWaveformResponse() override;
+    /// @}
+private:
+    class ThreeComponentWaveformResponseImpl;
+    std::unique_ptr<ThreeComponentWaveformResponseImpl> pImpl;
+};
+}
+#endif
@@ -8,6 +8,10 @@ namespace URTS::Broadcasts::Internal::DataPacket
  class DataPacket;
 }
 namespace URTS::Services::Scalable::PacketCache
+{
+ class PacketView;
+}
+namespace URTS::Services::Scalable::PacketCache
 {
 /// @class WigginsInterpolator "wigginsInterpolator.hpp" "urts/services/scalable/packetCache/wigginsInterpolator.hpp"
 /// @brief Performs Wiggins interpolation on a vector of data packets. 
@@ -111,6 +115,31 @@ public:
     void interpolate(int nPackets, const URTS::Broadcasts::Internal::DataPacket::DataPacket packets[],
                      const std::chrono::microseconds &startTime = std::chrono::microseconds {-631152000000000},
                      const std::chrono::microseconds &endtime   = std::chrono::microseconds {5680281600000000});
+    /// @brief Interpolates packet views.  This avoids materializing data
+    ///        packets from, for example, a data response.
+    /// @param[in] packets    The packet views to interpolate.
+    /// @param[in] startTime  The start time (UTC) in microseconds since the
+    ///                       epoch of the interpolation.
+    /// @param[in] endTime    The end time (UTC) in microseconds since the
+    ///                       epoch of the interpolation.
+    /// @throws std::runtime_error if an error occurs.
+    /// @throws std::invalid_argument if the start time exceeds the end time.
+    void interpolate(const std::vector<PacketView> &packets,
+                     const std::chrono::microseconds &startTime = std::chrono::microseconds {-631152000000000},
+                     const std::chrono::microseconds &endtime   = std::chrono::microseconds {5680281600000000});
+    /// @brief Interpolates packet views.
+    /// @param[in] nPackets   The number of packets (which must be positive).
+    /// @param[in] packets    An array of packet views.  This has dimension
+    ///                       [nPackets].
+    /// @param[in] startTime  The start time (UTC) in microseconds since the
+    ///                       epoch of the interpolation.
+    /// @param[in] endTime    The end time (UTC) in microsecond since the
+    ///                       epoch of the interpolation.
+    /// @throws std::invalid_argument if the start time exceeds the end time,
+    ///         the number of packets is positive and packets is NULL.
+    void interpolate(int nPackets, const PacketView packets[],
+                     const std::chrono::microseconds &startTime = std::chrono::microseconds {-631152000000000},
+                     const std::chrono::microseconds &endtime   = std::chrono::microseconds {5680281600000000});
     /// @}
 
     /// @name Interpolated Signal
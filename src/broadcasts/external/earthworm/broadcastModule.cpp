@@ -5,6 +5,9 @@
 #include <thread>
 #include <filesystem>
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <optional>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -43,6 +46,7 @@
 #include "urts/broadcasts/external/earthworm/traceBuf2.hpp"
 #include "urts/broadcasts/external/earthworm/waveRing.hpp"
 #include "private/isEmpty.hpp"
+#include "private/latencyStatistics.hpp"
 
  
 #define MODULE_NAME "broadcastWaveRing"
@@ -66,6 +70,8 @@ namespace
     commands = "Commands:\n";
     commands = commands + "   quit         Exits the program.\n";
     commands = commands + "   packetsSent  Number of packets sent in last minute.\n";
+    commands = commands + "   latency      Time from checking the ring to publishing packets in last minute.\n";
+    commands = commands + "   readTime     Longest time spent reading the ring in last minute.\n";
     commands = commands + "   help         Displays this message.\n";
     return commands;
 }
@@ -127,6 +133,27 @@ struct ProgramOptions
 
         mBroadcastAddress
             = propertyTree.get<std::string> ("PublisherOptions.address", "");
+        mMaximumBatchSize
+            = propertyTree.get<int> ("PublisherOptions.maximumBatchSize",
+                                     mMaximumBatchSize);
+        if (mMaximumBatchSize < 1)
+        {
+            throw std::invalid_argument(
+                "PublisherOptions.maximumBatchSize must be positive");
+        }
+        auto maximumBatchAge = static_cast<int> (mMaximumBatchAge.count());
+        maximumBatchAge
+            = propertyTree.get<int> ("PublisherOptions.maximumBatchAge",
+                                     maximumBatchAge);
+        if (maximumBatchAge < 0)
+        {
+            throw std::invalid_argument(
+                "PublisherOptions.maximumBatchAge must be non-negative");
+        }
+        mMaximumBatchAge = std::chrono::milliseconds {maximumBatchAge};
+        mCompressSamples
+            = propertyTree.get<bool> ("PublisherOptions.compressSamples",
+                                      mCompressSamples);
         //----------------------------- Earthworm ----------------------------//
         // EW_PARAMS environment variable
         mEarthwormParametersDirectory = propertyTree.get<std::string>
@@ -154,6 +181,14 @@ struct ProgramOptions
             std::cerr << "Setting wait time to 0" << std::endl;
             mEarthwormWait = 0;
         }
+        // Threads used to unpack messages when catching up
+        mUnpackThreads = propertyTree.get<int> ("Earthworm.unpackThreads",
+                                                mUnpackThreads);
+        if (mUnpackThreads < 1)
+        {
+            throw std::invalid_argument(
+                "Earthworm.unpackThreads must be positive");
+        }
     }
     UAuth::ZAPOptions mZAPOptions;
     std::string mEarthwormParametersDirectory
@@ -163,10 +198,14 @@ struct ProgramOptions
     std::string mEarthwormWaveRingName{"WAVE_RING"};
     std::string mDataPacketBroadcastName{"DataPacket"};
     std::string mBroadcastAddress{""};
+    std::chrono::milliseconds mMaximumBatchAge{100};
     std::string mHeartbeatBroadcastName{"Heartbeat"};
     std::filesystem::path mLogFileDirectory{"/var/log/urts"};
     std::chrono::seconds heartBeatInterval{30};
     int mEarthwormWait{0};
+    int mUnpackThreads{2};
+    int mMaximumBatchSize{1}; // Batching is opt-in
+    bool mCompressSamples{false}; // Compression is opt-in
     UMPS::Logging::Level mVerbosity{UMPS::Logging::Level::Info};
 };
 
@@ -203,6 +242,7 @@ std::unique_ptr<URTS::Broadcasts::External::Earthworm::WaveRing>
           (logger);
     earthwormWaveRing->connect(options.mEarthwormWaveRingName,
                                options.mEarthwormWait);
+    earthwormWaveRing->setNumberOfUnpackThreads(options.mUnpackThreads);
     if (flushRing){earthwormWaveRing->flush();}
     logger->debug("Attach to earthworm ring: "
                 + options.mEarthwormWaveRingName);
@@ -333,10 +373,20 @@ public:
         mLogger->debug("Earthworm broadcast thread is starting");
         int numberOfPacketsSent = 0;
         mNumberOfPacketsSent = 0;
+        mLatency.clear();
+        std::chrono::microseconds maximumCopyTime{0};
+        std::chrono::microseconds maximumUnpackTime{0};
+        mMaximumCopyTime = 0;
+        mMaximumUnpackTime = 0;
         auto packetMonitorStart = std::chrono::high_resolution_clock::now();
+        auto idleWait = std::chrono::milliseconds {1};
+        // When the last read found nothing, messages may have arrived any
+        // time after it so latencies are measured from that read
+        std::optional<std::chrono::steady_clock::time_point> emptyReadTime;
         while (keepRunning())
         {
-            auto startClock = std::chrono::high_resolution_clock::now();
+            auto now = std::chrono::steady_clock::now();
+            auto readTime = emptyReadTime ? *emptyReadTime : now;
             // Read from the earthworm ring
             try
             {
@@ -348,12 +398,17 @@ public:
                              + std::string(e.what()));
                 continue;
             }
+            maximumCopyTime = std::max(maximumCopyTime,
+                                       mWaveRing->getCopyTime());
+            maximumUnpackTime = std::max(maximumUnpackTime,
+                                         mWaveRing->getUnpackTime());
             //auto nMessages = mWaveRing->getNumberOfTraceBuf2Messages();
             //auto traceBuf2MessagesPtr
             //    = mWaveRing->getTraceBuf2MessagesPointer();
             //const auto &traceBuf2MessagesReference
             //     = mWaveRing->getTraceBuf2MessagesReference();
             auto traceBuf2Messages = mWaveRing->moveTraceBuf2Messages();
+            int nSent{0};
             // Now broadcast the tracebufs as datapacket messages
             //for (int iMessage = 0; iMessage < nMessages; ++iMessage)
             //for (auto &traceBuf2Message : traceBuf2MessagesReference)
@@ -366,33 +421,60 @@ public:
                     //    = traceBuf2MessagesPtr[iMessage].toDataPacket();
                     //auto dataPacket = traceBuf2Message.toDataPacket();
                     auto dataPacket = traceBuf2Message.moveToDataPacket();
-                    mPacketPublisher->send(dataPacket);
+                    mPacketPublisher->send(std::move(dataPacket));
                     //std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Don't baby zmq
                     numberOfPacketsSent = numberOfPacketsSent + 1;
+                    nSent = nSent + 1;
                 }
                 catch (const std::exception &e)
                 {
                     mLogger->error(e.what());
                 }
             }
-            auto endClock = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>
-                            (endClock - startClock);
-            if (duration < mBroadcastInterval)
+            // Don't hold a partial batch while waiting on the ring
+            if (nSent > 0)
+            {
+                try
+                {
+                    mPacketPublisher->flush();
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("Failed to publish packet batch");
+                }
+                // Everything in this read was published together
+                auto latency
+                    = std::chrono::duration_cast<std::chrono::microseconds>
+                      (std::chrono::steady_clock::now() - readTime);
+                for (int i = 0; i < nSent; ++i){mLatency.add(latency);}
+            }
+            // The ring cannot signal us so read again immediately while
+            // data is flowing and back off exponentially, up to the maximum
+            // idle wait, when it is idle.  The back off is part of the
+            // latency since the next read's latency starts at this read.
+            if (traceBuf2Messages.empty())
             {
-                auto wait = mBroadcastInterval - duration;
-                std::this_thread::sleep_for(wait);
+                emptyReadTime = now;
+                std::this_thread::sleep_for(idleWait);
+                idleWait = std::min(2*idleWait, mMaximumIdleWait);
             }
             else
             {
-                startClock = endClock;
+                emptyReadTime.reset();
+                idleWait = std::chrono::milliseconds {1};
             }
             // Update my packets sent counter
-            duration = std::chrono::duration_cast<std::chrono::seconds>
-                       (endClock - packetMonitorStart);
+            auto endClock = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::seconds>
+                            (endClock - packetMonitorStart);
             if (duration > std::chrono::seconds {60})
             {
                 mNumberOfPacketsSent = numberOfPacketsSent;
+                mLatency.endWindow();
+                mMaximumCopyTime = maximumCopyTime.count();
+                mMaximumUnpackTime = maximumUnpackTime.count();
+                maximumCopyTime = std::chrono::microseconds {0};
+                maximumUnpackTime = std::chrono::microseconds {0};
                 numberOfPacketsSent = 0;
                 packetMonitorStart = endClock; 
             }
@@ -475,6 +557,26 @@ public:
                 response.setReturnCode(
                     USC::CommandResponse::ReturnCode::InvalidCommand);
             }
+            else if (command == "latency")
+            {
+                mLogger->debug("Issuing latency command...");
+                response.setResponse(
+                    "Read to publish latency in last minute: "
+                    + mLatency.toString());
+                response.setReturnCode(
+                    USC::CommandResponse::ReturnCode::Success);
+            }
+            else if (command == "readTime")
+            {
+                mLogger->debug("Issuing readTime command...");
+                response.setResponse(
+                    "Longest ring read in last minute: copy "
+                    + std::to_string(mMaximumCopyTime.load())
+                    + " us, unpack "
+                    + std::to_string(mMaximumUnpackTime.load()) + " us");
+                response.setReturnCode(
+                    USC::CommandResponse::ReturnCode::Success);
+            }
             else
             {
                 response.setResponse(getInputOptions());
@@ -510,7 +612,11 @@ public:
          mWaveRing{nullptr};
     std::unique_ptr<UMPS::Services::Command::Service> mLocalCommand{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
-    std::chrono::seconds mBroadcastInterval{1};
+    /// The longest back off when the ring has no new messages.
+    std::chrono::milliseconds mMaximumIdleWait{10};
+    ::LatencyStatistics mLatency;
+    std::atomic<int64_t> mMaximumCopyTime{0};
+    std::atomic<int64_t> mMaximumUnpackTime{0};
     int mNumberOfPacketsSent{0};
     bool mKeepRunning{true};
     bool mInitialized{false};
@@ -586,6 +692,15 @@ int main(int argc, char *argv[])
             = std::make_unique<UDP::Publisher> (context, logger);
         packetPublisherOptions.setAddress(programOptions.mBroadcastAddress);
         packetPublisherOptions.setZAPOptions(programOptions.mZAPOptions);
+        packetPublisherOptions.setMaximumBatchSize(
+            programOptions.mMaximumBatchSize);
+        packetPublisherOptions.setMaximumBatchAge(
+            programOptions.mMaximumBatchAge);
+        if (programOptions.mCompressSamples)
+        {
+            packetPublisherOptions.setSampleEncoding(
+                UDP::DataPacket::Encoding::IntegerDelta);
+        }
         packetPublisher->initialize(packetPublisherOptions);
 
         constexpr bool flushRing{true};
@@ -3,11 +3,14 @@
 #include <sstream>
 #include <algorithm>
 #include <string>
+#include <cstring>
+#include <stdexcept>
 #include <cassert>
 #include <bit>
 #include <nlohmann/json.hpp>
 #include "urts/broadcasts/external/earthworm/traceBuf2.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "private/traceBuf2Samples.hpp"
 #ifdef WITH_EARTHWORM
    #include "trace_buf.h"
    #define MAX_TRACE_SIZE (MAX_TRACEBUF_SIZ - 64)
@@ -142,29 +145,8 @@ template<typename T> T unpack(const char *__restrict__ cIn,
     return value;
 }
 
-template<typename T, typename U> std::vector<T> 
-unpack(const char *__restrict__ cIn, const int nSamples, const bool swap)
-{
-    std::vector<T> result(nSamples);
-    if (!swap)
-    {
-        auto dPtr = reinterpret_cast<const U *__restrict__> (cIn);
-        std::copy(dPtr, dPtr + nSamples, result.data());
-    }
-    else
-    {
-        const auto nBytes = sizeof(U);
-        auto resultPtr = result.data();
-        for (int i = 0; i < nSamples; ++i)
-        {
-            resultPtr[i] = static_cast<T> (unpack<U>(cIn + i*nBytes, swap));
-        }
-    }
-    return result;
-}
-
 template<typename T>
-TraceBuf2<T> unpackEarthwormMessage(const char *message)
+TraceBuf2<T> unpackEarthwormMessage(const char *message, const size_t length)
 {
     // Bytes  0 - 3:  pinno (int)
     // Bytes  4 - 7:  nsamp (int)
@@ -180,6 +162,11 @@ TraceBuf2<T> unpackEarthwormMessage(const char *message)
     // Bytes 60 - 61: quality (char)
     // Bytes 62 - 63: pad (char) 
     TraceBuf2<T> result;
+    if (length < 64)
+    {
+        throw std::invalid_argument("Message has " + std::to_string(length)
+                                  + " bytes which is smaller than the header");
+    }
     // First figure out the data format (int, double, float, etc.)
     bool swap = false;
     char dtype = 'i';
@@ -233,118 +220,49 @@ TraceBuf2<T> unpackEarthwormMessage(const char *message)
 #endif
         return result;
     }
-    // Unpack some character info
-    std::string station(message + 32);
-    std::string network(message + 39);
-    std::string channel(message + 48);
-    std::string location(message + 52); 
+    // Unpack some character info.  A name that fills its field is not
+    // NULL terminated so do not read past the field.
+    std::string station(message + 32, strnlen(message + 32, STA_LEN + 1));
+    std::string network(message + 39, strnlen(message + 39, NET_LEN + 1));
+    std::string channel(message + 48, strnlen(message + 48, CHA_LEN + 1));
+    std::string location(message + 52, strnlen(message + 52, LOC_LEN + 1));
     result.setNetwork(network);
     result.setStation(station);
     result.setChannel(channel);
     result.setLocationCode(location);
     // Finally unpack the data
-    if (!swap)
+    auto pinno        = unpack<int>(&message[0],      swap);
+    auto nsamp        = unpack<int>(&message[4],      swap);
+    auto startTime    = unpack<double>(&message[8],   swap);
+    //auto endTime    = unpack<double>(&message[16],  swap);
+    auto samplingRate = unpack<double>(&message[24],  swap);
+    auto quality      = unpack<int16_t>(&message[60], swap);
+    if (nsamp < 0 || nsamp > MAX_TRACE_SIZE/nBytes)
     {
-        constexpr bool swapPass = false;
-        auto pinno        = unpack<int>(&message[0],      swapPass);
-        auto nsamp        = unpack<int>(&message[4],      swapPass);
-        auto startTime    = unpack<double>(&message[8],   swapPass);
-        //auto endTime    = unpack<double>(&message[16],  swapPass);
-        auto samplingRate = unpack<double>(&message[24],  swapPass);
-        auto quality      = unpack<int16_t>(&message[60], swapPass);
-        result.setPinNumber(pinno);
-        result.setStartTime(startTime);
-        result.setSamplingRate(samplingRate);
-        result.setQuality(quality);
-
-        if (dtype == 'i')
-        {
-            if (nBytes == 2)
-            {
-                auto dPtr = reinterpret_cast<const int16_t *> (message + 64);
-                result.setData(nsamp, dPtr);
-            }
-            else if (nBytes == 4)
-            {
-                auto dPtr = reinterpret_cast<const int32_t *> (message + 64);
-                result.setData(nsamp, dPtr);
-            }
-            else if (nBytes == 8)
-            {
-                auto dPtr = reinterpret_cast<const int64_t *> (message + 64);
-                result.setData(nsamp, dPtr);
-            }
-        }
-        else if (dtype == 'f' && nBytes == 4)
-        {
-            if (nBytes == 4)
-            {
-                auto dPtr = reinterpret_cast<const float *> (message + 64);
-                result.setData(nsamp, dPtr);
-            }
-            else if (nBytes == 8)
-            {
-                auto dPtr = reinterpret_cast<const double *> (message + 64);
-                result.setData(nsamp, dPtr);
-            }
-        }
-        else
-        {
-           std::cerr << "Can only process i or f datatype" << std::endl;
-#ifndef NDEBUG
-           assert(false);
-#endif
-        }
+        throw std::invalid_argument("Invalid number of samples: "
+                                  + std::to_string(nsamp));
     }
-    else
+    // Don't read samples beyond the end of the message
+    if (64 + static_cast<size_t> (nsamp)*nBytes > length)
     {
-        constexpr bool swapPass = true;
-        auto pinno        = unpack<int>(&message[0],      swapPass);
-        auto nsamp        = unpack<int>(&message[4],      swapPass);
-        auto startTime    = unpack<double>(&message[8],   swapPass);
-        auto samplingRate = unpack<double>(&message[24],  swapPass);
-        auto quality      = unpack<int16_t>(&message[60], swapPass);
-        result.setPinNumber(pinno);
-        result.setStartTime(startTime);
-        result.setSamplingRate(samplingRate);
-        result.setQuality(quality);
-
-        std::vector<T> x;
-        if (dtype == 'i')
-        {
-            if (nBytes == 2)
-            {
-                x = unpack<T, int16_t>(message + 64, nsamp, swapPass);
-            }
-            else if (nBytes == 4)
-            {
-                x = unpack<T, int32_t>(message + 64, nsamp, swapPass);
-            }
-            else if (nBytes == 8)
-            {
-                x = unpack<T, int64_t>(message + 64, nsamp, swapPass);
-            }
-        }
-        else if (dtype == 'f' && nBytes == 4)
-        {
-            if (nBytes == 4)
-            {
-                x = unpack<T, float>(message + 64, nsamp, swapPass);
-            }
-            else if (nBytes == 8)
-            {
-                x = unpack<T, double>(message + 64, nsamp, swapPass);
-            }
-        }
-        else
-        {
-           std::cerr << "Can only process i or f datatype" << std::endl;
+        throw std::invalid_argument("Message has " + std::to_string(length)
+                                  + " bytes but " + std::to_string(nsamp)
+                                  + " samples were specified");
+    }
+    result.setPinNumber(pinno);
+    result.setStartTime(startTime);
+    result.setSamplingRate(samplingRate);
+    result.setQuality(quality);
+
+    std::vector<T> x;
+    if (!::unpackSamples(message + 64, nsamp, dtype, nBytes, swap, &x))
+    {
+       std::cerr << "Can only process i or f datatype" << std::endl;
 #ifndef NDEBUG
-           assert(false);
+       assert(false);
 #endif
-        }
-        result.setData(std::move(x));
     }
+    result.setData(std::move(x));
     return result; 
 }
 
@@ -825,7 +743,14 @@ void TraceBuf2<T>::clear() noexcept
 template<class T>
 void TraceBuf2<T>::fromEarthworm(const char *message)
 {
-    auto t = unpackEarthwormMessage<T>(message);
+    fromEarthworm(message, MAX_TRACE_SIZE + 64);
+}
+
+template<class T>
+void TraceBuf2<T>::fromEarthworm(const char *message, const size_t length)
+{
+    if (message == nullptr){throw std::invalid_argument("message is NULL");}
+    auto t = unpackEarthwormMessage<T>(message, length);
     *this = std::move(t);
 }
 
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <vector>
 #include <map>
+#include <algorithm>
 #undef WITH_MSEED
 #ifdef WITH_MSEED
 #include <libmseed.h>
@@ -23,6 +24,8 @@ extern "C"
 #include <umps/logging/standardOut.hpp>
 #include "urts/broadcasts/external/earthworm/waveRing.hpp"
 #include "urts/broadcasts/external/earthworm/traceBuf2.hpp"
+#include "private/traceBuf2Slab.hpp"
+#include "private/workerPool.hpp"
 
 using namespace URTS::Broadcasts::External::Earthworm;
 
@@ -39,6 +42,8 @@ std::array<char, 14> MOD_WILDCARD{"MOD_WILDCARD\0"};
 std::array<char, 15> INST_WILDCARD{"INST_WILDCARD\0"};
 std::array<char, 16> TYPE_HEARTBEAT{"TYPE_HEARTBEAT\0"};
 std::array<char, 16> TYPE_TRACEBUF2{"TYPE_TRACEBUF2\0"};
+/// Don't bother spinning up an unpacking thread for fewer messages.
+constexpr int MINIMUM_MESSAGES_PER_THREAD{256};
 //std::array<char, 21> TYPE_TRACECOMP2{"TYPE_TRACE2_COMP_UA\0"};
 }
 
@@ -84,6 +89,23 @@ public:
     unsigned char mModWildCard = 0;
     /// Error type
     unsigned char mErrorType = 0;
+    /// The messages copied off the ring.  Each message has its own
+    /// MAX_TRACEBUF_SIZ slot.
+    std::vector<char> mSlab;
+    /// The type of the message in each slot.
+    std::vector<unsigned char> mMessageTypes;
+    /// The number of bytes copied into each slot.
+    std::vector<long> mMessageSizes;
+    /// Time spent copying and unpacking messages in the last read.
+    std::chrono::microseconds mCopyTime{0};
+    std::chrono::microseconds mUnpackTime{0};
+    /// Messages read in the last read
+    int mNumberOfMessagesRead = 0;
+    /// Threads that help unpack messages.  These are started on connect
+    /// and joined on disconnect.
+    ::WorkerPool mUnpackPool;
+    /// Threads used to unpack messages
+    int mNumberOfUnpackThreads = 2;
     /// Most waves read off the ring
     int mMostWavesRead = 0;
     /// Have the region?
@@ -129,6 +151,7 @@ WaveRing::~WaveRing()
 /// Disconnects
 void WaveRing::disconnect() noexcept
 {
+    pImpl->mUnpackPool.stop();
 #ifdef WITH_EARTHWORM
     pImpl->mLogger->debug("Disconnecting...");
     if (pImpl->mHaveRegion){tport_detach(&pImpl->mRegion);}
@@ -149,6 +172,13 @@ void WaveRing::disconnect() noexcept
     pImpl->mModWildCard = 0;
     pImpl->mErrorType = 0;
     pImpl->mMostWavesRead = 0;
+    // Release the workspace since it only grows while connected
+    std::vector<char> ().swap(pImpl->mSlab);
+    std::vector<unsigned char> ().swap(pImpl->mMessageTypes);
+    std::vector<long> ().swap(pImpl->mMessageSizes);
+    pImpl->mCopyTime = std::chrono::microseconds {0};
+    pImpl->mUnpackTime = std::chrono::microseconds {0};
+    pImpl->mNumberOfMessagesRead = 0;
     pImpl->mHaveRegion = false;
     pImpl->mConnected = false;
 #endif
@@ -254,6 +284,8 @@ void WaveRing::connect(const std::string &ringName,
     pImpl->mConnected = true;
     // Optimization -> reserve some space
     pImpl->mTraceBuf2Messages.reserve(1024);
+    // The calling thread unpacks too so it needs one fewer helper
+    pImpl->mUnpackPool.start(pImpl->mNumberOfUnpackThreads - 1);
     pImpl->mLogger->debug("Connected!");
 #endif
 }
@@ -272,17 +304,22 @@ void WaveRing::read()
     if (!isConnected()){throw std::runtime_error("Not to connected to a ring");}
     pImpl->mLogger->debug("Reading from ring...");
     // The algorithm works as follows:
-    //  (1) Take the information off the ring as fast as possible.
-    //  (2) Unpack the tracebuffers
-    // To do (1) first attempt to allocate enough space. 
-    int nWork = std::max(1024, pImpl->mMostWavesRead);
-    std::vector<std::array<char, MAX_TRACEBUF_SIZ>> messageWork;
-    std::vector<unsigned char> messageType;
-    messageWork.reserve(nWork);
-    messageType.reserve(nWork);
+    //  (1) Take the information off the ring as fast as possible.  The
+    //      messages are copied straight into a slab that persists between
+    //      reads so there is no per-message allocation or clearing.
+    //  (2) Unpack the tracebuffers.  When there are many, e.g., we are
+    //      catching up, this is split across a few threads.
+    constexpr auto slotSize = static_cast<size_t> (MAX_TRACEBUF_SIZ);
+    auto &slab = pImpl->mSlab;
+    auto &messageType = pImpl->mMessageTypes;
+    auto &messageSize = pImpl->mMessageSizes;
+    messageType.clear();
+    messageSize.clear();
+    if (slab.empty())
+    {
+        slab.resize(std::max(1024, pImpl->mMostWavesRead)*slotSize);
+    }
     pImpl->mTraceBuf2Messages.resize(0);
-    // Now copy the (unpacked) messages from the ring
-    std::array<char, MAX_TRACEBUF_SIZ> msg;
     MSG_LOGO gotLogo;
     long gotSize = 0;
     int returnCode = 0;
@@ -301,13 +338,16 @@ void WaveRing::read()
             disconnect();
             throw std::runtime_error(error);
         }
+        // Make room for the next message
+        auto slot = messageType.size();
+        if ((slot + 1)*slotSize > slab.size()){slab.resize(2*slab.size());}
         // Copy the ring message
-        std::fill(msg.begin(), msg.end(), '\0');
         returnCode = tport_copyfrom(&pImpl->mRegion,
                                     pImpl->mLogos.data(),
                                     pImpl->mLogos.size(),
                                     &gotLogo, &gotSize,
-                                    msg.data(), MAX_TRACEBUF_SIZ,
+                                    slab.data() + slot*slotSize,
+                                    MAX_TRACEBUF_SIZ,
                                     &sequenceNumber);
         // Are we done?
         if (returnCode == GET_NONE){break;}
@@ -341,14 +381,18 @@ void WaveRing::read()
             }
             continue;
         }
-        // Unpack the tracebuf2 type message
+        // Keep the tracebuf2 type message.  Only the gotSize bytes that
+        // were copied are read when unpacking so the slot does not need to
+        // be cleared.
         if (gotLogo.type == pImpl->mTraceBuffer2Type)
         {
-            // Note, there's an optimization to be had by only copying 
-            // gotSize bytes.  But for now, this is simple in terms of
-            // memory (re)allocation.
-            messageWork.push_back(msg);
+            if (gotSize < static_cast<long> (sizeof(TRACE2_HEADER)))
+            {
+                pImpl->mLogger->error("TraceBuf2 message too small");
+                continue;
+            }
             messageType.push_back(gotLogo.type);
+            messageSize.push_back(gotSize);
         }
 /*
         else if (gotLogo.type == pImpl->mTraceComp2Type)
@@ -360,8 +404,8 @@ void WaveRing::read()
         else if (gotLogo.type == pImpl->mMSEEDType)
         {
             pImpl->mLogger->error("MSEED message not handled");
-            messageWork.push_back(msg);
             messageType.push_back(gotLogo.type);
+            messageSize.push_back(gotSize);
         }
 #endif
         else
@@ -372,16 +416,18 @@ void WaveRing::read()
         nRead = nRead + 1;
     }
     auto end = std::chrono::high_resolution_clock::now();
-    auto elapsedTime = std::chrono::duration<double> (end - start).count();
+    pImpl->mCopyTime
+        = std::chrono::duration_cast<std::chrono::microseconds> (end - start);
+    pImpl->mNumberOfMessagesRead = nRead;
+    pImpl->mUnpackTime = std::chrono::microseconds {0};
     pImpl->mLogger->debug("Read " + std::to_string(nRead)
                         + " messages from ring in "
-                        + std::to_string(elapsedTime) + " (s).");
+                        + std::to_string(pImpl->mCopyTime.count()) + " (us).");
     if (pImpl->mMilliSecondsWait > 0){sleep_ew(pImpl->mMilliSecondsWait);}
     // Update our typical allocation size
-    pImpl->mMostWavesRead = std::max(pImpl->mMostWavesRead, 
-                                     static_cast<int> (messageWork.size()));
-    if (static_cast<int> (messageWork.size()) > pImpl->mMostWavesRead)
+    if (static_cast<int> (messageType.size()) > pImpl->mMostWavesRead)
     {
+        pImpl->mMostWavesRead = static_cast<int> (messageType.size());
         pImpl->mLogger->debug("Extending message workspace to " 
                             + std::to_string(pImpl->mMostWavesRead)
                             + " messages");
@@ -393,24 +439,23 @@ void WaveRing::read()
     if (nTraceBuf2Messages > 0)
     {
         start = std::chrono::high_resolution_clock::now();
-        pImpl->mTraceBuf2Messages.resize(messageWork.size());
+        auto nMessages = static_cast<int> (messageType.size());
         pImpl->mLogger->debug("Unpacking " + std::to_string(nTraceBuf2Messages)
                             + " traceBuf2 messages...");
-        for (int it = 0; it < static_cast<int> (messageWork.size()); ++it)
+        auto nThreads
+            = std::min(pImpl->mNumberOfUnpackThreads,
+                       std::max(1, nMessages/MINIMUM_MESSAGES_PER_THREAD));
+        auto nFailed = ::unpackTraceBuf2Slab(slab, slotSize, messageSize,
+                                             messageType,
+                                             pImpl->mTraceBuffer2Type,
+                                             nThreads,
+                                             &pImpl->mUnpackPool,
+                                             &pImpl->mTraceBuf2Messages);
+        if (nFailed > 0)
         {
-            if (messageType[it] == pImpl->mTraceBuffer2Type)
-            {
-                try
-                {
-                    pImpl->mTraceBuf2Messages[it].fromEarthworm(
-                        messageWork[it].data());
-                }
-                catch (const std::exception &e)
-                {
-                    pImpl->mLogger->error(e.what());
-                    continue;
-                }
-            }
+            pImpl->mLogger->error("Failed to unpack "
+                                + std::to_string(nFailed)
+                                + " traceBuf2 messages");
         }
         // Evict any empty messages
         pImpl->mTraceBuf2Messages.erase(
@@ -422,11 +467,15 @@ void WaveRing::read()
                            }),
                            pImpl->mTraceBuf2Messages.end());
         end = std::chrono::high_resolution_clock::now();
-        elapsedTime = std::chrono::duration<double> (end - start).count();
+        pImpl->mUnpackTime
+            = std::chrono::duration_cast<std::chrono::microseconds>
+              (end - start);
         pImpl->mLogger->debug("Successfully unpacked "
                             + std::to_string(pImpl->mTraceBuf2Messages.size())
                             + " traceBuf2 messages in "
-                            + std::to_string(elapsedTime) + " (s).");
+                            + std::to_string(pImpl->mUnpackTime.count())
+                            + " (us) with " + std::to_string(nThreads)
+                            + " threads.");
     }
 #ifdef WITH_MSEED
     auto nMSEEDMessages = std::count(messageType.begin(),
@@ -436,13 +485,13 @@ void WaveRing::read()
     {
         pImpl->mLogger->error(
            "Need loop to unpack MSEED messages with msr_unpack");
-        for (int it = 0; it < static_cast<int> (messageWork.size()); ++it)
+        for (int it = 0; it < static_cast<int> (messageType.size()); ++it)
         {
             if (messageType[it] == pImpl->mMSEEDType)
             {
                 MS3Record *msr = nullptr;
-                auto size = messageWork[it].size();
-                msr3_parse(messageWork[it].data(), size, &msr, 1, 0);
+                msr3_parse(slab.data() + it*slotSize, messageSize[it],
+                           &msr, 1, 0);
                 msr3_free(&msr);
             }
         }
@@ -522,3 +571,35 @@ int WaveRing::getNumberOfTraceBuf2Messages() const noexcept
 {
     return static_cast<int> (pImpl->mTraceBuf2Messages.size());
 }
+
+/// Unpacking threads
+void WaveRing::setNumberOfUnpackThreads(const int nThreads)
+{
+    if (nThreads < 1)
+    {
+        throw std::invalid_argument("Number of threads must be positive");
+    }
+    pImpl->mNumberOfUnpackThreads = nThreads;
+    if (isConnected()){pImpl->mUnpackPool.start(nThreads - 1);}
+}
+
+int WaveRing::getNumberOfUnpackThreads() const noexcept
+{
+    return pImpl->mNumberOfUnpackThreads;
+}
+
+/// Read statistics
+int WaveRing::getNumberOfMessagesRead() const noexcept
+{
+    return pImpl->mNumberOfMessagesRead;
+}
+
+std::chrono::microseconds WaveRing::getCopyTime() const noexcept
+{
+    return pImpl->mCopyTime;
+}
+
+std::chrono::microseconds WaveRing::getUnpackTime() const noexcept
+{
+    return pImpl->mUnpackTime;
+}
@@ -4,6 +4,9 @@
 #include <thread>
 #include <filesystem>
 #include <mutex>
+#include <atomic>
+#include <set>
+#include <vector>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -45,6 +48,7 @@
 #include "urts/broadcasts/external/seedlink/streamSelector.hpp"
 #include "urts/broadcasts/utilities/dataPacketSanitizer.hpp"
 #include "private/isEmpty.hpp"
+#include "private/latencyStatistics.hpp"
 
  
 #define MODULE_NAME "broadcastSEEDLink"
@@ -69,10 +73,105 @@ namespace
     commands = commands + "   quit   Exits the program.\n";
     commands = commands + "   packetsSent     Number of packets sent in last minute.\n";
     commands = commands + "   packetsSkipped  Number of packets not forwarded in last minute.\n";
+    commands = commands + "   packetsDropped  Number of packets dropped because the SEEDLink queue was full.\n";
+    commands = commands + "   latency         Time from reading to publishing packets in last minute.\n";
     commands = commands + "   help   Displays this message.\n";
     return commands;
 }
 
+/// @result The SEEDLink client options in the given section of the
+///         initialization file.
+[[nodiscard]] URTS::Broadcasts::External::SEEDLink::ClientOptions
+    parseSEEDLinkOptions(const boost::property_tree::ptree &propertyTree,
+                         const std::string &section)
+{
+    URTS::Broadcasts::External::SEEDLink::ClientOptions clientOptions;
+    auto seedlinkAddress
+        = propertyTree.get<std::string> (section + ".address",
+                                         clientOptions.getAddress());
+    if (seedlinkAddress.empty())
+    {
+        throw std::runtime_error(section + ".address not set");
+    }
+    clientOptions.setAddress(seedlinkAddress);
+    auto seedlinkPort = clientOptions.getPort();
+    clientOptions.setPort(
+        propertyTree.get<int> (section + ".port", seedlinkPort)
+    );
+    for (int iSelector = 1; iSelector <= 32768; ++iSelector)
+    {
+        std::string selectorName{section + ".data_selector_"};
+        selectorName = selectorName + std::to_string(iSelector);
+        auto selectorString
+            = propertyTree.get_optional<std::string> (selectorName);
+        if (selectorString)
+        {
+            namespace UBES = URTS::Broadcasts::External::SEEDLink;
+            std::vector<std::string> splitSelectors;
+            boost::split(splitSelectors, *selectorString, boost::is_any_of(",|"));
+            for (const auto &thisSplitSelector : splitSelectors)
+            {
+                std::vector<std::string> thisSelector; 
+                auto splitSelector = thisSplitSelector;
+                boost::algorithm::trim(splitSelector);
+ 
+                boost::split(thisSelector, splitSelector, boost::is_any_of(" \t"));
+                UBES::StreamSelector selector;
+                if (splitSelector.empty())
+                {
+                    throw std::invalid_argument("Empty selector");
+                }
+                // Require a network
+                boost::algorithm::trim(thisSelector.at(0));
+                selector.setNetwork(thisSelector.at(0));
+                if (splitSelector.size() > 1)
+                {
+                    boost::algorithm::trim(thisSelector.at(1));
+                    selector.setStation(thisSelector.at(1));
+                }
+                std::string channel{"*"};
+                std::string locationCode{"??"};
+                if (splitSelector.size() > 2)
+                {
+                    boost::algorithm::trim(thisSelector.at(2));
+                    channel = thisSelector.at(2);
+                }
+                if (splitSelector.size() > 3)
+                { 
+                    boost::algorithm::trim(thisSelector.at(3));
+                    locationCode = thisSelector.at(3);
+                }
+                // Data type
+                UBES::StreamSelector::Type dataType{UBES::StreamSelector::Type::All};
+                if (splitSelector.size() > 4)
+                {
+                    boost::algorithm::trim(thisSelector.at(4));
+                    if (thisSelector.at(4) == "D")
+                    {
+                        dataType = UBES::StreamSelector::Type::Data;
+                    }
+                    else if (thisSelector.at(4) == "A")
+                    {
+                        dataType = UBES::StreamSelector::Type::All;
+                    }
+                    // TODO other data types
+                }
+                selector.setSelector(channel, locationCode, dataType);
+                clientOptions.addStreamSelector(selector);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+    // Connections to different servers need their own state files
+    auto stateFile
+        = propertyTree.get<std::string> (section + ".stateFile", "");
+    if (!stateFile.empty()){clientOptions.setStateFile(stateFile);}
+    return clientOptions;
+}
+
 }
 
 /// @brief Defines the module options.
@@ -140,98 +239,68 @@ struct ProgramOptions
 
         mBroadcastAddress
             = propertyTree.get<std::string> ("PublisherOptions.address", "");
+        mMaximumBatchSize
+            = propertyTree.get<int> ("PublisherOptions.maximumBatchSize",
+                                     mMaximumBatchSize);
+        if (mMaximumBatchSize < 1)
+        {
+            throw std::invalid_argument(
+                "PublisherOptions.maximumBatchSize must be positive");
+        }
+        auto maximumBatchAge = static_cast<int> (mMaximumBatchAge.count());
+        maximumBatchAge
+            = propertyTree.get<int> ("PublisherOptions.maximumBatchAge",
+                                     maximumBatchAge);
+        if (maximumBatchAge < 0)
+        {
+            throw std::invalid_argument(
+                "PublisherOptions.maximumBatchAge must be non-negative");
+        }
+        mMaximumBatchAge = std::chrono::milliseconds {maximumBatchAge};
+        mCompressSamples
+            = propertyTree.get<bool> ("PublisherOptions.compressSamples",
+                                      mCompressSamples);
         //----------------------------- SEEDLink ----------------------------//
-        auto seedlinkAddress = mSEEDLinkClientOptions.getAddress();
-        mSEEDLinkClientOptions.setAddress(
-            propertyTree.get<std::string> ("SEEDLink.address", seedlinkAddress)
-        );
-        if (seedlinkAddress.empty())
+        // The first server is in [SEEDLink].  Additional servers, which are
+        // each read on their own thread, are in [SEEDLink_2], [SEEDLink_3], ...
+        mSEEDLinkClientOptions.clear();
+        mSEEDLinkClientOptions.push_back(
+            ::parseSEEDLinkOptions(propertyTree, "SEEDLink"));
+        for (int iServer = 2; iServer <= 64; ++iServer)
         {
-            throw std::runtime_error("SEEDLink address not set");
+            auto section = "SEEDLink_" + std::to_string(iServer);
+            if (!propertyTree.get_child_optional(section)){break;}
+            mSEEDLinkClientOptions.push_back(
+                ::parseSEEDLinkOptions(propertyTree, section));
         }
-        auto seedlinkPort = mSEEDLinkClientOptions.getPort();
-        mSEEDLinkClientOptions.setPort(
-            propertyTree.get<int> ("SEEDLink.port", seedlinkPort)
-        );
-        for (int iSelector = 1; iSelector <= 32768; ++iSelector)
+        // Connections cannot share a state file
+        std::set<std::string> stateFiles;
+        for (const auto &clientOptions : mSEEDLinkClientOptions)
         {
-            std::string selectorName{"SEEDLink.data_selector_"};
-            selectorName = selectorName + std::to_string(iSelector);
-            auto selectorString
-                = propertyTree.get_optional<std::string> (selectorName);
-            if (selectorString)
+            if (!clientOptions.haveStateFile()){continue;}
+            if (!stateFiles.insert(clientOptions.getStateFile()).second)
             {
-                namespace UBES = URTS::Broadcasts::External::SEEDLink;
-                std::vector<std::string> splitSelectors;
-                boost::split(splitSelectors, *selectorString, boost::is_any_of(",|"));
-                for (const auto &thisSplitSelector : splitSelectors)
-                {
-                    std::vector<std::string> thisSelector; 
-                    auto splitSelector = thisSplitSelector;
-                    boost::algorithm::trim(splitSelector);
- 
-                    boost::split(thisSelector, splitSelector, boost::is_any_of(" \t"));
-                    UBES::StreamSelector selector;
-                    if (splitSelector.empty())
-                    {
-                        throw std::invalid_argument("Empty selector");
-                    }
-                    // Require a network
-                    boost::algorithm::trim(thisSelector.at(0));
-                    selector.setNetwork(thisSelector.at(0));
-                    if (splitSelector.size() > 1)
-                    {
-                        boost::algorithm::trim(thisSelector.at(1));
-                        selector.setStation(thisSelector.at(1));
-                    }
-                    std::string channel{"*"};
-                    std::string locationCode{"??"};
-                    if (splitSelector.size() > 2)
-                    {
-                        boost::algorithm::trim(thisSelector.at(2));
-                        channel = thisSelector.at(2);
-                    }
-                    if (splitSelector.size() > 3)
-                    { 
-                        boost::algorithm::trim(thisSelector.at(3));
-                        locationCode = thisSelector.at(3);
-                    }
-                    // Data type
-                    UBES::StreamSelector::Type dataType{UBES::StreamSelector::Type::All};
-                    if (splitSelector.size() > 4)
-                    {
-                        boost::algorithm::trim(thisSelector.at(4));
-                        if (thisSelector.at(4) == "D")
-                        {
-                            dataType = UBES::StreamSelector::Type::Data;
-                        }
-                        else if (thisSelector.at(4) == "A")
-                        {
-                            dataType = UBES::StreamSelector::Type::All;
-                        }
-                        // TODO other data types
-                    }
-                    selector.setSelector(channel, locationCode, dataType);
-                    mSEEDLinkClientOptions.addStreamSelector(selector);
-                }
-            }
-            else
-            {
-                break;
+                throw std::invalid_argument("SEEDLink state file "
+                                          + clientOptions.getStateFile()
+                                          + " is used more than once");
             }
         }
     }
     UAuth::ZAPOptions mZAPOptions;
-    URTS::Broadcasts::External::SEEDLink::ClientOptions mSEEDLinkClientOptions;
+    std::vector<URTS::Broadcasts::External::SEEDLink::ClientOptions>
+        mSEEDLinkClientOptions;
     std::string mModuleName{MODULE_NAME};
     std::string mDataPacketBroadcastName{"DataPacket"};
     std::string mBroadcastAddress{""};
+    std::chrono::milliseconds mMaximumBatchAge{100};
     std::string mHeartbeatBroadcastName{"Heartbeat"};
     std::filesystem::path mLogFileDirectory{"/var/log/urts"};
     std::chrono::seconds mHeartBeatInterval{30};
     std::chrono::seconds mExpirationTime{std::chrono::minutes {10}}; // 10 Minutes
     std::chrono::seconds mFutureTime{0}; // Do not allow data from future
     int mEarthwormWait{0};
+    int mMaximumBatchSize{1}; // Batching is opt-in
+    bool mCompressSamples{false}; // Compression is opt-in
     UMPS::Logging::Level mVerbosity{UMPS::Logging::Level::Info};
 };
 
@@ -263,24 +332,31 @@ public:
     BroadcastPackets(
         const std::string &moduleName, 
         std::unique_ptr<UDP::Publisher> &&packetPublisher,
-        std::unique_ptr<URTS::Broadcasts::External::SEEDLink::Client>
-             &&seedLink,
+        std::vector<std::unique_ptr<URTS::Broadcasts::External::SEEDLink::Client>>
+             &&seedLinkClients,
         std::shared_ptr<UMPS::Logging::ILog> &logger) :
         mPacketPublisher(std::move(packetPublisher)),
-        mSEEDLinkClient(std::move(seedLink)),
+        mSEEDLinkClients(std::move(seedLinkClients)),
         mLogger(logger)
     {
-        if (mSEEDLinkClient == nullptr)
+        if (mSEEDLinkClients.empty())
         {
-            throw std::invalid_argument("SEEDLink client is NULL");
+            throw std::invalid_argument("No SEEDLink clients");
         }
         if (mPacketPublisher == nullptr)
         {
             throw std::invalid_argument("Packet publisher is NULL");
         }
-        if (!mSEEDLinkClient->isInitialized())
+        for (const auto &seedLinkClient : mSEEDLinkClients)
         {
-            throw std::invalid_argument("SEEDLink client not initialized");
+            if (seedLinkClient == nullptr)
+            {
+                throw std::invalid_argument("SEEDLink client is NULL");
+            }
+            if (!seedLinkClient->isInitialized())
+            {
+                throw std::invalid_argument("SEEDLink client not initialized");
+            }
         }
         if (!mPacketPublisher->isInitialized())
         {
@@ -337,8 +413,12 @@ public:
     void stop() override
     {
         setRunning(false);
-        mSEEDLinkClient->stop();
-        if (mBroadcastThread.joinable()){mBroadcastThread.join();}
+        for (auto &seedLinkClient : mSEEDLinkClients){seedLinkClient->stop();}
+        for (auto &broadcastThread : mBroadcastThreads)
+        {
+            if (broadcastThread.joinable()){broadcastThread.join();}
+        }
+        mBroadcastThreads.clear();
         if (mLocalCommand != nullptr)
         {
             if (mLocalCommand->isRunning()){mLocalCommand->stop();}
@@ -353,23 +433,48 @@ public:
             throw std::runtime_error("Class not initialized");
         }
         setRunning(true);
-        mLogger->debug("Starting the SEEDLink client thread...");
-        mSEEDLinkClient->start();
-        mLogger->debug("Starting the broadcast thread...");
-        mBroadcastThread = std::thread(&BroadcastPackets::run,
-                                       this);
+        mNumberOfPacketsSent = 0;
+        mNumberOfPacketsSkipped = 0;
+        mPacketsSentInWindow = 0;
+        mPacketsSkippedInWindow = 0;
+        mLatency.clear();
+        mPacketMonitorStart = std::chrono::high_resolution_clock::now();
+        mLogger->debug("Starting the SEEDLink client threads...");
+        for (auto &seedLinkClient : mSEEDLinkClients){seedLinkClient->start();}
+        mLogger->debug("Starting the broadcast threads...");
+        for (size_t iClient = 0; iClient < mSEEDLinkClients.size(); ++iClient)
+        {
+            mBroadcastThreads.push_back(
+                std::thread(&BroadcastPackets::run, this, iClient));
+        }
         mLogger->debug("Starting the local command proxy...");
         mLocalCommand->start();
     }
+    /// @result The number of packets the SEEDLink clients dropped because
+    ///         their queues were full.
+    [[nodiscard]] uint64_t getNumberOfOverflowedPackets() const noexcept
+    {
+        uint64_t nOverflowed{0};
+        for (const auto &seedLinkClient : mSEEDLinkClients)
+        {
+            nOverflowed = nOverflowed
+                        + seedLinkClient->getNumberOfOverflowedPackets();
+        }
+        return nOverflowed;
+    }
     /// @result True indicates this is running.
     [[nodiscard]] bool isRunning() const noexcept override
     {
         return keepRunning();
     }
     /// @brief Reads EW messages and publishes them to an URTS broadcast
-    void run()
+    ///        There is one of these threads for each SEEDLink client.  The
+    ///        threads share the sanitizer, so packets that arrive from more
+    ///        than one server are only forwarded once, and the publisher.
+    void run(const size_t iClient)
     {
-        if (!mSEEDLinkClient->isInitialized())
+        const auto &seedLinkClient = mSEEDLinkClients.at(iClient);
+        if (!seedLinkClient->isInitialized())
         {
             throw std::runtime_error("SEEDLink client not yet initialized");
         }
@@ -377,14 +482,18 @@ public:
         { 
             throw std::runtime_error("Publisher not yet initialized");
         }
-        mLogger->debug("Earthworm broadcast thread is starting");
-        int numberOfPacketsSent = 0;
-        int numberOfPacketsSkipped = 0;
-        mNumberOfPacketsSent = 0;
-        mNumberOfPacketsSkipped = 0;
-        auto packetMonitorStart = std::chrono::high_resolution_clock::now();
+        mLogger->debug("SEEDLink broadcast thread "
+                     + std::to_string(iClient) + " is starting");
+        constexpr int maxPacketsPerDrain{1024};
+        // Reused so that a steady stream does not allocate
+        std::vector<UDP::DataPacket> packets;
+        std::vector<std::chrono::steady_clock::time_point> ingestTimes;
+        std::vector<std::chrono::steady_clock::time_point> sentIngestTimes;
         while (keepRunning())
         {
+            // Sleep until the SEEDLink reader has packets.  The time out
+            // lets us notice a stop request and update the counters.
+            seedLinkClient->waitForPackets(mMaximumWait);
             auto startClock = std::chrono::high_resolution_clock::now();
             auto startClockEpoch
                 = std::chrono::duration_cast<std::chrono::microseconds>
@@ -395,25 +504,26 @@ public:
             auto broadcastTimeEnd
                 = startClockEpoch
                 + std::chrono::microseconds {mFutureTime};
-            // Read from the earthworm ring
-            std::vector<UDP::DataPacket> packets;
-            // Send the packets off
-            bool getNextPacket = true;
-            while (getNextPacket)
+            // Drain what the SEEDLink reader has queued.  A full batch
+            // means more may be waiting so keep draining.
+            int nPackets{0};
+            do
             {
-                auto packet = mSEEDLinkClient->try_pop();
-                if (packet == nullptr)
-                {
-                    getNextPacket = false;
-                }
-                else
+                nPackets = seedLinkClient->getPackets(&packets,
+                                                      maxPacketsPerDrain,
+                                                      &ingestTimes);
+                if (nPackets == 0){break;}
+                // Send the packets off
+                std::lock_guard<std::mutex> publishLock(mPublishMutex);
+                for (int iPacket = 0; iPacket < nPackets; ++iPacket)
                 {
+                    auto &packet = packets[iPacket];
                     // Don't forward empty packets
-                    if (packet->getNumberOfSamples() < 1){continue;}
+                    if (packet.getNumberOfSamples() < 1){continue;}
                     bool allow = false;
                     try
                     {
-                        allow = mDataPacketSanitizer->allow(*packet);
+                        allow = mDataPacketSanitizer->allow(packet);
                     }
                     catch (const std::exception &e)
                     {
@@ -426,18 +536,20 @@ public:
                     {
                         try
                         {
-                            mPacketPublisher->send(*packet);
-                            numberOfPacketsSent = numberOfPacketsSent + 1;
+                            mPacketPublisher->send(std::move(packet));
+                            mPacketsSentInWindow = mPacketsSentInWindow + 1;
+                            sentIngestTimes.push_back(ingestTimes[iPacket]);
                         }
                         catch (const std::exception &e)
                         {
-                            numberOfPacketsSkipped = numberOfPacketsSkipped + 1;
+                            mPacketsSkippedInWindow
+                                = mPacketsSkippedInWindow + 1;
                             mLogger->error("Failed to publish packet");
                         }
                     }
                     else
                     {
-                        numberOfPacketsSkipped = numberOfPacketsSkipped + 1;
+                        mPacketsSkippedInWindow = mPacketsSkippedInWindow + 1;
                     }
 /*
                     try
@@ -480,33 +592,45 @@ public:
                     }
 */
                 }
-            }
-            // Update
-            auto endClock = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>
-                            (endClock - startClock);
-            if (duration < mBroadcastInterval)
+            } while (nPackets == maxPacketsPerDrain && keepRunning());
+            // Don't hold a partial batch while waiting on SEEDLink
+            std::lock_guard<std::mutex> publishLock(mPublishMutex);
+            if (!sentIngestTimes.empty())
             {
-                auto wait = mBroadcastInterval - duration;
-                std::this_thread::sleep_for(wait);
-            }
-            else
-            {
-                startClock = endClock;
+                try
+                {
+                    mPacketPublisher->flush();
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("Failed to publish packet batch");
+                }
+                // The packets are out so tally how long they were held
+                auto publishTime = std::chrono::steady_clock::now();
+                for (const auto &ingestTime : sentIngestTimes)
+                {
+                    mLatency.add(
+                       std::chrono::duration_cast<std::chrono::microseconds>
+                       (publishTime - ingestTime));
+                }
+                sentIngestTimes.clear();
             }
             // Update my packets sent counter
-            duration = std::chrono::duration_cast<std::chrono::seconds>
-                       (endClock - packetMonitorStart);
+            auto endClock = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::seconds>
+                            (endClock - mPacketMonitorStart);
             if (duration > std::chrono::seconds {60})
             {
-                mNumberOfPacketsSent = numberOfPacketsSent;
-                mNumberOfPacketsSkipped = numberOfPacketsSkipped;
-                numberOfPacketsSent = 0;
-                numberOfPacketsSkipped = 0;
-                packetMonitorStart = endClock;
+                mNumberOfPacketsSent = mPacketsSentInWindow;
+                mNumberOfPacketsSkipped = mPacketsSkippedInWindow;
+                mLatency.endWindow();
+                mPacketsSentInWindow = 0;
+                mPacketsSkippedInWindow = 0;
+                mPacketMonitorStart = endClock;
             }
         }
-        mLogger->debug("Earthworm broadcast thread is terminating");
+        mLogger->debug("SEEDLink broadcast thread "
+                     + std::to_string(iClient) + " is terminating");
     }
     // Callback for local interaction
     std::unique_ptr<UMPS::MessageFormats::IMessage>
@@ -593,6 +717,24 @@ public:
                 response.setReturnCode(
                     USC::CommandResponse::ReturnCode::Success);
             }
+            else if (command == "packetsDropped")
+            {
+                mLogger->debug("Issuing packetsDropped command...");
+                response.setResponse(
+                    "Number of packets dropped since start: "
+                    + std::to_string(getNumberOfOverflowedPackets()));
+                response.setReturnCode(
+                    USC::CommandResponse::ReturnCode::Success);
+            }
+            else if (command == "latency")
+            {
+                mLogger->debug("Issuing latency command...");
+                response.setResponse(
+                    "Read to publish latency in last minute: "
+                    + mLatency.toString());
+                response.setReturnCode(
+                    USC::CommandResponse::ReturnCode::Success);
+            }
             else
             {
                 response.setResponse(getInputOptions());
@@ -621,19 +763,29 @@ public:
         return commandsResponse.clone();
     }
     mutable std::mutex mMutex;
-    std::thread mBroadcastThread;
+    /// One forwarding thread per SEEDLink client.
+    std::vector<std::thread> mBroadcastThreads;
     std::unique_ptr<UDP::Publisher> mPacketPublisher{nullptr};
-    std::unique_ptr<URTS::Broadcasts::External::SEEDLink::Client>
-         mSEEDLinkClient{nullptr};
+    std::vector<std::unique_ptr<URTS::Broadcasts::External::SEEDLink::Client>>
+         mSEEDLinkClients;
     std::unique_ptr<UMPS::Services::Command::Service> mLocalCommand{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
     std::unique_ptr<URTS::Broadcasts::Utilities::DataPacketSanitizer>
          mDataPacketSanitizer{nullptr};
-    std::chrono::seconds mBroadcastInterval{1};
+    /// The longest the broadcast thread waits on the SEEDLink reader
+    /// before checking whether it should stop.
+    std::chrono::milliseconds mMaximumWait{100};
+    ::LatencyStatistics mLatency;
     std::chrono::seconds mExpirationTime{std::chrono::minutes {10}}; // 10 Minutes
     std::chrono::seconds mFutureTime{0}; // Do not allow data from future
-    int mNumberOfPacketsSent{0};
-    int mNumberOfPacketsSkipped{0};
+    /// Serializes the forwarding threads' access to the sanitizer, the
+    /// publisher, and the statistics below.
+    std::mutex mPublishMutex;
+    std::chrono::high_resolution_clock::time_point mPacketMonitorStart;
+    int mPacketsSentInWindow{0};
+    int mPacketsSkippedInWindow{0};
+    std::atomic<int> mNumberOfPacketsSent{0};
+    std::atomic<int> mNumberOfPacketsSkipped{0};
     bool mKeepRunning{true};
     bool mInitialized{false};
 };
@@ -702,26 +854,44 @@ int main(int argc, char *argv[])
                      programOptions.mDataPacketBroadcastName).getAddress();
             programOptions.mBroadcastAddress = packetAddress;
         }
-        // Create the SEEDLink client
-        auto seedLinkClient
-            = std::make_unique<URTS::Broadcasts::External::SEEDLink::Client>
-              (logger);
-        seedLinkClient->initialize(programOptions.mSEEDLinkClientOptions);
+        // Create a SEEDLink client for each server
+        std::vector<std::unique_ptr<URTS::Broadcasts::External::SEEDLink::Client>>
+            seedLinkClients;
+        for (const auto &clientOptions : programOptions.mSEEDLinkClientOptions)
+        {
+            logger->debug("Connecting to SEEDLink server "
+                        + clientOptions.getAddress() + ":"
+                        + std::to_string(clientOptions.getPort()));
+            auto seedLinkClient
+                = std::make_unique<URTS::Broadcasts::External::SEEDLink::Client>
+                  (logger);
+            seedLinkClient->initialize(clientOptions);
 #ifndef NDEBUG
-        assert(seedLinkClient->isInitialized());
+            assert(seedLinkClient->isInitialized());
 #endif
+            seedLinkClients.push_back(std::move(seedLinkClient));
+        }
         // Create the publisher
         UDP::PublisherOptions packetPublisherOptions;
         auto packetPublisher
             = std::make_unique<UDP::Publisher> (context, logger);
         packetPublisherOptions.setAddress(programOptions.mBroadcastAddress);
         packetPublisherOptions.setZAPOptions(programOptions.mZAPOptions);
+        packetPublisherOptions.setMaximumBatchSize(
+            programOptions.mMaximumBatchSize);
+        packetPublisherOptions.setMaximumBatchAge(
+            programOptions.mMaximumBatchAge);
+        if (programOptions.mCompressSamples)
+        {
+            packetPublisherOptions.setSampleEncoding(
+                UDP::DataPacket::Encoding::IntegerDelta);
+        }
         packetPublisher->initialize(packetPublisherOptions);
 
         auto broadcastProcess 
             = std::make_unique<BroadcastPackets> (programOptions.mModuleName,
                                                   std::move(packetPublisher), 
-                                                  std::move(seedLinkClient),
+                                                  std::move(seedLinkClients),
                                                   logger);
         broadcastProcess->mExpirationTime = programOptions.mExpirationTime;
         broadcastProcess->mFutureTime = programOptions.mFutureTime;
@@ -1,10 +1,11 @@
 #include <thread>
 #include <array>
 #include <mutex>
+#include <chrono>
 #include <cmath>
 #include <string>
 #include <cstring>
-#include <queue>
+#include <limits>
 #include <umps/logging/standardOut.hpp>
 #include <libmseed.h>
 #include <libslink.h>
@@ -17,6 +18,7 @@
 #include "urts/broadcasts/external/seedlink/streamSelector.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "urts/version.hpp"
+#include "private/packetHandoff.hpp"
 
 using namespace URTS::Broadcasts::External::SEEDLink;
 namespace UDataPacket = URTS::Broadcasts::Internal::DataPacket;
@@ -206,6 +208,8 @@ public:
             throw std::runtime_error("SEEDLink client not initialized");
         }
         setRunning(true);
+        // Reset the queue before the reader thread starts producing
+        clearQueue();
         mLogger->debug("Starting the SEEDLink polling thread...");
 #if LIBSLINK_VERSION_MAJOR >= 4
         mSEEDLinkConnection->terminate = 0;
@@ -218,8 +222,6 @@ public:
 #if LIBSLINK_VERSION_MAJOR < 4
     void scrapePackets()
     {
-        // Reset the queue
-        clearQueue();
         // Recover state
         if (mUseStateFile)
         {
@@ -286,8 +288,6 @@ public:
 #else
     void scrapePackets()
     {   
-        // Reset the queue
-        clearQueue();
         // Recover state
         if (mUseStateFile)
         {
@@ -375,64 +375,59 @@ public:
         mLogger->debug("Thread leaving SEEDLink polling loop");
     }               
 #endif
-    /// Update the queue
+    /// Update the queue.  This is only called by the SEEDLink reader thread.
     void addPacket(UDataPacket::DataPacket &&dataPacket)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
-        if (mDataPackets.size() > mMaximumQueueSize)
+        QueuedPacket queuedPacket{std::move(dataPacket),
+                                  std::chrono::steady_clock::now()};
+        if (!mDataPackets.try_push(std::move(queuedPacket)))
         {
-            mDataPackets.pop();
+            // The consumer is not keeping up so the newest packet is dropped
+            auto nOverflowed = mDataPackets.getNumberOfOverflowedValues();
+            if (nOverflowed == 1 || nOverflowed%1000 == 0)
+            {
+                mLogger->warn("SEEDLink packet queue full; "
+                            + std::to_string(nOverflowed)
+                            + " packets dropped");
+            }
         }
-        mDataPackets.push(std::move(dataPacket));
     }
-    /// Reset queue
+    /// Reset queue.  This must not be called while the reader thread is
+    /// running or another thread is getting packets.
     void clearQueue()
     {
-        std::lock_guard<std::mutex> lock(mMutex);
-        std::queue<UDataPacket::DataPacket> ().swap(mDataPackets);
+        mDataPackets.clear();
     }
     /// Get the latest batch of packets
-    [[nodiscard]] std::vector<UDataPacket::DataPacket> getPackets() const
+    void getPackets(std::vector<UDataPacket::DataPacket> *packets,
+                    std::vector<std::chrono::steady_clock::time_point>
+                        *ingestTimes,
+                    const size_t maxPackets) const
     {
-        std::vector<UDataPacket::DataPacket> result;
-        std::lock_guard<std::mutex> lock(mMutex);
-        result.reserve(mDataPackets.size());
-        while (!mDataPackets.empty())
+        mScratch.clear();
+        mDataPackets.pop_all(&mScratch, maxPackets);
+        for (auto &queuedPacket : mScratch)
         {
-            result.push_back(std::move(mDataPackets.front()));
-            mDataPackets.pop();
+            packets->push_back(std::move(queuedPacket.packet));
+            if (ingestTimes != nullptr)
+            {
+                ingestTimes->push_back(queuedPacket.ingestTime);
+            }
         }
-        return result;
-    } 
-    /// @brief A container with the value at the front of the queue provided
-    ///        that the queue is not empty.  If the queue is not empty then
-    ///        then this value is removed from the front. 
-    /// @result The value at the front of the queue or a nullptr if the queue
-    ///         was empty. 
-    [[nodiscard]] std::shared_ptr<UDataPacket::DataPacket> try_pop()
+    }
+    /// Block until the queue has packets or the time out elapses
+    [[nodiscard]] bool waitForPackets(const std::chrono::milliseconds &timeOut) const
     {
-        std::lock_guard<std::mutex> lockGuard(mMutex);
-        std::shared_ptr<UDataPacket::DataPacket> result;
-        if (mDataPackets.empty())
-        {
-            result = nullptr;
-            return result;
-        }
-        result
-            = std::make_shared<UDataPacket::DataPacket> (mDataPackets.front());
-        mDataPackets.pop();
-        return result;
+        return mDataPackets.waitFor(timeOut);
     }
     /// @result True indicates that the queue is empty.
     [[nodiscard]] bool empty() const
-    {   
-        std::lock_guard<std::mutex> lockGuard(mMutex);
+    {
         return mDataPackets.empty();
-    }   
+    }
     /// @result The number of elements in the queue.
     [[nodiscard]] size_t size() const
     {
-        std::lock_guard<std::mutex> lockGuard(mMutex);
         return mDataPackets.size();
     }
 //private:
@@ -441,7 +436,16 @@ public:
     SLCD *mSEEDLinkConnection{nullptr};
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr}; 
     ClientOptions mOptions;
-    mutable std::queue<UDataPacket::DataPacket> mDataPackets;
+    /// A packet and the time the reader thread queued it.
+    struct QueuedPacket
+    {
+        UDataPacket::DataPacket packet;
+        std::chrono::steady_clock::time_point ingestTime;
+    };
+    /// Hands packets from the SEEDLink reader thread to the consumer.
+    mutable ::PacketHandoff<QueuedPacket> mDataPackets;
+    /// The consumer's workspace for draining the ring.
+    mutable std::vector<QueuedPacket> mScratch;
     /*
     const std::array<std::string, 10> PacketType{ "Data",
                                                   "Detection",
@@ -489,7 +493,6 @@ bool Client::isInitialized() const noexcept
 void Client::initialize(const ClientOptions &options)
 {
     pImpl->disconnect(); // Hangup first
-    pImpl->clearQueue(); // Release queue
     pImpl->mInitialized = false;
     // Create a new instance
 #if LIBSLINK_VERSION_MAJOR < 4
@@ -521,6 +524,7 @@ void Client::initialize(const ClientOptions &options)
     // Queue size
     pImpl->mMaximumQueueSize
         = static_cast<size_t> (options.getMaximumInternalQueueSize());
+    pImpl->mDataPackets.setCapacity(pImpl->mMaximumQueueSize);
     // If there are selectors then try to use them
     const char *timeStamp{nullptr};
     auto streamSelectors = options.getStreamSelectors();
@@ -667,7 +671,42 @@ void Client::stop()
 /// Gets the packets
 std::vector<UDataPacket::DataPacket> Client::getPackets() const
 {
-    return pImpl->getPackets();
+    std::vector<UDataPacket::DataPacket> result;
+    result.reserve(size());
+    pImpl->getPackets(&result, nullptr, std::numeric_limits<size_t>::max());
+    return result;
+}
+
+int Client::getPackets(std::vector<UDataPacket::DataPacket> *packets,
+                       const int maxPackets,
+                       std::vector<std::chrono::steady_clock::time_point>
+                           *ingestTimes) const
+{
+    if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
+    if (maxPackets < 1)
+    {
+        throw std::invalid_argument("maxPackets must be positive");
+    }
+    packets->clear();
+    if (ingestTimes != nullptr){ingestTimes->clear();}
+    pImpl->getPackets(packets, ingestTimes, static_cast<size_t> (maxPackets));
+    return static_cast<int> (packets->size());
+}
+
+/// Wait for packets
+bool Client::waitForPackets(const std::chrono::milliseconds &timeOut) const
+{
+    if (timeOut.count() < 0)
+    {
+        throw std::invalid_argument("timeOut cannot be negative");
+    }
+    return pImpl->waitForPackets(timeOut);
+}
+
+/// Overflowed packets
+uint64_t Client::getNumberOfOverflowedPackets() const noexcept
+{
+    return pImpl->mDataPackets.getNumberOfOverflowedValues();
 }
 
 /// Empty?
@@ -681,8 +720,3 @@ size_t Client::size() const
 {
     return pImpl->size();
 }
-
-std::shared_ptr<UDataPacket::DataPacket> Client::try_pop()
-{
-    return pImpl->try_pop();
-}
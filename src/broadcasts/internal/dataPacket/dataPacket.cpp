@@ -1,14 +1,23 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <bit>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "private/isEmpty.hpp"
+#include "private/sampleCodec.hpp"
 
 #define MESSAGE_TYPE "URTS::Broadcasts::Internal::DataPacket::DataPacket"
-#define MESSAGE_VERSION "1.0.0"
+#define MESSAGE_VERSION "2.1.0"
 
 using namespace URTS::Broadcasts::Internal::DataPacket;
 
@@ -80,11 +89,88 @@ void fromCBORMessage(const uint8_t *message, const size_t length,
     objectToDataPacket(obj, packet);
 }
 
+/// @brief The binary wire format.  Version 1.0.0 messages are CBOR and are
+///        still accepted on decode.  All numbers are little-endian.
+///          Offset  Type      Contents
+///          0       char[4]   "URDP"
+///          4       uint8     The message's major version
+///          5       uint8[4]  The network, station, channel, and location
+///                            code lengths
+///          9       uint8     The sample encoding (see DataPacket::Encoding)
+///          10      uint8[2]  Reserved (0)
+///          12      uint32    Number of samples
+///          16      int64     Start time (UTC microseconds)
+///          24      float64   Sampling rate (Hz)
+///          32      char[]    The network, station, channel, and location
+///                            code
+///          ...     -         The samples.  These are float64's or, for
+///                            the integer delta encoding, variable length
+///                            integers that fill the rest of the message.
+constexpr std::array<char, 4> BINARY_MAGIC{'U', 'R', 'D', 'P'};
+constexpr uint8_t BINARY_VERSION{2};
+constexpr size_t BINARY_HEADER_SIZE{32};
+
+template<typename T>
+void writeLittleEndian(const T value, char *destination) noexcept
+{
+    auto bits = std::bit_cast<std::array<char, sizeof(T)>> (value);
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    std::memcpy(destination, bits.data(), sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] T readLittleEndian(const uint8_t *source) noexcept
+{
+    std::array<char, sizeof(T)> bits;
+    std::memcpy(bits.data(), source, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    return std::bit_cast<T> (bits);
+}
+
+/// @result True indicates the message is in the binary format.
+[[nodiscard]] bool isBinaryMessage(const uint8_t *message,
+                                   const size_t length) noexcept
+{
+    if (length < BINARY_MAGIC.size()){return false;}
+    return std::memcmp(message, BINARY_MAGIC.data(),
+                       BINARY_MAGIC.size()) == 0;
+}
+
+/// @result The length of the name as stored in the binary header.
+[[nodiscard]] uint8_t checkNameLength(const std::string &name)
+{
+    if (name.size() > std::numeric_limits<uint8_t>::max())
+    {
+        throw std::invalid_argument("Name " + name + " is too long");
+    }
+    return static_cast<uint8_t> (name.size());
+}
+
 }
 
 class DataPacket::DataPacketImpl
 {
 public:
+    /// Resets the packet but retains the storage
+    void clear() noexcept
+    {
+        mData.clear();
+        mNetwork.clear();
+        mStation.clear();
+        mChannel.clear();
+        mLocationCode.clear();
+        constexpr std::chrono::microseconds zeroMuS{0};
+        mStartTimeMicroSeconds = zeroMuS;
+        mEndTimeMicroSeconds = zeroMuS;
+        mSamplingRate = 0;
+        mEncoding = DataPacket::Encoding::Float64;
+    }
     void updateEndTime()
     {
         mEndTimeMicroSeconds = mStartTimeMicroSeconds;
@@ -108,25 +194,168 @@ public:
     /// End time in microseconds (10e-6)
     std::chrono::microseconds mEndTimeMicroSeconds{0};
     double mSamplingRate{0};
+    DataPacket::Encoding mEncoding{DataPacket::Encoding::Float64};
 };
 
+namespace
+{
+
+/// @brief Recycles packet implementations.  A released implementation keeps
+///        its string and sample capacity so, once the pool is warm, packets
+///        of a steady stream are created, filled, and destroyed without
+///        touching the heap.
+/// @note Each thread keeps its own free list in front of the shared one and
+///       moves implementations to and from the shared list in batches.  The
+///       lock is therefore taken once per batch rather than once per packet.
+template<typename Impl>
+class DataPacketImplPool
+{
+public:
+    DataPacketImplPool()
+    {
+        mFree.reserve(MAXIMUM_POOL_SIZE);
+    }
+    /// @result The pool.  This is intentionally never destroyed so packets
+    ///         with static storage duration can be safely released.
+    [[nodiscard]] static DataPacketImplPool &instance()
+    {
+        static auto *pool = new DataPacketImplPool();
+        return *pool;
+    }
+    /// @result An empty implementation.
+    [[nodiscard]] Impl *acquire()
+    {
+        auto cache = localCache();
+        if (cache != nullptr)
+        {
+            if (cache->mFree.empty()){takeBatch(&cache->mFree);}
+            if (!cache->mFree.empty())
+            {
+                auto impl = cache->mFree.back();
+                cache->mFree.pop_back();
+                return impl;
+            }
+            return new Impl();
+        }
+        {
+        std::scoped_lock lock(mMutex);
+        if (!mFree.empty())
+        {
+            auto impl = mFree.back();
+            mFree.pop_back();
+            return impl;
+        }
+        }
+        return new Impl();
+    }
+    /// @brief Clears the implementation and returns it to the pool.
+    void release(Impl *impl) noexcept
+    {
+        impl->clear();
+        // Do not hoard unusually large sample buffers
+        if (impl->mData.capacity() > MAXIMUM_RETAINED_SAMPLES)
+        {
+            std::vector<double> ().swap(impl->mData);
+        }
+        auto cache = localCache();
+        if (cache != nullptr)
+        {
+            cache->mFree.push_back(impl); // Capacity is reserved
+            if (cache->mFree.size() > 2*BATCH_SIZE)
+            {
+                giveBatch(&cache->mFree, BATCH_SIZE);
+            }
+            return;
+        }
+        {
+        std::scoped_lock lock(mMutex);
+        if (mFree.size() < MAXIMUM_POOL_SIZE)
+        {
+            mFree.push_back(impl);
+            return;
+        }
+        }
+        delete impl;
+    }
+private:
+    /// @brief A thread's free list.  When the thread exits its
+    ///        implementations are handed back to the shared list.
+    class LocalCache
+    {
+    public:
+        explicit LocalCache(bool *destroyed) :
+            mDestroyed(destroyed)
+        {
+            mFree.reserve(2*BATCH_SIZE + 1);
+        }
+        ~LocalCache()
+        {
+            instance().giveBatch(&mFree, mFree.size());
+            *mDestroyed = true;
+        }
+        LocalCache(const LocalCache &) = delete;
+        LocalCache& operator=(const LocalCache &) = delete;
+        std::vector<Impl *> mFree;
+        bool *mDestroyed{nullptr};
+    };
+    /// @result This thread's free list or a nullptr if the thread is exiting
+    ///         and the list has been destroyed.
+    [[nodiscard]] static LocalCache *localCache() noexcept
+    {
+        // The flag is trivially destructible so it can be read after the
+        // cache is gone, e.g., when a thread-local packet is released.
+        thread_local bool destroyed{false};
+        if (destroyed){return nullptr;}
+        thread_local LocalCache cache{&destroyed};
+        return &cache;
+    }
+    /// @brief Moves up to a batch from the shared list to the given list.
+    void takeBatch(std::vector<Impl *> *local)
+    {
+        std::scoped_lock lock(mMutex);
+        auto nMove = std::min(BATCH_SIZE, mFree.size());
+        local->insert(local->end(), mFree.end() - nMove, mFree.end());
+        mFree.resize(mFree.size() - nMove);
+    }
+    /// @brief Moves the last n implementations in the given list to the
+    ///        shared list.  Whatever does not fit is deleted.
+    void giveBatch(std::vector<Impl *> *local, const size_t n) noexcept
+    {
+        auto first = local->end() - static_cast<std::ptrdiff_t> (n);
+        {
+        std::scoped_lock lock(mMutex);
+        auto nMove = std::min(n, MAXIMUM_POOL_SIZE - mFree.size());
+        mFree.insert(mFree.end(), first, first + nMove);
+        first = first + nMove;
+        }
+        for (auto it = first; it != local->end(); ++it){delete *it;}
+        local->resize(local->size() - n);
+    }
+    std::mutex mMutex;
+    std::vector<Impl *> mFree;
+    static constexpr size_t MAXIMUM_POOL_SIZE{1024};
+    static constexpr size_t MAXIMUM_RETAINED_SAMPLES{2048};
+    static constexpr size_t BATCH_SIZE{32};
+};
+
+}
+
+/// Release to pool
+void DataPacket::DataPacketImplDeleter::operator()(
+    DataPacketImpl *impl) const noexcept
+{
+    DataPacketImplPool<DataPacketImpl>::instance().release(impl);
+}
+
 /// Clear class
 void DataPacket::clear() noexcept
 {
-    pImpl->mData.clear();
-    pImpl->mNetwork.clear();
-    pImpl->mStation.clear();
-    pImpl->mChannel.clear();
-    pImpl->mLocationCode.clear();
-    constexpr std::chrono::microseconds zeroMuS{0};
-    pImpl->mStartTimeMicroSeconds = zeroMuS;
-    pImpl->mEndTimeMicroSeconds = zeroMuS;
-    pImpl->mSamplingRate = 0;
+    pImpl->clear();
 }
 
 /// C'tor
 DataPacket::DataPacket() :
-    pImpl(std::make_unique<DataPacketImpl> ())
+    pImpl(DataPacketImplPool<DataPacketImpl>::instance().acquire())
 {
 }
 
@@ -146,7 +375,12 @@ DataPacket::DataPacket(DataPacket &&packet) noexcept
 DataPacket& DataPacket::operator=(const DataPacket &packet)
 {
     if (&packet == this){return *this;}
-    pImpl = std::make_unique<DataPacketImpl> (*packet.pImpl);
+    if (pImpl == nullptr)
+    {
+        pImpl.reset(DataPacketImplPool<DataPacketImpl>::instance().acquire());
+    }
+    // Copying member-wise reuses this packet's storage
+    *pImpl = *packet.pImpl;
     return *this;
 }
 
@@ -154,7 +388,10 @@ DataPacket& DataPacket::operator=(const DataPacket &packet)
 DataPacket& DataPacket::operator=(DataPacket &&packet) noexcept
 {
     if (&packet == this){return *this;}
-    pImpl = std::move(packet.pImpl);
+    // Trade storage so that the storage of this packet is recycled rather
+    // than freed
+    std::swap(pImpl, packet.pImpl);
+    if (packet.pImpl != nullptr){packet.clear();}
     return *this;
 }
 
@@ -168,7 +405,7 @@ void DataPacket::setNetwork(const std::string &network)
     pImpl->mNetwork = network;
 }
 
-std::string DataPacket::getNetwork() const
+const std::string &DataPacket::getNetwork() const
 {
     if (!haveNetwork()){throw std::runtime_error("Network not set yet");}
     return pImpl->mNetwork;
@@ -186,7 +423,7 @@ void DataPacket::setStation(const std::string &station)
     pImpl->mStation = station;
 }
 
-std::string DataPacket::getStation() const
+const std::string &DataPacket::getStation() const
 {
     if (!haveStation()){throw std::runtime_error("Station not set yet");}
     return pImpl->mStation;
@@ -204,7 +441,7 @@ void DataPacket::setChannel(const std::string &channel)
     pImpl->mChannel = channel;
 }
 
-std::string DataPacket::getChannel() const
+const std::string &DataPacket::getChannel() const
 {
     if (!haveChannel()){throw std::runtime_error("Channel not set yet");}
     return pImpl->mChannel;
@@ -222,7 +459,7 @@ void DataPacket::setLocationCode(const std::string &location)
     pImpl->mLocationCode = location;
 }
 
-std::string DataPacket::getLocationCode() const
+const std::string &DataPacket::getLocationCode() const
 {
     if (!haveLocationCode())
     {
@@ -266,6 +503,17 @@ int DataPacket::getNumberOfSamples() const noexcept
     return static_cast<int> (pImpl->mData.size());
 }
 
+/// Encoding
+void DataPacket::setEncoding(const Encoding encoding) noexcept
+{
+    pImpl->mEncoding = encoding;
+}
+
+DataPacket::Encoding DataPacket::getEncoding() const noexcept
+{
+    return pImpl->mEncoding;
+}
+
 /// Start time
 void DataPacket::setStartTime(const double startTime) noexcept
 {
@@ -368,7 +616,12 @@ std::unique_ptr<UMPS::MessageFormats::IMessage>
 ///  Convert message
 std::string DataPacket::toMessage() const
 {
-    return toCBOR();
+    return toBinary();
+}
+
+void DataPacket::serializeInto(std::string *buffer) const
+{
+    toBinary(buffer);
 }
 
 void DataPacket::fromMessage(const std::string &message)
@@ -380,7 +633,14 @@ void DataPacket::fromMessage(const std::string &message)
 void DataPacket::fromMessage(const char *messageIn, const size_t length)
 {
     auto message = reinterpret_cast<const uint8_t *> (messageIn);
-    fromCBOR(message, length);
+    if (message != nullptr && ::isBinaryMessage(message, length))
+    {
+        fromBinary(message, length);
+    }
+    else
+    {
+        fromCBOR(message, length); // Version 1 messages
+    }
 }
 
 /// From CBOR
@@ -401,6 +661,203 @@ void DataPacket::fromCBOR(const uint8_t *data, const size_t length)
     *this = std::move(packet);
 }
 
+/// To binary
+void DataPacket::toBinary(std::string *message) const
+{
+    toBinary(message, pImpl->mEncoding);
+}
+
+void DataPacket::toBinary(std::string *message, const Encoding encoding) const
+{
+    if (message == nullptr){throw std::invalid_argument("message is NULL");}
+    const auto &network = getNetwork();
+    const auto &station = getStation();
+    const auto &channel = getChannel();
+    const auto &locationCode = getLocationCode();
+    auto samplingRate = getSamplingRate();
+    std::array<uint8_t, 4> lengths{::checkNameLength(network),
+                                   ::checkNameLength(station),
+                                   ::checkNameLength(channel),
+                                   ::checkNameLength(locationCode)};
+    const auto &data = pImpl->mData;
+    if (data.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::invalid_argument("Too many samples");
+    }
+    auto nNameBytes = static_cast<size_t> (lengths[0]) + lengths[1]
+                    + lengths[2] + lengths[3];
+    auto nSamples = static_cast<int> (data.size());
+    auto sampleOffset = ::BINARY_HEADER_SIZE + nNameBytes;
+    auto rawSize = sampleOffset + sizeof(double)*data.size();
+    // Try to compress integer samples.  The varints are appended straight
+    // into the message so a reused buffer does not reallocate.
+    auto wireEncoding = Encoding::Float64;
+    if (encoding == Encoding::IntegerDelta &&
+        ::isIntegral(data.data(), nSamples))
+    {
+        message->resize(sampleOffset);
+        ::appendIntegerDeltas(data.data(), nSamples, message);
+        if (message->size() < rawSize){wireEncoding = Encoding::IntegerDelta;}
+    }
+    // Resizing a reused buffer does not reallocate
+    if (wireEncoding == Encoding::Float64){message->resize(rawSize);}
+    auto *destination = message->data();
+    std::memcpy(destination, ::BINARY_MAGIC.data(), ::BINARY_MAGIC.size());
+    destination[4] = static_cast<char> (::BINARY_VERSION);
+    std::memcpy(destination + 5, lengths.data(), lengths.size());
+    destination[9] = static_cast<char> (wireEncoding);
+    std::memset(destination + 10, 0, 2);
+    ::writeLittleEndian(static_cast<uint32_t> (data.size()), destination + 12);
+    ::writeLittleEndian(static_cast<int64_t> (getStartTime().count()),
+                        destination + 16);
+    ::writeLittleEndian(samplingRate, destination + 24);
+    destination = destination + ::BINARY_HEADER_SIZE;
+    for (const auto *name : {&network, &station, &channel, &locationCode})
+    {
+        std::memcpy(destination, name->data(), name->size());
+        destination = destination + name->size();
+    }
+    if (wireEncoding == Encoding::IntegerDelta){return;}
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        if (!data.empty())
+        {
+            std::memcpy(destination, data.data(), sizeof(double)*data.size());
+        }
+    }
+    else
+    {
+        for (const auto &x : data)
+        {
+            ::writeLittleEndian(x, destination);
+            destination = destination + sizeof(double);
+        }
+    }
+}
+
+std::string DataPacket::toBinary() const
+{
+    std::string message;
+    toBinary(&message);
+    return message;
+}
+
+/// From binary
+void DataPacket::fromBinary(const uint8_t *data, const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr){throw std::invalid_argument("data is NULL");}
+    if (length < ::BINARY_HEADER_SIZE || !::isBinaryMessage(data, length))
+    {
+        throw std::runtime_error("Message is not a binary data packet");
+    }
+    if (data[4] != ::BINARY_VERSION)
+    {
+        throw std::runtime_error("Unsupported binary data packet version "
+                               + std::to_string(data[4]));
+    }
+    const auto *lengths = data + 5;
+    auto nSamples = ::readLittleEndian<uint32_t> (data + 12);
+    auto startTime = ::readLittleEndian<int64_t> (data + 16);
+    auto samplingRate = ::readLittleEndian<double> (data + 24);
+    auto nNameBytes = static_cast<size_t> (lengths[0]) + lengths[1]
+                    + lengths[2] + lengths[3];
+    auto encoding = static_cast<Encoding> (data[9]);
+    if (encoding == Encoding::Float64)
+    {
+        if (length != ::BINARY_HEADER_SIZE + nNameBytes
+                    + sizeof(double)*static_cast<size_t> (nSamples))
+        {
+            throw std::runtime_error("Binary data packet has invalid length");
+        }
+    }
+    else if (encoding == Encoding::IntegerDelta)
+    {
+        // Every sample takes at least one byte so a corrupt count cannot
+        // trigger a huge allocation
+        if (length < ::BINARY_HEADER_SIZE + nNameBytes ||
+            length - ::BINARY_HEADER_SIZE - nNameBytes < nSamples)
+        {
+            throw std::runtime_error("Binary data packet has invalid length");
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Binary data packet has unknown encoding "
+                               + std::to_string(data[9]));
+    }
+    if (!(samplingRate > 0))
+    {
+        throw std::runtime_error("Binary data packet has invalid sampling rate");
+    }
+    const auto *names = reinterpret_cast<const char *> (data)
+                      + ::BINARY_HEADER_SIZE;
+    for (int i = 0; i < 4; ++i)
+    {
+        std::string_view name(names, lengths[i]);
+        if (std::all_of(name.begin(), name.end(),
+                        [](const char c)
+                        {
+                            return std::isspace(static_cast<unsigned char> (c));
+                        }))
+        {
+            throw std::runtime_error("Binary data packet has an empty name");
+        }
+        names = names + lengths[i];
+    }
+    // Decode compressed samples into this thread's scratch space first so a
+    // malformed message leaves the packet unchanged
+    const auto *samples = data + ::BINARY_HEADER_SIZE + nNameBytes;
+    if (encoding == Encoding::IntegerDelta)
+    {
+        thread_local std::vector<double> decoded;
+        decoded.resize(nSamples);
+        const auto *end = data + length;
+        ::decodeIntegerDeltas(&samples, end,
+                              static_cast<int> (nSamples), decoded.data());
+        if (samples != end)
+        {
+            throw std::runtime_error("Binary data packet has invalid length");
+        }
+        pImpl->mData.assign(decoded.begin(), decoded.end());
+    }
+    // Everything checks out so overwrite this packet.  This reuses the
+    // existing string and sample storage.
+    names = reinterpret_cast<const char *> (data) + ::BINARY_HEADER_SIZE;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto &name = (i == 0) ? pImpl->mNetwork :
+                     (i == 1) ? pImpl->mStation :
+                     (i == 2) ? pImpl->mChannel : pImpl->mLocationCode;
+        name.assign(names, lengths[i]);
+        names = names + lengths[i];
+    }
+    if (encoding == Encoding::Float64)
+    {
+        pImpl->mData.resize(nSamples);
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (nSamples > 0)
+            {
+                std::memcpy(pImpl->mData.data(), samples,
+                            sizeof(double)*nSamples);
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < nSamples; ++i)
+            {
+                pImpl->mData[i]
+                    = ::readLittleEndian<double> (samples + sizeof(double)*i);
+            }
+        }
+    }
+    pImpl->mEncoding = encoding;
+    pImpl->mSamplingRate = samplingRate;
+    pImpl->mStartTimeMicroSeconds = std::chrono::microseconds {startTime};
+    pImpl->updateEndTime();
+}
+
 /// To CBOR
 std::string DataPacket::toCBOR() const
 {
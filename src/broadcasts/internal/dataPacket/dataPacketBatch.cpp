@@ -0,0 +1,326 @@
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <bit>
+#include "urts/broadcasts/internal/dataPacket/dataPacketBatch.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+
+#define MESSAGE_TYPE "URTS::Broadcasts::Internal::DataPacket::DataPacketBatch"
+#define MESSAGE_VERSION "1.0.0"
+
+using namespace URTS::Broadcasts::Internal::DataPacket;
+
+namespace
+{
+
+/// @brief The binary wire format.  All numbers are little-endian.
+///          Offset  Type      Contents
+///          0       char[4]   "URDB"
+///          4       uint8     The message's major version
+///          5       uint8[3]  Reserved (0)
+///          8       uint32    Number of packets
+///          12      -         For each packet, a uint32 with the length
+///                            of the packet followed by the packet in the
+///                            DataPacket's binary format.
+constexpr std::array<char, 4> BINARY_MAGIC{'U', 'R', 'D', 'B'};
+constexpr uint8_t BINARY_VERSION{1};
+constexpr size_t BINARY_HEADER_SIZE{12};
+
+void writeUInt32(const uint32_t value, char *destination) noexcept
+{
+    auto bits = std::bit_cast<std::array<char, sizeof(uint32_t)>> (value);
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    std::memcpy(destination, bits.data(), sizeof(uint32_t));
+}
+
+[[nodiscard]] uint32_t readUInt32(const char *source) noexcept
+{
+    std::array<char, sizeof(uint32_t)> bits;
+    std::memcpy(bits.data(), source, sizeof(uint32_t));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    return std::bit_cast<uint32_t> (bits);
+}
+
+/// @throws std::invalid_argument if the packet cannot be serialized.
+void checkPacket(const DataPacket &packet)
+{
+    if (!packet.haveNetwork())
+    {
+        throw std::invalid_argument("Network not set");
+    }
+    if (!packet.haveStation())
+    {
+        throw std::invalid_argument("Station not set");
+    }
+    if (!packet.haveChannel())
+    {
+        throw std::invalid_argument("Channel not set");
+    }
+    if (!packet.haveLocationCode())
+    {
+        throw std::invalid_argument("Location code not set");
+    }
+    if (!packet.haveSamplingRate())
+    {
+        throw std::invalid_argument("Sampling rate not set");
+    }
+}
+
+/// Writes the batch header then each packet with writePacket.
+template<typename F>
+void toBinary(const std::vector<DataPacket> &packets,
+              std::string *message,
+              F &&writePacket)
+{
+    if (message == nullptr){throw std::invalid_argument("message is NULL");}
+    if (packets.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::invalid_argument("Too many packets");
+    }
+    message->resize(::BINARY_HEADER_SIZE);
+    auto *header = message->data();
+    std::memcpy(header, ::BINARY_MAGIC.data(), ::BINARY_MAGIC.size());
+    header[4] = static_cast<char> (::BINARY_VERSION);
+    std::memset(header + 5, 0, 3);
+    ::writeUInt32(static_cast<uint32_t> (packets.size()), header + 8);
+    std::string packetMessage;
+    for (const auto &packet : packets)
+    {
+        writePacket(packet, &packetMessage);
+        std::array<char, sizeof(uint32_t)> length;
+        ::writeUInt32(static_cast<uint32_t> (packetMessage.size()),
+                      length.data());
+        message->append(length.data(), length.size());
+        message->append(packetMessage);
+    }
+}
+
+}
+
+class DataPacketBatch::DataPacketBatchImpl
+{
+public:
+    std::vector<DataPacket> mPackets;
+};
+
+/// C'tor
+DataPacketBatch::DataPacketBatch() :
+    pImpl(std::make_unique<DataPacketBatchImpl> ())
+{
+}
+
+/// Copy c'tor
+DataPacketBatch::DataPacketBatch(const DataPacketBatch &batch)
+{
+    *this = batch;
+}
+
+/// Move c'tor
+DataPacketBatch::DataPacketBatch(DataPacketBatch &&batch) noexcept
+{
+    *this = std::move(batch);
+}
+
+/// Copy assignment
+DataPacketBatch& DataPacketBatch::operator=(const DataPacketBatch &batch)
+{
+    if (&batch == this){return *this;}
+    pImpl = std::make_unique<DataPacketBatchImpl> (*batch.pImpl);
+    return *this;
+}
+
+/// Move assignment
+DataPacketBatch& DataPacketBatch::operator=(DataPacketBatch &&batch) noexcept
+{
+    if (&batch == this){return *this;}
+    pImpl = std::move(batch.pImpl);
+    return *this;
+}
+
+/// Destructor
+DataPacketBatch::~DataPacketBatch() = default;
+
+/// Reset class
+void DataPacketBatch::clear() noexcept
+{
+    pImpl->mPackets.clear();
+}
+
+/// Add a packet
+void DataPacketBatch::addPacket(const DataPacket &packet)
+{
+    ::checkPacket(packet);
+    pImpl->mPackets.push_back(packet);
+}
+
+void DataPacketBatch::addPacket(DataPacket &&packet)
+{
+    ::checkPacket(packet);
+    pImpl->mPackets.push_back(std::move(packet));
+}
+
+/// Set the packets
+void DataPacketBatch::setPackets(std::vector<DataPacket> &&packets)
+{
+    for (const auto &packet : packets){::checkPacket(packet);}
+    pImpl->mPackets = std::move(packets);
+}
+
+/// Get the packets
+std::vector<DataPacket> DataPacketBatch::getPackets() const
+{
+    return pImpl->mPackets;
+}
+
+const std::vector<DataPacket>
+    &DataPacketBatch::getPacketsReference() const noexcept
+{
+    return pImpl->mPackets;
+}
+
+std::vector<DataPacket> DataPacketBatch::movePackets() noexcept
+{
+    std::vector<DataPacket> result;
+    std::swap(result, pImpl->mPackets);
+    return result;
+}
+
+/// Number of packets
+int DataPacketBatch::getNumberOfPackets() const noexcept
+{
+    return static_cast<int> (pImpl->mPackets.size());
+}
+
+bool DataPacketBatch::empty() const noexcept
+{
+    return pImpl->mPackets.empty();
+}
+
+/// To binary
+void DataPacketBatch::toBinary(std::string *message) const
+{
+    ::toBinary(pImpl->mPackets, message,
+               [](const DataPacket &packet, std::string *packetMessage)
+               {
+                   packet.toBinary(packetMessage);
+               });
+}
+
+void DataPacketBatch::toBinary(std::string *message,
+                               const DataPacket::Encoding encoding) const
+{
+    ::toBinary(pImpl->mPackets, message,
+               [encoding](const DataPacket &packet, std::string *packetMessage)
+               {
+                   packet.toBinary(packetMessage, encoding);
+               });
+}
+
+///  Convert message
+std::string DataPacketBatch::toMessage() const
+{
+    std::string message;
+    toBinary(&message);
+    return message;
+}
+
+void DataPacketBatch::serializeInto(std::string *buffer) const
+{
+    toBinary(buffer);
+}
+
+void DataPacketBatch::serializeInto(std::string *buffer,
+                                    const DataPacket::Encoding encoding) const
+{
+    toBinary(buffer, encoding);
+}
+
+void DataPacketBatch::fromMessage(const std::string &message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    fromMessage(message.data(), message.size());
+}
+
+void DataPacketBatch::fromMessage(const char *data, const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr){throw std::invalid_argument("data is NULL");}
+    if (length < ::BINARY_HEADER_SIZE ||
+        std::memcmp(data, ::BINARY_MAGIC.data(), ::BINARY_MAGIC.size()) != 0)
+    {
+        throw std::runtime_error("Message is not a data packet batch");
+    }
+    if (static_cast<uint8_t> (data[4]) != ::BINARY_VERSION)
+    {
+        throw std::runtime_error("Unsupported data packet batch version "
+                               + std::to_string(static_cast<uint8_t> (data[4])));
+    }
+    auto nPackets = ::readUInt32(data + 8);
+    // Every packet requires a length and a header so a corrupt count cannot
+    // trigger a huge allocation
+    if (nPackets > (length - ::BINARY_HEADER_SIZE)/sizeof(uint32_t))
+    {
+        throw std::runtime_error("Data packet batch has invalid length");
+    }
+    std::vector<DataPacket> packets(nPackets);
+    size_t offset = ::BINARY_HEADER_SIZE;
+    for (auto &packet : packets)
+    {
+        if (length - offset < sizeof(uint32_t))
+        {
+            throw std::runtime_error("Data packet batch is truncated");
+        }
+        auto packetLength = static_cast<size_t> (::readUInt32(data + offset));
+        offset = offset + sizeof(uint32_t);
+        if (packetLength == 0 || length - offset < packetLength)
+        {
+            throw std::runtime_error("Data packet batch is truncated");
+        }
+        packet.fromBinary(reinterpret_cast<const uint8_t *> (data + offset),
+                          packetLength);
+        offset = offset + packetLength;
+    }
+    if (offset != length)
+    {
+        throw std::runtime_error("Data packet batch has invalid length");
+    }
+    pImpl->mPackets = std::move(packets);
+}
+
+/// Copy this class
+std::unique_ptr<UMPS::MessageFormats::IMessage> DataPacketBatch::clone() const
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<DataPacketBatch> (*this);
+    return result;
+}
+
+/// Create an instance of this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    DataPacketBatch::createInstance() const noexcept
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<DataPacketBatch> ();
+    return result;
+}
+
+/// Message type
+std::string DataPacketBatch::getMessageType() const noexcept
+{
+    return MESSAGE_TYPE;
+}
+
+/// Message version
+std::string DataPacketBatch::getMessageVersion() const noexcept
+{
+    return MESSAGE_VERSION;
+}
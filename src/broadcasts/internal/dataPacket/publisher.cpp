@@ -6,23 +6,124 @@
 #include <umps/messaging/xPublisherXSubscriber/publisherOptions.hpp>
 #include <umps/messaging/xPublisherXSubscriber/publisher.hpp>
 #include <umps/logging/log.hpp>
+#include <umps/logging/standardOut.hpp>
 #include "urts/broadcasts/internal/dataPacket/publisher.hpp"
 #include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacketBatch.hpp"
+#include "private/serializedMessage.hpp"
 
 using namespace URTS::Broadcasts::Internal::DataPacket;
 namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
 
+namespace
+{
+/// @brief Presents a packet as a message whose samples are written with the
+///        publisher's encoding so a packet with a different encoding need
+///        not be copied.
+/// @note This is write-only and must not outlive the wrapped packet.
+class EncodedDataPacket : public UMPS::MessageFormats::IMessage
+{
+public:
+    EncodedDataPacket(const DataPacket &packet,
+                      const DataPacket::Encoding encoding) :
+        mPacket(packet),
+        mEncoding(encoding)
+    {
+    }
+    [[nodiscard]] std::string toMessage() const final
+    {
+        std::string message;
+        mPacket.toBinary(&message, mEncoding);
+        return message;
+    }
+    [[nodiscard]] std::string getMessageType() const noexcept final
+    {
+        return mPacket.getMessageType();
+    }
+    [[nodiscard]] std::string getMessageVersion() const noexcept final
+    {
+        return mPacket.getMessageVersion();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        clone() const final
+    {
+        return mPacket.clone();
+    }
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createInstance() const noexcept final
+    {
+        return mPacket.createInstance();
+    }
+    void fromMessage(const std::string &) final
+    {
+        throw std::runtime_error("Encoded packets are write-only");
+    }
+    void fromMessage(const char *, const size_t) final
+    {
+        throw std::runtime_error("Encoded packets are write-only");
+    }
+private:
+    const DataPacket &mPacket;
+    DataPacket::Encoding mEncoding;
+};
+}
+
 class Publisher::PublisherImpl
 {
 public:
     PublisherImpl(std::shared_ptr<UMPS::Messaging::Context> context,
                   std::shared_ptr<UMPS::Logging::ILog> logger)
     {
-        mPublisher = std::make_unique<UXPubXSub::Publisher> (context, logger);
+        if (logger == nullptr)
+        {
+            mLogger = std::make_shared<UMPS::Logging::StandardOut> ();
+        }
+        else
+        {
+            mLogger = logger;
+        }
+        mPublisher = std::make_unique<UXPubXSub::Publisher> (context, mLogger);
+    }
+    /// @brief Sends the current batch.
+    void flush()
+    {
+        if (mBatch.empty()){return;}
+        try
+        {
+            mPublisher->send(::SerializedMessage<DataPacketBatch>
+                             {mBatch, mSampleEncoding});
+        }
+        catch (...)
+        {
+            mBatch.clear();
+            throw;
+        }
+        mBatch.clear();
+    }
+    /// @brief Adds the packet to the current batch and sends the batch if
+    ///        it is full or too old.  The age is only checked here so an idle
+    ///        producer must call flush() to send a partial batch.
+    template<typename T>
+    void addToBatch(T &&packet)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (mBatch.empty()){mBatchStartTime = now;}
+        mBatch.addPacket(std::forward<T> (packet));
+        if (mBatch.getNumberOfPackets() >= mMaximumBatchSize ||
+            now - mBatchStartTime >= mMaximumBatchAge)
+        {
+            flush();
+        }
     }
     std::unique_ptr<UXPubXSub::Publisher> mPublisher;
+    std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
     PublisherOptions mOptions;
+    DataPacketBatch mBatch;
+    std::chrono::steady_clock::time_point mBatchStartTime;
+    std::chrono::milliseconds mMaximumBatchAge{100};
+    DataPacket::Encoding mSampleEncoding{DataPacket::Encoding::Float64};
+    int mMaximumBatchSize{1};
 };
 
 /// C'tor
@@ -81,6 +182,9 @@ void Publisher::initialize(const PublisherOptions &options)
     // Slow joiner problem
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     pImpl->mOptions = options;
+    pImpl->mMaximumBatchSize = options.getMaximumBatchSize();
+    pImpl->mMaximumBatchAge = options.getMaximumBatchAge();
+    pImpl->mSampleEncoding = options.getSampleEncoding();
 }
 
 /// Initialized?
@@ -90,10 +194,74 @@ bool Publisher::isInitialized() const noexcept
 }
 
 /// Destructor
-Publisher::~Publisher() = default;
+Publisher::~Publisher()
+{
+    if (pImpl == nullptr){return;} // Moved from
+    auto nPackets = pImpl->mBatch.getNumberOfPackets();
+    try
+    {
+        if (isInitialized()){pImpl->flush();}
+    }
+    catch (const std::exception &e)
+    {
+        pImpl->mLogger->error("Failed to send final batch of "
+                            + std::to_string(nPackets)
+                            + " packets.  Failed with: "
+                            + std::string {e.what()});
+    }
+    catch (...)
+    {
+        pImpl->mLogger->error("Failed to send final batch of "
+                            + std::to_string(nPackets) + " packets");
+    }
+}
 
 /// Send
 void Publisher::send(const DataPacket &message)
 {
-    pImpl->mPublisher->send(message); 
+    // Packets are sent with the publisher's sample encoding.  Batches are
+    // serialized with that encoding when they are flushed.
+    if (pImpl->mMaximumBatchSize > 1)
+    {
+        pImpl->addToBatch(message);
+    }
+    else if (message.getEncoding() != pImpl->mSampleEncoding)
+    {
+        pImpl->mPublisher->send(::EncodedDataPacket {message,
+                                                     pImpl->mSampleEncoding});
+    }
+    else
+    {
+        // The binary packet is written once into an exactly sized string so
+        // a reused buffer would only add a copy.
+        pImpl->mPublisher->send(message);
+    }
+}
+
+void Publisher::send(DataPacket &&message)
+{
+    if (pImpl->mMaximumBatchSize > 1)
+    {
+        pImpl->addToBatch(std::move(message));
+    }
+    else
+    {
+        message.setEncoding(pImpl->mSampleEncoding);
+        // The binary packet is written once into an exactly sized string so
+        // a reused buffer would only add a copy.
+        pImpl->mPublisher->send(message);
+    }
+}
+
+/// Flush the batch
+void Publisher::flush()
+{
+    if (!isInitialized()){throw std::runtime_error("Publisher not initialized");}
+    pImpl->flush();
+}
+
+/// Number of packets waiting in the batch
+int Publisher::getNumberOfPendingPackets() const noexcept
+{
+    return pImpl->mBatch.getNumberOfPackets();
 }
@@ -16,6 +16,9 @@ public:
         mOptions.setTimeOut(std::chrono::milliseconds{1000}); 
     }
     UMPS::Messaging::XPublisherXSubscriber::PublisherOptions mOptions;
+    std::chrono::milliseconds mMaximumBatchAge{100};
+    DataPacket::Encoding mSampleEncoding{DataPacket::Encoding::Float64};
+    int mMaximumBatchSize{1};
 };
 
 /// C'tor
@@ -119,3 +122,47 @@ std::chrono::milliseconds PublisherOptions::getTimeOut() const noexcept
 {
     return pImpl->mOptions.getTimeOut();
 }
+
+/// Maximum batch size
+void PublisherOptions::setMaximumBatchSize(const int maximumBatchSize)
+{
+    if (maximumBatchSize < 1)
+    {
+        throw std::invalid_argument("Maximum batch size must be positive");
+    }
+    pImpl->mMaximumBatchSize = maximumBatchSize;
+}
+
+int PublisherOptions::getMaximumBatchSize() const noexcept
+{
+    return pImpl->mMaximumBatchSize;
+}
+
+/// Maximum batch age
+void PublisherOptions::setMaximumBatchAge(
+    const std::chrono::milliseconds &maximumBatchAge)
+{
+    if (maximumBatchAge.count() < 0)
+    {
+        throw std::invalid_argument("Maximum batch age must be non-negative");
+    }
+    pImpl->mMaximumBatchAge = maximumBatchAge;
+}
+
+std::chrono::milliseconds
+    PublisherOptions::getMaximumBatchAge() const noexcept
+{
+    return pImpl->mMaximumBatchAge;
+}
+
+/// Sample encoding
+void PublisherOptions::setSampleEncoding(
+    const DataPacket::Encoding encoding) noexcept
+{
+    pImpl->mSampleEncoding = encoding;
+}
+
+DataPacket::Encoding PublisherOptions::getSampleEncoding() const noexcept
+{
+    return pImpl->mSampleEncoding;
+}
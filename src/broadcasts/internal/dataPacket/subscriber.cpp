@@ -1,3 +1,6 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/messaging/publisherSubscriber/subscriber.hpp>
 #include <umps/messaging/publisherSubscriber/subscriberOptions.hpp>
@@ -7,7 +10,9 @@
 #include "urts/broadcasts/internal/dataPacket/subscriber.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacketBatch.hpp"
 #include "private/staticUniquePointerCast.hpp"
+#include "private/receiveBatch.hpp"
 
 using namespace URTS::Broadcasts::Internal::DataPacket;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -25,11 +30,86 @@ public:
         std::unique_ptr<UMPS::MessageFormats::IMessage> dataPacketMessageType
             = std::make_unique<DataPacket> (); 
         mMessageTypes.add(dataPacketMessageType);
+        std::unique_ptr<UMPS::MessageFormats::IMessage> batchMessageType
+            = std::make_unique<DataPacketBatch> ();
+        mMessageTypes.add(batchMessageType);
+    }
+    /// @result The number of received packets that have not been handed
+    ///         out.
+    [[nodiscard]] size_t getNumberOfPendingPackets() const noexcept
+    {
+        return mPendingPackets.size() - mNextPendingPacket;
+    }
+    /// @brief Moves up to maxPackets pending packets to the back of packets.
+    /// @result The number of packets moved.
+    size_t popPendingPackets(std::vector<DataPacket> *packets,
+                             const size_t maxPackets)
+    {
+        auto nMove = std::min(maxPackets, getNumberOfPendingPackets());
+        auto first = mPendingPackets.begin() + mNextPendingPacket;
+        packets->insert(packets->end(),
+                        std::make_move_iterator(first),
+                        std::make_move_iterator(first + nMove));
+        mNextPendingPacket = mNextPendingPacket + nMove;
+        return nMove;
+    }
+    /// @brief Receives the next message into the pending packets.  This
+    ///        is only called once every pending packet was handed out.  The
+    ///        pending packets are a vector that is read from the front and
+    ///        reused, rather than a deque, so a single packet message does
+    ///        not allocate once the vector is warm.
+    void receive()
+    {
+        auto message = mSubscriber->receive();
+        if (message == nullptr){return;} // Time out
+        mPendingPackets.clear();
+        mNextPendingPacket = 0;
+        try
+        {
+            if (message->getMessageType() == mBatchMessageType)
+            {
+                // Adopt the batch's packets rather than move them one by one
+                auto batch = static_unique_pointer_cast<DataPacketBatch>
+                             (std::move(message));
+                mPendingPackets = batch->movePackets();
+            }
+            else
+            {
+                auto packet = static_unique_pointer_cast<DataPacket>
+                              (std::move(message));
+                mPendingPackets.push_back(std::move(*packet));
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::string errorMessage
+                = "Error deserializing data packet.  Failed with "
+                + std::string{e.what()};
+            throw std::runtime_error(errorMessage);
+        }
+    }
+    /// @brief Reports a message in a batch that could not be received.
+    void reportReceiveError(const std::exception &e) const
+    {
+        std::string errorMessage{"Skipping message in batch.  "
+                               + std::string{e.what()}};
+        if (mLogger != nullptr)
+        {
+            mLogger->error(errorMessage);
+        }
+        else
+        {
+            std::cerr << errorMessage << std::endl;
+        }
     }
     std::shared_ptr<UMPS::Logging::ILog> mLogger;
     std::unique_ptr<UPubSub::Subscriber> mSubscriber;
     SubscriberOptions mOptions;
     UMPS::MessageFormats::Messages mMessageTypes;
+    /// Received packets.  Those before mNextPendingPacket were handed out.
+    std::vector<DataPacket> mPendingPackets;
+    size_t mNextPendingPacket{0};
+    const std::string mBatchMessageType{DataPacketBatch {}.getMessageType()};
 };
 
 /// C'tor
@@ -104,20 +184,55 @@ Subscriber::~Subscriber() = default;
 /// Receive
 std::unique_ptr<DataPacket> Subscriber::receive() const
 {
-    auto message = pImpl->mSubscriber->receive();
-    if (message != nullptr)
+    if (pImpl->getNumberOfPendingPackets() == 0){pImpl->receive();}
+    if (pImpl->getNumberOfPendingPackets() == 0){return nullptr;}
+    auto &packet = pImpl->mPendingPackets[pImpl->mNextPendingPacket];
+    pImpl->mNextPendingPacket = pImpl->mNextPendingPacket + 1;
+    return std::make_unique<DataPacket> (std::move(packet));
+}
+
+/// Receive all packets in a message
+std::vector<DataPacket> Subscriber::receivePackets() const
+{
+    std::vector<DataPacket> result;
+    receivePackets(&result);
+    return result;
+}
+
+void Subscriber::receivePackets(std::vector<DataPacket> *packets) const
+{
+    if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
+    packets->clear();
+    if (pImpl->getNumberOfPendingPackets() == 0){pImpl->receive();}
+    pImpl->popPendingPackets(packets, pImpl->getNumberOfPendingPackets());
+}
+
+/// Receive all available packets
+int Subscriber::receiveBatch(std::vector<DataPacket> *packets,
+                             const int maxPackets,
+                             const std::chrono::milliseconds &timeOut) const
+{
+    if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
+    if (!isInitialized())
     {
-        try
-        {
-            return static_unique_pointer_cast<DataPacket> (std::move(message));
-        }
-        catch (const std::exception &e)
-        {
-            std::string errorMessage
-                = "Error deserializing data packet.  Failed with "
-                + std::string{e.what()};
-            throw std::runtime_error(errorMessage);
-        }
+        throw std::runtime_error("Subscriber not initialized");
     }
-    return nullptr;
+    packets->clear();
+    return ::receiveBatch([&](const int nRemaining)
+    {
+        if (pImpl->getNumberOfPendingPackets() == 0){pImpl->receive();}
+        return static_cast<int> (pImpl->popPendingPackets(
+                   packets, static_cast<size_t> (nRemaining)));
+    }, [&](const std::exception &e)
+    {
+        pImpl->reportReceiveError(e);
+    }, maxPackets, timeOut);
+}
+
+std::vector<DataPacket> Subscriber::receiveBatch(
+    const int maxPackets, const std::chrono::milliseconds &timeOut) const
+{
+    std::vector<DataPacket> result;
+    receiveBatch(&result, maxPackets, timeOut);
+    return result;
 }
@@ -7,6 +7,7 @@
 #include "urts/broadcasts/internal/origin/arrival.hpp"
 #include "urts/broadcasts/internal/pick/uncertaintyBound.hpp"
 #include "database/aqms/utilities.hpp"
+#include "private/cborWriter.hpp"
 
 #define MESSAGE_TYPE "URTS::Broadcasts::Internal::Origin"
 #define MESSAGE_VERSION "1.0.0"
@@ -16,72 +17,125 @@ using namespace URTS::Broadcasts::Internal::Origin;
 namespace
 {
 
-nlohmann::json toJSONObject(const Origin &origin)
-{
-    nlohmann::json obj;
-    obj["MessageType"] = origin.getMessageType();
-    obj["MessageVersion"] = origin.getMessageVersion();
-    obj["Latitude"] = origin.getLatitude();
-    obj["Longitude"] = origin.getLongitude();
-    obj["Depth"] = origin.getDepth();
-    obj["Time"] = static_cast<int64_t> (origin.getTime().count());
-    obj["Identifier"] = origin.getIdentifier();
-    obj["ReviewStatus"] = static_cast<int> (origin.getReviewStatus());
-    obj["MonitoringRegion"] = static_cast<int> (origin.getMonitoringRegion());
-    obj["Algorithms"] = origin.getAlgorithms();
-    obj["PreviousIdentifiers"] = origin.getPreviousIdentifiers();
+void toCBORMessage(const Origin &origin, std::string *result)
+{
     const auto &arrivals = origin.getArrivalsReference();
+    auto algorithms = origin.getAlgorithms();
+    auto previousIdentifiers = origin.getPreviousIdentifiers();
+    result->clear();
+    result->reserve(512 + 512*arrivals.size());
+    CBORWriter writer(result);
+    writer.startMap(arrivals.empty() ? 11 : 12);
+    writer.write("MessageType");
+    writer.write(origin.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(origin.getMessageVersion());
+    writer.write("Latitude");
+    writer.write(origin.getLatitude());
+    writer.write("Longitude");
+    writer.write(origin.getLongitude());
+    writer.write("Depth");
+    writer.write(origin.getDepth());
+    writer.write("Time");
+    writer.write(static_cast<int64_t> (origin.getTime().count()));
+    writer.write("Identifier");
+    writer.write(origin.getIdentifier());
+    writer.write("ReviewStatus");
+    writer.write(static_cast<int> (origin.getReviewStatus()));
+    writer.write("MonitoringRegion");
+    writer.write(static_cast<int> (origin.getMonitoringRegion()));
+    writer.write("Algorithms");
+    writer.startArray(algorithms.size());
+    for (const auto &algorithm : algorithms)
+    {
+        writer.write(algorithm);
+    }
+    writer.write("PreviousIdentifiers");
+    writer.startArray(previousIdentifiers.size());
+    for (const auto &previousIdentifier : previousIdentifiers)
+    {
+        writer.write(previousIdentifier);
+    }
     if (!arrivals.empty())
     {
-        nlohmann::json arrivalObjects;
+        writer.write("Arrivals");
+        writer.startArray(arrivals.size());
         for (const auto &arrival : arrivals)
         {
-             nlohmann::json arrivalObject;
-             arrivalObject["Identifier"] = arrival.getIdentifier();
-             arrivalObject["Network"] = arrival.getNetwork();
-             arrivalObject["Station"] = arrival.getStation();
-             arrivalObject["Channel"] = arrival.getChannel();
-             arrivalObject["LocationCode"] = arrival.getLocationCode();
-             arrivalObject["Time"]
-                = static_cast<int64_t> (arrival.getTime().count());
-             arrivalObject["Phase"] = static_cast<int> (arrival.getPhase());
-             arrivalObject["OriginalChannels"] = arrival.getOriginalChannels();
-             arrivalObject["ProcessingAlgorithms"]
-                = arrival.getProcessingAlgorithms();
-             arrivalObject["FirstMotion"]
-                = static_cast<int> (arrival.getFirstMotion());
-             arrivalObject["ReviewStatus"]
-                = static_cast<int> (arrival.getReviewStatus());
-             auto originIdentifier = arrival.getOriginIdentifier();
-             if (originIdentifier)
-             {
-                 arrivalObject["OriginIdentifier"] = *originIdentifier;
-             }
-             auto residual = arrival.getResidual();
-             if (residual){arrivalObject["Residual"] = *residual;}
-             auto snr = arrival.getSignalToNoiseRatio();
-             if (snr){arrivalObject["SignalToNoiseRatio"] = *snr;}
-             auto uncertainty = arrival.getLowerAndUpperUncertaintyBound();
-             if (uncertainty)
-             {
-                 nlohmann::json uncertaintyObject;
-                 uncertaintyObject["LowerPercentile"]
-                    = uncertainty->first.getPercentile();
-                 uncertaintyObject["LowerPerturbation"]
-                    = static_cast<int64_t>
-                      (uncertainty->first.getPerturbation().count());
-                 uncertaintyObject["UpperPercentile"]
-                    = uncertainty->second.getPercentile();
-                 uncertaintyObject["UpperPerturbation"]
-                    = static_cast<int64_t>
-                      (uncertainty->second.getPerturbation().count());
-                 arrivalObject["Uncertainty"] = uncertaintyObject;
-             }
-             arrivalObjects.push_back(std::move(arrivalObject));
+            auto originalChannels = arrival.getOriginalChannels();
+            auto processingAlgorithms = arrival.getProcessingAlgorithms();
+            auto originIdentifier = arrival.getOriginIdentifier();
+            auto residual = arrival.getResidual();
+            auto snr = arrival.getSignalToNoiseRatio();
+            auto uncertainty = arrival.getLowerAndUpperUncertaintyBound();
+            int nArrivalPairs = 11;
+            if (originIdentifier){nArrivalPairs = nArrivalPairs + 1;}
+            if (residual){nArrivalPairs = nArrivalPairs + 1;}
+            if (snr){nArrivalPairs = nArrivalPairs + 1;}
+            if (uncertainty){nArrivalPairs = nArrivalPairs + 1;}
+            writer.startMap(nArrivalPairs);
+            writer.write("Identifier");
+            writer.write(arrival.getIdentifier());
+            writer.write("Network");
+            writer.write(arrival.getNetwork());
+            writer.write("Station");
+            writer.write(arrival.getStation());
+            writer.write("Channel");
+            writer.write(arrival.getChannel());
+            writer.write("LocationCode");
+            writer.write(arrival.getLocationCode());
+            writer.write("Time");
+            writer.write(static_cast<int64_t> (arrival.getTime().count()));
+            writer.write("Phase");
+            writer.write(static_cast<int> (arrival.getPhase()));
+            writer.write("OriginalChannels");
+            writer.startArray(originalChannels.size());
+            for (const auto &originalChannel : originalChannels)
+            {
+                writer.write(originalChannel);
+            }
+            writer.write("ProcessingAlgorithms");
+            writer.startArray(processingAlgorithms.size());
+            for (const auto &algorithm : processingAlgorithms)
+            {
+                writer.write(algorithm);
+            }
+            writer.write("FirstMotion");
+            writer.write(static_cast<int> (arrival.getFirstMotion()));
+            writer.write("ReviewStatus");
+            writer.write(static_cast<int> (arrival.getReviewStatus()));
+            if (originIdentifier)
+            {
+                writer.write("OriginIdentifier");
+                writer.write(*originIdentifier);
+            }
+            if (residual)
+            {
+                writer.write("Residual");
+                writer.write(*residual);
+            }
+            if (snr)
+            {
+                writer.write("SignalToNoiseRatio");
+                writer.write(*snr);
+            }
+            if (uncertainty)
+            {
+                writer.write("Uncertainty");
+                writer.startMap(4);
+                writer.write("LowerPercentile");
+                writer.write(uncertainty->first.getPercentile());
+                writer.write("LowerPerturbation");
+                writer.write(static_cast<int64_t>
+                             (uncertainty->first.getPerturbation().count()));
+                writer.write("UpperPercentile");
+                writer.write(uncertainty->second.getPercentile());
+                writer.write("UpperPerturbation");
+                writer.write(static_cast<int64_t>
+                             (uncertainty->second.getPerturbation().count()));
+            }
         }
-        obj["Arrivals"] = arrivalObjects;
     }
-    return obj;
 }
 
 Origin objectToOrigin(const nlohmann::json &obj)
@@ -498,12 +552,17 @@ std::string Origin::getMessageVersion() const noexcept
 //  Convert message
 std::string Origin::toMessage() const
 {
-    auto obj = ::toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    std::string result;
+    ::toCBORMessage(*this, &result);
     return result; 
 }
 
+void Origin::serializeInto(std::string *buffer) const
+{
+    if (buffer == nullptr){throw std::invalid_argument("buffer is NULL");}
+    ::toCBORMessage(*this, buffer);
+}
+
 void Origin::fromMessage(const std::string &message)
 {
     if (message.empty()){throw std::invalid_argument("Message is empty");}
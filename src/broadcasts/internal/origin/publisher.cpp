@@ -10,6 +10,7 @@
 #include "urts/broadcasts/internal/origin/publisher.hpp"
 #include "urts/broadcasts/internal/origin/publisherOptions.hpp"
 #include "urts/broadcasts/internal/origin/origin.hpp"
+#include "private/serializedMessage.hpp"
 
 using namespace URTS::Broadcasts::Internal::Origin;
 namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
@@ -107,5 +108,5 @@ void Publisher::send(const Origin &message)
             } 
         }
     }
-    pImpl->mPublisher->send(message); 
+    pImpl->mPublisher->send(::SerializedMessage<Origin> {message});
 }
@@ -1,3 +1,4 @@
+#include <iostream>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/messaging/publisherSubscriber/subscriber.hpp>
 #include <umps/messaging/publisherSubscriber/subscriberOptions.hpp>
@@ -8,6 +9,7 @@
 #include "urts/broadcasts/internal/origin/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/origin/origin.hpp"
 #include "private/staticUniquePointerCast.hpp"
+#include "private/receiveBatch.hpp"
 
 using namespace URTS::Broadcasts::Internal::Origin;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -26,6 +28,20 @@ public:
             = std::make_unique<Origin> (); 
         mMessageTypes.add(originMessageType);
     }
+    /// @brief Reports a message in a batch that could not be received.
+    void reportReceiveError(const std::exception &e) const
+    {
+        std::string errorMessage{"Skipping message in batch.  "
+                               + std::string{e.what()}};
+        if (mLogger != nullptr)
+        {
+            mLogger->error(errorMessage);
+        }
+        else
+        {
+            std::cerr << errorMessage << std::endl;
+        }
+    }
     std::shared_ptr<UMPS::Logging::ILog> mLogger;
     std::unique_ptr<UPubSub::Subscriber> mSubscriber;
     SubscriberOptions mOptions;
@@ -121,3 +137,26 @@ std::unique_ptr<Origin> Subscriber::receive() const
     }
     return nullptr;
 }
+
+/// Receive all available messages
+int Subscriber::receiveBatch(std::vector<Origin> *origins,
+                             const int maxMessages,
+                             const std::chrono::milliseconds &timeOut) const
+{
+    if (origins == nullptr){throw std::invalid_argument("origins is NULL");}
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Subscriber not initialized");
+    }
+    origins->clear();
+    return ::receiveBatch([&](const int)
+    {
+        auto message = receive();
+        if (message == nullptr){return 0;}
+        origins->push_back(std::move(*message));
+        return 1;
+    }, [&](const std::exception &e)
+    {
+        pImpl->reportReceiveError(e);
+    }, maxMessages, timeOut);
+}
@@ -6,6 +6,7 @@
 #include "urts/broadcasts/internal/pick/pick.hpp"
 #include "urts/broadcasts/internal/pick/uncertaintyBound.hpp"
 #include "private/isEmpty.hpp"
+#include "private/cborWriter.hpp"
 
 #define MESSAGE_TYPE "URTS::Broadcasts::Internal::Pick"
 #define MESSAGE_VERSION "1.0.0"
@@ -84,6 +85,95 @@ nlohmann::json toJSONObject(const Pick &pick)
     return obj;
 }
 
+/// Writes the same map as toJSONObject without building the document.
+void toCBORMessage(const Pick &pick, std::string *result)
+{
+    auto originalChannels = pick.getOriginalChannels();
+    auto phaseHint = pick.getPhaseHint();
+    auto processingAlgorithms = pick.getProcessingAlgorithms();
+    result->clear();
+    result->reserve(512);
+    CBORWriter writer(result);
+    writer.startMap(15);
+    writer.write("MessageType");
+    writer.write(pick.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(pick.getMessageVersion());
+    writer.write("Network");
+    writer.write(pick.getNetwork());
+    writer.write("Station");
+    writer.write(pick.getStation());
+    writer.write("Channel");
+    writer.write(pick.getChannel());
+    writer.write("LocationCode");
+    writer.write(pick.getLocationCode());
+    writer.write("Time");
+    writer.write(static_cast<int64_t> (pick.getTime().count()));
+    writer.write("Identifier");
+    writer.write(pick.getIdentifier());
+    writer.write("UncertaintyBounds");
+    if (pick.haveLowerAndUpperUncertaintyBound())
+    {
+        auto bounds = pick.getLowerAndUpperUncertaintyBound();
+        writer.startMap(4);
+        writer.write("LowerPercentile");
+        writer.write(bounds.first.getPercentile());
+        writer.write("LowerPerturbation");
+        writer.write(static_cast<int64_t>
+                     (bounds.first.getPerturbation().count()));
+        writer.write("UpperPercentile");
+        writer.write(bounds.second.getPercentile());
+        writer.write("UpperPerturbation");
+        writer.write(static_cast<int64_t>
+                     (bounds.second.getPerturbation().count()));
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("SignalToNoiseRatio");
+    if (pick.haveSignalToNoiseRatio())
+    {
+        writer.write(pick.getSignalToNoiseRatio());
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("OriginalChannels");
+    if (!originalChannels.empty())
+    {
+        writer.startArray(originalChannels.size());
+        for (const auto &originalChannel : originalChannels)
+        {
+            writer.write(originalChannel);
+        }
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("PhaseHint");
+    if (!phaseHint.empty())
+    {
+        writer.write(phaseHint);
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("FirstMotion");
+    writer.write(static_cast<int> (pick.getFirstMotion()));
+    writer.write("ReviewStatus");
+    writer.write(static_cast<int> (pick.getReviewStatus()));
+    writer.write("ProcessingAlgorithms");
+    writer.startArray(processingAlgorithms.size());
+    for (const auto &algorithm : processingAlgorithms)
+    {
+        writer.write(algorithm);
+    }
+}
+
 Pick objectToPick(const nlohmann::json &obj)
 {
     Pick pick;
@@ -462,12 +552,17 @@ std::vector<std::string> Pick::getOriginalChannels() const noexcept
 ///  Convert message
 std::string Pick::toMessage() const
 {
-    auto obj = ::toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    std::string result;
+    ::toCBORMessage(*this, &result);
     return result; 
 }
 
+void Pick::serializeInto(std::string *buffer) const
+{
+    if (buffer == nullptr){throw std::invalid_argument("buffer is NULL");}
+    ::toCBORMessage(*this, buffer);
+}
+
 void Pick::fromMessage(const std::string &message)
 {
     if (message.empty()){throw std::invalid_argument("Message is empty");}
@@ -10,6 +10,7 @@
 #include "urts/broadcasts/internal/pick/publisher.hpp"
 #include "urts/broadcasts/internal/pick/publisherOptions.hpp"
 #include "urts/broadcasts/internal/pick/pick.hpp"
+#include "private/serializedMessage.hpp"
 
 using namespace URTS::Broadcasts::Internal::Pick;
 namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
@@ -113,5 +114,5 @@ void Publisher::send(const Pick &message)
             } 
         }
     }
-    pImpl->mPublisher->send(message); 
+    pImpl->mPublisher->send(::SerializedMessage<Pick> {message});
 }
@@ -1,3 +1,4 @@
+#include <iostream>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/messaging/xPublisherXSubscriber/subscriber.hpp>
 #include <umps/messaging/xPublisherXSubscriber/subscriberOptions.hpp>
@@ -8,6 +9,7 @@
 #include "urts/broadcasts/internal/pick/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/pick/pick.hpp"
 #include "private/staticUniquePointerCast.hpp"
+#include "private/receiveBatch.hpp"
 
 using namespace URTS::Broadcasts::Internal::Pick;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -18,13 +20,29 @@ class Subscriber::SubscriberImpl
 {
 public:
     SubscriberImpl(std::shared_ptr<UMPS::Messaging::Context> context,
-                   std::shared_ptr<UMPS::Logging::ILog> logger)
+                   std::shared_ptr<UMPS::Logging::ILog> logger) :
+        mLogger(logger)
     {
         mSubscriber = std::make_unique<UPubSub::Subscriber> (context, logger);
         std::unique_ptr<UMPS::MessageFormats::IMessage> pickMessageType
             = std::make_unique<Pick> (); 
         mMessageTypes.add(pickMessageType);
     }
+    /// @brief Reports a message in a batch that could not be received.
+    void reportReceiveError(const std::exception &e) const
+    {
+        std::string errorMessage{"Skipping message in batch.  "
+                               + std::string{e.what()}};
+        if (mLogger != nullptr)
+        {
+            mLogger->error(errorMessage);
+        }
+        else
+        {
+            std::cerr << errorMessage << std::endl;
+        }
+    }
+    std::shared_ptr<UMPS::Logging::ILog> mLogger;
     std::unique_ptr<UPubSub::Subscriber> mSubscriber;
     SubscriberOptions mOptions;
     UMPS::MessageFormats::Messages mMessageTypes;
@@ -109,3 +127,26 @@ std::unique_ptr<Pick> Subscriber::receive() const
     }
     return nullptr;
 }
+
+/// Receive all available messages
+int Subscriber::receiveBatch(std::vector<Pick> *picks,
+                             const int maxMessages,
+                             const std::chrono::milliseconds &timeOut) const
+{
+    if (picks == nullptr){throw std::invalid_argument("picks is NULL");}
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Subscriber not initialized");
+    }
+    picks->clear();
+    return ::receiveBatch([&](const int)
+    {
+        auto message = receive();
+        if (message == nullptr){return 0;}
+        picks->push_back(std::move(*message));
+        return 1;
+    }, [&](const std::exception &e)
+    {
+        pImpl->reportReceiveError(e);
+    }, maxMessages, timeOut);
+}
@@ -1,88 +1,337 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <optional>
+#include <type_traits>
 #include <chrono>
 #include <cmath>
-#include <nlohmann/json.hpp>
+#include <cstring>
+#include <limits>
+#include <bit>
 #include "urts/broadcasts/internal/probabilityPacket/probabilityPacket.hpp"
 #include "private/isEmpty.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Broadcasts::Internal::ProbabilityPacket::ProbabilityPacket"
 #define MESSAGE_VERSION "1.0.0"
+#define COMPACT_MESSAGE_VERSION "2.0.0"
 
 using namespace URTS::Broadcasts::Internal::ProbabilityPacket;
 
 namespace
 {
 
-nlohmann::json toJSONObject(const ProbabilityPacket &packet)
-{
-    nlohmann::json obj;
-    obj["MessageType"] = packet.getMessageType();
-    obj["MessageVersion"] = packet.getMessageVersion();
-    obj["Network"] = packet.getNetwork();
-    obj["Station"] = packet.getStation();
-    obj["Channel"] = packet.getChannel();
-    obj["LocationCode"] = packet.getLocationCode();
-    obj["StartTime"] = packet.getStartTime().count();
-    obj["SamplingRate"] = packet.getSamplingRate();
-    obj["Algorithm"] = packet.getAlgorithm();
-    obj["PositiveClassName"] = packet.getPositiveClassName();
-    obj["NegativeClassName"] = packet.getNegativeClassName();
-    obj["OriginalChannels"] = packet.getOriginalChannels();
-    if (packet.haveSamplingRate() && packet.getNumberOfSamples() > 0)
+namespace UPP = URTS::Broadcasts::Internal::ProbabilityPacket;
+
+/// @result The name of the encoding in the message.
+[[nodiscard]] std::string_view toString(const UPP::ProbabilityPacket::Encoding encoding)
+{
+    if (encoding == UPP::ProbabilityPacket::Encoding::Float32)
+    {
+        return "Float32";
+    }
+    if (encoding == UPP::ProbabilityPacket::Encoding::UInt16)
     {
-        obj["EndTime"] = packet.getEndTime().count();
+        return "UInt16";
+    }
+    return "Float64";
+}
+
+[[nodiscard]] UPP::ProbabilityPacket::Encoding
+    toEncoding(const std::string_view &encoding)
+{
+    if (encoding == "Float64"){return UPP::ProbabilityPacket::Encoding::Float64;}
+    if (encoding == "Float32"){return UPP::ProbabilityPacket::Encoding::Float32;}
+    if (encoding == "UInt16"){return UPP::ProbabilityPacket::Encoding::UInt16;}
+    throw std::runtime_error("Unhandled probability encoding "
+                           + std::string {encoding});
+}
+
+/// @result The probability as a fixed-point number.
+[[nodiscard]] uint16_t quantize(const double probability) noexcept
+{
+    constexpr double scale{std::numeric_limits<uint16_t>::max()};
+    if (!(probability > 0)){return 0;} // Also handles NaN
+    if (probability >= 1){return std::numeric_limits<uint16_t>::max();}
+    return static_cast<uint16_t> (probability*scale + 0.5);
+}
+
+template<typename T>
+void writeLittleEndian(const T value, char *destination) noexcept
+{
+    auto bits = std::bit_cast<std::array<char, sizeof(T)>> (value);
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    std::memcpy(destination, bits.data(), sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] T readLittleEndian(const char *source) noexcept
+{
+    std::array<char, sizeof(T)> bits;
+    std::memcpy(bits.data(), source, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bits.begin(), bits.end());
+    }
+    return std::bit_cast<T> (bits);
+}
+
+/// @brief Writes the probabilities as a byte string of the given type.
+template<typename T>
+void writeCompactData(const std::vector<double> &data, ::CBORWriter *writer)
+{
+    auto *destination = writer->startBytes(sizeof(T)*data.size());
+    for (const auto &x : data)
+    {
+        if constexpr (std::is_same_v<T, uint16_t>)
+        {
+            ::writeLittleEndian(::quantize(x), destination);
+        }
+        else
+        {
+            ::writeLittleEndian(static_cast<T> (x), destination);
+        }
+        destination = destination + sizeof(T);
+    }
+}
+
+/// @brief Reads the probabilities from a byte string of the given type.
+template<typename T>
+void readCompactData(const std::string_view &bytes, std::vector<double> *data)
+{
+    if (bytes.size() % sizeof(T) != 0)
+    {
+        throw std::runtime_error("Probability data has invalid length");
+    }
+    auto n = bytes.size()/sizeof(T);
+    data->resize(n);
+    const auto *source = bytes.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto value = ::readLittleEndian<T> (source + sizeof(T)*i);
+        if constexpr (std::is_same_v<T, uint16_t>)
+        {
+            constexpr double scale{std::numeric_limits<uint16_t>::max()};
+            (*data)[i] = value/scale;
+        }
+        else
+        {
+            (*data)[i] = static_cast<double> (value);
+        }
+    }
+}
+
+void toCBORMessage(const UPP::ProbabilityPacket &packet, std::string *result)
+{
+    const auto &data = packet.getDataReference();
+    auto encoding = packet.getEncoding();
+    bool compact = (encoding != UPP::ProbabilityPacket::Encoding::Float64);
+    auto originalChannels = packet.getOriginalChannels();
+    result->clear();
+    result->reserve(512 + 9*data.size());
+    ::CBORWriter writer(result);
+    writer.startMap(compact ? 15 : 14);
+    writer.write("MessageType");
+    writer.write(packet.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(packet.getMessageVersion());
+    writer.write("Network");
+    writer.write(packet.getNetwork());
+    writer.write("Station");
+    writer.write(packet.getStation());
+    writer.write("Channel");
+    writer.write(packet.getChannel());
+    writer.write("LocationCode");
+    writer.write(packet.getLocationCode());
+    writer.write("StartTime");
+    writer.write(static_cast<int64_t> (packet.getStartTime().count()));
+    writer.write("SamplingRate");
+    writer.write(packet.getSamplingRate());
+    writer.write("Algorithm");
+    writer.write(packet.getAlgorithm());
+    writer.write("PositiveClassName");
+    writer.write(packet.getPositiveClassName());
+    writer.write("NegativeClassName");
+    writer.write(packet.getNegativeClassName());
+    writer.write("OriginalChannels");
+    writer.startArray(originalChannels.size());
+    for (const auto &originalChannel : originalChannels)
+    {
+        writer.write(originalChannel);
+    }
+    writer.write("EndTime");
+    if (!data.empty())
+    {
+        writer.write(static_cast<int64_t> (packet.getEndTime().count()));
     }
     else
     {
-        obj["EndTime"] = nullptr;
+        writer.writeNull();
     }
-    if (packet.getNumberOfSamples() > 0)
+    if (compact)
     {
-        obj["Data"] = packet.getData();
+        writer.write("Encoding");
+        writer.write(::toString(encoding));
+    }
+    writer.write("Data");
+    if (data.empty())
+    {
+        writer.writeNull();
+    }
+    else if (encoding == UPP::ProbabilityPacket::Encoding::Float32)
+    {
+        ::writeCompactData<float> (data, &writer);
+    }
+    else if (encoding == UPP::ProbabilityPacket::Encoding::UInt16)
+    {
+        ::writeCompactData<uint16_t> (data, &writer);
     }
     else
     {
-        obj["Data"] = nullptr;
+        writer.write(data.data(), data.size());
     }
-    return obj;
 }
 
-ProbabilityPacket objectToProbabilityPacket(const nlohmann::json &obj)
-{
-    ProbabilityPacket packet;
-    if (obj["MessageType"] != packet.getMessageType())
+UPP::ProbabilityPacket fromCBORMessage(const uint8_t *message,
+                                       const size_t length)
+{
+    UPP::ProbabilityPacket packet;
+    ::CBORReader reader(message, length);
+    std::optional<std::string_view> messageType;
+    std::optional<std::string> network;
+    std::optional<std::string> station;
+    std::optional<std::string> channel;
+    std::optional<std::string> locationCode;
+    std::optional<double> samplingRate;
+    std::optional<std::string> algorithm;
+    std::optional<std::string> positiveClassName;
+    std::optional<std::string> negativeClassName;
+    std::optional<int64_t> startTime;
+    std::vector<std::string> originalChannels;
+    std::vector<double> data;
+    std::string_view compactData;
+    auto encoding = UPP::ProbabilityPacket::Encoding::Float64;
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Network")
+        {
+            network = reader.readString();
+        }
+        else if (key == "Station")
+        {
+            station = reader.readString();
+        }
+        else if (key == "Channel")
+        {
+            channel = reader.readString();
+        }
+        else if (key == "LocationCode")
+        {
+            locationCode = reader.readString();
+        }
+        else if (key == "SamplingRate")
+        {
+            samplingRate = reader.readDouble();
+        }
+        else if (key == "Algorithm")
+        {
+            algorithm = reader.readString();
+        }
+        else if (key == "PositiveClassName")
+        {
+            positiveClassName = reader.readString();
+        }
+        else if (key == "NegativeClassName")
+        {
+            negativeClassName = reader.readString();
+        }
+        else if (key == "OriginalChannels")
+        {
+            if (reader.readNull()){return true;}
+            auto nChannels = reader.readArraySize();
+            for (uint64_t i = 0; i < nChannels; ++i)
+            {
+                originalChannels.push_back(reader.readString());
+            }
+        }
+        else if (key == "StartTime")
+        {
+            startTime = reader.readInteger();
+        }
+        else if (key == "Encoding")
+        {
+            encoding = ::toEncoding(reader.readStringView());
+        }
+        else if (key == "Data")
+        {
+            if (reader.readNull()){return true;}
+            if (reader.peekBytes())
+            {
+                compactData = reader.readBytesView();
+            }
+            else
+            {
+                reader.readDoubles(&data);
+            }
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (::requireField(messageType, "MessageType") != packet.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    packet.setNetwork(obj["Network"].get<std::string> ());
-    packet.setStation(obj["Station"].get<std::string> ());
-    packet.setChannel(obj["Channel"].get<std::string> ());
-    packet.setLocationCode(obj["LocationCode"].get<std::string> ());
-    packet.setSamplingRate(obj["SamplingRate"].get<double> ());
-    packet.setAlgorithm(obj["Algorithm"].get<std::string> ());
-    packet.setPositiveClassName(obj["PositiveClassName"].get<std::string> ());
-    packet.setNegativeClassName(obj["NegativeClassName"].get<std::string> ());
-    std::vector<std::string> originalChannels = obj["OriginalChannels"];
+    packet.setNetwork(::requireField(network, "Network"));
+    packet.setStation(::requireField(station, "Station"));
+    packet.setChannel(::requireField(channel, "Channel"));
+    packet.setLocationCode(::requireField(locationCode, "LocationCode"));
+    packet.setSamplingRate(::requireField(samplingRate, "SamplingRate"));
+    packet.setAlgorithm(::requireField(algorithm, "Algorithm"));
+    packet.setPositiveClassName(
+        ::requireField(positiveClassName, "PositiveClassName"));
+    packet.setNegativeClassName(
+        ::requireField(negativeClassName, "NegativeClassName"));
     if (!originalChannels.empty())
     {
         packet.setOriginalChannels(originalChannels);
     }
-    auto startTime = obj["StartTime"].get<int64_t> ();
-    std::chrono::microseconds startTimeMuS{startTime};
+    std::chrono::microseconds startTimeMuS{
+        ::requireField(startTime, "StartTime")};
     packet.setStartTime(startTimeMuS);
-    std::vector<double> data = obj["Data"];
+    if (!compactData.empty())
+    {
+        if (encoding == UPP::ProbabilityPacket::Encoding::Float32)
+        {
+            ::readCompactData<float> (compactData, &data);
+        }
+        else if (encoding == UPP::ProbabilityPacket::Encoding::UInt16)
+        {
+            ::readCompactData<uint16_t> (compactData, &data);
+        }
+        else
+        {
+            throw std::runtime_error("Byte string data requires an encoding");
+        }
+    }
     if (!data.empty()){packet.setData(std::move(data));}
+    packet.setEncoding(encoding);
     return packet;
 }
 
-ProbabilityPacket fromCBORMessage(const uint8_t *message, const size_t length)
-{
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return ::objectToProbabilityPacket(obj);
-}
-
 }
 
 class ProbabilityPacket::ProbabilityPacketImpl
@@ -115,6 +364,7 @@ public:
     /// End time in microseconds (10e-6)
     std::chrono::microseconds mEndTimeMicroSeconds{0};
     double mSamplingRate{0};
+    Encoding mEncoding{Encoding::Float64};
 };
 
 /// Clear class
@@ -129,6 +379,7 @@ void ProbabilityPacket::clear() noexcept
     pImpl->mStartTimeMicroSeconds = zeroMuS;
     pImpl->mEndTimeMicroSeconds = zeroMuS;
     pImpl->mSamplingRate = 0;
+    pImpl->mEncoding = Encoding::Float64;
 }
 
 /// C'tor
@@ -383,6 +634,17 @@ const std::vector<double> &ProbabilityPacket::getDataReference() const noexcept
     return pImpl->mData;
 }
 
+/// Encoding
+void ProbabilityPacket::setEncoding(const Encoding encoding) noexcept
+{
+    pImpl->mEncoding = encoding;
+}
+
+ProbabilityPacket::Encoding ProbabilityPacket::getEncoding() const noexcept
+{
+    return pImpl->mEncoding;
+}
+
 /// Message format
 std::string ProbabilityPacket::getMessageType() const noexcept
 {
@@ -392,6 +654,10 @@ std::string ProbabilityPacket::getMessageType() const noexcept
 /// Message version
 std::string ProbabilityPacket::getMessageVersion() const noexcept
 {
+    if (pImpl->mEncoding != Encoding::Float64)
+    {
+        return COMPACT_MESSAGE_VERSION;
+    }
     return MESSAGE_VERSION;
 }
 
@@ -415,10 +681,15 @@ std::unique_ptr<UMPS::MessageFormats::IMessage>
 ///  Convert message
 std::string ProbabilityPacket::toMessage() const
 {
-    auto obj = ::toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
-    return result;
+    std::string message;
+    ::toCBORMessage(*this, &message);
+    return message;
+}
+
+void ProbabilityPacket::serializeInto(std::string *buffer) const
+{
+    if (buffer == nullptr){throw std::invalid_argument("buffer is NULL");}
+    ::toCBORMessage(*this, buffer);
 }
 
 void ProbabilityPacket::fromMessage(const std::string &message)
@@ -9,6 +9,7 @@
 #include "urts/broadcasts/internal/probabilityPacket/publisher.hpp"
 #include "urts/broadcasts/internal/probabilityPacket/publisherOptions.hpp"
 #include "urts/broadcasts/internal/probabilityPacket/probabilityPacket.hpp"
+#include "private/serializedMessage.hpp"
 
 using namespace URTS::Broadcasts::Internal::ProbabilityPacket;
 namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
@@ -94,5 +95,5 @@ Publisher::~Publisher() = default;
 /// Send
 void Publisher::send(const ProbabilityPacket &message)
 {
-    pImpl->mPublisher->send(message); 
+    pImpl->mPublisher->send(::SerializedMessage<ProbabilityPacket> {message});
 }
@@ -1,3 +1,4 @@
+#include <iostream>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/messaging/publisherSubscriber/subscriber.hpp>
 #include <umps/messaging/publisherSubscriber/subscriberOptions.hpp>
@@ -8,6 +9,7 @@
 #include "urts/broadcasts/internal/probabilityPacket/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/probabilityPacket/probabilityPacket.hpp"
 #include "private/staticUniquePointerCast.hpp"
+#include "private/receiveBatch.hpp"
 
 using namespace URTS::Broadcasts::Internal::ProbabilityPacket;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -27,6 +29,20 @@ public:
                 = std::make_unique<ProbabilityPacket> (); 
         mMessageTypes.add(probabilityPacketMessageType);
     }
+    /// @brief Reports a message in a batch that could not be received.
+    void reportReceiveError(const std::exception &e) const
+    {
+        std::string errorMessage{"Skipping message in batch.  "
+                               + std::string{e.what()}};
+        if (mLogger != nullptr)
+        {
+            mLogger->error(errorMessage);
+        }
+        else
+        {
+            std::cerr << errorMessage << std::endl;
+        }
+    }
     std::shared_ptr<UMPS::Logging::ILog> mLogger;
     std::unique_ptr<UPubSub::Subscriber> mSubscriber;
     SubscriberOptions mOptions;
@@ -124,3 +140,26 @@ std::unique_ptr<ProbabilityPacket> Subscriber::receive() const
     }
     return nullptr;
 }
+
+/// Receive all available messages
+int Subscriber::receiveBatch(std::vector<ProbabilityPacket> *packets,
+                             const int maxMessages,
+                             const std::chrono::milliseconds &timeOut) const
+{
+    if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Subscriber not initialized");
+    }
+    packets->clear();
+    return ::receiveBatch([&](const int)
+    {
+        auto message = receive();
+        if (message == nullptr){return 0;}
+        packets->push_back(std::move(*message));
+        return 1;
+    }, [&](const std::exception &e)
+    {
+        pImpl->reportReceiveError(e);
+    }, maxMessages, timeOut);
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <filesystem>
 #include <string>
+#include <vector>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -326,14 +327,29 @@ public:
         assert(mPickSubscriber->isInitialized());
 #endif
         mLogger->debug("Starting the pick subscriber...");
+        // Bursts are handed to the queue under one lock and wakeup
+        constexpr int maxPicks{256};
+        constexpr std::chrono::milliseconds batchTimeOut{10};
+        std::vector<URTS::Broadcasts::Internal::Pick::Pick> picks;
+        std::vector<URTS::Services::Scalable::Associators::MAssociate::Pick>
+            massPicks;
         while (keepRunning())
         {
-            auto pick = mPickSubscriber->receive();
-            if (pick != nullptr)
+            try
+            {
+                mPickSubscriber->receiveBatch(&picks, maxPicks, batchTimeOut);
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Error receiving picks: "
+                             + std::string {e.what()});
+                continue;
+            }
+            for (const auto &pick : picks)
             {
                 try
                 {
-                    URTS::Services::Scalable::Associators::MAssociate::Pick massPick{*pick};
+                    URTS::Services::Scalable::Associators::MAssociate::Pick massPick{pick};
                     auto network = massPick.getNetwork();
 //std::cout << massPick.getStandardError() << " " << static_cast<int> (massPick.getPhaseHint()) << std::endl;
 // TODO fix this
@@ -376,14 +392,14 @@ else
                     {
                         if (sendUtah)
                         {
-                            mPickSubscriberQueue.push(std::move(massPick));
+                            massPicks.push_back(std::move(massPick));
                         } 
                     }
                     else
                     {
                         if (sendYNP)
                         {
-                            mPickSubscriberQueue.push(std::move(massPick));
+                            massPicks.push_back(std::move(massPick));
                         }
                     }
                 }
@@ -392,6 +408,7 @@ else
                     mLogger->warn(e.what());
                 } 
             }
+            mPickSubscriberQueue.push_all(&massPicks);
         }
         mLogger->debug("Pick subscriber thread leaving...");
     }
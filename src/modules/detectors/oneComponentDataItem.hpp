@@ -353,7 +353,7 @@ public:
             {
                 nPSamplesOut
                     = static_cast<int>
-                      (pResponse->getProbabilitySignalReference().size());
+                      (pResponse->getProbabilitySignalView().size());
                 mInferencedP = true;
             }
         }
@@ -406,7 +406,7 @@ public:
         // Unpack the signal 
         if (mInferencedP)
         {
-            const auto &pRef = pResponse->getProbabilitySignalReference();
+            auto pRef = pResponse->getProbabilitySignalView();
             std::vector<double> pSignal(std::max(0, i1 - i0), 0);
             if (!haveGaps)
             {
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <mutex>
 #include <array>
+#include <span>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -56,18 +57,18 @@ inference1C(const URTS::Services::Scalable::PacketCache::
 std::vector<double>
 extractSignal(const bool changesSamplingRate,
               const int i0, const int i1,
-              const std::vector<double> &pRef,
+              const std::span<const double> pRef,
               const URTS::Services::Scalable::
                           PacketCache::SingleComponentWaveform &interpolator,
               std::shared_ptr<UMPS::Logging::ILog> &logger)
 {
     std::vector<double> pSignal(std::max(0, i1 - i0), 0);
-    if (!interpolator.haveGaps())
-    {
 #ifndef NDEBUG
-        assert(i0 >= 0);
-        assert(i1 <= static_cast<int> (pRef.size()));
+    assert(i0 >= 0);
+    assert(i1 <= static_cast<int> (pRef.size()));
 #endif
+    if (!interpolator.haveGaps())
+    {
         std::copy(pRef.begin() + i0, pRef.begin() + i1,
                   pSignal.data());
     }
@@ -79,7 +80,7 @@ extractSignal(const bool changesSamplingRate,
             for (int i = i0; i < i1; ++i)
             {
 #ifndef NDEBUG
-                pSignal.at(i - i0) = pRef.at(i)*gapIndicator.at(i);
+                pSignal.at(i - i0) = pRef[i]*gapIndicator.at(i);
 #else
                 pSignal[i - i0] = pRef[i]*gapIndicator[i];
 #endif
@@ -92,7 +93,7 @@ extractSignal(const bool changesSamplingRate,
             for (int i = i0; i < i1; ++i)
             {
 #ifndef NDEBUG
-                pSignal.at(i - i0) = pRef.at(i);
+                pSignal.at(i - i0) = pRef[i];
 #else
                 pSignal[i - i0] = pRef[i];
 #endif
@@ -424,7 +425,7 @@ public:
                                       mPInferenceRequest);
             mInferencedP = true;
             nSamplesOut = static_cast<int>
-                          (pResponse->getProbabilitySignalReference().size());
+                          (pResponse->getProbabilitySignalView().size());
         }
         catch (const std::exception &e)
         {
@@ -447,7 +448,7 @@ public:
             = std::chrono::microseconds {static_cast<int64_t> (dtMuSec)};
         if (mInferencedP)
         {
-            const auto &pRef = pResponse->getProbabilitySignalReference();
+            auto pRef = pResponse->getProbabilitySignalView();
             auto pSignal = ::extractSignal(mChangesSamplingRate,
                                            i0, i1, pRef,
                                            mInterpolator,
@@ -491,6 +492,13 @@ public:
 #endif
         mState = State::Query;
     }
+    /// @brief Sets the encoding of the broadcast probability packets.
+    void setProbabilityPacketEncoding(
+        const URTS::Broadcasts::Internal::ProbabilityPacket::
+                    ProbabilityPacket::Encoding encoding) noexcept
+    {
+        mPProbabilityPacket.setEncoding(encoding);
+    }
     [[nodiscard]] size_t getHash() const noexcept
     {
         return mHash;
@@ -617,6 +625,8 @@ public:
                      p1CProperties.mWindowStart,
                      p1CProperties.mWindowEnd,
                      p1CProperties.mSamplingRate);
+            item.setProbabilityPacketEncoding(
+                mProgramOptions.mProbabilityPacketEncoding);
             mPItems.insert(std::pair{item.getHash(), item});
         }
         mInitialized = true;
@@ -123,6 +123,32 @@ public:
         {
             throw std::runtime_error("Probability broadcast indeterminable");
         }
+        // Compact encodings reduce the bandwidth to the pickers
+        std::string probabilityEncoding
+            = propertyTree.get<std::string> (
+                 "MLDetector.probabilityEncoding", "Float64");
+        namespace UPP = URTS::Broadcasts::Internal::ProbabilityPacket;
+        if (probabilityEncoding == "Float64")
+        {
+            mProbabilityPacketEncoding
+                = UPP::ProbabilityPacket::Encoding::Float64;
+        }
+        else if (probabilityEncoding == "Float32")
+        {
+            mProbabilityPacketEncoding
+                = UPP::ProbabilityPacket::Encoding::Float32;
+        }
+        else if (probabilityEncoding == "UInt16")
+        {
+            mProbabilityPacketEncoding
+                = UPP::ProbabilityPacket::Encoding::UInt16;
+        }
+        else
+        {
+            throw std::invalid_argument(
+                "MLDetector.probabilityEncoding must be Float64, Float32, "
+                "or UInt16");
+        }
         mP3CDetectorServiceName
             = propertyTree.get<std::string> (
                 "MLDetector.pThreeComponentDetectorServiceName",
@@ -308,6 +334,12 @@ public:
         mPacketCacheRequestorOptions;
     URTS::Broadcasts::Internal::ProbabilityPacket::PublisherOptions
         mProbabilityPacketPublisherOptions;
+    URTS::Broadcasts::Internal::ProbabilityPacket::ProbabilityPacket::Encoding
+        mProbabilityPacketEncoding
+        {
+            URTS::Broadcasts::Internal::ProbabilityPacket::
+                ProbabilityPacket::Encoding::Float64
+        };
     double mDataQueryWaitPercentage{30};
     int mDatabasePort{5432};
     int mProbabilityPacketHighWaterMark{0}; // Infinite
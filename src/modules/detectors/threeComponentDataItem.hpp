@@ -285,6 +285,20 @@ public:
 #ifndef NDEBUG
         assert(indices[0] != -1 && indices[1] != -1 && indices[2] != -2);
 #endif
+        // Reuse the packet cache's sensor identifiers in subsequent requests
+        // so the cache can skip looking up the channels by name
+        std::array<URTS::Services::Scalable::PacketCache::DataRequest *, 3>
+            requests{&mVerticalRequest, &mNorthRequest, &mEastRequest};
+        for (int k = 0; k < 3; ++k)
+        {
+            if (indices[k] < 0){continue;}
+            const auto &dataResponse = dataResponsesPtr[indices[k]];
+            if (dataResponse.haveSensorIdentifier())
+            {
+                requests[k]->setSensorIdentifier(
+                    dataResponse.getSensorIdentifier());
+            }
+        }
         // Is there data?
         if (dataResponsesPtr[indices[0]].getNumberOfPackets() < 1 ||
             dataResponsesPtr[indices[1]].getNumberOfPackets() < 1 ||
@@ -441,7 +455,7 @@ public:
             {
                 nPSamplesOut
                     = static_cast<int>
-                      (pResponse->getProbabilitySignalReference().size());
+                      (pResponse->getProbabilitySignalView().size());
                 mInferencedP = true;
             }
         }
@@ -465,7 +479,7 @@ public:
             {
                 nSSamplesOut
                     = static_cast<int>
-                      (sResponse->getProbabilitySignalReference().size());
+                      (sResponse->getProbabilitySignalView().size());
                 mInferencedS = true;
             }
         }
@@ -530,7 +544,7 @@ public:
         // Unpack the signal 
         if (mInferencedP)
         {
-            const auto &pRef = pResponse->getProbabilitySignalReference();
+            auto pRef = pResponse->getProbabilitySignalView();
             std::vector<double> pSignal(std::max(0, i1 - i0), 0);
             if (!haveGaps)
             {
@@ -569,7 +583,7 @@ public:
         }
         if (mInferencedS)
         {
-            const auto &pRef = sResponse->getProbabilitySignalReference();
+            auto pRef = sResponse->getProbabilitySignalView();
             std::vector<double> pSignal(std::max(0, i1 - i0), 0);
             if (!haveGaps)
             {
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <mutex>
 #include <array>
+#include <span>
 #ifndef NDEBUG
 #include <cassert>
 #endif
@@ -131,18 +132,18 @@ inference3C(const URTS::Services::Scalable::PacketCache::
 std::vector<double>
 extractSignal(const bool changesSamplingRate,
               const int i0, const int i1,
-              const std::vector<double> &pRef,
+              const std::span<const double> pRef,
               const URTS::Services::Scalable::
                           PacketCache::ThreeComponentWaveform &interpolator,
               std::shared_ptr<UMPS::Logging::ILog> &logger)
 {
     std::vector<double> pSignal(std::max(0, i1 - i0), 0);
-    if (!interpolator.haveGaps())
-    {
 #ifndef NDEBUG
-        assert(i0 >= 0);
-        assert(i1 <= static_cast<int> (pRef.size()));
+    assert(i0 >= 0);
+    assert(i1 <= static_cast<int> (pRef.size()));
 #endif
+    if (!interpolator.haveGaps())
+    {
         std::copy(pRef.begin() + i0, pRef.begin() + i1,
                   pSignal.data());
     }
@@ -154,7 +155,7 @@ extractSignal(const bool changesSamplingRate,
             for (int i = i0; i < i1; ++i)
             {
 #ifndef NDEBUG
-                pSignal.at(i - i0) = pRef.at(i)*gapIndicator.at(i);
+                pSignal.at(i - i0) = pRef[i]*gapIndicator.at(i);
 #else
                 pSignal[i - i0] = pRef[i]*gapIndicator[i];
 #endif
@@ -167,7 +168,7 @@ extractSignal(const bool changesSamplingRate,
             for (int i = i0; i < i1; ++i)
             {
 #ifndef NDEBUG
-                pSignal.at(i - i0) = pRef.at(i);
+                pSignal.at(i - i0) = pRef[i];
 #else
                 pSignal[i - i0] = pRef[i];
 #endif
@@ -307,6 +308,14 @@ public:
         updateLastProbabilityTimeToNow();
         mState = State::Query;
     }
+    /// @brief Sets the encoding of the broadcast probability packets.
+    void setProbabilityPacketEncoding(
+        const URTS::Broadcasts::Internal::ProbabilityPacket::
+                    ProbabilityPacket::Encoding encoding) noexcept
+    {
+        mPProbabilityPacket.setEncoding(encoding);
+        mSProbabilityPacket.setEncoding(encoding);
+    }
     /// @result The hash.
     [[nodiscard]] size_t getHash() const noexcept
     {
@@ -322,6 +331,15 @@ public:
     {
         mLastProbabilityTime = ::getNow();
     }
+    /// @brief Discards the received packets and cursors so the next query
+    ///        obtains the entire query window.
+    void resetCursors()
+    {
+        for (auto &dataResponse : mDataResponses){dataResponse.clear();}
+        mVerticalRequest.setCursor(0);
+        mNorthRequest.setCursor(0);
+        mEastRequest.setCursor(0);
+    }
     /// @brief Queries the packet cache
     void queryPacketCache(
         URTS::Services::Scalable::PacketCache::Requestor &requestor,
@@ -440,10 +458,46 @@ public:
 #ifndef NDEBUG
         assert(indices[0] != -1 && indices[1] != -1 && indices[2] != -2);
 #endif
+        // The packet cache only sent what is new since the last query so
+        // merge that into what we already have.  Then reuse the cache's
+        // sensor identifiers and cursors in subsequent requests.
+        std::array<URTS::Services::Scalable::PacketCache::DataRequest *, 3>
+            requests{&mVerticalRequest, &mNorthRequest, &mEastRequest};
+        for (int k = 0; k < 3; ++k)
+        {
+            if (indices[k] < 0){continue;}
+            const auto &dataResponse = dataResponsesPtr[indices[k]];
+            try
+            {
+                mDataResponses[k].merge(dataResponse, t0QueryMuSec);
+            }
+            catch (const std::exception &e)
+            {
+                logger->error("Instance " + std::to_string(mInstance)
+                            + " failed to merge responses for " + mName
+                            + ".  Failed with: " + std::string{e.what()});
+                resetCursors();
+                return;
+            }
+            if (dataResponse.haveSensorIdentifier())
+            {
+                requests[k]->setSensorIdentifier(
+                    dataResponse.getSensorIdentifier());
+            }
+            if (dataResponse.haveCursorEndTime())
+            {
+                requests[k]->setCursor(dataResponse.getCursor(),
+                                       dataResponse.getCursorEndTime());
+            }
+            else if (dataResponse.haveCursor())
+            {
+                requests[k]->setCursor(dataResponse.getCursor());
+            }
+        }
         // Is there data?
-        if (dataResponsesPtr[indices[0]].getNumberOfPackets() < 1 ||
-            dataResponsesPtr[indices[1]].getNumberOfPackets() < 1 ||
-            dataResponsesPtr[indices[2]].getNumberOfPackets() < 1)
+        if (mDataResponses[0].getNumberOfPackets() < 1 ||
+            mDataResponses[1].getNumberOfPackets() < 1 ||
+            mDataResponses[2].getNumberOfPackets() < 1)
         {
             return;
         }
@@ -451,9 +505,9 @@ public:
         // also truncates the signal.
         try
         {
-            mInterpolator.set(dataResponsesPtr[indices[0]],
-                              dataResponsesPtr[indices[1]],
-                              dataResponsesPtr[indices[2]],
+            mInterpolator.set(mDataResponses[0],
+                              mDataResponses[1],
+                              mDataResponses[2],
                               t0QueryMuSec,
                               t1QueryMuSec);
         }
@@ -563,7 +617,7 @@ public:
                                       mPInferenceRequest);
             mInferencedP = true;
             nPSamplesOut = static_cast<int>
-                           (pResponse->getProbabilitySignalReference().size());
+                           (pResponse->getProbabilitySignalView().size());
         }
         catch (const std::exception &e)
         {
@@ -584,7 +638,7 @@ public:
                                       mSInferenceRequest);
             mInferencedS = true;
             nSSamplesOut = static_cast<int>
-                           (sResponse->getProbabilitySignalReference().size());
+                           (sResponse->getProbabilitySignalView().size());
         }
         catch (const std::exception &e)
         {
@@ -624,7 +678,7 @@ public:
             = std::chrono::microseconds {static_cast<int64_t> (dtMuSec)};
         if (mInferencedP)
         {
-            const auto &pRef = pResponse->getProbabilitySignalReference();
+            auto pRef = pResponse->getProbabilitySignalView();
             auto pSignal = ::extractSignal(mChangesSamplingRate,
                                            i0, i1, pRef,
                                            mInterpolator,
@@ -638,7 +692,7 @@ public:
         }
         if (mInferencedS)
         {
-            const auto &pRef = sResponse->getProbabilitySignalReference();
+            auto pRef = sResponse->getProbabilitySignalView();
             auto pSignal = ::extractSignal(mChangesSamplingRate,
                                            i0, i1, pRef,
                                            mInterpolator,
@@ -699,6 +753,10 @@ public:
     URTS::Services::Scalable::PacketCache::DataRequest mVerticalRequest;
     URTS::Services::Scalable::PacketCache::DataRequest mNorthRequest;
     URTS::Services::Scalable::PacketCache::DataRequest mEastRequest;
+    /// The packets received so far for the vertical, north, and east
+    /// channels.  The packet cache responses are merged into these.
+    std::array<URTS::Services::Scalable::PacketCache::DataResponse, 3>
+        mDataResponses;
     // Partially populated requests for the inference services
     URTS::Services::Scalable::Detectors::UNetThreeComponentP::ProcessingRequest
         mPInferenceRequest;
@@ -835,6 +893,8 @@ public:
                              p3CProperties.mWindowStart,
                              p3CProperties.mWindowEnd,
                              p3CProperties.mSamplingRate);
+                    item.setProbabilityPacketEncoding(
+                        mProgramOptions.mProbabilityPacketEncoding);
                     mPSItems.insert(std::pair{item.getHash(), item});
                 }
             }
@@ -505,6 +505,20 @@ public:
 #ifndef NDEBUG
         assert(indices[0] != -1 && indices[1] != -1 && indices[2] != -2);
 #endif
+        // Reuse the packet cache's sensor identifiers in subsequent requests
+        // so the cache can skip looking up the channels by name
+        std::array<URTS::Services::Scalable::PacketCache::DataRequest *, 3>
+            requests{&mVerticalDataRequest, &mNorthDataRequest, &mEastDataRequest};
+        for (int k = 0; k < 3; ++k)
+        {
+            if (indices[k] < 0){continue;}
+            const auto &dataResponse = dataResponsesPtr[indices[k]];
+            if (dataResponse.haveSensorIdentifier())
+            {
+                requests[k]->setSensorIdentifier(
+                    dataResponse.getSensorIdentifier());
+            }
+        }
         // Is there data?
         if (dataResponsesPtr[indices[0]].getNumberOfPackets() < 1 ||
             dataResponsesPtr[indices[1]].getNumberOfPackets() < 1 ||
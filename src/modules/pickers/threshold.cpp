@@ -4,6 +4,7 @@
 #include <mutex>
 #include <string>
 #include <map>
+#include <vector>
 #include <chrono>
 #ifndef NDEBUG
 #include <cassert>
@@ -452,12 +453,24 @@ public:
     /// @brief Reads packets
     void getPackets()
     {
+        // Bursts are handed to the queue under one lock and wakeup
+        constexpr int maxPackets{256};
+        constexpr std::chrono::milliseconds batchTimeOut{10};
+        std::vector<URTS::Broadcasts::Internal::ProbabilityPacket::
+                    ProbabilityPacket> packets;
         while (keepRunning())
         {
-            auto packet = mProbabilityPacketSubscriber->receive();
-            if (packet != nullptr)
+            try
             {
-                mProbabilityPacketQueue.push(std::move(*packet));
+                mProbabilityPacketSubscriber->receiveBatch(&packets,
+                                                           maxPackets,
+                                                           batchTimeOut);
+                mProbabilityPacketQueue.push_all(&packets);
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Error receiving probability packets: "
+                             + std::string {e.what()});
             }
         }
     }
@@ -1,7 +1,12 @@
 #include <vector>
-#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <chrono>
 #include "urts/services/scalable/associators/massociate/associationRequest.hpp"
 #include "urts/services/scalable/associators/massociate/pick.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Associators::MAssociate::AssocationRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -13,76 +18,135 @@ namespace
 
 std::string toCBORObject(const AssociationRequest &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
     const auto &picks = message.getPicksReference();
+    std::string result;
+    result.reserve(256 + 192*picks.size());
+    CBORWriter writer(&result);
+    writer.startMap(4);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("Picks");
     if (!picks.empty())
     {
-        nlohmann::json jsonPicks;
+        writer.startArray(picks.size());
         for (const auto &pick : picks)
         {
-            nlohmann::json pickObject;
-            pickObject["Network"] = pick.getNetwork();
-            pickObject["Station"] = pick.getStation();
-            pickObject["Channel"] = pick.getChannel();
-            pickObject["LocationCode"] = pick.getLocationCode();
-            pickObject["Time"] = static_cast<int64_t> (pick.getTime().count());
-            pickObject["PhaseHint"] = static_cast<int> (pick.getPhaseHint());
-            pickObject["StandardError"] = pick.getStandardError();
-            pickObject["Identifier"] = pick.getIdentifier();
-            jsonPicks.push_back(std::move(pickObject)); 
+            writer.startMap(8);
+            writer.write("Network");
+            writer.write(pick.getNetwork());
+            writer.write("Station");
+            writer.write(pick.getStation());
+            writer.write("Channel");
+            writer.write(pick.getChannel());
+            writer.write("LocationCode");
+            writer.write(pick.getLocationCode());
+            writer.write("Time");
+            writer.write(static_cast<int64_t> (pick.getTime().count()));
+            writer.write("PhaseHint");
+            writer.write(static_cast<int> (pick.getPhaseHint()));
+            writer.write("StandardError");
+            writer.write(pick.getStandardError());
+            writer.write("Identifier");
+            writer.write(pick.getIdentifier());
         }
-        obj["Picks"] = jsonPicks;
     }
     else
     {
-        obj["Picks"] = nullptr;
+        writer.writeNull();
     }
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
     return result;
 }
 
 AssociationRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     AssociationRequest result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::vector<Pick> picks;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
     {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    result.setIdentifier(obj["Identifier"].template get<int64_t> ());
-    if (!obj["Picks"].is_null())
-    {
-        std::vector<Pick> picks;
-        for (const auto &pickObject : obj["Picks"])
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "Picks")
+        {
+            if (reader.readNull()){return true;}
+            auto nPicks = reader.readArraySize();
+            picks.reserve(nPicks);
+            for (uint64_t i = 0; i < nPicks; ++i)
+            {
+                // Required pick fields are verified by setPicks
+                Pick pick;
+                reader.readMap([&](const std::string_view &pickKey)
+                {
+                    if (pickKey == "Network")
+                    {
+                        pick.setNetwork(reader.readString());
+                    }
+                    else if (pickKey == "Station")
+                    {
+                        pick.setStation(reader.readString());
+                    }
+                    else if (pickKey == "Channel")
+                    {
+                        pick.setChannel(reader.readString());
+                    }
+                    else if (pickKey == "LocationCode")
+                    {
+                        pick.setLocationCode(reader.readString());
+                    }
+                    else if (pickKey == "Time")
+                    {
+                        pick.setTime(
+                            std::chrono::microseconds {reader.readInteger()});
+                    }
+                    else if (pickKey == "PhaseHint")
+                    {
+                        pick.setPhaseHint(static_cast<Pick::PhaseHint>
+                                          (reader.readInteger()));
+                    }
+                    else if (pickKey == "StandardError")
+                    {
+                        pick.setStandardError(reader.readDouble());
+                    }
+                    else if (pickKey == "Identifier")
+                    {
+                        pick.setIdentifier(reader.readUnsigned());
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    return true;
+                });
+                picks.push_back(std::move(pick));
+            }
+        }
+        else
         {
-            Pick pick;
-            pick.setNetwork(pickObject["Network"].template get<std::string> ());
-            pick.setStation(pickObject["Station"].template get<std::string> ());
-            pick.setChannel(pickObject["Channel"].template get<std::string> ());
-            pick.setLocationCode(
-                pickObject["LocationCode"].template get<std::string> ());
-            auto iTime = pickObject["Time"].template get<int64_t> ();
-            pick.setTime(std::chrono::microseconds {iTime});
-            auto phaseHint
-                = static_cast<Pick::PhaseHint>
-                  (pickObject["PhaseHint"].template get<int> ());
-            pick.setPhaseHint(phaseHint);
-            pick.setStandardError(
-                pickObject["StandardError"].template get<double> ());
-            pick.setIdentifier(
-                pickObject["Identifier"].template get<int64_t> ());
-            picks.push_back(std::move(pick));
+            return false;
         }
-        result.setPicks(picks);
+        return true;
+    });
+    if (messageType != result.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
     }
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    if (!picks.empty()){result.setPicks(picks);}
     return result;
 }
-
 }
 
 class AssociationRequest::AssociationRequestImpl
@@ -1,7 +1,10 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include "urts/services/scalable/detectors/uNetOneComponentP/inferenceRequest.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Detectors::UNetOneComponentP::InferenceRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -13,38 +16,72 @@ namespace
 
 std::string toCBORObject(const InferenceRequest &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
     if (!message.haveSignal()){throw std::runtime_error("Signal not set");}
-    obj["VerticalSignal"] = message.getSignal();
-    obj["InferenceStrategy"]
-        = static_cast<int> (message.getInferenceStrategy());
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    const auto &vertical = message.getSignalReference();
+    std::string result;
+    result.reserve(256 + 9*vertical.size());
+    CBORWriter writer(&result);
+    writer.startMap(5);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("VerticalSignal");
+    writer.write(vertical.data(), vertical.size());
+    writer.write("InferenceStrategy");
+    writer.write(static_cast<int> (message.getInferenceStrategy()));
     return result;
 }
 
 InferenceRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     InferenceRequest result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<std::vector<double>> vertical;
+    std::optional<int> strategy;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "VerticalSignal")
+        {
+            reader.readDoubles(&vertical.emplace());
+        }
+        else if (key == "InferenceStrategy")
+        {
+            strategy = static_cast<int> (reader.readInteger());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
-    auto strategy
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    auto inferenceStrategy
         = static_cast<InferenceRequest::InferenceStrategy>
-          (obj["InferenceStrategy"].get<int> ());
-    std::vector<double> vertical = obj["VerticalSignal"];
-    result.setSignal(std::move(vertical), strategy);
+          (::requireField(strategy, "InferenceStrategy"));
+    result.setSignal(
+        std::move(::requireField(vertical, "VerticalSignal")),
+        inferenceStrategy);
     return result;
 }
 
-
 }
 
 class InferenceRequest::RequestImpl
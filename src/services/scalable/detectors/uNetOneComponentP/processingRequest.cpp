@@ -1,9 +1,12 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include <uussmlmodels/detectors/uNetOneComponentP/inference.hpp>
 #include "urts/services/scalable/detectors/uNetOneComponentP/processingRequest.hpp"
 #include "urts/services/scalable/detectors/uNetOneComponentP/inferenceRequest.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Detectors::UNetOneComponentP::ProcessingRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -15,40 +18,80 @@ namespace
 
 std::string toCBORObject(const ProcessingRequest &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["SamplingRate"] = message.getSamplingRate();
     if (!message.haveSignal()){throw std::runtime_error("Signal not set");}
-    obj["VerticalSignal"] = message.getSignal();
-    obj["InferenceStrategy"]
-        = static_cast<int> (message.getInferenceStrategy());
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    const auto &vertical = message.getSignalReference();
+    std::string result;
+    result.reserve(256 + 9*vertical.size());
+    CBORWriter writer(&result);
+    writer.startMap(6);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("SamplingRate");
+    writer.write(message.getSamplingRate());
+    writer.write("VerticalSignal");
+    writer.write(vertical.data(), vertical.size());
+    writer.write("InferenceStrategy");
+    writer.write(static_cast<int> (message.getInferenceStrategy()));
     return result;
 }
 
 ProcessingRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     ProcessingRequest result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<double> samplingRate;
+    std::optional<std::vector<double>> vertical;
+    std::optional<int> strategy;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "SamplingRate")
+        {
+            samplingRate = reader.readDouble();
+        }
+        else if (key == "VerticalSignal")
+        {
+            reader.readDoubles(&vertical.emplace());
+        }
+        else if (key == "InferenceStrategy")
+        {
+            strategy = static_cast<int> (reader.readInteger());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
-    result.setSamplingRate(obj["SamplingRate"].get<double> ());
-    auto strategy
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    result.setSamplingRate(::requireField(samplingRate, "SamplingRate"));
+    auto inferenceStrategy
         = static_cast<ProcessingRequest::InferenceStrategy>
-          (obj["InferenceStrategy"].get<int> ());
-    std::vector<double> vertical = obj["VerticalSignal"];
-    result.setSignal(std::move(vertical), strategy);
+          (::requireField(strategy, "InferenceStrategy"));
+    result.setSignal(
+        std::move(::requireField(vertical, "VerticalSignal")),
+        inferenceStrategy);
     return result;
 }
 
-
 }
 
 class ProcessingRequest::RequestImpl
@@ -1,10 +1,16 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <memory>
+#include <span>
+#include <optional>
+#include <string_view>
 #include "urts/services/scalable/detectors/uNetOneComponentP/processingResponse.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
+#include "private/sharedSignalCopy.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Detectors::UNetOneComponentP::ProcessingResponse"
-#define MESSAGE_VERSION "1.0.0"
+#define MESSAGE_VERSION "2.0.0"
 
 using namespace URTS::Services::Scalable::Detectors::UNetOneComponentP;
 
@@ -13,39 +19,98 @@ namespace
 
 std::string toCBORObject(const ProcessingResponse &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["SamplingRate"] = message.getSamplingRate();
-    obj["ReturnCode"] = static_cast<int> (message.getReturnCode());
     if (!message.haveProbabilitySignal())
     {
         throw std::runtime_error("Probability signal not set");
     }
-    obj["ProbabilitySignal"] = message.getProbabilitySignal();
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    auto probabilitySignal = message.getProbabilitySignalView();
+    std::string result;
+    result.reserve(256 + 8*probabilitySignal.size());
+    CBORWriter writer(&result);
+    writer.startMap(6);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("SamplingRate");
+    writer.write(message.getSamplingRate());
+    writer.write("ReturnCode");
+    writer.write(static_cast<int> (message.getReturnCode()));
+    writer.write("ProbabilitySignal");
+    writer.writeSamples(probabilitySignal.data(), probabilitySignal.size());
     return result;
 }
 
 ProcessingResponse
-    fromCBORMessage(const uint8_t *message, const size_t length)
+    fromCBORMessage(const std::shared_ptr<const std::string> &message)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     ProcessingResponse result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<double> samplingRate;
+    std::optional<int> returnCode;
+    std::optional<std::vector<double>> probabilitySignal;
+    std::shared_ptr<const double> probabilitySignalView;
+    int nSamples{0};
+    CBORReader reader(reinterpret_cast<const uint8_t *> (message->data()),
+                      message->size());
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "SamplingRate")
+        {
+            samplingRate = reader.readDouble();
+        }
+        else if (key == "ReturnCode")
+        {
+            returnCode = static_cast<int> (reader.readInteger());
+        }
+        else if (key == "ProbabilitySignal")
+        {
+            auto view = reader.readSamples(&probabilitySignal.emplace());
+            if (view && !view->empty())
+            {
+                // Point into the message rather than copying the samples
+                probabilitySignalView
+                    = std::shared_ptr<const double> (message, view->data());
+                nSamples = static_cast<int> (view->size());
+            }
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setSamplingRate(obj["SamplingRate"].get<double> ());
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
+    result.setSamplingRate(::requireField(samplingRate, "SamplingRate"));
+    result.setIdentifier(::requireField(identifier, "Identifier"));
     result.setReturnCode(
        static_cast<ProcessingResponse::ReturnCode> (
-         obj["ReturnCode"].get<int> ()
+         ::requireField(returnCode, "ReturnCode")
     ));
-    std::vector<double> probabilitySignal = obj["ProbabilitySignal"];
-    result.setProbabilitySignal(std::move(probabilitySignal));
+    if (probabilitySignalView)
+    {
+        result.setProbabilitySignal(std::move(probabilitySignalView),
+                                    nSamples);
+    }
+    else
+    {
+        result.setProbabilitySignal(
+            std::move(::requireField(probabilitySignal, "ProbabilitySignal")));
+    }
     return result;
 }
 
@@ -54,7 +119,22 @@ ProcessingResponse
 class ProcessingResponse::ResponseImpl
 {
 public:
+    /// Resets the probability signal.
+    void clearProbabilitySignal()
+    {
+        mProbabilitySignal.clear();
+        mProbabilitySignalView = nullptr;
+        mProbabilitySignalViewSize = 0;
+        mProbabilitySignalCopy.reset();
+        mHaveProbabilitySignal = false;
+    }
+    /// The probability signal when it was set by the caller.
     std::vector<double> mProbabilitySignal;
+    /// The probability signal when it is a view, e.g., into a message.
+    std::shared_ptr<const double> mProbabilitySignalView{nullptr};
+    size_t mProbabilitySignalViewSize{0};
+    /// A vector copy of a viewed signal for getProbabilitySignalReference().
+    ::SharedSignalCopy mProbabilitySignalCopy;
     double mSamplingRate{100};
     int64_t mIdentifier{0};
     ProcessingResponse::ReturnCode mReturnCode;
@@ -164,6 +244,7 @@ void ProcessingResponse::setProbabilitySignal(const std::vector<double> &signal)
     {
         throw std::invalid_argument("Probability signal is empty");
     }
+    pImpl->clearProbabilitySignal();
     pImpl->mProbabilitySignal = signal;
     pImpl->mHaveProbabilitySignal = true;
 }
@@ -174,27 +255,57 @@ void ProcessingResponse::setProbabilitySignal(std::vector<double> &&signal)
     {
         throw std::invalid_argument("Probability signal is empty");
     }
-    pImpl->mProbabilitySignal = signal;
+    pImpl->clearProbabilitySignal();
+    pImpl->mProbabilitySignal = std::move(signal);
+    pImpl->mHaveProbabilitySignal = true;
+}
+
+void ProcessingResponse::setProbabilitySignal(
+    std::shared_ptr<const double> signal, const int nSamples)
+{
+    if (signal == nullptr)
+    {
+        throw std::invalid_argument("Probability signal is NULL");
+    }
+    if (nSamples < 1)
+    {
+        throw std::invalid_argument("Probability signal is empty");
+    }
+    pImpl->clearProbabilitySignal();
+    pImpl->mProbabilitySignalView = std::move(signal);
+    pImpl->mProbabilitySignalViewSize = static_cast<size_t> (nSamples);
     pImpl->mHaveProbabilitySignal = true;
 }
 
 std::vector<double> ProcessingResponse::getProbabilitySignal() const
+{
+    auto view = getProbabilitySignalView();
+    return std::vector<double> (view.begin(), view.end());
+}
+
+std::span<const double> ProcessingResponse::getProbabilitySignalView() const
 {
     if (!haveProbabilitySignal())
     {
         throw std::runtime_error("Probability signal not set");
     }
-    return pImpl->mProbabilitySignal;
+    if (pImpl->mProbabilitySignalView)
+    {
+        return std::span<const double> {pImpl->mProbabilitySignalView.get(),
+                                        pImpl->mProbabilitySignalViewSize};
+    }
+    return std::span<const double> {pImpl->mProbabilitySignal};
 }
 
-const std::vector<double>
-&ProcessingResponse::getProbabilitySignalReference() const
+const std::vector<double> &
+ProcessingResponse::getProbabilitySignalReference() const
 {
-    if (!haveProbabilitySignal())
+    auto view = getProbabilitySignalView();
+    if (pImpl->mProbabilitySignalView)
     {
-        throw std::runtime_error("Probability signal not set");
+        return pImpl->mProbabilitySignalCopy.get(view);
     }
-    return *&pImpl->mProbabilitySignal;
+    return pImpl->mProbabilitySignal;
 }
 
 bool ProcessingResponse::haveProbabilitySignal() const noexcept
@@ -230,8 +341,18 @@ void ProcessingResponse::fromMessage(const std::string &message)
 void ProcessingResponse::fromMessage(
     const char *messageIn, const size_t length)
 {
-    auto message = reinterpret_cast<const uint8_t *> (messageIn);
-    *this = ::fromCBORMessage(message, length);
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (messageIn == nullptr){throw std::invalid_argument("data is NULL");}
+    // A single copy of the message lets the signal point into it
+    *this = ::fromCBORMessage(
+        std::make_shared<const std::string> (messageIn, length));
+}
+
+void ProcessingResponse::fromMessage(std::string &&message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    *this = ::fromCBORMessage(
+        std::make_shared<const std::string> (std::move(message)));
 }
 
 /// Copy this class
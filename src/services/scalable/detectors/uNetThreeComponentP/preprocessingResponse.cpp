@@ -1,8 +1,11 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include "urts/services/scalable/detectors/uNetThreeComponentP/preprocessingResponse.hpp"
 #include "urts/services/scalable/detectors/uNetThreeComponentP/inferenceRequest.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Detectors::UNetThreeComponentP::PreprocessingResponse"
 #define MESSAGE_VERSION "1.0.0"
@@ -14,42 +17,95 @@ namespace
 
 std::string toCBORObject(const PreprocessingResponse &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["SamplingRate"] = message.getSamplingRate();
-    obj["ReturnCode"] = static_cast<int> (message.getReturnCode());
     if (!message.haveSignals()){throw std::runtime_error("Signals not set");}
-    obj["VerticalSignal"] = message.getVerticalSignal();
-    obj["NorthSignal"] = message.getNorthSignal();
-    obj["EastSignal"] = message.getEastSignal();
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    auto vertical = message.getVerticalSignal();
+    auto north = message.getNorthSignal();
+    auto east = message.getEastSignal();
+    std::string result;
+    result.reserve(256 + 9*(vertical.size() + north.size() + east.size()));
+    CBORWriter writer(&result);
+    writer.startMap(8);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("SamplingRate");
+    writer.write(message.getSamplingRate());
+    writer.write("ReturnCode");
+    writer.write(static_cast<int> (message.getReturnCode()));
+    writer.write("VerticalSignal");
+    writer.write(vertical.data(), vertical.size());
+    writer.write("NorthSignal");
+    writer.write(north.data(), north.size());
+    writer.write("EastSignal");
+    writer.write(east.data(), east.size());
     return result;
 }
 
 PreprocessingResponse
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     PreprocessingResponse result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<double> samplingRate;
+    std::optional<int> returnCode;
+    std::optional<std::vector<double>> vertical;
+    std::optional<std::vector<double>> north;
+    std::optional<std::vector<double>> east;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "SamplingRate")
+        {
+            samplingRate = reader.readDouble();
+        }
+        else if (key == "ReturnCode")
+        {
+            returnCode = static_cast<int> (reader.readInteger());
+        }
+        else if (key == "VerticalSignal")
+        {
+            reader.readDoubles(&vertical.emplace());
+        }
+        else if (key == "NorthSignal")
+        {
+            reader.readDoubles(&north.emplace());
+        }
+        else if (key == "EastSignal")
+        {
+            reader.readDoubles(&east.emplace());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setSamplingRate(obj["SamplingRate"].get<double> ());
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
+    result.setSamplingRate(::requireField(samplingRate, "SamplingRate"));
+    result.setIdentifier(::requireField(identifier, "Identifier"));
     result.setReturnCode(
        static_cast<PreprocessingResponse::ReturnCode> (
-         obj["ReturnCode"].get<int> ()
+         ::requireField(returnCode, "ReturnCode")
     ));
-    std::vector<double> vertical = obj["VerticalSignal"];
-    std::vector<double> north = obj["NorthSignal"];
-    std::vector<double> east = obj["EastSignal"];
-    result.setVerticalNorthEastSignal(std::move(vertical),
-                                      std::move(north),
-                                      std::move(east));
+    result.setVerticalNorthEastSignal(
+        std::move(::requireField(vertical, "VerticalSignal")),
+        std::move(::requireField(north, "NorthSignal")),
+        std::move(::requireField(east, "EastSignal")));
     return result;
 }
 
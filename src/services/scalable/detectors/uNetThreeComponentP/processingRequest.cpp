@@ -1,8 +1,11 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include "urts/services/scalable/detectors/uNetThreeComponentP/processingRequest.hpp"
 #include "urts/services/scalable/detectors/uNetThreeComponentP/inferenceRequest.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Detectors::UNetThreeComponentP::ProcessingRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -14,47 +17,98 @@ namespace
 
 std::string toCBORObject(const ProcessingRequest &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["SamplingRate"] = message.getSamplingRate();
     if (!message.haveSignals()){throw std::runtime_error("Signals not set");}
-    obj["VerticalSignal"] = message.getVerticalSignal();
-    obj["NorthSignal"] = message.getNorthSignal();
-    obj["EastSignal"] = message.getEastSignal();
-    obj["InferenceStrategy"]
-        = static_cast<int> (message.getInferenceStrategy());
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    const auto &vertical = message.getVerticalSignalReference();
+    const auto &north = message.getNorthSignalReference();
+    const auto &east = message.getEastSignalReference();
+    std::string result;
+    result.reserve(256 + 9*(vertical.size() + north.size() + east.size()));
+    CBORWriter writer(&result);
+    writer.startMap(8);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("SamplingRate");
+    writer.write(message.getSamplingRate());
+    writer.write("VerticalSignal");
+    writer.write(vertical.data(), vertical.size());
+    writer.write("NorthSignal");
+    writer.write(north.data(), north.size());
+    writer.write("EastSignal");
+    writer.write(east.data(), east.size());
+    writer.write("InferenceStrategy");
+    writer.write(static_cast<int> (message.getInferenceStrategy()));
     return result;
 }
 
 ProcessingRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     ProcessingRequest result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<double> samplingRate;
+    std::optional<std::vector<double>> vertical;
+    std::optional<std::vector<double>> north;
+    std::optional<std::vector<double>> east;
+    std::optional<int> strategy;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "SamplingRate")
+        {
+            samplingRate = reader.readDouble();
+        }
+        else if (key == "VerticalSignal")
+        {
+            reader.readDoubles(&vertical.emplace());
+        }
+        else if (key == "NorthSignal")
+        {
+            reader.readDoubles(&north.emplace());
+        }
+        else if (key == "EastSignal")
+        {
+            reader.readDoubles(&east.emplace());
+        }
+        else if (key == "InferenceStrategy")
+        {
+            strategy = static_cast<int> (reader.readInteger());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
-    result.setSamplingRate(obj["SamplingRate"].get<double> ());
-    auto strategy
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    result.setSamplingRate(::requireField(samplingRate, "SamplingRate"));
+    auto inferenceStrategy
         = static_cast<ProcessingRequest::InferenceStrategy>
-          (obj["InferenceStrategy"].get<int> ());
-    std::vector<double> vertical = obj["VerticalSignal"];
-    std::vector<double> north = obj["NorthSignal"];
-    std::vector<double> east = obj["EastSignal"];
-    result.setVerticalNorthEastSignal(std::move(vertical),
-                                      std::move(north),
-                                      std::move(east),
-                                      strategy);
+          (::requireField(strategy, "InferenceStrategy"));
+    result.setVerticalNorthEastSignal(
+        std::move(::requireField(vertical, "VerticalSignal")),
+        std::move(::requireField(north, "NorthSignal")),
+        std::move(::requireField(east, "EastSignal")),
+        inferenceStrategy);
     return result;
 }
 
-
 }
 
 class ProcessingRequest::RequestImpl
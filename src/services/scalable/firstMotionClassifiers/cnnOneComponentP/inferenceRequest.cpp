@@ -1,7 +1,10 @@
 #include <vector>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include "urts/services/scalable/firstMotionClassifiers/cnnOneComponentP/inferenceRequest.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::FirstMotionClassifiers::CNNOneComponentP::InferenceRequest"
 #define MESSAGE_VERSION "1.0.0"
@@ -13,35 +16,69 @@ namespace
 
 std::string toCBORObject(const InferenceRequest &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["Threshold"] = message.getThreshold();
     if (!message.haveSignal()){throw std::runtime_error("Signal not set");}
-    obj["VerticalSignal"] = message.getVerticalSignal();
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    const auto &vertical = message.getVerticalSignalReference();
+    std::string result;
+    result.reserve(256 + 9*vertical.size());
+    CBORWriter writer(&result);
+    writer.startMap(5);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("Threshold");
+    writer.write(message.getThreshold());
+    writer.write("VerticalSignal");
+    writer.write(vertical.data(), vertical.size());
     return result;
 }
 
 InferenceRequest
     fromCBORMessage(const uint8_t *message, const size_t length)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
     InferenceRequest result;
-    if (obj["MessageType"] != result.getMessageType())
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<double> threshold;
+    std::optional<std::vector<double>> vertical;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "Threshold")
+        {
+            threshold = reader.readDouble();
+        }
+        else if (key == "VerticalSignal")
+        {
+            reader.readDoubles(&vertical.emplace());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
     {
         throw std::invalid_argument("Message has invalid message type");
     }
-    result.setThreshold(obj["Threshold"].get<double> ());
-    result.setIdentifier(obj["Identifier"].get<int64_t> ());
-    std::vector<double> vertical = obj["VerticalSignal"];
-    result.setVerticalSignal(std::move(vertical));
+    result.setThreshold(::requireField(threshold, "Threshold"));
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    result.setVerticalSignal(
+        std::move(::requireField(vertical, "VerticalSignal")));
     return result;
 }
 
-
 }
 
 class InferenceRequest::RequestImpl
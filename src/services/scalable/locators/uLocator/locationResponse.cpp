@@ -1,7 +1,13 @@
-#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <chrono>
 #include "urts/services/scalable/locators/uLocator/locationResponse.hpp"
 #include "urts/services/scalable/locators/uLocator/origin.hpp"
 #include "urts/services/scalable/locators/uLocator/arrival.hpp"
+#include "private/cborWriter.hpp"
+#include "private/cborReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::Locators::ULocator::LocationResponse"
 #define MESSAGE_VERSION "1.0.0"
@@ -13,139 +19,235 @@ namespace
 
 std::string toCBORObject(const LocationResponse &message)
 {
-    nlohmann::json obj;
-    obj["MessageType"] = message.getMessageType();
-    obj["MessageVersion"] = message.getMessageVersion();
-    obj["Identifier"] = message.getIdentifier();
-    obj["ReturnCode"] = static_cast<int> (message.getReturnCode());
     auto origin = message.getOrigin();
+    size_t nArrivals = origin ? origin->getArrivalsReference().size() : 0;
+    std::string result;
+    result.reserve(512 + 128*nArrivals);
+    CBORWriter writer(&result);
+    writer.startMap(origin ? 5 : 4);
+    writer.write("MessageType");
+    writer.write(message.getMessageType());
+    writer.write("MessageVersion");
+    writer.write(message.getMessageVersion());
+    writer.write("Identifier");
+    writer.write(message.getIdentifier());
+    writer.write("ReturnCode");
+    writer.write(static_cast<int> (message.getReturnCode()));
     if (origin)
     {
-        nlohmann::json originObject;
-        originObject["Latitude"] = origin->getLatitude();
-        originObject["Longitude"] = origin->getLongitude();
-        originObject["Depth"] = origin->getDepth();
-        originObject["Time"]
-            = static_cast<int64_t> (origin->getTime().count());
         auto originIdentifier = origin->getIdentifier();
+        const auto &arrivals = origin->getArrivalsReference();
+        int nOriginPairs = 5;
+        if (originIdentifier){nOriginPairs = nOriginPairs + 1;}
+        if (!arrivals.empty()){nOriginPairs = nOriginPairs + 1;}
+        writer.write("Origin");
+        writer.startMap(nOriginPairs);
+        writer.write("Latitude");
+        writer.write(origin->getLatitude());
+        writer.write("Longitude");
+        writer.write(origin->getLongitude());
+        writer.write("Depth");
+        writer.write(origin->getDepth());
+        writer.write("Time");
+        writer.write(static_cast<int64_t> (origin->getTime().count()));
         if (originIdentifier)
         {
-            originObject["Identifier"] = *originIdentifier;
+            writer.write("Identifier");
+            writer.write(*originIdentifier);
         }
-        originObject["DepthFixedToFreeSurface"]
-            = origin->depthFixedToFreeSurface();
-        const auto &arrivals = origin->getArrivalsReference();
+        writer.write("DepthFixedToFreeSurface");
+        writer.write(origin->depthFixedToFreeSurface());
         if (!arrivals.empty())
         {
-            nlohmann::json arrivalObjects;
+            writer.write("Arrivals");
+            writer.startArray(arrivals.size());
             for (const auto &arrival : arrivals)
             {
-                nlohmann::json arrivalObject;
-                arrivalObject["Network"] = arrival.getNetwork();
-                arrivalObject["Station"] = arrival.getStation();
-                arrivalObject["Time"]
-                    = static_cast<int64_t> (arrival.getTime().count());
-                arrivalObject["Phase"]
-                    = static_cast<int> (arrival.getPhase());
                 auto standardError = arrival.getStandardError();
+                auto arrivalIdentifier = arrival.getIdentifier();
+                auto travelTime = arrival.getTravelTime();
+                int nArrivalPairs = 4;
+                if (standardError){nArrivalPairs = nArrivalPairs + 1;}
+                if (arrivalIdentifier){nArrivalPairs = nArrivalPairs + 1;}
+                if (travelTime){nArrivalPairs = nArrivalPairs + 1;}
+                writer.startMap(nArrivalPairs);
+                writer.write("Network");
+                writer.write(arrival.getNetwork());
+                writer.write("Station");
+                writer.write(arrival.getStation());
+                writer.write("Time");
+                writer.write(static_cast<int64_t> (arrival.getTime().count()));
+                writer.write("Phase");
+                writer.write(static_cast<int> (arrival.getPhase()));
                 if (standardError)
                 {
-                    arrivalObject["StandardError"] = *standardError;
+                    writer.write("StandardError");
+                    writer.write(*standardError);
                 }
-                auto arrivalIdentifier = arrival.getIdentifier();
                 if (arrivalIdentifier)
                 {
-                    arrivalObject["Identifier"] = *arrivalIdentifier;
+                    writer.write("Identifier");
+                    writer.write(*arrivalIdentifier);
                 }
-                auto travelTime = arrival.getTravelTime();
                 if (travelTime)
                 {
-                    arrivalObject["TravelTime"] = *travelTime;
+                    writer.write("TravelTime");
+                    writer.write(*travelTime);
                 }
-                arrivalObjects.push_back(std::move(arrivalObject));
             }
-            originObject["Arrivals"] = arrivalObjects;
         }
-        obj["Origin"] = originObject;
     }
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
     return result;
 }
 
-LocationResponse
-    fromCBORMessage(const uint8_t *message, const size_t length)
+Arrival readArrival(CBORReader *reader)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    LocationResponse result;
-    if (obj["MessageType"] != result.getMessageType())
+    Arrival arrival;
+    reader->readMap([&](const std::string_view &key)
     {
-        throw std::invalid_argument("Message has invalid message type");
-    }
-    result.setIdentifier(obj["Identifier"].template get<int64_t> ());
-    result.setReturnCode(
-        static_cast<LocationResponse::ReturnCode>
-        (obj["ReturnCode"].template get<int> ()));
-    if (obj.contains("Origin"))
+        if (key == "Network")
+        {
+            arrival.setNetwork(reader->readString());
+        }
+        else if (key == "Station")
+        {
+            arrival.setStation(reader->readString());
+        }
+        else if (key == "Time")
+        {
+            arrival.setTime(std::chrono::microseconds {reader->readInteger()});
+        }
+        else if (key == "Phase")
+        {
+            arrival.setPhase(static_cast<Arrival::Phase>
+                             (reader->readInteger()));
+        }
+        else if (key == "StandardError")
+        {
+            arrival.setStandardError(reader->readDouble());
+        }
+        else if (key == "Identifier")
+        {
+            arrival.setIdentifier(reader->readInteger());
+        }
+        else if (key == "TravelTime")
+        {
+            arrival.setTravelTime(reader->readDouble());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    return arrival;
+}
+
+Origin readOrigin(CBORReader *reader)
+{
+    Origin origin;
+    std::optional<double> latitude;
+    std::optional<double> longitude;
+    std::optional<double> depth;
+    std::optional<int64_t> time;
+    std::optional<bool> depthFixed;
+    std::vector<Arrival> arrivals;
+    reader->readMap([&](const std::string_view &key)
     {
-        auto originObject = obj["Origin"];
-        Origin origin;
-        origin.setLatitude(
-            originObject["Latitude"].template get<double> ());
-        origin.setLongitude(
-            originObject["Longitude"].template get<double> ());
-        origin.setDepth(originObject["Depth"].template get<double> ());
-            origin.setTime(
-                std::chrono::microseconds
-                {
-                     originObject["Time"].template get<int64_t> ()
-                });
-        if (originObject.contains("Identifier"))
+        if (key == "Latitude")
+        {
+            latitude = reader->readDouble();
+        }
+        else if (key == "Longitude")
+        {
+            longitude = reader->readDouble();
+        }
+        else if (key == "Depth")
         {
-            origin.setIdentifier(
-                originObject["Identifier"].template get<int64_t> ());
+            depth = reader->readDouble();
         }
-        auto depthFixed
-            = originObject["DepthFixedToFreeSurface"].template get<bool> ();
-        origin.toggleDepthFixedToFreeSurface(depthFixed);
-        if (originObject.contains("Arrivals"))
+        else if (key == "Time")
         {
-            std::vector<Arrival> arrivals;
-            for (const auto &arrivalObject : originObject["Arrivals"])
+            time = reader->readInteger();
+        }
+        else if (key == "Identifier")
+        {
+            origin.setIdentifier(reader->readInteger());
+        }
+        else if (key == "DepthFixedToFreeSurface")
+        {
+            depthFixed = reader->readBoolean();
+        }
+        else if (key == "Arrivals")
+        {
+            if (reader->readNull()){return true;}
+            auto nArrivals = reader->readArraySize();
+            arrivals.reserve(nArrivals);
+            for (uint64_t i = 0; i < nArrivals; ++i)
             {
-                Arrival arrival;
-                arrival.setNetwork(arrivalObject["Network"].template get<std::string> ());
-                arrival.setStation(arrivalObject["Station"].template get<std::string> ());
-                auto iTime = arrivalObject["Time"].template get<int64_t> (); 
-                arrival.setTime(std::chrono::microseconds {iTime});
-                auto phase
-                    = static_cast<Arrival::Phase>
-                      (arrivalObject["Phase"].template get<int> ());
-                arrival.setPhase(phase);
-                if (arrivalObject.contains("StandardError"))
-                {
-                    arrival.setStandardError(
-                        arrivalObject["StandardError"].template get<double> ());
-                }
-                if (arrivalObject.contains("Identifier"))
-                {
-                    arrival.setIdentifier(
-                        arrivalObject["Identifier"].template get<int64_t> ());
-                }
-                if (arrivalObject.contains("TravelTime"))
-                {
-                    arrival.setTravelTime(
-                        arrivalObject["TravelTime"].template get<double> ());
-                }
-                arrivals.push_back(std::move(arrival));
+                arrivals.push_back(::readArrival(reader));
             }
-            if (!arrivals.empty()){origin.setArrivals(arrivals);}
         }
-        result.setOrigin(origin);
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    origin.setLatitude(::requireField(latitude, "Latitude"));
+    origin.setLongitude(::requireField(longitude, "Longitude"));
+    origin.setDepth(::requireField(depth, "Depth"));
+    origin.setTime(std::chrono::microseconds {::requireField(time, "Time")});
+    origin.toggleDepthFixedToFreeSurface(
+        ::requireField(depthFixed, "DepthFixedToFreeSurface"));
+    if (!arrivals.empty()){origin.setArrivals(arrivals);}
+    return origin;
+}
+
+LocationResponse
+    fromCBORMessage(const uint8_t *message, const size_t length)
+{
+    LocationResponse result;
+    std::optional<std::string_view> messageType;
+    std::optional<int64_t> identifier;
+    std::optional<int> returnCode;
+    std::optional<Origin> origin;
+    CBORReader reader(message, length);
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readInteger();
+        }
+        else if (key == "ReturnCode")
+        {
+            returnCode = static_cast<int> (reader.readInteger());
+        }
+        else if (key == "Origin")
+        {
+            origin = ::readOrigin(&reader);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != result.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
     }
+    result.setIdentifier(::requireField(identifier, "Identifier"));
+    result.setReturnCode(
+        static_cast<LocationResponse::ReturnCode>
+        (::requireField(returnCode, "ReturnCode")));
+    if (origin){result.setOrigin(*origin);}
     return result;
 }
-
 }
 
 class LocationResponse::LocationResponseImpl
@@ -97,6 +97,20 @@ nlohmann::json toJSONObject(const BulkDataRequest &request)
             requestObject["StartTime"] = startTime;
             requestObject["EndTime"] = endTime;
             requestObject["Identifier"] = requestsPtr[i].getIdentifier();
+            if (requestsPtr[i].haveSensorIdentifier())
+            {
+                requestObject["SensorIdentifier"]
+                    = requestsPtr[i].getSensorIdentifier();
+            }
+            if (requestsPtr[i].haveCursor())
+            {
+                requestObject["Cursor"] = requestsPtr[i].getCursor();
+            }
+            if (requestsPtr[i].haveCursorEndTime())
+            {
+                requestObject["CursorEndTime"]
+                    = requestsPtr[i].getCursorEndTime().count();
+            }
             // Append
             requestObjects.push_back(std::move(requestObject));
          }
@@ -142,6 +156,24 @@ BulkDataRequest objectToBulkDataRequest(const nlohmann::json &obj)
             dataRequest.setQueryTimes(std::pair(startTime, endTime));
             dataRequest.setIdentifier(requestObject["Identifier"]
                                      .get<uint64_t> ());
+            if (requestObject.contains("SensorIdentifier"))
+            {
+                dataRequest.setSensorIdentifier(
+                    requestObject["SensorIdentifier"].get<uint64_t> ());
+            }
+            if (requestObject.contains("Cursor") &&
+                requestObject.contains("CursorEndTime"))
+            {
+                dataRequest.setCursor(
+                    requestObject["Cursor"].get<uint64_t> (),
+                    std::chrono::microseconds
+                    {requestObject["CursorEndTime"].get<int64_t> ()});
+            }
+            else if (requestObject.contains("Cursor"))
+            {
+                dataRequest.setCursor(
+                    requestObject["Cursor"].get<uint64_t> ());
+            }
             // Append it
             request.addDataRequest(dataRequest);
          }
@@ -3,13 +3,17 @@
 #include <limits>
 #include <vector>
 #include <string>
+#include <optional>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include "urts/services/scalable/packetCache/bulkDataResponse.hpp"
 #include "urts/services/scalable/packetCache/dataResponse.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "dataResponseWriter.hpp"
+#include "dataResponseReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::PacketCache::BulkDataResponse"
-#define MESSAGE_VERSION "1.0.0"
+#define MESSAGE_VERSION "2.2.0"
 
 using namespace URTS::Services::Scalable::PacketCache;
 namespace UDP = URTS::Broadcasts::Internal::DataPacket;
@@ -69,6 +73,20 @@ nlohmann::json toJSONObject(
                 dataObject["Packets"] = nullptr;
             } // End check on packets > 0
             dataObject["Identifier"] = responsePtr[i].getIdentifier();
+            if (responsePtr[i].haveSensorIdentifier())
+            {
+                dataObject["SensorIdentifier"]
+                    = responsePtr[i].getSensorIdentifier();
+            }
+            if (responsePtr[i].haveCursor())
+            {
+                dataObject["Cursor"] = responsePtr[i].getCursor();
+            }
+            if (responsePtr[i].haveCursorEndTime())
+            {
+                dataObject["CursorEndTime"]
+                    = responsePtr[i].getCursorEndTime().count();
+            }
             dataObject["ReturnCode"]
                 = static_cast<int> (responsePtr[i].getReturnCode());
             // Update the data responses with the object for this request
@@ -100,9 +118,9 @@ BulkDataResponse objectToBulkDataResponse(const nlohmann::json &obj)
         for (const auto &dataObject : dataObjects)
         {
             auto nPackets = dataObject["NumberOfPackets"].get<int> ();
+            DataResponse dataResponse;
             if (nPackets > 0)
             {
-                DataResponse dataResponse;
                 auto network = dataObject["Network"].get<std::string> ();
                 auto station = dataObject["Station"].get<std::string> ();
                 auto channel = dataObject["Channel"].get<std::string> ();
@@ -130,14 +148,35 @@ BulkDataResponse objectToBulkDataResponse(const nlohmann::json &obj)
                     }
                     packets.push_back(std::move(packet));
                 }
-                if (!packets.empty()){dataResponse.setPackets(packets);}
-                dataResponse.setIdentifier(dataObject["Identifier"]
-                                          .get<uint64_t> ());
-                auto rc = static_cast<DataResponse::ReturnCode>
-                          (dataObject["ReturnCode"].get<int> ());
-                dataResponse.setReturnCode(rc);
-                response.addDataResponse(std::move(dataResponse));
+                if (!packets.empty())
+                {
+                    dataResponse.setPackets(std::move(packets));
+                }
             }
+            dataResponse.setIdentifier(dataObject["Identifier"]
+                                      .get<uint64_t> ());
+            if (dataObject.contains("SensorIdentifier"))
+            {
+                dataResponse.setSensorIdentifier(
+                    dataObject["SensorIdentifier"].get<uint64_t> ());
+            }
+            if (dataObject.contains("Cursor") &&
+                dataObject.contains("CursorEndTime"))
+            {
+                dataResponse.setCursor(
+                    dataObject["Cursor"].get<uint64_t> (),
+                    std::chrono::microseconds
+                    {dataObject["CursorEndTime"].get<int64_t> ()});
+            }
+            else if (dataObject.contains("Cursor"))
+            {
+                dataResponse.setCursor(
+                    dataObject["Cursor"].get<uint64_t> ());
+            }
+            auto rc = static_cast<DataResponse::ReturnCode>
+                      (dataObject["ReturnCode"].get<int> ());
+            dataResponse.setReturnCode(rc);
+            response.addDataResponse(std::move(dataResponse));
         }
     }
     response.setIdentifier(obj["Identifier"].get<uint64_t> ());
@@ -152,10 +191,53 @@ BulkDataResponse fromJSONMessage(const std::string &message)
     return objectToBulkDataResponse(obj);
 }
 
-BulkDataResponse fromCBORMessage(const uint8_t *message, const size_t length)
+BulkDataResponse
+    fromCBORMessage(const std::shared_ptr<const std::string> &message)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToBulkDataResponse(obj);
+    BulkDataResponse response;
+    std::optional<std::string_view> messageType;
+    std::optional<uint64_t> identifier;
+    std::optional<int> returnCode;
+    CBORReader reader(reinterpret_cast<const uint8_t *> (message->data()),
+                      message->size());
+    reader.readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType")
+        {
+            messageType = reader.readStringView();
+        }
+        else if (key == "DataResponses")
+        {
+            if (reader.readNull()){return true;}
+            auto nDataResponses = reader.readArraySize();
+            for (uint64_t i = 0; i < nDataResponses; ++i)
+            {
+                response.addDataResponse(
+                    ::readDataResponse(&reader, message));
+            }
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader.readUnsigned();
+        }
+        else if (key == "ReturnCode")
+        {
+            returnCode = static_cast<int> (reader.readInteger());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (messageType != response.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    response.setIdentifier(::requireField(identifier, "Identifier"));
+    response.setReturnCode(static_cast<BulkDataResponse::ReturnCode>
+                           (::requireField(returnCode, "ReturnCode")));
+    return response;
 }
 
 }
@@ -166,6 +248,8 @@ public:
     std::vector<DataResponse> mResponses;
     uint64_t mIdentifier{0};
     BulkDataResponse::ReturnCode mReturnCode{BulkDataResponse::ReturnCode::Success};
+    bool mCompressSamples{false};
+    bool mCompactLayout{false};
 };
 
 /// C'tor
@@ -260,6 +344,28 @@ BulkDataResponse::ReturnCode BulkDataResponse::getReturnCode() const noexcept
     return pImpl->mReturnCode;
 }
 
+/// Sample compression
+void BulkDataResponse::setSampleCompression(const bool compress) noexcept
+{
+    pImpl->mCompressSamples = compress;
+}
+
+bool BulkDataResponse::useSampleCompression() const noexcept
+{
+    return pImpl->mCompressSamples;
+}
+
+/// Compact layout
+void BulkDataResponse::setCompactLayout(const bool compact) noexcept
+{
+    pImpl->mCompactLayout = compact;
+}
+
+bool BulkDataResponse::useCompactLayout() const noexcept
+{
+    return pImpl->mCompactLayout;
+}
+
 /// Message type
 std::string BulkDataResponse::getMessageType() const noexcept
 {
@@ -279,12 +385,53 @@ std::string BulkDataResponse::toJSON(const int nIndent) const
     return obj.dump(nIndent);
 }
 
-/// Create CBOR
+/// Create CBOR.  This is written directly from the packet views.
 std::string BulkDataResponse::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    std::string result;
+    auto nDataResponses = getNumberOfDataResponses();
+    const auto *responsePtr = getDataResponsesPointer();
+    size_t nSamples = 0;
+    size_t nPackets = 0;
+    for (int i = 0; i < nDataResponses; ++i)
+    {
+        for (const auto &packet : responsePtr[i].getPacketViewsReference())
+        {
+            nSamples = nSamples + packet.getNumberOfSamples();
+            nPackets = nPackets + 1;
+        }
+    }
+    result.reserve(256 + 128*nDataResponses + 32*nPackets + 9*nSamples);
+    CBORWriter writer(&result);
+    writer.startMap(6);
+    writer.write("MessageType");
+    writer.write(getMessageType());
+    writer.write("MessageVersion");
+    writer.write(getMessageVersion());
+    writer.write("NumberOfDataResponses");
+    writer.write(nDataResponses);
+    writer.write("DataResponses");
+    if (nDataResponses > 0)
+    {
+        writer.startArray(nDataResponses);
+        for (int i = 0; i < nDataResponses; ++i)
+        {
+            ::writeDataResponse(responsePtr[i], 0,
+                                pImpl->mCompressSamples
+                             || responsePtr[i].useSampleCompression(),
+                                pImpl->mCompactLayout
+                             || responsePtr[i].useCompactLayout(),
+                                &writer);
+        }
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("Identifier");
+    writer.write(static_cast<uint64_t> (getIdentifier()));
+    writer.write("ReturnCode");
+    writer.write(static_cast<int> (getReturnCode()));
     return result;
 }
 
@@ -307,7 +454,9 @@ void BulkDataResponse::fromCBOR(const uint8_t *data, const size_t length)
     {
         throw std::invalid_argument("data is NULL");
     }
-    *this = fromCBORMessage(data, length);
+    // A single copy of the message lets the packet views point into it
+    *this = fromCBORMessage(std::make_shared<const std::string>
+                            (reinterpret_cast<const char *> (data), length));
 }
 
 ///  Convert message
@@ -329,6 +478,13 @@ void BulkDataResponse::fromMessage(const char *messageIn,
     fromCBOR(message, length);
 }
 
+void BulkDataResponse::fromMessage(std::string &&message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    *this = fromCBORMessage(std::make_shared<const std::string>
+                            (std::move(message)));
+}
+
 
 /// Copy this class
 std::unique_ptr<UMPS::MessageFormats::IMessage> BulkDataResponse::clone() const
@@ -1,12 +1,31 @@
 #include <string>
+#include <string_view>
 #include <set>
-#include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <random>
+#include <array>
+#include <functional>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef NDEBUG
+#include <cassert>
+#endif
 #include <umps/logging/standardOut.hpp>
 #include "urts/services/scalable/packetCache/cappedCollection.hpp"
 #include "urts/services/scalable/packetCache/circularBuffer.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "urts/services/scalable/packetCache/packetSummary.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "utilities.hpp"
 #include "stringMatch.hpp"
@@ -14,6 +33,172 @@
 using namespace URTS::Services::Scalable::PacketCache;
 namespace UDP = URTS::Broadcasts::Internal::DataPacket;
 
+namespace
+{
+/// The number of shards in the name to identifier table.  Names are
+/// distributed amongst the shards by their hash.
+constexpr size_t N_SHARDS{64};
+/// Channels are stored in fixed-size segments so that a channel can be
+/// found from its identifier without a lock.
+constexpr uint32_t SEGMENT_SIZE{1024};
+constexpr uint32_t MAX_SEGMENTS{1024};
+/// Allows the name table to be searched with a std::string_view.
+struct StringHash
+{
+    using is_transparent = void;
+    [[nodiscard]] size_t operator()(const std::string_view s) const noexcept
+    {
+        return std::hash<std::string_view> {}(s);
+    }
+};
+/// A shard of the table that interns a sensor name to its dense identifier.
+/// Lookups take a shared lock while adding a new name takes an exclusive
+/// lock.
+struct NameShard
+{
+    mutable std::shared_mutex mMutex;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>
+        mIdentifiers;
+};
+/// A channel in the collection.  The blacklist verdict is computed once
+/// when the channel is first seen.  Blacklisted channels are interned but
+/// never buffered.
+struct Channel
+{
+    std::string mName;
+    CircularBuffer mCircularBuffer;
+    bool mBlackListed{false};
+};
+using Segment = std::array<std::atomic<Channel *>, SEGMENT_SIZE>;
+/// Writes NETWORK.STATION.CHANNEL.LOCATION_CODE into the given buffer.
+/// Reusing the buffer avoids allocating on the ingest path.
+void makeName(const UDP::DataPacket &packet, std::string *name)
+{
+    const auto &network = packet.getNetwork();
+    const auto &station = packet.getStation();
+    const auto &channel = packet.getChannel();
+    const auto &locationCode = packet.getLocationCode();
+    name->clear();
+    name->reserve(network.size() + station.size()
+                + channel.size() + locationCode.size() + 3);
+    name->append(network);
+    name->push_back('.');
+    name->append(station);
+    name->push_back('.');
+    name->append(channel);
+    name->push_back('.');
+    name->append(locationCode);
+}
+/// Snapshot files begin with this 32 byte header:
+///   magic (8 bytes), version (4 bytes), byte order mark (4 bytes),
+///   number of channels (8 bytes), reserved (8 bytes).
+/// Each channel is then written as:
+///   name length (4 bytes), number of packets (4 bytes), name padded to
+///   a multiple of 8 bytes,
+/// followed by each packet:
+///   start time in microseconds (8 bytes), sampling rate (8 bytes),
+///   number of samples (8 bytes), samples (8 bytes each).
+/// Every field is 8 byte aligned so the samples can be read directly from
+/// the mapped file.
+constexpr std::array<char, 8> SNAPSHOT_MAGIC{'U', 'R', 'T', 'S',
+                                             'P', 'C', 'S', 'S'};
+constexpr uint32_t SNAPSHOT_VERSION{1};
+constexpr uint32_t SNAPSHOT_BYTE_ORDER_MARK{0x01020304};
+constexpr size_t SNAPSHOT_HEADER_SIZE{32};
+[[nodiscard]] size_t padTo8(const size_t n) noexcept
+{
+    return (n + 7) & ~static_cast<size_t> (7);
+}
+template<typename T>
+void append(std::string *buffer, const T value)
+{
+    buffer->append(reinterpret_cast<const char *> (&value), sizeof(T));
+}
+/// A read-only memory map of a snapshot file.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &fileName)
+    {
+        mDescriptor = ::open(fileName.c_str(), O_RDONLY);
+        if (mDescriptor < 0)
+        {
+            throw std::runtime_error("Could not open " + fileName);
+        }
+        struct stat status;
+        if (::fstat(mDescriptor, &status) != 0)
+        {
+            ::close(mDescriptor);
+            throw std::runtime_error("Could not stat " + fileName);
+        }
+        mSize = static_cast<size_t> (status.st_size);
+        if (mSize > 0)
+        {
+            auto data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE,
+                               mDescriptor, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(mDescriptor);
+                throw std::runtime_error("Could not map " + fileName);
+            }
+            mData = static_cast<const char *> (data);
+            ::madvise(data, mSize, MADV_SEQUENTIAL);
+        }
+    }
+    ~MappedFile()
+    {
+        if (mData != nullptr)
+        {
+            ::munmap(const_cast<char *> (mData), mSize);
+        }
+        if (mDescriptor >= 0){::close(mDescriptor);}
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile& operator=(const MappedFile &) = delete;
+    /// Reads a value at the offset and advances the offset.
+    template<typename T>
+    [[nodiscard]] T read(size_t *offset) const
+    {
+        const auto *pointer = advance(offset, sizeof(T));
+        T value;
+        std::memcpy(&value, pointer, sizeof(T));
+        return value;
+    }
+    /// @result A pointer to n bytes beginning at the offset.  The offset is
+    ///         advanced.
+    [[nodiscard]] const char *advance(size_t *offset, const size_t n) const
+    {
+        if (*offset > mSize || n > mSize - *offset)
+        {
+            throw std::runtime_error("Snapshot is truncated");
+        }
+        const auto *pointer = mData + *offset;
+        *offset = *offset + n;
+        return pointer;
+    }
+    [[nodiscard]] size_t size() const noexcept{return mSize;}
+private:
+    const char *mData{nullptr};
+    size_t mSize{0};
+    int mDescriptor{-1};
+};
+/// Splits NETWORK.STATION.CHANNEL.LOCATION_CODE into its parts.
+[[nodiscard]] bool splitName(const std::string &name,
+                             std::array<std::string, 4> *parts)
+{
+    size_t i0 = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto i1 = name.find('.', i0);
+        if (i1 == std::string::npos){return false;}
+        (*parts)[i] = name.substr(i0, i1 - i0);
+        i0 = i1 + 1;
+    }
+    (*parts)[3] = name.substr(i0);
+    return (*parts)[3].find('.') == std::string::npos;
+}
+}
+
 /// Implementation
 class CappedCollection::CappedCollectionImpl
 {
@@ -41,65 +226,178 @@ public:
     /// Reset class
     void clear() noexcept
     {
-        std::scoped_lock lock(mMutex);
-        mCircularBufferMap.clear();
+        std::scoped_lock insertLock(mInsertMutex);
+        for (auto &shard : mNameShards)
+        {
+            std::scoped_lock lock(shard.mMutex);
+            shard.mIdentifiers.clear();
+        }
+        for (auto &segment : mSegments)
+        {
+            segment.store(nullptr, std::memory_order_release);
+        }
+        mSegmentStorage.clear();
+        mChannelStorage.clear();
+        mNextIdentifier.store(0, std::memory_order_release);
         mMaxPackets = 0;
+        mCompress = false;
         mInitialized = false; 
     }
+    /// Get the shard to which this name belongs
+    [[nodiscard]] NameShard &getShard(const std::string_view name) noexcept
+    {
+        return mNameShards[StringHash {}(name)%mNameShards.size()];
+    }
+    [[nodiscard]] const NameShard &getShard(
+        const std::string_view name) const noexcept
+    {
+        return mNameShards[StringHash {}(name)%mNameShards.size()];
+    }
+    /// @result The channel with this identifier or NULL if it does not exist.
+    [[nodiscard]] Channel *getChannel(const uint32_t identifier) const noexcept
+    {
+        if (identifier >= mNextIdentifier.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        auto segment = mSegments[identifier/SEGMENT_SIZE]
+                      .load(std::memory_order_acquire);
+        if (segment == nullptr){return nullptr;}
+        return (*segment)[identifier%SEGMENT_SIZE]
+              .load(std::memory_order_acquire);
+    }
+    /// @result The identifier of the name or -1 if it does not exist.
+    [[nodiscard]] int64_t findIdentifier(
+        const std::string_view name) const noexcept
+    {
+        const auto &shard = getShard(name);
+        std::shared_lock lock(shard.mMutex);
+        auto it = shard.mIdentifiers.find(name);
+        if (it != shard.mIdentifiers.end()){return it->second;}
+        return -1;
+    }
+    /// @result The channel corresponding to this name or NULL if it does not
+    ///         exist or is blacklisted.
+    [[nodiscard]] Channel *findChannel(
+        const std::string_view name) const noexcept
+    {
+        auto identifier = findIdentifier(name);
+        if (identifier < 0){return nullptr;}
+        auto channel = getChannel(static_cast<uint32_t> (identifier));
+        if (channel == nullptr || channel->mBlackListed){return nullptr;}
+        return channel;
+    }
+    /// Interns the packet's name.  This is the rare path hence the global
+    /// lock.
+    [[nodiscard]] uint32_t insert(const std::string &name,
+                                  const UDP::DataPacket &packet)
+    {
+        std::scoped_lock insertLock(mInsertMutex);
+        auto &shard = getShard(name);
+        {
+        std::shared_lock lock(shard.mMutex);
+        auto it = shard.mIdentifiers.find(name);
+        if (it != shard.mIdentifiers.end()){return it->second;} // Beat us
+        }
+        auto identifier = mNextIdentifier.load(std::memory_order_relaxed);
+        auto iSegment = identifier/SEGMENT_SIZE;
+        if (iSegment >= MAX_SEGMENTS)
+        {
+            throw std::runtime_error("Too many channels in collection");
+        }
+        if (mSegments[iSegment].load(std::memory_order_relaxed) == nullptr)
+        {
+            mSegmentStorage.push_back(std::make_unique<Segment> ());
+            for (auto &item : *mSegmentStorage.back())
+            {
+                item.store(nullptr, std::memory_order_relaxed);
+            }
+            mSegments[iSegment].store(mSegmentStorage.back().get(),
+                                      std::memory_order_release);
+        }
+        auto channel = std::make_unique<Channel> ();
+        channel->mName = name;
+        channel->mBlackListed = isBlackListed(packet);
+        if (!channel->mBlackListed)
+        {
+            mLogger->debug("Adding: " + name);
+            channel->mCircularBuffer.initialize(packet.getNetwork(),
+                                                packet.getStation(),
+                                                packet.getChannel(),
+                                                packet.getLocationCode(),
+                                                mMaxPackets,
+                                                mCompress);
+        }
+        else
+        {
+            mLogger->debug("Blacklisting: " + name);
+        }
+        // Publish the channel before its identifier
+        (*mSegments[iSegment].load(std::memory_order_relaxed))
+            [identifier%SEGMENT_SIZE].store(channel.get(),
+                                            std::memory_order_release);
+        mChannelStorage.push_back(std::move(channel));
+        mNextIdentifier.store(identifier + 1, std::memory_order_release);
+        std::scoped_lock lock(shard.mMutex);
+        shard.mIdentifiers.insert(std::pair(name, identifier));
+        return identifier;
+    }
     /// Have sensor?
     [[nodiscard]] bool haveSensor(const std::string &name) const noexcept
     {
-        std::scoped_lock lock(mMutex);
-        return mCircularBufferMap.contains(name);
+        return findChannel(name) != nullptr;
     }
     /// Get all sensor names
     [[nodiscard]] std::unordered_set<std::string> getSensors() const noexcept
     {
         std::unordered_set<std::string> result;
-        std::scoped_lock lock(mMutex);
-        result.reserve(mCircularBufferMap.size());
-        for (auto it = mCircularBufferMap.begin();
-             it != mCircularBufferMap.end(); ++it)
+        auto nChannels = mNextIdentifier.load(std::memory_order_acquire);
+        for (uint32_t identifier = 0; identifier < nChannels; ++identifier)
         {
-            result.insert(it->first);
+            auto channel = getChannel(identifier);
+            if (channel != nullptr && !channel->mBlackListed)
+            {
+                result.insert(channel->mName);
+            }
         }
         return result;
     }
-    /// Update (with move semantics for speed - i.e., no copies)
-    void update(UDP::DataPacket &&packet)
+    /// Update.  The circular buffer copies the samples into its ring.
+    void update(const UDP::DataPacket &packet)
     {
-        auto name = makeName(packet);
-        std::scoped_lock lock(mMutex);
-        auto it = mCircularBufferMap.find(name);
-        if (it == mCircularBufferMap.end())
+        thread_local std::string name;
+        ::makeName(packet, &name);
+        // Common case - channel exists.  Channels are never removed while
+        // running so the pointer remains valid and the circular buffer
+        // serializes its own writes.
+        auto identifier = findIdentifier(name);
+        if (identifier < 0){identifier = insert(name, packet);}
+        auto channel = getChannel(static_cast<uint32_t> (identifier));
+#ifndef NDEBUG
+        assert(channel != nullptr);
+#endif
+        if (channel->mBlackListed){return;}
+        if (mLogger->getLevel() >= UMPS::Logging::Level::Debug)
         {
-            mLogger->debug("Adding: " + name);
-            CircularBuffer cbNew;
-            cbNew.initialize(packet.getNetwork(),
-                             packet.getStation(),
-                             packet.getChannel(),
-                             packet.getLocationCode(),
-                             mMaxPackets);
-            cbNew.addPacket(std::move(packet));
-            mCircularBufferMap.insert(std::pair(name, cbNew));
+            mLogger->debug("Updating: " + name);
         }
-        else
+        auto sequenceNumber = channel->mCircularBuffer.addPacket(packet);
+        if (sequenceNumber > 0 && mInsertionCallback)
         {
-            if (mLogger->getLevel() >= UMPS::Logging::Level::Debug)
-            {
-                mLogger->debug("Updating: " + name);
-            }
-            it->second.addPacket(std::move(packet));
-        } 
+            mInsertionCallback(packet,
+                               makeSensorIdentifier(
+                                   static_cast<uint32_t> (identifier)),
+                               sequenceNumber);
+        }
     }
     /// True indicates the channel is blacklisted 
-    [[nodiscard]] bool isBlackListed(const UDP::DataPacket &packet)
+    [[nodiscard]] bool isBlackListed(const UDP::DataPacket &packet) const
     {
         bool isBlackListed = false;
         if (mBlackList.empty()){return isBlackListed;}
         if (packet.haveChannel())
         {
-            auto channel = packet.getChannel();
+            const auto &channel = packet.getChannel();
             for (const auto &pattern : mBlackList)
             {
                 if (::stringMatch(channel, pattern))
@@ -115,61 +413,80 @@ public:
     [[nodiscard]] int getTotalNumberOfPackets() const noexcept
     {
         int nPackets = 0;
-        std::scoped_lock lock(mMutex);
-        for (auto it = mCircularBufferMap.begin();
-             it != mCircularBufferMap.end(); ++it)
+        auto nChannels = mNextIdentifier.load(std::memory_order_acquire);
+        for (uint32_t identifier = 0; identifier < nChannels; ++identifier)
         {
-            nPackets = nPackets + it->second.getNumberOfPackets();
+            auto channel = getChannel(identifier);
+            if (channel != nullptr && !channel->mBlackListed)
+            {
+                nPackets = nPackets
+                         + channel->mCircularBuffer.getNumberOfPackets();
+            }
         }
         return nPackets;
     }
-    /// Query
-    std::vector<UDP::DataPacket>
-        getPackets(const std::string &name,
-                   const std::chrono::microseconds &t0) const
+    /// Get the memory used by the samples
+    [[nodiscard]] size_t getSampleMemoryUsage() const noexcept
     {
-        std::scoped_lock lock(mMutex);
-        auto it = mCircularBufferMap.find(name);
-        if (it != mCircularBufferMap.end())
+        size_t nBytes = 0;
+        auto nChannels = mNextIdentifier.load(std::memory_order_acquire);
+        for (uint32_t identifier = 0; identifier < nChannels; ++identifier)
         {
-            return it->second.getPackets(t0);
+            auto channel = getChannel(identifier);
+            if (channel != nullptr && !channel->mBlackListed)
+            {
+                nBytes = nBytes
+                       + channel->mCircularBuffer.getSampleMemoryUsage();
+            }
         }
-        throw std::invalid_argument("Sensor: " + name
-                                  + " not in collection");
+        return nBytes;
     }
-    /// Query
-    std::vector<UDP::DataPacket>
-        getPackets(const std::string &name,
-                   const std::chrono::microseconds &t0,
-                   const std::chrono::microseconds &t1) const 
+    /// Get the channel or throw
+    [[nodiscard]] const Channel &getChannel(const std::string &name) const
     {
-        std::scoped_lock lock(mMutex);
-        auto it = mCircularBufferMap.find(name);
-        if (it != mCircularBufferMap.end())
+        auto channel = findChannel(name);
+        if (channel == nullptr)
         {
-            return it->second.getPackets(t0, t1);
+            throw std::invalid_argument("Sensor: " + name
+                                      + " not in collection");
         }
-        throw std::invalid_argument("Sensor: " + name
-                                  + " not in collection");
+        return *channel;
+    }
+    /// Make a sensor identifier.  The upper 32 bits are unique to this
+    /// initialization of the collection so that identifiers handed out by
+    /// a previous instance are not misinterpreted.
+    [[nodiscard]] uint64_t makeSensorIdentifier(
+        const uint32_t identifier) const noexcept
+    {
+        return (static_cast<uint64_t> (mTag) << 32) | identifier;
     }
-    /// Get earliest start time
-    std::chrono::microseconds
-        getEarliestStartTime(const std::string &name) const
+    /// @result The channel corresponding to the sensor identifier or NULL.
+    [[nodiscard]] Channel *findChannel(
+        const uint64_t sensorIdentifier) const noexcept
     {
-        std::scoped_lock lock(mMutex);
-        auto it = mCircularBufferMap.find(name);
-        if (it != mCircularBufferMap.end())
-        {   
-            return it->second.getEarliestStartTime();
+        if (static_cast<uint32_t> (sensorIdentifier >> 32) != mTag)
+        {
+            return nullptr;
         }
-        return std::chrono::microseconds{std::numeric_limits<int>::lowest()};
+        auto channel
+            = getChannel(static_cast<uint32_t> (sensorIdentifier & 0xFFFFFFFF));
+        if (channel == nullptr || channel->mBlackListed){return nullptr;}
+        return channel;
     }
 ///private:
-    mutable std::mutex mMutex;
-    std::map<std::string, CircularBuffer> mCircularBufferMap;
+    std::array<NameShard, N_SHARDS> mNameShards;
+    std::array<std::atomic<Segment *>, MAX_SEGMENTS> mSegments{};
+    std::vector<std::unique_ptr<Segment>> mSegmentStorage;
+    std::vector<std::unique_ptr<Channel>> mChannelStorage;
+    std::mutex mInsertMutex;
     std::set<std::string> mBlackList;
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
+    std::function<void (const UDP::DataPacket &, uint64_t, uint64_t)>
+        mInsertionCallback;
+    std::atomic<uint32_t> mNextIdentifier{0};
     int mMaxPackets{0};
+    uint32_t mTag{0};
+    bool mCompress{false};
     bool mInitialized{false};
 };
 
@@ -191,7 +508,8 @@ CappedCollection::~CappedCollection() = default;
 
 /// Initialization
 void CappedCollection::initialize(const int maxPackets,
-                                  const std::set<std::string> &blackList)
+                                  const std::set<std::string> &blackList,
+                                  const bool compress)
 {
     clear();
     if (maxPackets < 1)
@@ -200,8 +518,11 @@ void CappedCollection::initialize(const int maxPackets,
                                   + std::to_string(maxPackets)
                                   + " must be positive");
     }
+    std::random_device device;
     pImpl->mBlackList = blackList;
     pImpl->mMaxPackets = maxPackets;
+    pImpl->mTag = static_cast<uint32_t> (device());
+    pImpl->mCompress = compress;
     pImpl->mInitialized = true;
 }
 
@@ -211,23 +532,38 @@ bool CappedCollection::isInitialized() const noexcept
     return pImpl->mInitialized;
 }
 
-/// Add a packet
-void CappedCollection::addPacket(const UDP::DataPacket &packet)
+/// Compressed?
+bool CappedCollection::isCompressed() const noexcept
 {
-    auto packetCopy = packet;
-    addPacket(std::move(packetCopy));
+    return pImpl->mCompress;
 }
 
-/// Add packet with move
-void CappedCollection::addPacket(UDP::DataPacket &&packet)
+/// Add a packet
+void CappedCollection::addPacket(const UDP::DataPacket &packet)
 {
-    if (pImpl->isBlackListed(packet)){return;}
     if (!isInitialized()){throw std::runtime_error("Class not initialized");}
     if (!isValidPacket(packet))
     {
+        // Blacklisted channels are silently ignored 
+        if (pImpl->isBlackListed(packet)){return;}
         throw std::invalid_argument("Packet is invalid");
     }
-    pImpl->update(std::move(packet));
+    pImpl->update(packet);
+}
+
+/// Add packet with move
+void CappedCollection::addPacket(UDP::DataPacket &&packet)
+{
+    addPacket(static_cast<const UDP::DataPacket &> (packet));
+}
+
+/// Insertion callback
+void CappedCollection::setInsertionCallback(
+    const std::function<void (const UDP::DataPacket &packet,
+                              uint64_t sensorIdentifier,
+                              uint64_t sequenceNumber)> &callback)
+{
+    pImpl->mInsertionCallback = callback;
 }
 
 /// Reset the class
@@ -252,6 +588,36 @@ bool CappedCollection::haveSensor(const std::string &name) const noexcept
     return pImpl->haveSensor(name);
 }
 
+bool CappedCollection::haveSensor(const uint64_t identifier) const noexcept
+{
+    if (!isInitialized()){return false;}
+    return pImpl->findChannel(identifier) != nullptr;
+}
+
+/// Name to identifier
+uint64_t CappedCollection::getSensorIdentifier(const std::string &name) const
+{
+    auto identifier = pImpl->findIdentifier(name);
+    if (identifier < 0 || !haveSensor(name))
+    {
+        throw std::invalid_argument("Sensor " + name + " not in collection");
+    }
+    return pImpl->makeSensorIdentifier(static_cast<uint32_t> (identifier));
+}
+
+/// Identifier to name
+std::string CappedCollection::getSensorName(const uint64_t identifier) const
+{
+    auto channel = pImpl->findChannel(identifier);
+    if (channel == nullptr)
+    {
+        throw std::invalid_argument("Sensor identifier "
+                                  + std::to_string(identifier)
+                                  + " not in collection");
+    }
+    return channel->mName;
+}
+
 /// Get all the sensor names
 std::unordered_set<std::string>
     CappedCollection::getSensorNames() const noexcept
@@ -259,23 +625,164 @@ std::unordered_set<std::string>
     return pImpl->getSensors();
 }
 
+/// Write the packets to a snapshot file
+int CappedCollection::writeSnapshot(const std::string &fileName) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    // Take views of each channel's packets.  Each buffer is only briefly
+    // read-locked so ingest continues while the snapshot is written.
+    constexpr std::chrono::microseconds
+        t0{std::numeric_limits<int64_t>::lowest()};
+    std::vector<std::pair<std::string, std::vector<PacketView>>> channels;
+    for (const auto &name : getSensorNames())
+    {
+        auto channel = pImpl->findChannel(name);
+        if (channel == nullptr){continue;}
+        auto views = channel->mCircularBuffer.getPacketViews(t0);
+        if (views.empty()){continue;}
+        channels.emplace_back(name, std::move(views));
+    }
+    auto temporaryFile = fileName + ".tmp";
+    std::ofstream file(temporaryFile, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Could not open " + temporaryFile);
+    }
+    std::string buffer;
+    buffer.reserve(SNAPSHOT_HEADER_SIZE);
+    buffer.append(SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size());
+    ::append(&buffer, SNAPSHOT_VERSION);
+    ::append(&buffer, SNAPSHOT_BYTE_ORDER_MARK);
+    ::append(&buffer, static_cast<uint64_t> (channels.size()));
+    ::append(&buffer, uint64_t {0});
+    file.write(buffer.data(), static_cast<std::streamsize> (buffer.size()));
+    int nPackets = 0;
+    for (const auto &[name, views] : channels)
+    {
+        buffer.clear();
+        ::append(&buffer, static_cast<uint32_t> (name.size()));
+        ::append(&buffer, static_cast<uint32_t> (views.size()));
+        buffer.append(name);
+        buffer.resize(8 + ::padTo8(name.size()), '\0');
+        file.write(buffer.data(),
+                   static_cast<std::streamsize> (buffer.size()));
+        for (const auto &view : views)
+        {
+            buffer.clear();
+            ::append(&buffer, static_cast<int64_t> (view.getStartTime().count()));
+            ::append(&buffer, view.getSamplingRate());
+            ::append(&buffer,
+                     static_cast<uint64_t> (view.getNumberOfSamples()));
+            file.write(buffer.data(),
+                       static_cast<std::streamsize> (buffer.size()));
+            file.write(reinterpret_cast<const char *> (view.getDataPointer()),
+                       static_cast<std::streamsize>
+                       (sizeof(double)*view.getNumberOfSamples()));
+        }
+        nPackets = nPackets + static_cast<int> (views.size());
+    }
+    file.close();
+    if (file.fail())
+    {
+        std::filesystem::remove(temporaryFile);
+        throw std::runtime_error("Failed to write " + temporaryFile);
+    }
+    // Replacing the previous snapshot is atomic so a crash while writing
+    // never leaves a partial snapshot behind
+    std::filesystem::rename(temporaryFile, fileName);
+    return nPackets;
+}
+
+/// Load the packets in a snapshot file
+int CappedCollection::loadSnapshot(const std::string &fileName)
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (!std::filesystem::exists(fileName))
+    {
+        throw std::invalid_argument("Snapshot " + fileName
+                                  + " does not exist");
+    }
+    ::MappedFile file(fileName);
+    size_t offset = 0;
+    const auto *magic = file.advance(&offset, SNAPSHOT_MAGIC.size());
+    if (std::memcmp(magic, SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size()) != 0)
+    {
+        throw std::runtime_error(fileName + " is not a snapshot");
+    }
+    if (file.read<uint32_t> (&offset) != SNAPSHOT_VERSION)
+    {
+        throw std::runtime_error("Unsupported snapshot version");
+    }
+    if (file.read<uint32_t> (&offset) != SNAPSHOT_BYTE_ORDER_MARK)
+    {
+        throw std::runtime_error("Snapshot byte order does not match host");
+    }
+    auto nChannels = file.read<uint64_t> (&offset);
+    offset = SNAPSHOT_HEADER_SIZE;
+    int nPackets = 0;
+    std::array<std::string, 4> parts;
+    for (uint64_t iChannel = 0; iChannel < nChannels; ++iChannel)
+    {
+        auto nameLength = file.read<uint32_t> (&offset);
+        auto nChannelPackets = file.read<uint32_t> (&offset);
+        const auto *namePointer = file.advance(&offset, ::padTo8(nameLength));
+        std::string name(namePointer, nameLength);
+        if (!::splitName(name, &parts))
+        {
+            throw std::runtime_error("Invalid sensor name in snapshot: "
+                                   + name);
+        }
+        for (uint32_t iPacket = 0; iPacket < nChannelPackets; ++iPacket)
+        {
+            auto startTime = file.read<int64_t> (&offset);
+            auto samplingRate = file.read<double> (&offset);
+            auto nSamples = file.read<uint64_t> (&offset);
+            if (nSamples > static_cast<uint64_t>
+                           (std::numeric_limits<int>::max())/sizeof(double))
+            {
+                throw std::runtime_error("Snapshot is corrupt");
+            }
+            const auto *data
+                = reinterpret_cast<const double *>
+                  (file.advance(&offset, sizeof(double)*nSamples));
+            UDP::DataPacket packet;
+            packet.setNetwork(parts[0]);
+            packet.setStation(parts[1]);
+            packet.setChannel(parts[2]);
+            packet.setLocationCode(parts[3]);
+            packet.setSamplingRate(samplingRate);
+            packet.setStartTime(std::chrono::microseconds {startTime});
+            packet.setData(static_cast<int> (nSamples), data);
+            addPacket(std::move(packet));
+        }
+        nPackets = nPackets + static_cast<int> (nChannelPackets);
+    }
+    return nPackets;
+}
+
 /// Get total number of packets
 int CappedCollection::getTotalNumberOfPackets() const noexcept
 {
     return pImpl->getTotalNumberOfPackets();
 }
 
+/// Memory used by the samples
+size_t CappedCollection::getSampleMemoryUsage() const noexcept
+{
+    return pImpl->getSampleMemoryUsage();
+}
+
 /// Earliest time
 std::chrono::microseconds
     CappedCollection::getEarliestStartTime(const std::string &name) const
 {
-    auto t = pImpl->getEarliestStartTime(name);
-    if (t == std::chrono::microseconds{std::numeric_limits<int>::lowest()})
+    auto channel = pImpl->findChannel(name);
+    if (channel == nullptr)
     {
         throw std::runtime_error("Sensor " + name
                                + " does not exist in collection");
     }
-    return t;
+    return channel->mCircularBuffer.getEarliestStartTime();
 }
 
 
@@ -288,7 +795,7 @@ std::vector<UDP::DataPacket>
     {
         throw std::runtime_error("Sensor " + name + " not in collection");
     }
-    return pImpl->getPackets(name, t0); 
+    return pImpl->getChannel(name).mCircularBuffer.getPackets(t0);
 }
 
 std::vector<UDP::DataPacket>
@@ -314,7 +821,7 @@ std::vector<UDP::DataPacket>
                                   + " must be less than t1 = "
                                   + std::to_string(t1.count()));
     }
-    return pImpl->getPackets(name, t0, t1);
+    return pImpl->getChannel(name).mCircularBuffer.getPackets(t0, t1);
 }
 
 std::vector<UDP::DataPacket>
@@ -326,3 +833,108 @@ std::vector<UDP::DataPacket>
                       ::secondsToMicroSeconds(t0),
                       ::secondsToMicroSeconds(t1));
 }
+
+/// Get views of the packets from t0 to t1
+std::vector<PacketView>
+    CappedCollection::getPacketViews(const std::string &name,
+                                     const std::chrono::microseconds &t0,
+                                     const std::chrono::microseconds &t1) const
+{
+    if (!haveSensor(name))
+    {
+        throw std::runtime_error("Sensor " + name + " not in collection");
+    }
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return pImpl->getChannel(name).mCircularBuffer.getPacketViews(t0, t1);
+}
+
+/// Get views of the packets from t0 to t1 by sensor identifier
+std::vector<PacketView>
+    CappedCollection::getPacketViews(const uint64_t identifier,
+                                     const std::chrono::microseconds &t0,
+                                     const std::chrono::microseconds &t1) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    auto channel = pImpl->findChannel(identifier);
+    if (channel == nullptr)
+    {
+        throw std::runtime_error("Sensor identifier "
+                               + std::to_string(identifier)
+                               + " not in collection");
+    }
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return channel->mCircularBuffer.getPacketViews(t0, t1);
+}
+
+/// Get views of the packets from t0 to t1 added since the cursor
+std::pair<std::vector<PacketView>, uint64_t>
+    CappedCollection::getPacketViews(const uint64_t identifier,
+                                     const std::chrono::microseconds &t0,
+                                     const std::chrono::microseconds &t1,
+                                     const uint64_t cursor) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    auto channel = pImpl->findChannel(identifier);
+    if (channel == nullptr)
+    {
+        throw std::runtime_error("Sensor identifier "
+                               + std::to_string(identifier)
+                               + " not in collection");
+    }
+    return channel->mCircularBuffer.getPacketViews(t0, t1, cursor);
+}
+
+/// Get views of the packets from t0 to t1 added since the cursor or
+/// beginning after the cursor end time
+std::tuple<std::vector<PacketView>, uint64_t, std::chrono::microseconds>
+    CappedCollection::getPacketViews(
+        const uint64_t identifier,
+        const std::chrono::microseconds &t0,
+        const std::chrono::microseconds &t1,
+        const uint64_t cursor,
+        const std::chrono::microseconds &cursorEndTime) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    auto channel = pImpl->findChannel(identifier);
+    if (channel == nullptr)
+    {
+        throw std::runtime_error("Sensor identifier "
+                               + std::to_string(identifier)
+                               + " not in collection");
+    }
+    return channel->mCircularBuffer.getPacketViews(t0, t1, cursor,
+                                                   cursorEndTime);
+}
+
+/// Describe the packets from t0 to t1 by sensor identifier
+std::vector<PacketSummary>
+    CappedCollection::getPacketSummaries(const uint64_t identifier,
+                                         const std::chrono::microseconds &t0,
+                                         const std::chrono::microseconds &t1) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    auto channel = pImpl->findChannel(identifier);
+    if (channel == nullptr)
+    {
+        throw std::runtime_error("Sensor identifier "
+                               + std::to_string(identifier)
+                               + " not in collection");
+    }
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return channel->mCircularBuffer.getPacketSummaries(t0, t1);
+}
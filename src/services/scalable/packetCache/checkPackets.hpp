@@ -3,10 +3,11 @@
 #include <vector>
 #include <string>
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
 namespace
 {
 
-[[nodiscard]]
+[[maybe_unused]] [[nodiscard]]
 std::pair<std::chrono::microseconds, std::chrono::microseconds>
 checkPacketsAndGetStartEndTime(
     const std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket>
@@ -63,5 +64,36 @@ checkPacketsAndGetStartEndTime(
     return std::pair {t0Packets, t1Packets};
 }
 
+/// @brief As above but for the packet views of a data response.  The views
+///        share the response's channel so only the times are checked.
+[[maybe_unused]] [[nodiscard]]
+std::pair<std::chrono::microseconds, std::chrono::microseconds>
+checkPacketsAndGetStartEndTime(
+    const std::vector<URTS::Services::Scalable::PacketCache::PacketView>
+        &packets)
+{
+    if (packets.empty())
+    {
+        throw std::runtime_error("No packets - shouldn't be here");
+    }
+    auto t0Packets = packets.front().getStartTime();
+    auto t1Packets = packets.front().getEndTime();
+    for (const auto &packet : packets)
+    {
+        if (!(packet.getSamplingRate() > 0))
+        {
+            throw std::invalid_argument("Sampling rate not set for packet ");
+        }
+        if (packet.getStartTime() > packet.getEndTime())
+        {
+            throw std::invalid_argument(
+               "Packet start time > packet end time");
+        }
+        t0Packets = std::min(t0Packets, packet.getStartTime());
+        t1Packets = std::max(t1Packets, packet.getEndTime());
+    }
+    return std::pair {t0Packets, t1Packets};
+}
+
 }
 #endif
@@ -10,6 +10,8 @@
 #endif
 #include <boost/circular_buffer.hpp>
 #include "urts/services/scalable/packetCache/circularBuffer.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "urts/services/scalable/packetCache/packetSummary.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "private/isEmpty.hpp"
 #include "utilities.hpp"
@@ -291,7 +293,7 @@ CircularBuffer& CircularBuffer::operator=(CircularBuffer &&cb) noexcept
 void CircularBuffer::initialize(
     const std::string &network, const std::string &station,
     const std::string &channel, const std::string &locationCode,
-    const int maxPackets)
+    const int maxPackets, const bool compress)
 {
     clear();
     if (::isEmpty(network)){throw std::invalid_argument("Network is empty");}
@@ -306,16 +308,23 @@ void CircularBuffer::initialize(
         throw std::invalid_argument("maxPackets " + std::to_string(maxPackets)
                                   + " must be positive");
     }
-    pImpl->mCircularBuffer.rset_capacity(maxPackets);
+    pImpl->setCapacity(maxPackets);
     pImpl->mNetwork = network;
     pImpl->mStation = station;
     pImpl->mChannel = channel;
     pImpl->mLocationCode = locationCode;
     pImpl->mName = ::makeName(network, station, channel, locationCode);
     pImpl->mMaxPackets = maxPackets;
+    pImpl->mCompress = compress;
     pImpl->mInitialized = true;
 }
 
+/// Compressed?
+bool CircularBuffer::isCompressed() const noexcept
+{
+    return pImpl->mCompress;
+}
+
 std::string CircularBuffer::getNetwork() const
 {
     if (!isInitialized()){throw std::invalid_argument("Class not initialized");}
@@ -352,6 +361,12 @@ int CircularBuffer::getNumberOfPackets() const noexcept
     return pImpl->size();
 }
 
+/// Memory used by the samples
+size_t CircularBuffer::getSampleMemoryUsage() const noexcept
+{
+    return pImpl->getSampleMemoryUsage();
+}
+
 /// Circular buffer capacity
 int CircularBuffer::getMaximumNumberOfPackets() const
 {
@@ -366,29 +381,28 @@ void CircularBuffer::clear() noexcept
 }
 
 /// Add a packet
-void CircularBuffer::addPacket(UDP::DataPacket &&packet)
+uint64_t CircularBuffer::addPacket(const UDP::DataPacket &packet)
 {
     // Is this a valid packet?
     if (!::isValidPacket(packet))
     {   
         throw std::invalid_argument("Packet is invalid");
     }
-    // Make the packet name
-    auto packetName = ::makeName(packet);
-    if (packetName != pImpl->mName)
+    // Check the packet name
+    if (!::haveName(packet, pImpl->mName))
     {   
-        throw std::invalid_argument("Packet for " + packetName
+        throw std::invalid_argument("Packet for " + ::makeName(packet)
                                   + " does not belong in buffer for "
                                   + pImpl->mName);
     }   
-    pImpl->update(std::move(packet));
+    // The samples are copied into the ring so there is nothing to steal
+    return pImpl->update(packet);
 }
 
 /// Add a packet
-void CircularBuffer::addPacket(const UDP::DataPacket &packet)
+uint64_t CircularBuffer::addPacket(UDP::DataPacket &&packet)
 {
-    auto packetCopy = packet;
-    addPacket(std::move(packetCopy));
+    return addPacket(static_cast<const UDP::DataPacket &> (packet));
 }
 
 /// Get earliest start time
@@ -484,3 +498,77 @@ std::vector<UDP::DataPacket> CircularBuffer::getPackets(
     return packets;
 }
 
+/// Get views of all packets from given time to now
+std::vector<PacketView> CircularBuffer::getPacketViews(
+    const std::chrono::microseconds &t0) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    constexpr std::chrono::microseconds
+        t1{std::numeric_limits<int64_t>::max()};
+    return pImpl->getPacketViews(t0, t1);
+}
+
+/// Get views of all packets from given time t0 to given time t1
+std::vector<PacketView> CircularBuffer::getPacketViews(
+    const std::chrono::microseconds &t0,
+    const std::chrono::microseconds &t1) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return pImpl->getPacketViews(t0, t1);
+}
+
+/// Get views of the packets from t0 to t1 added after the cursor
+std::pair<std::vector<PacketView>, uint64_t>
+    CircularBuffer::getPacketViews(const std::chrono::microseconds &t0,
+                                   const std::chrono::microseconds &t1,
+                                   const uint64_t cursor) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return pImpl->getPacketViews(t0, t1, cursor);
+}
+
+/// Get views of the packets from t0 to t1 added after the cursor or
+/// beginning after the cursor end time
+std::tuple<std::vector<PacketView>, uint64_t, std::chrono::microseconds>
+    CircularBuffer::getPacketViews(
+        const std::chrono::microseconds &t0,
+        const std::chrono::microseconds &t1,
+        const uint64_t cursor,
+        const std::chrono::microseconds &cursorEndTime) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return pImpl->getPacketViews(t0, t1, cursor, cursorEndTime);
+}
+
+/// Describe the packets from t0 to t1
+std::vector<PacketSummary> CircularBuffer::getPacketSummaries(
+    const std::chrono::microseconds &t0,
+    const std::chrono::microseconds &t1) const
+{
+    if (!isInitialized()){throw std::runtime_error("Class not initialized");}
+    if (t1 <= t0)
+    {
+        throw std::invalid_argument("t0 = " + std::to_string(t0.count())
+                                  + " must be less than t1 = "
+                                  + std::to_string(t1.count()));
+    }
+    return pImpl->getPacketSummaries(t0, t1);
+}
@@ -3,112 +3,153 @@
 #include <iostream>
 #include <cmath>
 #include <string>
-#include <map>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <algorithm>
+#include <tuple>
 #ifndef NDEBUG
 #include <cassert>
 #endif
 #include <boost/circular_buffer.hpp>
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "urts/services/scalable/packetCache/packetSummary.hpp"
+#include "private/sampleCodec.hpp"
 
 #define NAN_TIME std::chrono::microseconds{std::numeric_limits<int64_t>::lowest()}
 
+/// @brief The packet cache storage engine.  Rather than holding one data
+///        packet (and its many small heap allocations) per slot, the samples
+///        for this channel are written back-to-back into a ring of large
+///        chunks.  The chunks are sized from the first packet and allocated
+///        as the buffer fills; after that, freed chunks are recycled so a
+///        full buffer stops allocating.  Packet boundaries are tracked in a
+///        small, time-sorted side index.
+///
+///        Samples are immutable once written and each index entry shares
+///        ownership of the chunk holding its samples.  Queries can therefore
+///        hand out reference-counted views instead of copies.  A chunk is
+///        only rewritten once neither the index nor any outstanding view
+///        refers to it; otherwise, a new chunk is allocated.
+///
+///        Optionally, each packet's samples can instead be losslessly
+///        compressed into their own small buffer.  This trades decoding on
+///        every query for a much longer retention in the same memory.
 template<class T>
 class URTS::Services::Scalable::PacketCache::CircularBufferImpl
 {
 public:
-    void update(T &&packet)
+    /// Describes where a packet's samples live.
+    struct PacketIndex
     {
-        auto t0 = packet.getStartTime(); 
-        std::scoped_lock lock(mMutex);
-        if (mCircularBuffer.capacity() == 0L)
+        std::shared_ptr<const double> data{nullptr};
+        /// The compressed samples.  When set, data is not used.
+        std::shared_ptr<const std::vector<uint8_t>> encoded{nullptr};
+        std::chrono::microseconds startTime{0};
+        std::chrono::microseconds endTime{0};
+        double samplingRate{0};
+        /// The order in which the packet was stored.  This is strictly
+        /// increasing so clients can request only what they have not seen.
+        uint64_t sequence{0};
+        int nSamples{0};
+    };
+    /// A contiguous block of sample storage.
+    struct Chunk
+    {
+        std::shared_ptr<double[]> samples{nullptr};
+        size_t size{0};
+    };
+    /// Adds a packet to the buffer.  This returns the packet's sequence
+    /// number or 0 if the packet expired and was not added.
+    [[nodiscard]] uint64_t update(const T &packet)
+    {
+        PacketIndex entry;
+        entry.startTime = packet.getStartTime();
+        entry.endTime = packet.getEndTime();
+        entry.samplingRate = packet.getSamplingRate();
+        entry.nSamples = packet.getNumberOfSamples();
+        const auto *data = packet.getDataPointer();
+        auto t0 = entry.startTime;
+        // Compress before taking the lock so readers are not held up
+        if (mCompress)
         {
-            throw std::runtime_error("Circular capacity is 0");
+            entry.encoded = std::make_shared<const std::vector<uint8_t>>
+                            (::encodeSamples(data, entry.nSamples));
         }
-        // Empty buffer case
-        if (mCircularBuffer.empty())
+        std::scoped_lock lock(mMutex);
+        if (mIndex.capacity() == 0L)
         {
-            mCircularBuffer.push_back(std::move(packet));
-            return;
+            throw std::runtime_error("Circular capacity is 0");
         }
-        // Most common thing will be a new piece of data at end
-        auto t1Buffer = mCircularBuffer.back().getStartTime();
-        if (t0 > t1Buffer)
+        entry.sequence = mSequence + 1;
+        // Empty buffer or the most common case of new data at the end
+        if (mIndex.empty() || t0 > mIndex.back().startTime)
         {
-            mCircularBuffer.push_back(std::move(packet));
-            return;
+            if (mIndex.full()){mIndex.pop_front();}
+            store(&entry, data);
+            mIndex.push_back(std::move(entry));
+            mSequence = mSequence + 1;
+            return mSequence;
         }
         // Now the joy of backfilling data begins.  Is the data too old?
-        auto t0Buffer = mCircularBuffer.front().getStartTime();
-        // Data expired and the buffer is full so skip it. 
-        if (t0 < t0Buffer && mCircularBuffer.full()){return;}
-        // The packet is not too old so it will go somewhere in the CB.
-        // Find the packet whose start time is greater than or equal to this
-        // packet's start value.
-        auto it = std::upper_bound(mCircularBuffer.begin(),
-                                   mCircularBuffer.end(), packet,
-                                   [](const T &lhs, const T &rhs)
+        // Data expired and the buffer is full so skip it.
+        if (t0 < mIndex.front().startTime && mIndex.full()){return 0;}
+        // The packet is not too old so it will go somewhere in the index.
+        // Find the first packet whose start time is not less than this
+        // packet's start time.
+        auto it = std::lower_bound(mIndex.begin(), mIndex.end(), t0,
+                                   [](const PacketIndex &lhs,
+                                      const std::chrono::microseconds t)
                                    {
-                                      return lhs.getStartTime() <
-                                             rhs.getStartTime();
+                                      return lhs.startTime < t;
                                    });
-        // By this point we shouldn't be pointing to the end of the CB.
-        if (it != mCircularBuffer.end())
+        auto index = std::distance(mIndex.begin(), it);
+        // We have an exact match - overwrite the old packet.  The old
+        // samples are released when nothing else refers to their chunk.
+        if (it != mIndex.end() && it->startTime == t0)
         {
-            // We have an exact match - ovewrite the old packet
-            auto index = std::distance(mCircularBuffer.begin(), it);
-            auto t0Neighbor = mCircularBuffer[index].getStartTime();
-            if (t0Neighbor == t0)
-            {
-                mCircularBuffer[index] = std::move(packet);
-                return; 
-            }
-            // Insert the element before its upper bounding element
-            mCircularBuffer.rinsert(it, std::move(packet));
-            // Debug code checks this is sorted
+            store(&entry, data);
+            mIndex[index] = std::move(entry);
+            mSequence = mSequence + 1;
+            return mSequence;
+        }
+        // Make room then insert the element before its upper bounding
+        // element.
+        if (mIndex.full())
+        {
+            mIndex.pop_front();
+            index = index - 1;
+        }
+        store(&entry, data);
+        mIndex.insert(mIndex.begin() + index, std::move(entry));
+        mSequence = mSequence + 1;
 #ifndef NDEBUG
-            assert(std::is_sorted(mCircularBuffer.begin(),
-                                  mCircularBuffer.end(),
-                                  [](const T &lhs, const T &rhs)
-                                  {
-                                     return lhs.getStartTime() <
-                                            rhs.getStartTime();
-                                  }));
+        assert(std::is_sorted(mIndex.begin(), mIndex.end(),
+                              [](const PacketIndex &lhs,
+                                 const PacketIndex &rhs)
+                              {
+                                 return lhs.startTime < rhs.startTime;
+                              }));
 #endif
-            // This isn't beautiful but now we insert the packet at the end
-            // and sort the (mostly sorted circular buffer).  Basically,
-            // backfilling is an ugly process we want to do as little as
-            // possible.
-            //mCircularBuffer.push_back(packet);
-            //mCircularBuffer.rinsert(it, packet);
-            //std::sort(mCircularBuffer.begin(), mCircularBuffer.end(),
-            //          [](const T &lhs, const T &rhs)
-            //          {
-            //             return lhs.getStartTime() < rhs.getStartTime();
-            //          });
-        }
+        return mSequence;
     }
     [[nodiscard]] std::chrono::microseconds getEarliestStartTime() const
     {
-        std::scoped_lock lock(mMutex);
-        if (mCircularBuffer.empty())
-        {
-            return NAN_TIME;
-        }
-        const auto &packet = mCircularBuffer.front(); 
-        return packet.getStartTime();
+        std::shared_lock lock(mMutex);
+        if (mIndex.empty()){return NAN_TIME;}
+        return mIndex.front().startTime;
     }
     // Get all packets currently in buffer
     [[nodiscard]] std::vector<T> getAllPackets() const
     {
         std::vector<T> result;
-        std::scoped_lock lock(mMutex);
-        auto nPackets = mCircularBuffer.size();
-        result.reserve(nPackets); 
-        for (const auto &packet : mCircularBuffer)
+        std::shared_lock lock(mMutex);
+        result.reserve(mIndex.size());
+        for (const auto &entry : mIndex)
         {
-            result.push_back(packet);
+            result.push_back(toPacket(entry));
         }
         return result;
     }
@@ -118,127 +159,383 @@ public:
                    const std::chrono::microseconds t1MuS) const
     {
         std::vector<T> result;
-        std::scoped_lock lock(mMutex);
-        if (mCircularBuffer.empty()){return result;}
-        auto it0 = std::upper_bound(mCircularBuffer.begin(),
-                                    mCircularBuffer.end(), t0MuS,
-                                    [](const std::chrono::microseconds t0MuS,
-                                       const T &rhs)
-                                    {
-                                       return t0MuS <= rhs.getStartTime();
-                                    });
-        if (it0 == mCircularBuffer.end()){return result;}
-        // Attempt to move back one b/c of upper_bound works
-        if (it0 != mCircularBuffer.begin() && it0->getStartTime() > t0MuS)
-        {
-            it0 = std::prev(it0, 1);
-            // If the end time of the previous packet is before t0MuS
-            // then restore the iterator as this packet is too old.
-            if (it0->getEndTime() < t0MuS){it0 = std::next(it0);}
-        }
-        // For efficiency's sake when we query with
-        auto it1 = mCircularBuffer.end();
-        if (t1MuS < mCircularBuffer.back().getStartTime())
-        {
-            it1 = std::upper_bound(mCircularBuffer.begin(),
-                                   mCircularBuffer.end(), t1MuS,
-                                   [](const std::chrono::microseconds t1MuS,
-                                      const T &rhs)
-                                   {
-                                      return t1MuS < rhs.getStartTime();
-                                   });
-        }
-        // Just one packet
-        if (it0 == it1)
+        std::shared_lock lock(mMutex);
+        auto [it0, it1] = getQueryRange(t0MuS, t1MuS);
+        auto nPackets = static_cast<int> (std::distance(it0, it1));
+        if (nPackets < 1){return result;}
+        result.reserve(nPackets);
+        for (auto it = it0; it != it1; std::advance(it, 1))
         {
-            result.push_back(*it0);
-            return result;
+            result.push_back(toPacket(*it));
         }
-        // General copy
 #ifndef NDEBUG
-        // Don't want an infinite copy
-        assert(std::distance(mCircularBuffer.begin(), it0) <
-               std::distance(mCircularBuffer.begin(), it1));
+        assert(nPackets == static_cast<int> (result.size()));
 #endif
+        return result;
+    }
+    // Perform query from now until whenever but only share the samples
+    [[nodiscard]] std::vector<PacketView>
+        getPacketViews(const std::chrono::microseconds t0MuS,
+                       const std::chrono::microseconds t1MuS) const
+    {
+        std::vector<PacketView> result;
+        std::shared_lock lock(mMutex);
+        auto [it0, it1] = getQueryRange(t0MuS, t1MuS);
         auto nPackets = static_cast<int> (std::distance(it0, it1));
         if (nPackets < 1){return result;}
         result.reserve(nPackets);
-        for (auto &it = it0; it != it1; std::advance(it, 1))
+        for (auto it = it0; it != it1; std::advance(it, 1))
         {
-            result.push_back(*it);
+            result.emplace_back(it->startTime, it->samplingRate,
+                                it->nSamples, getSamples(*it));
+        }
+        return result;
+    }
+    /// Query views of the packets in [t0, t1] that were stored after the
+    /// cursor.  The updated cursor, which is the highest sequence number
+    /// delivered, is returned alongside the views.
+    [[nodiscard]] std::pair<std::vector<PacketView>, uint64_t>
+        getPacketViews(const std::chrono::microseconds t0MuS,
+                       const std::chrono::microseconds t1MuS,
+                       const uint64_t cursor) const
+    {
+        std::vector<PacketView> result;
+        std::shared_lock lock(mMutex);
+        auto newCursor = cursor;
+        auto [it0, it1] = getQueryRange(t0MuS, t1MuS);
+        for (auto it = it0; it != it1; std::advance(it, 1))
+        {
+            if (it->sequence > cursor)
+            {
+                result.emplace_back(it->startTime, it->samplingRate,
+                                    it->nSamples, getSamples(*it));
+                newCursor = std::max(newCursor, it->sequence);
+            }
+        }
+        return std::pair {std::move(result), newCursor};
+    }
+    /// Query views of the packets in [t0, t1] that were stored after the
+    /// cursor or that begin after the cursor end time, i.e., that were not
+    /// in the window of the query which returned the cursor.  The updated
+    /// cursor and cursor end time are returned alongside the views.
+    [[nodiscard]] std::tuple<std::vector<PacketView>, uint64_t,
+                             std::chrono::microseconds>
+        getPacketViews(const std::chrono::microseconds t0MuS,
+                       const std::chrono::microseconds t1MuS,
+                       const uint64_t cursor,
+                       const std::chrono::microseconds cursorEndTime) const
+    {
+        std::vector<PacketView> result;
+        std::shared_lock lock(mMutex);
+        auto newCursor = cursor;
+        // A lone packet after t1 can be returned so it must count as seen
+        auto newCursorEndTime = t1MuS;
+        auto [it0, it1] = getQueryRange(t0MuS, t1MuS);
+        for (auto it = it0; it != it1; std::advance(it, 1))
+        {
+            if (it->sequence > cursor || it->startTime > cursorEndTime)
+            {
+                result.emplace_back(it->startTime, it->samplingRate,
+                                    it->nSamples, getSamples(*it));
+                newCursor = std::max(newCursor, it->sequence);
+            }
+            newCursorEndTime = std::max(newCursorEndTime, it->startTime);
+        }
+        return std::tuple {std::move(result), newCursor, newCursorEndTime};
+    }
+    /// Describes the packets in [t0, t1] without touching their samples
+    [[nodiscard]] std::vector<PacketSummary>
+        getPacketSummaries(const std::chrono::microseconds t0MuS,
+                           const std::chrono::microseconds t1MuS) const
+    {
+        std::vector<PacketSummary> result;
+        std::shared_lock lock(mMutex);
+        auto [it0, it1] = getQueryRange(t0MuS, t1MuS);
+        result.reserve(std::distance(it0, it1));
+        for (auto it = it0; it != it1; std::advance(it, 1))
+        {
+            result.push_back(PacketSummary {it->startTime, it->endTime,
+                                            it->sequence, it->nSamples});
         }
-#ifndef NDEBUG
-        assert(nPackets == static_cast<int> (result.size()));
-#endif
         return result;
     }
     /// Resets the class
     void clear() noexcept
     {
         std::scoped_lock lock(mMutex);
-        mCircularBuffer.clear();
+        mIndex.clear();
+        mIndex.set_capacity(0);
+        mChunks.clear();
+        mChunk = Chunk {};
+        mChunkOffset = 0;
+        mChunkSize = 0;
+        mSequence = 0;
         mName.clear();
         mNetwork.clear();
         mStation.clear();
         mChannel.clear();
         mLocationCode.clear();
         mMaxPackets = 0;
+        mCompress = false;
         mInitialized = false;
     }
     /// Return the capacity (max space) in the circular buffer
     int capacity() const noexcept
     {
-        std::scoped_lock lock(mMutex);
-        return static_cast<int> (mCircularBuffer.capacity());
+        std::shared_lock lock(mMutex);
+        return static_cast<int> (mIndex.capacity());
     }
     /// Return the size of the circular buffer
     int size() const noexcept
+    {
+        std::shared_lock lock(mMutex);
+        return static_cast<int> (mIndex.size());
+    }
+    /// Return the number of bytes held for samples.  For uncompressed
+    /// storage this is the allocated chunks, including their unused tails.
+    size_t getSampleMemoryUsage() const noexcept
+    {
+        std::shared_lock lock(mMutex);
+        size_t nBytes = 0;
+        if (mCompress)
+        {
+            for (const auto &entry : mIndex)
+            {
+                if (entry.encoded != nullptr)
+                {
+                    nBytes = nBytes + entry.encoded->capacity();
+                }
+            }
+            return nBytes;
+        }
+        for (const auto &chunk : mChunks){nBytes = nBytes + chunk.size;}
+        nBytes = nBytes + mChunk.size;
+        return sizeof(double)*nBytes;
+    }
+    /// Sets the maximum number of packets
+    void setCapacity(const int maxPackets)
     {
         std::scoped_lock lock(mMutex);
-        return static_cast<int> (mCircularBuffer.size());
+        mIndex.set_capacity(maxPackets);
+        mMaxPackets = maxPackets;
+        // Room for the chunks covering a full buffer plus as many again
+        // held by outstanding views
+        auto nChunks = (static_cast<size_t> (std::max(1, maxPackets))
+                      + PACKETS_PER_CHUNK - 1)/PACKETS_PER_CHUNK;
+        mChunks.reserve(2*nChunks);
     }
     /// C'tor
     CircularBufferImpl() = default;
-    /// Copy c'tor
+    /// Copy c'tor.  Since the chunks are written in place the samples must
+    /// be deep copied into this buffer's own chunks.
     CircularBufferImpl(const CircularBufferImpl &cb)
     {
-        std::scoped_lock lock(cb.mMutex);
-        mCircularBuffer = cb.mCircularBuffer;
+        std::shared_lock lock(cb.mMutex);
+        mIndex.set_capacity(cb.mIndex.capacity());
+        mChunkSize = cb.mChunkSize;
+        mSequence = cb.mSequence;
+        mCompress = cb.mCompress;
+        for (const auto &entry : cb.mIndex)
+        {
+            auto entryCopy = entry;
+            // Compressed samples are immutable so they can be shared
+            if (entry.encoded == nullptr)
+            {
+                entryCopy.data = write(entry.data.get(), entry.nSamples);
+            }
+            mIndex.push_back(std::move(entryCopy));
+        }
         mName = cb.mName;
         mNetwork = cb.mNetwork;
         mStation = cb.mStation;
         mChannel = cb.mChannel;
         mLocationCode = cb.mLocationCode;
         mMaxPackets = cb.mMaxPackets;
-        mInitialized = cb.mInitialized; 
+        mInitialized = cb.mInitialized;
     }
     /// Move c'tor
     CircularBufferImpl(CircularBufferImpl &&cb) noexcept
     {
         std::scoped_lock lock(cb.mMutex);
-        mCircularBuffer = std::move(cb.mCircularBuffer);
+        mIndex = std::move(cb.mIndex);
+        mChunks = std::move(cb.mChunks);
+        mChunk = std::move(cb.mChunk);
+        mChunkOffset = cb.mChunkOffset;
+        mChunkSize = cb.mChunkSize;
+        mSequence = cb.mSequence;
         mName = std::move(cb.mName);
         mNetwork = std::move(cb.mNetwork);
         mStation = std::move(cb.mStation);
         mChannel = std::move(cb.mChannel);
         mLocationCode = std::move(cb.mLocationCode);
         mMaxPackets = cb.mMaxPackets;
+        mCompress = cb.mCompress;
         mInitialized = cb.mInitialized;
     }
     /// Destructor
     ~CircularBufferImpl()
     {
-        clear(); 
+        clear();
     }
 ///private:
-    mutable std::mutex mMutex;
-    boost::circular_buffer<T> mCircularBuffer;
+    /// Finds the packets in the index overlapping [t0, t1].
+    /// @note The mutex must be held by the caller.
+    [[nodiscard]]
+    std::pair<typename boost::circular_buffer<PacketIndex>::const_iterator,
+              typename boost::circular_buffer<PacketIndex>::const_iterator>
+        getQueryRange(const std::chrono::microseconds t0MuS,
+                      const std::chrono::microseconds t1MuS) const
+    {
+        auto itEnd = mIndex.end();
+        if (mIndex.empty()){return std::pair {itEnd, itEnd};}
+        auto it0 = std::upper_bound(mIndex.begin(), mIndex.end(), t0MuS,
+                                    [](const std::chrono::microseconds t,
+                                       const PacketIndex &rhs)
+                                    {
+                                       return t <= rhs.startTime;
+                                    });
+        if (it0 == itEnd){return std::pair {itEnd, itEnd};}
+        // Attempt to move back one b/c of upper_bound works
+        if (it0 != mIndex.begin() && it0->startTime > t0MuS)
+        {
+            it0 = std::prev(it0, 1);
+            // If the end time of the previous packet is before t0MuS
+            // then restore the iterator as this packet is too old.
+            if (it0->endTime < t0MuS){it0 = std::next(it0);}
+        }
+        // For efficiency's sake when we query with
+        auto it1 = itEnd;
+        if (t1MuS < mIndex.back().startTime)
+        {
+            it1 = std::upper_bound(mIndex.begin(), mIndex.end(), t1MuS,
+                                   [](const std::chrono::microseconds t,
+                                      const PacketIndex &rhs)
+                                   {
+                                      return t < rhs.startTime;
+                                   });
+        }
+        // Just one packet
+        if (it0 == it1){it1 = std::next(it0);}
+        if (std::distance(it0, it1) < 1){return std::pair {itEnd, itEnd};}
+        return std::pair {it0, it1};
+    }
+    /// Materializes a packet from the index entry.
+    [[nodiscard]] T toPacket(const PacketIndex &entry) const
+    {
+        T packet;
+        packet.setNetwork(mNetwork);
+        packet.setStation(mStation);
+        packet.setChannel(mChannel);
+        packet.setLocationCode(mLocationCode);
+        packet.setSamplingRate(entry.samplingRate);
+        packet.setStartTime(entry.startTime);
+        if (entry.encoded != nullptr)
+        {
+            std::vector<double> samples(entry.nSamples);
+            ::decodeSamples(entry.encoded->data(), entry.encoded->size(),
+                            entry.nSamples, samples.data());
+            packet.setData(std::move(samples));
+        }
+        else
+        {
+            packet.setData(entry.nSamples, entry.data.get());
+        }
+        return packet;
+    }
+    /// The entry's samples.  Compressed samples are decoded into a new
+    /// buffer owned by the returned pointer.
+    [[nodiscard]] std::shared_ptr<const double>
+        getSamples(const PacketIndex &entry) const
+    {
+        if (entry.encoded == nullptr){return entry.data;}
+        std::shared_ptr<double[]> samples(
+            new double[std::max(1, entry.nSamples)]);
+        ::decodeSamples(entry.encoded->data(), entry.encoded->size(),
+                        entry.nSamples, samples.get());
+        return std::shared_ptr<const double> (samples, samples.get());
+    }
+    /// Stores the entry's samples in the ring unless they were compressed.
+    void store(PacketIndex *entry, const double *data)
+    {
+        if (entry->encoded == nullptr)
+        {
+            entry->data = write(data, entry->nSamples);
+        }
+    }
+    /// Makes a new chunk the write target.  Preferably, this reuses the
+    /// oldest chunk that nothing refers to anymore.
+    void nextChunk(const size_t nSamples)
+    {
+        // Size the chunks from the first packet
+        if (mChunkSize == 0)
+        {
+            mChunkSize = nSamples*std::min(PACKETS_PER_CHUNK,
+                                  static_cast<size_t> (std::max(1, mMaxPackets)));
+        }
+        if (mChunk.samples != nullptr){mChunks.push_back(std::move(mChunk));}
+        mChunk = Chunk {};
+        mChunkOffset = 0;
+        for (auto it = mChunks.begin(); it != mChunks.end();)
+        {
+            // Only this class can hand out new references and it holds the
+            // exclusive lock so a count of one means the chunk is free.  The
+            // fence pairs with the release from the last reference drop.
+            if (it->samples.use_count() == 1)
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (it->size >= nSamples)
+                {
+                    mChunk = std::move(*it);
+                    mChunks.erase(it);
+                    return;
+                }
+                // Too small to ever be useful again
+                it = mChunks.erase(it);
+                continue;
+            }
+            ++it;
+        }
+        auto chunkSize = std::max(mChunkSize, nSamples);
+        mChunk.samples = std::shared_ptr<double[]> (new double[chunkSize]);
+        mChunk.size = chunkSize;
+    }
+    /// Writes the samples to the head of the ring.
+    /// @result A shared view of the written samples.
+    [[nodiscard]] std::shared_ptr<const double>
+        write(const double *data, const int nSamplesIn)
+    {
+        auto nSamples = static_cast<size_t> (nSamplesIn);
+        if (mChunk.samples == nullptr || mChunkOffset + nSamples > mChunk.size)
+        {
+            nextChunk(nSamples);
+        }
+        auto *destination = mChunk.samples.get() + mChunkOffset;
+        std::copy(data, data + nSamples, destination);
+        mChunkOffset = mChunkOffset + nSamples;
+        return std::shared_ptr<const double> (mChunk.samples, destination);
+    }
+
+    static constexpr size_t PACKETS_PER_CHUNK{16};
+    mutable std::shared_mutex mMutex;
+    /// Time-sorted packet boundaries
+    boost::circular_buffer<PacketIndex> mIndex;
+    /// Retired chunks.  A vector, unlike a deque, does not allocate as
+    /// chunks cycle through it.
+    std::vector<Chunk> mChunks;
+    /// The chunk currently being written
+    Chunk mChunk;
+    size_t mChunkOffset{0};
+    size_t mChunkSize{0};
+    /// The sequence number of the most recently stored packet
+    uint64_t mSequence{0};
     std::string mName;
     std::string mNetwork;
     std::string mStation;
     std::string mChannel;
-    std::string mLocationCode; 
+    std::string mLocationCode;
     int mMaxPackets{0};
+    /// True indicates the samples are compressed
+    bool mCompress{false};
     bool mInitialized{false};
 };
 
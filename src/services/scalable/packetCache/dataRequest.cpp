@@ -31,6 +31,15 @@ nlohmann::json toJSONObject(const DataRequest &request)
     obj["StartTime"] = startTime;
     obj["EndTime"] = endTime;
     obj["Identifier"] = request.getIdentifier();
+    if (request.haveSensorIdentifier())
+    {
+        obj["SensorIdentifier"] = request.getSensorIdentifier();
+    }
+    if (request.haveCursor()){obj["Cursor"] = request.getCursor();}
+    if (request.haveCursorEndTime())
+    {
+        obj["CursorEndTime"] = request.getCursorEndTime().count();
+    }
     return obj;
 }
 
@@ -51,6 +60,23 @@ DataRequest objectToDataRequest(const nlohmann::json &obj)
     auto endTime = obj["EndTime"].get<double> ();
     request.setQueryTimes(std::pair(startTime, endTime));
     request.setIdentifier(obj["Identifier"]);
+    if (obj.contains("SensorIdentifier"))
+    {
+        request.setSensorIdentifier(obj["SensorIdentifier"].get<uint64_t> ());
+    }
+    if (obj.contains("Cursor"))
+    {
+        if (obj.contains("CursorEndTime"))
+        {
+            request.setCursor(obj["Cursor"].get<uint64_t> (),
+                              std::chrono::microseconds
+                              {obj["CursorEndTime"].get<int64_t> ()});
+        }
+        else
+        {
+            request.setCursor(obj["Cursor"].get<uint64_t> ());
+        }
+    }
     return request;
 }
 
@@ -76,10 +102,16 @@ public:
     std::string mChannel;
     std::string mLocationCode;
     uint64_t mIdentifier = 0;
+    uint64_t mSensorIdentifier = 0;
+    uint64_t mCursor = 0;
+    std::chrono::microseconds mCursorEndTime{0};
     const double mMaxTime
         = static_cast<double> (std::numeric_limits<uint32_t>::max());
     double mStartTime = -mMaxTime; //std::numeric_limits<double>::lowest();
     double mEndTime = mMaxTime; //16725225600; // Year 2500 is 16725225600
+    bool mHaveSensorIdentifier = false;
+    bool mHaveCursor = false;
+    bool mHaveCursorEndTime = false;
 };
 
 /// C'tor
@@ -253,6 +285,68 @@ uint64_t DataRequest::getIdentifier() const noexcept
     return pImpl->mIdentifier;
 }
 
+/// Sensor identifier
+void DataRequest::setSensorIdentifier(const uint64_t identifier) noexcept
+{
+    pImpl->mSensorIdentifier = identifier;
+    pImpl->mHaveSensorIdentifier = true;
+}
+
+uint64_t DataRequest::getSensorIdentifier() const
+{
+    if (!haveSensorIdentifier())
+    {
+        throw std::runtime_error("Sensor identifier not set");
+    }
+    return pImpl->mSensorIdentifier;
+}
+
+bool DataRequest::haveSensorIdentifier() const noexcept
+{
+    return pImpl->mHaveSensorIdentifier;
+}
+
+/// Cursor
+void DataRequest::setCursor(const uint64_t cursor) noexcept
+{
+    pImpl->mCursor = cursor;
+    pImpl->mHaveCursor = true;
+    pImpl->mHaveCursorEndTime = false;
+}
+
+void DataRequest::setCursor(const uint64_t cursor,
+                            const std::chrono::microseconds &endTime) noexcept
+{
+    setCursor(cursor);
+    pImpl->mCursorEndTime = endTime;
+    pImpl->mHaveCursorEndTime = true;
+}
+
+uint64_t DataRequest::getCursor() const
+{
+    if (!haveCursor()){throw std::runtime_error("Cursor not set");}
+    return pImpl->mCursor;
+}
+
+bool DataRequest::haveCursor() const noexcept
+{
+    return pImpl->mHaveCursor;
+}
+
+std::chrono::microseconds DataRequest::getCursorEndTime() const
+{
+    if (!haveCursorEndTime())
+    {
+        throw std::runtime_error("Cursor end time not set");
+    }
+    return pImpl->mCursorEndTime;
+}
+
+bool DataRequest::haveCursorEndTime() const noexcept
+{
+    return pImpl->mHaveCursorEndTime;
+}
+
 /// Create JSON
 std::string DataRequest::toJSON(const int nIndent) const
 {
@@ -3,12 +3,18 @@
 #include <limits>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <optional>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include "urts/services/scalable/packetCache/dataResponse.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "dataResponseWriter.hpp"
+#include "dataResponseReader.hpp"
 
 #define MESSAGE_TYPE "URTS::Services::Scalable::PacketCache::DataResponse"
-#define MESSAGE_VERSION "1.0.0"
+#define MESSAGE_VERSION "2.2.0"
 
 using namespace URTS::Services::Scalable::PacketCache;
 namespace UDP = URTS::Broadcasts::Internal::DataPacket;
@@ -22,23 +28,22 @@ nlohmann::json toJSONObject(
     nlohmann::json obj;
     obj["MessageType"] = response.getMessageType();
     obj["MessageVersion"] = response.getMessageVersion();
-    const auto &packetsReference = response.getPacketsReference();
+    const auto &packetsReference = response.getPacketViewsReference();
 #ifndef NDEBUG
     assert(static_cast<int> (packetsReference.size()) ==
            response.getNumberOfPackets());
 #endif
     auto nPackets = response.getNumberOfPackets();
     obj["NumberOfPackets"] = nPackets;
-    auto packetsPointer = response.getPacketsPointer();
     if (nPackets > 0)
     {
-        obj["Network"] = packetsPointer[0].getNetwork();
-        obj["Station"] = packetsPointer[0].getStation();
-        obj["Channel"] = packetsPointer[0].getChannel();
-        obj["LocationCode"] = packetsPointer[0].getLocationCode();
+        obj["Network"] = response.getNetwork();
+        obj["Station"] = response.getStation();
+        obj["Channel"] = response.getChannel();
+        obj["LocationCode"] = response.getLocationCode();
         // Now the packets (these were sorted on time)
         nlohmann::json packetObjects;
-	for (const auto &packet : packetsReference)
+        for (const auto &packet : packetsReference)
         {
             nlohmann::json packetObject;
             packetObject["StartTime"] = packet.getStartTime().count();
@@ -46,7 +51,9 @@ nlohmann::json toJSONObject(
             auto nSamples = packet.getNumberOfSamples();
             if (nSamples > 0)
             {
-                packetObject["Data"] = packet.getData();
+                const auto *data = packet.getDataPointer();
+                packetObject["Data"]
+                    = std::vector<double> (data, data + nSamples);
             }
             else
             {
@@ -61,6 +68,15 @@ nlohmann::json toJSONObject(
         obj["Packets"] = nullptr;
     }
     obj["Identifier"] = response.getIdentifier();
+    if (response.haveSensorIdentifier())
+    {
+        obj["SensorIdentifier"] = response.getSensorIdentifier();
+    }
+    if (response.haveCursor()){obj["Cursor"] = response.getCursor();}
+    if (response.haveCursorEndTime())
+    {
+        obj["CursorEndTime"] = response.getCursorEndTime().count();
+    }
     obj["ReturnCode"] = static_cast<int> (response.getReturnCode());
     return obj;
 }
@@ -103,6 +119,23 @@ DataResponse objectToDataResponse(const nlohmann::json &obj)
         response.setPackets(std::move(packets));
     }
     response.setIdentifier(obj["Identifier"].get<uint64_t> ());
+    if (obj.contains("SensorIdentifier"))
+    {
+        response.setSensorIdentifier(obj["SensorIdentifier"].get<uint64_t> ());
+    }
+    if (obj.contains("Cursor"))
+    {
+        if (obj.contains("CursorEndTime"))
+        {
+            response.setCursor(obj["Cursor"].get<uint64_t> (),
+                               std::chrono::microseconds
+                               {obj["CursorEndTime"].get<int64_t> ()});
+        }
+        else
+        {
+            response.setCursor(obj["Cursor"].get<uint64_t> ());
+        }
+    }
     response.setReturnCode(static_cast<DataResponse::ReturnCode>
                            (obj["ReturnCode"].get<int> ()));
     return response;
@@ -114,10 +147,17 @@ DataResponse fromJSONMessage(const std::string &message)
     return objectToDataResponse(obj);
 }
 
-DataResponse fromCBORMessage(const uint8_t *message, const size_t length)
+DataResponse fromCBORMessage(const std::shared_ptr<const std::string> &message)
 {
-    auto obj = nlohmann::json::from_cbor(message, message + length);
-    return objectToDataResponse(obj);
+    CBORReader reader(reinterpret_cast<const uint8_t *> (message->data()),
+                      message->size());
+    std::optional<std::string_view> messageType;
+    auto response = ::readDataResponse(&reader, message, &messageType);
+    if (messageType != response.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    return response;
 }
 
 void checkPackets(const std::vector<UDP::DataPacket> &packets)
@@ -167,17 +207,75 @@ void checkPackets(const std::vector<UDP::DataPacket> &packets)
 class DataResponse::DataResponseImpl
 {
 public:
-    void sortPackets()
+    /// Takes ownership of the packets and points the views at their samples.
+    void setPackets(std::vector<UDP::DataPacket> &&packets)
     {
-        if (!std::is_sorted(mPackets.begin(),
-                            mPackets.end(),
+        sortPackets(&packets);
+        auto dataPackets
+            = std::make_shared<const std::vector<UDP::DataPacket>>
+              (std::move(packets));
+        mPackets.clear();
+        mPackets.reserve(dataPackets->size());
+        for (const auto &packet : *dataPackets)
+        {
+            std::shared_ptr<const double>
+                data(dataPackets, packet.getDataPointer());
+            mPackets.emplace_back(packet.getStartTime(),
+                                  packet.getSamplingRate(),
+                                  packet.getNumberOfSamples(),
+                                  std::move(data));
+        }
+        if (!dataPackets->empty())
+        {
+            mNetwork = dataPackets->at(0).getNetwork();
+            mStation = dataPackets->at(0).getStation();
+            mChannel = dataPackets->at(0).getChannel();
+            mLocationCode = dataPackets->at(0).getLocationCode();
+        }
+        else
+        {
+            mNetwork.clear();
+            mStation.clear();
+            mChannel.clear();
+            mLocationCode.clear();
+        }
+        mDataPackets = std::move(dataPackets);
+    }
+    /// Makes data packets from the views.  This is only done on demand.
+    const std::vector<UDP::DataPacket> &getDataPackets() const
+    {
+        if (mDataPackets == nullptr)
+        {
+            auto dataPackets = std::make_shared<std::vector<UDP::DataPacket>> ();
+            dataPackets->reserve(mPackets.size());
+            for (const auto &view : mPackets)
+            {
+                UDP::DataPacket packet;
+                packet.setNetwork(mNetwork);
+                packet.setStation(mStation);
+                packet.setChannel(mChannel);
+                packet.setLocationCode(mLocationCode);
+                packet.setSamplingRate(view.getSamplingRate());
+                packet.setStartTime(view.getStartTime());
+                packet.setData(view.getNumberOfSamples(),
+                               view.getDataPointer());
+                dataPackets->push_back(std::move(packet));
+            }
+            mDataPackets = std::move(dataPackets);
+        }
+        return *mDataPackets;
+    }
+    static void sortPackets(std::vector<UDP::DataPacket> *packets)
+    {
+        if (!std::is_sorted(packets->begin(),
+                            packets->end(),
                             [](const UDP::DataPacket &a,
                                const UDP::DataPacket &b)
                             {
                                 return a.getStartTime() < b.getStartTime();
                             }))
         {
-            std::sort(mPackets.begin(), mPackets.end(),
+            std::sort(packets->begin(), packets->end(),
                       [](const UDP::DataPacket &a,
                          const UDP::DataPacket &b)
                        {
@@ -185,9 +283,42 @@ public:
                        });
         }
     }
-    std::vector<UDP::DataPacket> mPackets;
+    void sortPacketViews()
+    {
+        if (!std::is_sorted(mPackets.begin(),
+                            mPackets.end(),
+                            [](const PacketView &a, const PacketView &b)
+                            {
+                                return a.getStartTime() < b.getStartTime();
+                            }))
+        {
+            std::stable_sort(mPackets.begin(), mPackets.end(),
+                             [](const PacketView &a, const PacketView &b)
+                             {
+                                 return a.getStartTime() < b.getStartTime();
+                             });
+        }
+    }
+    /// The packets are stored as views of shared, immutable samples.
+    std::vector<PacketView> mPackets;
+    /// Data packets are materialized lazily (or shared with the caller's
+    /// packets when they were provided as data packets).
+    mutable std::shared_ptr<const std::vector<UDP::DataPacket>>
+        mDataPackets{nullptr};
+    std::string mNetwork;
+    std::string mStation;
+    std::string mChannel;
+    std::string mLocationCode;
     uint64_t mIdentifier{0};
+    uint64_t mSensorIdentifier{0};
+    uint64_t mCursor{0};
+    std::chrono::microseconds mCursorEndTime{0};
     ReturnCode mReturnCode{ReturnCode::Success};
+    bool mHaveSensorIdentifier{false};
+    bool mHaveCursor{false};
+    bool mHaveCursorEndTime{false};
+    bool mCompressSamples{false};
+    bool mCompactLayout{false};
 };
 
 /// C'tor
@@ -238,15 +369,114 @@ void DataResponse::setPackets(
     const std::vector<UDP::DataPacket> &packets)
 {
     checkPackets(packets);
-    pImpl->mPackets = packets;
-    pImpl->sortPackets();
+    auto packetsCopy = packets;
+    pImpl->setPackets(std::move(packetsCopy));
 }
 
 void DataResponse::setPackets(std::vector<UDP::DataPacket> &&packets)
 {
     checkPackets(packets);
+    pImpl->setPackets(std::move(packets));
+}
+
+/// Packet views
+void DataResponse::setPacketViews(const std::string &network,
+                                  const std::string &station,
+                                  const std::string &channel,
+                                  const std::string &locationCode,
+                                  std::vector<PacketView> &&packets)
+{
+    if (!packets.empty())
+    {
+        if (network.empty()){throw std::invalid_argument("Network is empty");}
+        if (station.empty()){throw std::invalid_argument("Station is empty");}
+        if (channel.empty()){throw std::invalid_argument("Channel is empty");}
+        if (locationCode.empty())
+        {
+            throw std::invalid_argument("Location code is empty");
+        }
+    }
     pImpl->mPackets = std::move(packets);
-    pImpl->sortPackets();
+    pImpl->sortPacketViews();
+    pImpl->mDataPackets = nullptr;
+    pImpl->mNetwork = network;
+    pImpl->mStation = station;
+    pImpl->mChannel = channel;
+    pImpl->mLocationCode = locationCode;
+}
+
+/// Merge a newer response
+void DataResponse::merge(const DataResponse &response,
+                         const std::chrono::microseconds &startTime)
+{
+    const auto &newPackets = response.pImpl->mPackets;
+    const auto &oldPackets = pImpl->mPackets;
+    if (!newPackets.empty() && !oldPackets.empty())
+    {
+        if (response.pImpl->mNetwork != pImpl->mNetwork ||
+            response.pImpl->mStation != pImpl->mStation ||
+            response.pImpl->mChannel != pImpl->mChannel ||
+            response.pImpl->mLocationCode != pImpl->mLocationCode)
+        {
+            throw std::invalid_argument("Responses are for different sensors");
+        }
+    }
+    const auto &names = newPackets.empty() ? *pImpl : *response.pImpl;
+    auto network = names.mNetwork;
+    auto station = names.mStation;
+    auto channel = names.mChannel;
+    auto locationCode = names.mLocationCode;
+    // Retain the unexpired packets that were not replaced.  The views are
+    // sorted on start time so the replacement check is a binary search.
+    std::vector<PacketView> packets;
+    packets.reserve(oldPackets.size() + newPackets.size());
+    for (const auto &packet : oldPackets)
+    {
+        if (packet.getEndTime() < startTime){continue;}
+        if (std::binary_search(newPackets.begin(), newPackets.end(), packet,
+                               [](const PacketView &a, const PacketView &b)
+                               {
+                                   return a.getStartTime() < b.getStartTime();
+                               }))
+        {
+            continue;
+        }
+        packets.push_back(packet);
+    }
+    for (const auto &packet : newPackets)
+    {
+        if (packet.getEndTime() < startTime){continue;}
+        packets.push_back(packet);
+    }
+    if (packets.empty())
+    {
+        network.clear();
+        station.clear();
+        channel.clear();
+        locationCode.clear();
+    }
+    setPacketViews(network, station, channel, locationCode,
+                   std::move(packets));
+    setIdentifier(response.getIdentifier());
+    setReturnCode(response.getReturnCode());
+    if (response.haveSensorIdentifier())
+    {
+        setSensorIdentifier(response.getSensorIdentifier());
+    }
+    if (response.haveCursorEndTime())
+    {
+        setCursor(response.getCursor(), response.getCursorEndTime());
+    }
+    else if (response.haveCursor())
+    {
+        setCursor(response.getCursor());
+    }
+}
+
+const std::vector<PacketView>
+&DataResponse::getPacketViewsReference() const noexcept
+{
+    return pImpl->mPackets;
 }
 
 int DataResponse::getNumberOfPackets() const noexcept
@@ -254,20 +484,45 @@ int DataResponse::getNumberOfPackets() const noexcept
     return static_cast<int> (pImpl->mPackets.size());
 }
 
-std::vector<UDP::DataPacket> DataResponse::getPackets() const noexcept
+std::vector<UDP::DataPacket> DataResponse::getPackets() const
 {
-    return pImpl->mPackets;
+    return pImpl->getDataPackets();
 }
 
-const UDP::DataPacket *DataResponse::getPacketsPointer() const noexcept
+const UDP::DataPacket *DataResponse::getPacketsPointer() const
 {
-    return pImpl->mPackets.data();
+    return pImpl->getDataPackets().data();
 }
 
 const std::vector<UDP::DataPacket>
-&DataResponse::getPacketsReference() const noexcept
+&DataResponse::getPacketsReference() const
 {
-    return pImpl->mPackets;
+    return pImpl->getDataPackets();
+}
+
+/// Sensor
+std::string DataResponse::getNetwork() const
+{
+    if (getNumberOfPackets() < 1){throw std::runtime_error("No packets");}
+    return pImpl->mNetwork;
+}
+
+std::string DataResponse::getStation() const
+{
+    if (getNumberOfPackets() < 1){throw std::runtime_error("No packets");}
+    return pImpl->mStation;
+}
+
+std::string DataResponse::getChannel() const
+{
+    if (getNumberOfPackets() < 1){throw std::runtime_error("No packets");}
+    return pImpl->mChannel;
+}
+
+std::string DataResponse::getLocationCode() const
+{
+    if (getNumberOfPackets() < 1){throw std::runtime_error("No packets");}
+    return pImpl->mLocationCode;
 }
 
 /// Identifier
@@ -281,12 +536,96 @@ uint64_t DataResponse::getIdentifier() const noexcept
     return pImpl->mIdentifier;
 }
 
+/// Sensor identifier
+void DataResponse::setSensorIdentifier(const uint64_t identifier) noexcept
+{
+    pImpl->mSensorIdentifier = identifier;
+    pImpl->mHaveSensorIdentifier = true;
+}
+
+uint64_t DataResponse::getSensorIdentifier() const
+{
+    if (!haveSensorIdentifier())
+    {
+        throw std::runtime_error("Sensor identifier not set");
+    }
+    return pImpl->mSensorIdentifier;
+}
+
+bool DataResponse::haveSensorIdentifier() const noexcept
+{
+    return pImpl->mHaveSensorIdentifier;
+}
+
+/// Cursor
+void DataResponse::setCursor(const uint64_t cursor) noexcept
+{
+    pImpl->mCursor = cursor;
+    pImpl->mHaveCursor = true;
+    pImpl->mHaveCursorEndTime = false;
+}
+
+void DataResponse::setCursor(const uint64_t cursor,
+                             const std::chrono::microseconds &endTime) noexcept
+{
+    setCursor(cursor);
+    pImpl->mCursorEndTime = endTime;
+    pImpl->mHaveCursorEndTime = true;
+}
+
+uint64_t DataResponse::getCursor() const
+{
+    if (!haveCursor()){throw std::runtime_error("Cursor not set");}
+    return pImpl->mCursor;
+}
+
+bool DataResponse::haveCursor() const noexcept
+{
+    return pImpl->mHaveCursor;
+}
+
+std::chrono::microseconds DataResponse::getCursorEndTime() const
+{
+    if (!haveCursorEndTime())
+    {
+        throw std::runtime_error("Cursor end time not set");
+    }
+    return pImpl->mCursorEndTime;
+}
+
+bool DataResponse::haveCursorEndTime() const noexcept
+{
+    return pImpl->mHaveCursorEndTime;
+}
+
 /// Return code
 void DataResponse::setReturnCode(const ReturnCode code) noexcept
 {
     pImpl->mReturnCode = code;
 }
 
+/// Sample compression
+void DataResponse::setSampleCompression(const bool compress) noexcept
+{
+    pImpl->mCompressSamples = compress;
+}
+
+bool DataResponse::useSampleCompression() const noexcept
+{
+    return pImpl->mCompressSamples;
+}
+
+/// Compact layout
+void DataResponse::setCompactLayout(const bool compact) noexcept
+{
+    pImpl->mCompactLayout = compact;
+}
+
+bool DataResponse::useCompactLayout() const noexcept
+{
+    return pImpl->mCompactLayout;
+}
+
 DataResponse::ReturnCode DataResponse::getReturnCode() const noexcept
 {
     return pImpl->mReturnCode;
@@ -311,12 +650,23 @@ std::string DataResponse::toJSON(const int nIndent) const
     return obj.dump(nIndent);
 }
 
-/// Create CBOR
+/// Create CBOR.  This is written directly from the packet views.
 std::string DataResponse::toCBOR() const
 {
-    auto obj = toJSONObject(*this);
-    auto v = nlohmann::json::to_cbor(obj);
-    std::string result(v.begin(), v.end());
+    std::string result;
+    size_t nSamples = 0;
+    for (const auto &packet : pImpl->mPackets)
+    {
+        nSamples = nSamples + packet.getNumberOfSamples();
+    }
+    result.reserve(256 + 32*pImpl->mPackets.size() + 9*nSamples);
+    CBORWriter writer(&result);
+    ::writeDataResponse(*this, 2, pImpl->mCompressSamples,
+                        pImpl->mCompactLayout, &writer);
+    writer.write("MessageType");
+    writer.write(getMessageType());
+    writer.write("MessageVersion");
+    writer.write(getMessageVersion());
     return result;
 }
 
@@ -339,7 +689,9 @@ void DataResponse::fromCBOR(const uint8_t *data, const size_t length)
     {
         throw std::invalid_argument("data is NULL");
     }
-    *this = fromCBORMessage(data, length);
+    // A single copy of the message lets the packet views point into it
+    *this = fromCBORMessage(std::make_shared<const std::string>
+                            (reinterpret_cast<const char *> (data), length));
 }
 
 ///  Convert message
@@ -360,6 +712,13 @@ void DataResponse::fromMessage(const char *messageIn, const size_t length)
     fromCBOR(message, length);
 }
 
+void DataResponse::fromMessage(std::string &&message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    *this = fromCBORMessage(std::make_shared<const std::string>
+                            (std::move(message)));
+}
+
 
 /// Copy this class
 std::unique_ptr<UMPS::MessageFormats::IMessage> DataResponse::clone() const
@@ -0,0 +1,333 @@
+#ifndef PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_READER_HPP
+#define PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_READER_HPP
+#ifdef URTS_SRC
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <span>
+#include <algorithm>
+#include "urts/services/scalable/packetCache/dataResponse.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "private/cborReader.hpp"
+#include "private/sampleCodec.hpp"
+namespace
+{
+/// @brief Reads a data response's map as written by writeDataResponse.
+///        This understands both the per-packet and the compact layouts.
+///        Where possible, the response's packet views point directly into
+///        the message.  Otherwise, the samples of all packets are decoded
+///        into one shared buffer which the packet views then point into.
+/// @param[in,out] reader    The CBOR reader positioned at the map.
+/// @param[in] message       The message being read.  Packet views that
+///                          point into the message share ownership of it.
+///                          If NULL, then the samples are always copied.
+/// @param[out] messageType  If not NULL then this is the message type, if
+///                          it was in the map.
+/// @result The data response.
+/// @throws std::runtime_error if the message is malformed or missing a
+///         required field.
+/// @throws std::invalid_argument if the packets are invalid.
+[[maybe_unused]]
+URTS::Services::Scalable::PacketCache::DataResponse
+    readDataResponse(CBORReader *reader,
+                     const std::shared_ptr<const std::string> &message,
+                     std::optional<std::string_view> *messageType = nullptr)
+{
+    namespace UPC = URTS::Services::Scalable::PacketCache;
+    struct PacketHeader
+    {
+        std::optional<int64_t> startTime;
+        std::optional<double> samplingRate;
+        /// The samples in the message.  If NULL, the samples are in the
+        /// shared buffer.
+        const double *view{nullptr};
+        size_t offset{0};
+        size_t nSamples{0};
+    };
+    std::string network;
+    std::string station;
+    std::string channel;
+    std::string locationCode;
+    std::vector<PacketHeader> headers;
+    auto samples = std::make_shared<std::vector<double>> ();
+    std::optional<uint64_t> identifier;
+    std::optional<uint64_t> sensorIdentifier;
+    std::optional<uint64_t> cursor;
+    std::optional<int64_t> cursorEndTime;
+    std::optional<int> returnCode;
+    // The compact layout
+    std::optional<double> compactSamplingRate;
+    std::vector<int64_t> startTimes;
+    std::vector<int64_t> sampleCounts;
+    std::optional<std::span<const double>> compactView;
+    std::string_view encodedSamples;
+    bool compact{false};
+    int nPackets{0};
+    bool compressed{false};
+    reader->readMap([&](const std::string_view &key)
+    {
+        if (key == "MessageType" && messageType != nullptr)
+        {
+            *messageType = reader->readStringView();
+        }
+        else if (key == "NumberOfPackets")
+        {
+            nPackets = static_cast<int> (reader->readInteger());
+        }
+        else if (key == "Network")
+        {
+            network = reader->readString();
+        }
+        else if (key == "Station")
+        {
+            station = reader->readString();
+        }
+        else if (key == "Channel")
+        {
+            channel = reader->readString();
+        }
+        else if (key == "LocationCode")
+        {
+            locationCode = reader->readString();
+        }
+        else if (key == "Packets")
+        {
+            if (reader->readNull()){return true;}
+            auto nPacketObjects = reader->readArraySize();
+            headers.reserve(nPacketObjects);
+            for (uint64_t i = 0; i < nPacketObjects; ++i)
+            {
+                PacketHeader header;
+                header.offset = samples->size();
+                reader->readMap([&](const std::string_view &packetKey)
+                {
+                    if (packetKey == "StartTime")
+                    {
+                        header.startTime = reader->readInteger();
+                    }
+                    else if (packetKey == "SamplingRate")
+                    {
+                        header.samplingRate = reader->readDouble();
+                    }
+                    else if (packetKey == "Data")
+                    {
+                        auto view = reader->readSamples(samples.get());
+                        if (view && message != nullptr)
+                        {
+                            header.view = view->data();
+                            header.nSamples = view->size();
+                        }
+                        else if (view)
+                        {
+                            samples->insert(samples->end(),
+                                            view->begin(), view->end());
+                            header.nSamples = view->size();
+                        }
+                        else
+                        {
+                            header.nSamples = samples->size() - header.offset;
+                        }
+                    }
+                    else if (packetKey == "EncodedData")
+                    {
+                        auto encoded = reader->readBytesView();
+                        ::decodeIntegerDeltas(
+                            reinterpret_cast<const uint8_t *> (encoded.data()),
+                            encoded.size(), samples.get());
+                        header.nSamples = samples->size() - header.offset;
+                        compressed = true;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    return true;
+                });
+                headers.push_back(std::move(header));
+            }
+        }
+        else if (key == "SamplingRate")
+        {
+            compactSamplingRate = reader->readDouble();
+            compact = true;
+        }
+        else if (key == "StartTimes" || key == "SampleCounts")
+        {
+            auto &values = (key == "StartTimes" ? startTimes : sampleCounts);
+            auto n = reader->readArraySize();
+            // Guard against corrupt sizes; every item is at least a byte
+            values.reserve(std::min<uint64_t> (n, 1048576));
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                values.push_back(reader->readInteger());
+            }
+            compact = true;
+        }
+        else if (key == "Samples")
+        {
+            auto view = reader->readSamples(samples.get());
+            if (view && message != nullptr)
+            {
+                compactView = view;
+            }
+            else if (view)
+            {
+                samples->insert(samples->end(), view->begin(), view->end());
+            }
+            compact = true;
+        }
+        else if (key == "EncodedSamples")
+        {
+            encodedSamples = reader->readBytesView();
+            compressed = true;
+            compact = true;
+        }
+        else if (key == "Identifier")
+        {
+            identifier = reader->readUnsigned();
+        }
+        else if (key == "SensorIdentifier")
+        {
+            sensorIdentifier = reader->readUnsigned();
+        }
+        else if (key == "Cursor")
+        {
+            cursor = reader->readUnsigned();
+        }
+        else if (key == "CursorEndTime")
+        {
+            cursorEndTime = reader->readInteger();
+        }
+        else if (key == "ReturnCode")
+        {
+            returnCode = static_cast<int> (reader->readInteger());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    });
+    if (compact)
+    {
+        if (!headers.empty())
+        {
+            throw std::runtime_error("Packets and compact packets both set");
+        }
+        if (startTimes.size() != static_cast<size_t> (nPackets) ||
+            sampleCounts.size() != static_cast<size_t> (nPackets))
+        {
+            throw std::runtime_error(
+                "Compact packet arrays inconsistent with NumberOfPackets");
+        }
+        size_t nSamples = 0;
+        for (const auto &count : sampleCounts)
+        {
+            if (count < 0)
+            {
+                throw std::runtime_error("Negative compact sample count");
+            }
+            nSamples = nSamples + static_cast<size_t> (count);
+        }
+        if (!encodedSamples.empty())
+        {
+            if (nSamples > encodedSamples.size())
+            {
+                throw std::runtime_error("Encoded samples truncated");
+            }
+            samples->resize(nSamples);
+            const auto *data
+                = reinterpret_cast<const uint8_t *> (encodedSamples.data());
+            const auto *end = data + encodedSamples.size();
+            size_t offset = 0;
+            for (const auto &count : sampleCounts)
+            {
+                ::decodeIntegerDeltas(&data, end, static_cast<int> (count),
+                                      samples->data() + offset);
+                offset = offset + static_cast<size_t> (count);
+            }
+            if (data != end)
+            {
+                throw std::runtime_error("Encoded samples have invalid size");
+            }
+        }
+        auto nAvailable = compactView ? compactView->size() : samples->size();
+        if (nAvailable != nSamples)
+        {
+            throw std::runtime_error(
+                "Compact sample counts inconsistent with samples");
+        }
+        auto samplingRate
+            = ::requireField(compactSamplingRate, "SamplingRate");
+        headers.resize(startTimes.size());
+        size_t offset = 0;
+        for (size_t i = 0; i < headers.size(); ++i)
+        {
+            headers[i].startTime = startTimes[i];
+            headers[i].samplingRate = samplingRate;
+            headers[i].nSamples = static_cast<size_t> (sampleCounts[i]);
+            if (compactView)
+            {
+                headers[i].view = compactView->data() + offset;
+            }
+            else
+            {
+                headers[i].offset = offset;
+            }
+            offset = offset + headers[i].nSamples;
+        }
+    }
+    UPC::DataResponse response;
+    if (nPackets > 0)
+    {
+        std::shared_ptr<const std::vector<double>> sharedSamples
+            = std::move(samples);
+        std::vector<UPC::PacketView> views;
+        views.reserve(headers.size());
+        for (auto &header : headers)
+        {
+            std::shared_ptr<const double> data{nullptr};
+            if (header.view != nullptr)
+            {
+                data = std::shared_ptr<const double> (message, header.view);
+            }
+            else
+            {
+                data = std::shared_ptr<const double>
+                       (sharedSamples, sharedSamples->data() + header.offset);
+            }
+            views.emplace_back(
+                std::chrono::microseconds
+                {
+                    ::requireField(header.startTime, "StartTime")
+                },
+                ::requireField(header.samplingRate, "SamplingRate"),
+                static_cast<int> (header.nSamples),
+                std::move(data));
+        }
+        response.setPacketViews(network, station, channel, locationCode,
+                                std::move(views));
+    }
+    response.setIdentifier(::requireField(identifier, "Identifier"));
+    if (sensorIdentifier){response.setSensorIdentifier(*sensorIdentifier);}
+    if (cursor && cursorEndTime)
+    {
+        response.setCursor(*cursor,
+                           std::chrono::microseconds {*cursorEndTime});
+    }
+    else if (cursor)
+    {
+        response.setCursor(*cursor);
+    }
+    response.setSampleCompression(compressed);
+    response.setCompactLayout(compact);
+    response.setReturnCode(static_cast<UPC::DataResponse::ReturnCode>
+                           (::requireField(returnCode, "ReturnCode")));
+    return response;
+}
+}
+#endif
+#endif
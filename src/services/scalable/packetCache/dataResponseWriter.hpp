@@ -0,0 +1,203 @@
+#ifndef PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_WRITER_HPP
+#define PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_DATA_RESPONSE_WRITER_HPP
+#ifdef URTS_SRC
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "urts/services/scalable/packetCache/dataResponse.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "private/cborWriter.hpp"
+#include "private/sampleCodec.hpp"
+namespace
+{
+/// @result True indicates the packets can be written in the compact layout.
+///         This requires the packets share a sampling rate.
+[[nodiscard]] bool canWriteCompactLayout(
+    const std::vector<URTS::Services::Scalable::PacketCache::PacketView>
+        &packets) noexcept
+{
+    if (packets.empty()){return false;}
+    auto samplingRate = packets.front().getSamplingRate();
+    return std::all_of(packets.begin(), packets.end(),
+                       [samplingRate](const auto &packet)
+                       {
+                           return packet.getSamplingRate() == samplingRate;
+                       });
+}
+/// @brief Writes the packets in the compact layout.  Rather than a map per
+///        packet, this writes the shared sampling rate, arrays of the
+///        packets' start times and sample counts, and the samples of all
+///        packets in a single block.
+void writeCompactPackets(
+    const std::vector<URTS::Services::Scalable::PacketCache::PacketView>
+        &packets,
+    const bool compressSamples,
+    CBORWriter *writer)
+{
+    writer->write("SamplingRate");
+    writer->write(packets.front().getSamplingRate());
+    writer->write("StartTimes");
+    writer->startArray(packets.size());
+    for (const auto &packet : packets)
+    {
+        writer->write(static_cast<int64_t> (packet.getStartTime().count()));
+    }
+    writer->write("SampleCounts");
+    writer->startArray(packets.size());
+    size_t nSamples = 0;
+    bool integral = compressSamples;
+    for (const auto &packet : packets)
+    {
+        writer->write(packet.getNumberOfSamples());
+        nSamples = nSamples + static_cast<size_t> (packet.getNumberOfSamples());
+        if (integral)
+        {
+            integral = ::isIntegral(packet.getDataPointer(),
+                                    packet.getNumberOfSamples());
+        }
+    }
+    if (integral && nSamples > 0)
+    {
+        // Each packet's differences restart so a reader can decode the
+        // packets independently
+        thread_local std::vector<uint8_t> encoded;
+        encoded.clear();
+        for (const auto &packet : packets)
+        {
+            ::appendIntegerDeltas(packet.getDataPointer(),
+                                  packet.getNumberOfSamples(), &encoded);
+        }
+        if (encoded.size() < sizeof(double)*nSamples)
+        {
+            writer->write("EncodedSamples");
+            writer->writeBytes(encoded.data(), encoded.size());
+            return;
+        }
+    }
+    writer->write("Samples");
+    auto *destination = writer->startSamples(nSamples);
+    for (const auto &packet : packets)
+    {
+        auto n = static_cast<size_t> (packet.getNumberOfSamples());
+        CBORWriter::copySamples(packet.getDataPointer(), n, destination);
+        destination = destination + sizeof(double)*n;
+    }
+}
+/// @brief Writes the data response's packets, identifier, and return code
+///        as CBOR map entries directly from the response's packet views.
+///        The samples are written so that readers can view them in place.
+/// @param[in] response     The data response to write.
+/// @param[in] nExtraPairs  The number of additional key/value pairs the
+///                         caller will write to this map - e.g., the message
+///                         type and version.
+/// @param[in] compressSamples  If true then packets with integer valued
+///                             samples are written as zig-zag mapped,
+///                             variable length first differences in an
+///                             EncodedData byte string.  Packets that would
+///                             not get smaller are written as usual.
+/// @param[in] compactLayout  If true and the packets share a sampling rate
+///                           then the packets are written in the compact
+///                           layout - see writeCompactPackets().
+/// @param[in,out] writer   The CBOR writer.
+[[maybe_unused]]
+void writeDataResponse(
+    const URTS::Services::Scalable::PacketCache::DataResponse &response,
+    const int nExtraPairs,
+    const bool compressSamples,
+    const bool compactLayout,
+    CBORWriter *writer)
+{
+    const auto &packets = response.getPacketViewsReference();
+    auto nPackets = static_cast<int> (packets.size());
+    bool compact = compactLayout && ::canWriteCompactLayout(packets);
+    auto nPairs = (nPackets > 0 ? (compact ? 11 : 8) : 4) + nExtraPairs;
+    if (response.haveSensorIdentifier()){nPairs = nPairs + 1;}
+    if (response.haveCursor()){nPairs = nPairs + 1;}
+    if (response.haveCursorEndTime()){nPairs = nPairs + 1;}
+    writer->startMap(nPairs);
+    writer->write("NumberOfPackets");
+    writer->write(nPackets);
+    if (nPackets > 0)
+    {
+        writer->write("Network");
+        writer->write(response.getNetwork());
+        writer->write("Station");
+        writer->write(response.getStation());
+        writer->write("Channel");
+        writer->write(response.getChannel());
+        writer->write("LocationCode");
+        writer->write(response.getLocationCode());
+    }
+    // Now the packets (these were sorted on time)
+    if (compact)
+    {
+        ::writeCompactPackets(packets, compressSamples, writer);
+    }
+    else if (nPackets > 0)
+    {
+        writer->write("Packets");
+        writer->startArray(packets.size());
+        for (const auto &packet : packets)
+        {
+            writer->startMap(3);
+            writer->write("StartTime");
+            writer->write(static_cast<int64_t> (packet.getStartTime().count()));
+            writer->write("SamplingRate");
+            writer->write(packet.getSamplingRate());
+            auto nSamples = packet.getNumberOfSamples();
+            if (compressSamples && nSamples > 0 &&
+                ::isIntegral(packet.getDataPointer(), nSamples))
+            {
+                // Reusing this thread's scratch space avoids allocating
+                thread_local std::vector<uint8_t> encoded;
+                encoded.clear();
+                ::appendIntegerDeltas(packet.getDataPointer(), nSamples,
+                                      &encoded);
+                if (encoded.size() < sizeof(double)*nSamples)
+                {
+                    writer->write("EncodedData");
+                    writer->writeBytes(encoded.data(), encoded.size());
+                    continue;
+                }
+            }
+            writer->write("Data");
+            if (nSamples > 0)
+            {
+                writer->writeSamples(packet.getDataPointer(),
+                                     static_cast<size_t> (nSamples));
+            }
+            else
+            {
+                writer->writeNull();
+            }
+        }
+    }
+    else
+    {
+        writer->write("Packets");
+        writer->writeNull();
+    }
+    writer->write("Identifier");
+    writer->write(static_cast<uint64_t> (response.getIdentifier()));
+    if (response.haveSensorIdentifier())
+    {
+        writer->write("SensorIdentifier");
+        writer->write(static_cast<uint64_t> (response.getSensorIdentifier()));
+    }
+    if (response.haveCursor())
+    {
+        writer->write("Cursor");
+        writer->write(static_cast<uint64_t> (response.getCursor()));
+    }
+    if (response.haveCursorEndTime())
+    {
+        writer->write("CursorEndTime");
+        writer->write(static_cast<int64_t>
+                      (response.getCursorEndTime().count()));
+    }
+    writer->write("ReturnCode");
+    writer->write(static_cast<int> (response.getReturnCode()));
+}
+}
+#endif
+#endif
@@ -0,0 +1,66 @@
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include "urts/services/scalable/packetCache/packetView.hpp"
+
+using namespace URTS::Services::Scalable::PacketCache;
+
+/// C'tor
+PacketView::PacketView(const std::chrono::microseconds &startTime,
+                       const double samplingRate,
+                       const int nSamples,
+                       std::shared_ptr<const double> data) :
+    mData(std::move(data)),
+    mStartTime(startTime),
+    mEndTime(startTime),
+    mSamplingRate(samplingRate),
+    mSamples(nSamples)
+{
+    if (samplingRate <= 0)
+    {
+        throw std::invalid_argument("Sampling rate must be positive");
+    }
+    if (nSamples < 0){throw std::invalid_argument("nSamples is negative");}
+    if (nSamples > 0 && mData == nullptr)
+    {
+        throw std::invalid_argument("data is NULL");
+    }
+    if (nSamples > 0)
+    {
+        auto traceDuration
+            = std::round( ((nSamples - 1)/samplingRate)*1000000 );
+        std::chrono::microseconds
+            traceDurationMuS{static_cast<int64_t> (traceDuration)};
+        mEndTime = mStartTime + traceDurationMuS;
+    }
+}
+
+/// Start time
+std::chrono::microseconds PacketView::getStartTime() const noexcept
+{
+    return mStartTime;
+}
+
+/// End time
+std::chrono::microseconds PacketView::getEndTime() const noexcept
+{
+    return mEndTime;
+}
+
+/// Sampling rate
+double PacketView::getSamplingRate() const noexcept
+{
+    return mSamplingRate;
+}
+
+/// Number of samples
+int PacketView::getNumberOfSamples() const noexcept
+{
+    return mSamples;
+}
+
+/// Data
+const double *PacketView::getDataPointer() const noexcept
+{
+    return mData.get();
+}
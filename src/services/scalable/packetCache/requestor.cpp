@@ -15,6 +15,8 @@
 #include "urts/services/scalable/packetCache/dataResponse.hpp"
 #include "urts/services/scalable/packetCache/sensorRequest.hpp"
 #include "urts/services/scalable/packetCache/sensorResponse.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
 
 using namespace URTS::Services::Scalable::PacketCache;
 namespace UCI = UMPS::Services::ConnectionInformation;
@@ -31,12 +33,15 @@ namespace
         = std::make_unique<DataResponse> (); 
     std::unique_ptr<UMPS::MessageFormats::IMessage> sensorResponse
         = std::make_unique<SensorResponse> ();  
+    std::unique_ptr<UMPS::MessageFormats::IMessage> waveformResponse
+        = std::make_unique<ThreeComponentWaveformResponse> ();
     std::unique_ptr<UMPS::MessageFormats::IMessage> failureResponse
         = std::make_unique<UMF::Failure> (); 
     UMPS::MessageFormats::Messages messageFormats;
     messageFormats.add(bulkDataResponse);
     messageFormats.add(dataResponse);
     messageFormats.add(sensorResponse);
+    messageFormats.add(waveformResponse);
     messageFormats.add(failureResponse);
     return messageFormats;
 }
@@ -187,3 +192,23 @@ Requestor::request(const SensorRequest &request)
                     (std::move(message));
     return response;
 }
+
+/// Three-component waveform request
+std::unique_ptr<ThreeComponentWaveformResponse>
+Requestor::request(const ThreeComponentWaveformRequest &request)
+{
+    auto message = pImpl->mRequestor->request(request);
+    if (message->getMessageType() == pImpl->mFailureMessage.getMessageType())
+    {
+        auto failureMessage = UMF::static_unique_pointer_cast<UMF::Failure>
+                              (std::move(message));
+        auto errorMessage
+            = "Failure message received for three-component waveform request.  Failed with: "
+            + failureMessage->getDetails();
+        throw std::runtime_error(errorMessage);
+    }
+    auto response
+        = UMF::static_unique_pointer_cast<ThreeComponentWaveformResponse>
+          (std::move(message));
+    return response;
+}
@@ -1,10 +1,16 @@
 #include <mutex>
 #include <thread>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <filesystem>
 #include <umps/authentication/zapOptions.hpp>
 #include <umps/logging/standardOut.hpp>
 #include <umps/messaging/context.hpp>
 #include <umps/messaging/routerDealer/reply.hpp>
 #include <umps/messaging/routerDealer/replyOptions.hpp>
+#include <umps/messaging/xPublisherXSubscriber/publisher.hpp>
+#include <umps/messaging/xPublisherXSubscriber/publisherOptions.hpp>
 #include <umps/messageFormats/failure.hpp>
 #include "urts/services/scalable/packetCache/service.hpp"
 #include "urts/services/scalable/packetCache/serviceOptions.hpp"
@@ -15,13 +21,21 @@
 #include "urts/services/scalable/packetCache/bulkDataResponse.hpp"
 #include "urts/services/scalable/packetCache/sensorRequest.hpp"
 #include "urts/services/scalable/packetCache/sensorResponse.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
+#include "urts/services/scalable/packetCache/subscriptionPacket.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriber.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
+#include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "private/threadSafeQueue.hpp"
+#include "utilities.hpp"
+#include "threeComponentWaveformMemo.hpp"
 
 using namespace URTS::Services::Scalable::PacketCache;
 namespace URouterDealer = UMPS::Messaging::RouterDealer;
+namespace UXPubXSub = UMPS::Messaging::XPublisherXSubscriber;
 namespace UMF = UMPS::MessageFormats;
 namespace UDP = URTS::Broadcasts::Internal::DataPacket; 
 
@@ -32,21 +46,63 @@ void performDataRequest(const DataRequest &dataRequest,
                         const CappedCollection &mCappedCollection,
                         DataResponse *response)
 {
-    // Does this SNCL exist in the cache?
-    auto name = dataRequest.getNetwork() + "."
-              + dataRequest.getStation() + "."
-              + dataRequest.getChannel() + "."
-              + dataRequest.getLocationCode();
-    auto haveSensor = mCappedCollection.haveSensor(name);
+    // Requests that carry this cache's identifier for the sensor skip the
+    // name lookup.  Otherwise, does this SNCL exist in the cache?
+    uint64_t identifier{0};
+    uint64_t cursor{0};
+    // Without an end time only the cursor selects the packets
+    std::chrono::microseconds cursorEndTime
+    {
+        std::numeric_limits<int64_t>::max()
+    };
+    bool haveSensor{false};
+    if (dataRequest.haveSensorIdentifier())
+    {
+        identifier = dataRequest.getSensorIdentifier();
+        haveSensor = mCappedCollection.haveSensor(identifier);
+        // Cursors are only meaningful with a recognized identifier
+        if (haveSensor && dataRequest.haveCursor())
+        {
+            cursor = dataRequest.getCursor();
+            if (dataRequest.haveCursorEndTime())
+            {
+                cursorEndTime = dataRequest.getCursorEndTime();
+            }
+        }
+    }
+    if (!haveSensor)
+    {
+        auto name = dataRequest.getNetwork() + "."
+                  + dataRequest.getStation() + "."
+                  + dataRequest.getChannel() + "."
+                  + dataRequest.getLocationCode();
+        haveSensor = mCappedCollection.haveSensor(name);
+        if (haveSensor)
+        {
+            identifier = mCappedCollection.getSensorIdentifier(name);
+        }
+    }
     if (haveSensor)
     {
         auto [startTime, endTime] = dataRequest.getQueryTimes();
         try
         {
-            auto packets = mCappedCollection.getPackets(name,
-                                                        startTime,
-                                                        endTime);
-            response->setPackets(packets);
+            // Share the cached samples rather than copy them.  Only the
+            // packets the requester has not yet seen are returned.
+            auto [packets, newCursor, newCursorEndTime]
+                = mCappedCollection.getPacketViews(
+                     identifier,
+                     ::secondsToMicroSeconds(startTime),
+                     ::secondsToMicroSeconds(endTime),
+                     cursor,
+                     cursorEndTime);
+            response->setPacketViews(dataRequest.getNetwork(),
+                                     dataRequest.getStation(),
+                                     dataRequest.getChannel(),
+                                     dataRequest.getLocationCode(),
+                                     std::move(packets));
+            response->setSensorIdentifier(identifier);
+            response->setCursor(newCursor, newCursorEndTime);
         }
         catch (const std::exception &e)
         {
@@ -62,6 +118,77 @@ void performDataRequest(const DataRequest &dataRequest,
     }
 }
 
+/// @result The number of samples in the response.
+[[nodiscard]] size_t getNumberOfSamples(const DataResponse &response) noexcept
+{
+    size_t nSamples = 0;
+    for (const auto &packet : response.getPacketViewsReference())
+    {
+        nSamples = nSamples + packet.getNumberOfSamples();
+    }
+    return nSamples;
+}
+
+[[nodiscard]] size_t getNumberOfSamples(const BulkDataResponse &response)
+{
+    size_t nSamples = 0;
+    const auto *responses = response.getDataResponsesPointer();
+    for (int i = 0; i < response.getNumberOfDataResponses(); ++i)
+    {
+        nSamples = nSamples + ::getNumberOfSamples(responses[i]);
+    }
+    return nSamples;
+}
+
+/// @brief A reply that was serialized by the service so that its size
+///        could be measured.  This simply hands the message to UMPS.
+class SerializedReply : public UMF::IMessage
+{
+public:
+    SerializedReply(std::string &&message,
+                    std::string messageType,
+                    std::string messageVersion) :
+        mMessage(std::move(message)),
+        mMessageType(std::move(messageType)),
+        mMessageVersion(std::move(messageVersion))
+    {
+    }
+    [[nodiscard]] std::string toMessage() const final
+    {
+        return mMessage;
+    }
+    void fromMessage(const std::string &message) final
+    {
+        mMessage = message;
+    }
+    void fromMessage(const char *data, const size_t length) final
+    {
+        mMessage.assign(data, length);
+    }
+    [[nodiscard]] std::string getMessageType() const noexcept final
+    {
+        return mMessageType;
+    }
+    [[nodiscard]] std::string getMessageVersion() const noexcept final
+    {
+        return mMessageVersion;
+    }
+    [[nodiscard]] std::unique_ptr<UMF::IMessage> clone() const final
+    {
+        return std::make_unique<SerializedReply> (*this);
+    }
+    [[nodiscard]] std::unique_ptr<UMF::IMessage>
+        createInstance() const noexcept final
+    {
+        return std::make_unique<SerializedReply> ("", mMessageType,
+                                                  mMessageVersion);
+    }
+private:
+    std::string mMessage;
+    std::string mMessageType;
+    std::string mMessageVersion;
+};
+
 }
 
 class Service::ServiceImpl
@@ -82,21 +209,92 @@ public:
         }
         mDataPacketSubscriber
             = std::make_unique<UDP::Subscriber> (dataPacketContext, mLogger);
-        mPacketCacheReplier
-            = std::make_unique<URouterDealer::Reply> (responseContext, mLogger);
+        // The repliers share a context
+        mResponseContext = responseContext;
+        if (mResponseContext == nullptr)
+        {
+            mResponseContext = std::make_shared<UMPS::Messaging::Context> (1);
+        }
         mCappedCollection = std::make_unique<CappedCollection> (mLogger);
+        mSubscriptionPublisher
+            = std::make_unique<UXPubXSub::Publisher> (dataPacketContext,
+                                                      mLogger);
+    }
+    /// @brief Queues a packet that was just stored in the capped
+    ///        collection for the subscribers.  This is called by the thread
+    ///        adding packets to the capped collection so the packet is only
+    ///        handed off; it is serialized and sent by the publisher thread.
+    void publish(const UDP::DataPacket &packet,
+                 const uint64_t sensorIdentifier,
+                 const uint64_t sequenceNumber)
+    {
+        if (!mPublishSubscriptions){return;}
+        // Do not let a stalled publisher hold the ingest thread's memory
+        if (mSubscriptionQueue.size() >= MAXIMUM_SUBSCRIPTION_QUEUE_SIZE)
+        {
+            auto nDropped = mDroppedSubscriptionPackets + 1;
+            mDroppedSubscriptionPackets = nDropped;
+            if (nDropped == 1 || nDropped%1000 == 0)
+            {
+                mLogger->warn("Subscription queue full; "
+                            + std::to_string(nDropped)
+                            + " packets not published");
+            }
+            return;
+        }
+        try
+        {
+            SubscriptionPacket subscriptionPacket;
+            subscriptionPacket.setPacket(packet);
+            subscriptionPacket.setSensorIdentifier(sensorIdentifier);
+            subscriptionPacket.setSequenceNumber(sequenceNumber);
+            mSubscriptionQueue.push(std::move(subscriptionPacket));
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to queue packet.  Failed with: "
+                         + std::string {e.what()});
+        }
+    }
+    /// @brief A thread running this function will send the queued packets
+    ///        to the subscribers.
+    void publishSubscriptions()
+    {
+        SubscriptionPacket subscriptionPacket;
+        while (keepRunning())
+        {
+            if (mSubscriptionQueue.wait_until_and_pop(&subscriptionPacket))
+            {
+                try
+                {
+                    mSubscriptionPublisher->send(subscriptionPacket);
+                }
+                catch (const std::exception &e)
+                {
+                    mLogger->error("Failed to publish packet.  Failed with: "
+                                 + std::string {e.what()});
+                }
+            }
+        }
+        mLogger->debug("Subscription publisher thread has exited");
     }
     /// @brief A thread running this function will read data packet messages
     ///        from the data packet broadcast and put them into the queue.
     void getPackets()
     {
+        // Bursts are handed to the queue under one lock and wakeup
+        constexpr int maxPackets{512};
+        constexpr std::chrono::milliseconds batchTimeOut{20};
+        // Reused so that a steady stream does not allocate
+        std::vector<UDP::DataPacket> dataPackets;
         while (keepRunning())
         {
             try
             {
-                auto dataPacket = mDataPacketSubscriber->receive();
-                if (dataPacket == nullptr){continue;} // Time out
-                mDataPacketQueue.push(std::move(*dataPacket));
+                mDataPacketSubscriber->receiveBatch(&dataPackets,
+                                                    maxPackets,
+                                                    batchTimeOut);
+                mDataPacketQueue.push_all(&dataPackets);
             }
             catch (const std::exception &e)
             {
@@ -111,9 +309,10 @@ public:
     ///        and put them into the circular buffer.
     void queueToPacketCache()
     {
+        // Popping trades storage with this packet so it is reused
+        UDP::DataPacket dataPacket;
         while (keepRunning())
         {
-            UDP::DataPacket dataPacket;
             if (mDataPacketQueue.wait_until_and_pop(&dataPacket))
             {
                 if (dataPacket.getNumberOfSamples() > 0)
@@ -132,6 +331,42 @@ public:
         }
         mLogger->debug("Queue to circular buffer thread has exited");
     }
+    /// @brief Writes the capped collection to the snapshot file.
+    void writeSnapshot()
+    {
+        try
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            auto nPackets = mCappedCollection->writeSnapshot(mSnapshotFile);
+            auto t1 = std::chrono::steady_clock::now();
+            mLogger->debug("Wrote " + std::to_string(nPackets)
+                         + " packets to snapshot in "
+                         + std::to_string(
+                             std::chrono::duration_cast
+                             <std::chrono::milliseconds> (t1 - t0).count())
+                         + " ms");
+        }
+        catch (const std::exception &e)
+        {
+            mLogger->error("Failed to write snapshot.  Failed with: "
+                         + std::string {e.what()});
+        }
+    }
+    /// @brief A thread running this function will periodically write the
+    ///        capped collection to the snapshot file.
+    void writeSnapshots()
+    {
+        auto lastSnapshot = std::chrono::steady_clock::now();
+        while (keepRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds {100});
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastSnapshot < mSnapshotInterval){continue;}
+            writeSnapshot();
+            lastSnapshot = now;
+        }
+        mLogger->debug("Snapshot thread has exited");
+    }
     /// @brief Starts the service
     void start()
     {
@@ -146,9 +381,22 @@ public:
         mLogger->debug("Starting queue to packetCache thread...");
         mQueueToPacketCacheThread
            = std::thread(&ServiceImpl::queueToPacketCache, this);
-        // Start thread to read / respond to messages
+        // Start thread to push stored packets to subscribers
+        if (mPublishSubscriptions)
+        {
+            mLogger->debug("Starting subscription publisher thread...");
+            mSubscriptionPublisherThread
+                = std::thread(&ServiceImpl::publishSubscriptions, this);
+        }
+        // Start thread to periodically snapshot the packetCache
+        if (mWriteSnapshots)
+        {
+            mLogger->debug("Starting snapshot thread...");
+            mSnapshotThread = std::thread(&ServiceImpl::writeSnapshots, this);
+        }
+        // Start threads to read / respond to messages
         mLogger->debug("Starting replier service...");
-        mPacketCacheReplier->start();
+        for (auto &replier : mPacketCacheRepliers){replier->start();}
     }
     /// @result True indicates the threads should keep running
     [[nodiscard]] bool keepRunning() const
@@ -167,20 +415,69 @@ public:
     {
         mLogger->debug("PacketCache stopping threads...");
         setRunning(false);
-        if (mPacketCacheReplier != nullptr)
+        for (auto &replier : mPacketCacheRepliers)
         {
-            if (mPacketCacheReplier->isRunning()){mPacketCacheReplier->stop();}
+            if (replier->isRunning()){replier->stop();}
         }
         if (mDataPacketSubscriberThread.joinable())
         {
             mDataPacketSubscriberThread.join();
         }
+        bool wasRunning = mQueueToPacketCacheThread.joinable();
         if (mQueueToPacketCacheThread.joinable())
         {
             mQueueToPacketCacheThread.join();
         }
+        if (mSubscriptionPublisherThread.joinable())
+        {
+            mSubscriptionPublisherThread.join();
+        }
+        if (mSnapshotThread.joinable()){mSnapshotThread.join();}
+        // Capture the latest packets for the next start
+        if (wasRunning && mWriteSnapshots){writeSnapshot();}
+    }
+    /// @result True indicates all the repliers are initialized.
+    [[nodiscard]] bool repliersInitialized() const noexcept
+    {
+        if (mPacketCacheRepliers.empty()){return false;}
+        return std::all_of(mPacketCacheRepliers.begin(),
+                           mPacketCacheRepliers.end(),
+                           [](const auto &replier)
+                           {
+                               return replier->isInitialized();
+                           });
+    }
+    /// @brief Creates the reply to a data or bulk data request.  When
+    ///        compressing, the reply is serialized here so that the
+    ///        compression ratio can be tallied.
+    template<typename T>
+    [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
+        createDataReply(T &response)
+    {
+        response.setCompactLayout(mCompactResponses);
+        if (!mCompressResponses){return response.clone();}
+        response.setSampleCompression(true);
+        auto message = response.toMessage();
+        mUncompressedSampleBytes.fetch_add(
+            sizeof(double)*::getNumberOfSamples(response),
+            std::memory_order_relaxed);
+        mReplyBytes.fetch_add(message.size(), std::memory_order_relaxed);
+        return std::make_unique<::SerializedReply> (std::move(message),
+                                                    response.getMessageType(),
+                                                    response.getMessageVersion());
+    }
+    /// @result The ratio of the size of the replied samples as doubles to the
+    ///         size of the data replies.
+    [[nodiscard]] double getCompressionRatio() const noexcept
+    {
+        auto replyBytes = mReplyBytes.load(std::memory_order_relaxed);
+        if (replyBytes == 0){return 1;}
+        return static_cast<double>
+               (mUncompressedSampleBytes.load(std::memory_order_relaxed))
+              /static_cast<double> (replyBytes);
     }
-    // Respond to data requests
+    // Respond to data requests.  This is called concurrently by the replier
+    // threads so it must only touch thread-safe state.
     [[nodiscard]] std::unique_ptr<UMPS::MessageFormats::IMessage>
         callback(const std::string &messageType,
                  const void *messageContents, const size_t length) noexcept
@@ -218,7 +515,7 @@ public:
                 mLogger->error(e.what());
             }
             mLogger->debug("Replying to data request");
-            return response.clone();
+            return createDataReply(response);
         }
         // Bulk data request
         BulkDataRequest bulkDataRequest;
@@ -260,6 +557,41 @@ public:
                 response.addDataResponse(std::move(dataResponse));
             }
             mLogger->debug("Replying to bulk data request");
+            return createDataReply(response);
+        }
+        // Aligned three-component waveform
+        ThreeComponentWaveformRequest waveformRequest;
+        if (messageType == waveformRequest.getMessageType())
+        {
+            mLogger->debug("Three-component waveform request received");
+            ThreeComponentWaveformResponse response;
+            try
+            {
+                waveformRequest.fromMessage(
+                    static_cast<const char *> (messageContents), length);
+            }
+            catch (...)
+            {
+                mLogger->error("Received invalid three-component request");
+                response.setReturnCode(
+                    ThreeComponentWaveformResponse::ReturnCode::InvalidMessage);
+                return response.clone();
+            }
+            // Interpolate (or reuse a previous interpolation)
+            try
+            {
+                response = mWaveformMemo.get(waveformRequest,
+                                             *mCappedCollection);
+            }
+            catch (const std::exception &e)
+            {
+                mLogger->error("Three-component query failed with: "
+                             + std::string {e.what()});
+                response.setReturnCode(
+                 ThreeComponentWaveformResponse::ReturnCode::AlgorithmicFailure);
+            }
+            response.setIdentifier(waveformRequest.getIdentifier());
+            mLogger->debug("Replying to three-component waveform request");
             return response.clone();
         }
         // Get sensors
@@ -310,13 +642,29 @@ public:
     mutable std::mutex mMutex;
     std::thread mDataPacketSubscriberThread;
     std::thread mQueueToPacketCacheThread;
+    std::thread mSnapshotThread;
+    std::thread mSubscriptionPublisherThread;
     std::shared_ptr<UMPS::Logging::ILog> mLogger{nullptr};
     std::unique_ptr<UDP::Subscriber> mDataPacketSubscriber{nullptr};
     std::unique_ptr<CappedCollection> mCappedCollection{nullptr};
-    std::unique_ptr<URouterDealer::Reply> mPacketCacheReplier{nullptr};
+    std::shared_ptr<UMPS::Messaging::Context> mResponseContext{nullptr};
+    std::vector<std::unique_ptr<URouterDealer::Reply>> mPacketCacheRepliers;
+    std::unique_ptr<UXPubXSub::Publisher> mSubscriptionPublisher{nullptr};
+    ::ThreeComponentWaveformMemo mWaveformMemo;
     ::ThreadSafeQueue<UDP::DataPacket> mDataPacketQueue;
+    ::ThreadSafeQueue<SubscriptionPacket> mSubscriptionQueue;
     ServiceOptions mOptions;
+    std::string mSnapshotFile;
+    std::chrono::seconds mSnapshotInterval{60};
+    std::atomic<uint64_t> mUncompressedSampleBytes{0};
+    std::atomic<uint64_t> mReplyBytes{0};
+    std::atomic<bool> mCompressResponses{false};
+    std::atomic<bool> mCompactResponses{false};
+    int64_t mDroppedSubscriptionPackets{0};
+    static constexpr size_t MAXIMUM_SUBSCRIPTION_QUEUE_SIZE{65536};
     bool mKeepRunning{true};
+    bool mPublishSubscriptions{false};
+    bool mWriteSnapshots{false};
     bool mInitialized{false};
 };
 
@@ -367,8 +715,10 @@ void Service::initialize(const ServiceOptions &options)
     }
     // Ensure the service is stopped
     stop(); // Ensure the service is stopped
-    // Create the replier
-    pImpl->mLogger->debug("Creating packet cache replier...");
+    // Create the repliers
+    auto nRepliers = options.getNumberOfReplierThreads();
+    pImpl->mLogger->debug("Creating " + std::to_string(nRepliers)
+                        + " packet cache replier(s)...");
     UMPS::Messaging::RouterDealer::ReplyOptions replierOptions;
     replierOptions.setAddress(options.getReplierAddress());
     replierOptions.setZAPOptions(options.getReplierZAPOptions());
@@ -381,19 +731,95 @@ void Service::initialize(const ServiceOptions &options)
                                          std::placeholders::_1,
                                          std::placeholders::_2,
                                          std::placeholders::_3));
-    pImpl->mPacketCacheReplier->initialize(replierOptions); 
+    pImpl->mPacketCacheRepliers.clear();
+    for (int i = 0; i < nRepliers; ++i)
+    {
+        auto replier
+            = std::make_unique<URouterDealer::Reply> (pImpl->mResponseContext,
+                                                      pImpl->mLogger);
+        replier->initialize(replierOptions);
+        pImpl->mPacketCacheRepliers.push_back(std::move(replier));
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds {10});
     // Create the data packet subscriber
     pImpl->mLogger->debug("Creating data packet subscriber...");
     pImpl->mDataPacketSubscriber->initialize(subscriberOptions);
     std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    // Optionally push stored packets to subscribers
+    pImpl->mPublishSubscriptions = false;
+    pImpl->mDroppedSubscriptionPackets = 0;
+    if (options.haveSubscriptionPublisherOptions())
+    {
+        pImpl->mLogger->debug("Creating subscription publisher...");
+        auto publisherOptions = options.getSubscriptionPublisherOptions();
+        UXPubXSub::PublisherOptions subscriptionOptions;
+        subscriptionOptions.setAddress(publisherOptions.getAddress());
+        subscriptionOptions.setZAPOptions(publisherOptions.getZAPOptions());
+        subscriptionOptions.setTimeOut(publisherOptions.getTimeOut());
+        subscriptionOptions.setHighWaterMark(
+            publisherOptions.getHighWaterMark());
+        pImpl->mSubscriptionPublisher->initialize(subscriptionOptions);
+        pImpl->mPublishSubscriptions
+            = pImpl->mSubscriptionPublisher->isInitialized();
+        if (!pImpl->mPublishSubscriptions)
+        {
+            pImpl->mLogger->error("Failed to create subscription publisher");
+        }
+    }
     // Create the capped collection
     pImpl->mLogger->debug("Creating capped collection...");
     auto maximumNumberOfPackets = options.getMaximumNumberOfPackets();
-    pImpl->mCappedCollection->initialize(maximumNumberOfPackets);
+    auto compressSamples = options.useSampleCompression();
+    pImpl->mCappedCollection->setInsertionCallback(nullptr);
+    pImpl->mCappedCollection->initialize(maximumNumberOfPackets, {},
+                                         compressSamples);
+    // Refill the capped collection from the previous run's snapshot
+    pImpl->mWriteSnapshots = options.haveSnapshotFile();
+    if (pImpl->mWriteSnapshots)
+    {
+        pImpl->mSnapshotFile = options.getSnapshotFile();
+        pImpl->mSnapshotInterval = options.getSnapshotInterval();
+        if (std::filesystem::exists(pImpl->mSnapshotFile))
+        {
+            pImpl->mLogger->info("Loading snapshot "
+                               + pImpl->mSnapshotFile + "...");
+            try
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                auto nPackets = pImpl->mCappedCollection->loadSnapshot(
+                    pImpl->mSnapshotFile);
+                auto t1 = std::chrono::steady_clock::now();
+                pImpl->mLogger->info("Loaded " + std::to_string(nPackets)
+                                   + " packets from snapshot in "
+                                   + std::to_string(
+                                       std::chrono::duration_cast
+                                       <std::chrono::milliseconds>
+                                       (t1 - t0).count())
+                                   + " ms");
+            }
+            catch (const std::exception &e)
+            {
+                pImpl->mLogger->error("Failed to load snapshot.  Failed with: "
+                                    + std::string {e.what()});
+                pImpl->mCappedCollection->initialize(maximumNumberOfPackets,
+                                                     {}, compressSamples);
+            }
+        }
+    }
+    pImpl->mCappedCollection->setInsertionCallback(
+        std::bind(&ServiceImpl::publish,
+                  &*this->pImpl,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3));
+    pImpl->mWaveformMemo.clear();
+    pImpl->mCompressResponses = options.useResponseCompression();
+    pImpl->mCompactResponses = options.useCompactResponses();
+    pImpl->mUncompressedSampleBytes = 0;
+    pImpl->mReplyBytes = 0;
     // Initialized?
     pImpl->mInitialized = pImpl->mDataPacketSubscriber->isInitialized() &&
-                          pImpl->mPacketCacheReplier->isInitialized() &&
+                          pImpl->repliersInitialized() &&
                           pImpl->mCappedCollection->isInitialized();
     if (pImpl->mInitialized)
     {
@@ -442,3 +868,9 @@ int Service::getTotalNumberOfPackets() const noexcept
     return pImpl->mCappedCollection->getTotalNumberOfPackets();
 }
 
+/// Compression ratio
+double Service::getResponseCompressionRatio() const noexcept
+{
+    return pImpl->getCompressionRatio();
+}
+
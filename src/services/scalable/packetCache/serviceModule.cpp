@@ -33,6 +33,7 @@
 #include <umps/services/command/terminateRequest.hpp>
 #include <umps/services/command/terminateResponse.hpp>
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
+#include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
 #include "urts/services/scalable/packetCache/service.hpp"
 #include "urts/services/scalable/packetCache/serviceOptions.hpp"
 #include "private/isEmpty.hpp"
@@ -49,8 +50,9 @@ namespace UCI = UMPS::Services::ConnectionInformation;
     std::string commands{
 R"""(
 Commands: 
-   cacheSize  Total number of packets in the cache.
-   help       Displays this message.
+   cacheSize         Total number of packets in the cache.
+   compressionRatio  Compression ratio of the data responses.
+   help              Displays this message.
 )"""};
     return commands;
 }
@@ -161,6 +163,11 @@ struct ProgramOptions
               "PacketCache.proxyServicePollingTimeOut", pollingTimeOut);
         mPacketCacheServiceOptions.setReplierPollingTimeOut(
             std::chrono::milliseconds {pollingTimeOut} );
+        mPacketCacheServiceOptions.setNumberOfReplierThreads(
+            propertyTree.get<int> (
+                "PacketCache.proxyServiceNumberOfThreads",
+                mPacketCacheServiceOptions.getNumberOfReplierThreads())
+        );
          
         //-----------------Data Broadcast Connection Information--------------//
         mDataBroadcastName = propertyTree.get<std::string>
@@ -186,12 +193,40 @@ struct ProgramOptions
                                              dataTimeOut);
         mSubscriberOptions.setTimeOut(
             std::chrono::milliseconds {dataTimeOut} );
+        //--------------Subscription Broadcast Connection Information--------//
+        mSubscriptionBroadcastName = propertyTree.get<std::string>
+                                     ("PacketCache.subscriptionBroadcastName",
+                                      mSubscriptionBroadcastName);
+        mSubscriptionBroadcastAddress = propertyTree.get<std::string>
+                                ("PacketCache.subscriptionBroadcastAddress",
+                                 mSubscriptionBroadcastAddress);
         //------------------------Packet Cache Options------------------------//
         auto maximumNumberOfPackets
             =  mPacketCacheServiceOptions.getMaximumNumberOfPackets();
         mPacketCacheServiceOptions.setMaximumNumberOfPackets(
             propertyTree.get<int> ("PacketCache.maximumNumberOfPackets",
                                    maximumNumberOfPackets));
+        mPacketCacheServiceOptions.setSampleCompression(
+            propertyTree.get<bool> ("PacketCache.compressSamples",
+                      mPacketCacheServiceOptions.useSampleCompression()));
+        mPacketCacheServiceOptions.setResponseCompression(
+            propertyTree.get<bool> ("PacketCache.compressResponses",
+                      mPacketCacheServiceOptions.useResponseCompression()));
+        mPacketCacheServiceOptions.setCompactResponses(
+            propertyTree.get<bool> ("PacketCache.compactResponses",
+                      mPacketCacheServiceOptions.useCompactResponses()));
+        auto snapshotFile = propertyTree.get<std::string>
+                            ("PacketCache.snapshotFile", "");
+        if (!::isEmpty(snapshotFile))
+        {
+            mPacketCacheServiceOptions.setSnapshotFile(snapshotFile);
+        }
+        auto snapshotInterval = static_cast<int>
+            (mPacketCacheServiceOptions.getSnapshotInterval().count());
+        snapshotInterval = propertyTree.get<int> ("PacketCache.snapshotInterval",
+                                                  snapshotInterval);
+        mPacketCacheServiceOptions.setSnapshotInterval(
+            std::chrono::seconds {snapshotInterval});
     }
 ///private:
     UPacketCache::ServiceOptions mPacketCacheServiceOptions;
@@ -199,6 +234,8 @@ struct ProgramOptions
         mSubscriberOptions;
     std::string mServiceName{"PacketCache"};
     std::string mDataBroadcastName{"DataPacket"};
+    std::string mSubscriptionBroadcastName;
+    std::string mSubscriptionBroadcastAddress;
     std::string mHeartbeatBroadcastName{"Heartbeat"};
     std::string mModuleName{MODULE_NAME};
     std::filesystem::path mLogFileDirectory{"/var/log/urts"};
@@ -366,6 +403,14 @@ public:
                         USC::CommandResponse::ReturnCode::ApplicationError);
                 }
             }
+            else if (command == "compressionRatio")
+            {
+                mLogger->debug("Issuing compressionRatio command...");
+                response.setResponse(std::to_string(
+                    mPacketCache->getResponseCompressionRatio()));
+                response.setReturnCode(
+                    USC::CommandResponse::ReturnCode::Success);
+            }
             else
             {
                 response.setResponse(getInputOptions());
@@ -509,6 +554,29 @@ int main(int argc, char *argv[])
         programOptions.mPacketCacheServiceOptions
                       .setDataPacketSubscriberOptions(
                           programOptions.mSubscriberOptions);
+        // Optionally push stored packets to subscribers
+        if (!programOptions.mSubscriptionBroadcastName.empty() ||
+            !programOptions.mSubscriptionBroadcastAddress.empty())
+        {
+            URTS::Broadcasts::Internal::DataPacket::PublisherOptions
+                publisherOptions;
+            if (!programOptions.mSubscriptionBroadcastAddress.empty())
+            {
+                publisherOptions.setAddress(
+                    programOptions.mSubscriptionBroadcastAddress);
+            }
+            else
+            {
+                publisherOptions.setAddress(
+                    uOperator->getProxyBroadcastFrontendDetails(
+                       programOptions.mSubscriptionBroadcastName)
+                       .getAddress());
+            }
+            publisherOptions.setZAPOptions(programOptions.mZAPOptions);
+            publisherOptions.setHighWaterMark(0); // Infinite
+            programOptions.mPacketCacheServiceOptions
+                          .setSubscriptionPublisherOptions(publisherOptions);
+        }
         // Create the packet cache service
         auto broadcastContext = std::make_shared<UMPS::Messaging::Context> (1);
         auto replierContext = std::make_shared<UMPS::Messaging::Context> (1);
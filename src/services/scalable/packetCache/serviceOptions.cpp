@@ -5,6 +5,7 @@
 #include <umps/authentication/zapOptions.hpp>
 #include "urts/services/scalable/packetCache/serviceOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
+#include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
 #include "private/isEmpty.hpp"
 
 using namespace URTS::Services::Scalable::PacketCache;
@@ -15,12 +16,19 @@ class ServiceOptions::ServiceOptionsImpl
 {
 public:
     UDP::SubscriberOptions mSubscriberOptions;
+    UDP::PublisherOptions mSubscriptionPublisherOptions;
     UAuth::ZAPOptions mReplierZAPOptions;
     std::string mReplierAddress;
+    std::string mSnapshotFile;
+    std::chrono::seconds mSnapshotInterval{60};
     std::chrono::milliseconds mReplierPollingTimeOut{10};
     int mReplierSendHighWaterMark{8192};
     int mReplierReceiveHighWaterMark{4096};
+    int mReplierThreads{1};
     int mMaxPackets{300};
+    bool mCompressSamples{false};
+    bool mCompressResponses{false};
+    bool mCompactResponses{false};
 };
 
 /// Constructor
@@ -82,6 +90,85 @@ int ServiceOptions::getMaximumNumberOfPackets() const noexcept
     return pImpl->mMaxPackets;
 }
 
+/// Sample compression
+void ServiceOptions::setSampleCompression(const bool compress) noexcept
+{
+    pImpl->mCompressSamples = compress;
+}
+
+bool ServiceOptions::useSampleCompression() const noexcept
+{
+    return pImpl->mCompressSamples;
+}
+
+/// Response compression
+void ServiceOptions::setResponseCompression(const bool compress) noexcept
+{
+    pImpl->mCompressResponses = compress;
+}
+
+bool ServiceOptions::useResponseCompression() const noexcept
+{
+    return pImpl->mCompressResponses;
+}
+
+/// Compact responses
+void ServiceOptions::setCompactResponses(const bool compact) noexcept
+{
+    pImpl->mCompactResponses = compact;
+}
+
+bool ServiceOptions::useCompactResponses() const noexcept
+{
+    return pImpl->mCompactResponses;
+}
+
+/// Snapshot file
+void ServiceOptions::setSnapshotFile(const std::string &fileName)
+{
+    if (::isEmpty(fileName))
+    {
+        throw std::invalid_argument("Snapshot file is empty");
+    }
+    auto parentPath = std::filesystem::path(fileName).parent_path();
+    if (!parentPath.empty() && !std::filesystem::exists(parentPath))
+    {
+        throw std::invalid_argument("Snapshot directory "
+                                  + parentPath.string()
+                                  + " does not exist");
+    }
+    pImpl->mSnapshotFile = fileName;
+}
+
+std::string ServiceOptions::getSnapshotFile() const
+{
+    if (!haveSnapshotFile())
+    {
+        throw std::runtime_error("Snapshot file not set");
+    }
+    return pImpl->mSnapshotFile;
+}
+
+bool ServiceOptions::haveSnapshotFile() const noexcept
+{
+    return !pImpl->mSnapshotFile.empty();
+}
+
+/// Snapshot interval
+void ServiceOptions::setSnapshotInterval(const std::chrono::seconds &interval)
+{
+    if (interval.count() <= 0)
+    {
+        throw std::invalid_argument("Snapshot interval must be positive");
+    }
+    pImpl->mSnapshotInterval = interval;
+}
+
+std::chrono::seconds ServiceOptions::getSnapshotInterval() const noexcept
+{
+    return pImpl->mSnapshotInterval;
+}
+
 /// Data packet subscriber options
 void ServiceOptions::setDataPacketSubscriberOptions(
     const UDP::SubscriberOptions &options)
@@ -106,6 +193,31 @@ bool ServiceOptions::haveDataPacketSubscriberOptions() const noexcept
     return pImpl->mSubscriberOptions.haveAddress();
 }
 
+/// Subscription publisher options
+void ServiceOptions::setSubscriptionPublisherOptions(
+    const UDP::PublisherOptions &options)
+{
+    if (!options.haveAddress())
+    {
+        throw std::invalid_argument("Address not set");
+    }
+    pImpl->mSubscriptionPublisherOptions = options;
+}
+
+UDP::PublisherOptions ServiceOptions::getSubscriptionPublisherOptions() const
+{
+    if (!haveSubscriptionPublisherOptions())
+    {
+        throw std::runtime_error("Subscription publisher options not set");
+    }
+    return pImpl->mSubscriptionPublisherOptions;
+}
+
+bool ServiceOptions::haveSubscriptionPublisherOptions() const noexcept
+{
+    return pImpl->mSubscriptionPublisherOptions.haveAddress();
+}
+
 /// Sets the backend address
 void ServiceOptions::setReplierAddress(const std::string &address)
 {
@@ -177,6 +289,23 @@ int ServiceOptions::getReplierReceiveHighWaterMark() const noexcept
     return pImpl->mReplierReceiveHighWaterMark;
 }
 
+/// Replier threads
+void ServiceOptions::setNumberOfReplierThreads(const int nThreads)
+{
+    if (nThreads < 1)
+    {
+        throw std::invalid_argument("Number of replier threads = "
+                                  + std::to_string(nThreads)
+                                  + " must be positive");
+    }
+    pImpl->mReplierThreads = nThreads;
+}
+
+int ServiceOptions::getNumberOfReplierThreads() const noexcept
+{
+    return pImpl->mReplierThreads;
+}
+
 /*
 void ServiceOptions::parseInitializationFile(const std::string &iniFile,
                                              const std::string &section)
@@ -263,17 +263,20 @@ void SingleComponentWaveform::set(const DataResponse &response,
     }
     int nPackets = response.getNumberOfPackets();
     if (nPackets < 1){return;} // Nothing to do
-    const auto &packetsReference = response.getPacketsReference();
+    // Interpolating the views directly avoids materializing data packets.
+    // For a received response these point into the message's single
+    // block of samples.
+    const auto &packetsReference = response.getPacketViewsReference();
 #ifndef NDEBUG
     assert(static_cast<int> (packetsReference.size()) == nPackets);
 #endif
     /// Preliminary checks on packets
     auto [t0Packets, t1Packets]
         = ::checkPacketsAndGetStartEndTime(packetsReference);
-    auto network = packetsReference.at(0).getNetwork();
-    auto station = packetsReference.at(0).getStation();
-    auto channel = packetsReference.at(0).getChannel();
-    auto locationCode = packetsReference.at(0).getLocationCode();
+    auto network = response.getNetwork();
+    auto station = response.getStation();
+    auto channel = response.getChannel();
+    auto locationCode = response.getLocationCode();
     /*
     auto t0Packets = packetsReference[0].getStartTime();
     auto t1Packets = packetsReference[0].getEndTime();
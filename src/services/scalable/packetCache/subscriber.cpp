@@ -0,0 +1,196 @@
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <umps/authentication/zapOptions.hpp>
+#include <umps/messaging/publisherSubscriber/subscriber.hpp>
+#include <umps/messaging/publisherSubscriber/subscriberOptions.hpp>
+#include <umps/messageFormats/messages.hpp>
+#include <umps/messageFormats/message.hpp>
+#include <umps/logging/log.hpp>
+#include "urts/services/scalable/packetCache/subscriber.hpp"
+#include "urts/services/scalable/packetCache/subscriptionPacket.hpp"
+#include "urts/services/scalable/packetCache/dataRequest.hpp"
+#include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "private/staticUniquePointerCast.hpp"
+
+using namespace URTS::Services::Scalable::PacketCache;
+namespace UDP = URTS::Broadcasts::Internal::DataPacket;
+namespace UPubSub = UMPS::Messaging::PublisherSubscriber;
+
+class Subscriber::SubscriberImpl
+{
+public:
+    SubscriberImpl(std::shared_ptr<UMPS::Messaging::Context> context,
+                   std::shared_ptr<UMPS::Logging::ILog> logger) :
+        mLogger(logger)
+    {
+        mSubscriber = std::make_unique<UPubSub::Subscriber> (context, logger);
+    }
+    /// @brief Tracks the sensor's sequence numbers and, if packets were
+    ///        missed, creates a request to recover them.
+    void track(const SubscriptionPacket &packet)
+    {
+        auto sensorIdentifier = packet.getSensorIdentifier();
+        auto sequenceNumber = packet.getSequenceNumber();
+        auto idx = mLastSequenceNumber.find(sensorIdentifier);
+        if (idx == mLastSequenceNumber.end())
+        {
+            mLastSequenceNumber.insert(
+                std::pair {sensorIdentifier, sequenceNumber});
+            return;
+        }
+        auto lastSequenceNumber = idx->second;
+        if (sequenceNumber <= lastSequenceNumber){return;} // Stale
+        if (sequenceNumber > lastSequenceNumber + 1)
+        {
+            const auto &dataPacket = packet.getPacketReference();
+            DataRequest request;
+            request.setNetwork(dataPacket.getNetwork());
+            request.setStation(dataPacket.getStation());
+            request.setChannel(dataPacket.getChannel());
+            request.setLocationCode(dataPacket.getLocationCode());
+            request.setSensorIdentifier(sensorIdentifier);
+            request.setCursor(lastSequenceNumber);
+            mGapRequests.push_back(std::move(request));
+            mGaps = mGaps + 1;
+            if (mLogger != nullptr)
+            {
+                mLogger->warn("Missed "
+                            + std::to_string(sequenceNumber
+                                           - lastSequenceNumber - 1)
+                            + " packets for " + dataPacket.getNetwork() + "."
+                            + dataPacket.getStation() + "."
+                            + dataPacket.getChannel() + "."
+                            + dataPacket.getLocationCode());
+            }
+        }
+        idx->second = sequenceNumber;
+    }
+    std::shared_ptr<UMPS::Logging::ILog> mLogger;
+    std::unique_ptr<UPubSub::Subscriber> mSubscriber;
+    std::unordered_map<uint64_t, uint64_t> mLastSequenceNumber;
+    std::vector<DataRequest> mGapRequests;
+    int64_t mGaps{0};
+};
+
+/// C'tor
+Subscriber::Subscriber() :
+    pImpl(std::make_unique<SubscriberImpl> (nullptr, nullptr))
+{
+}
+
+Subscriber::Subscriber(std::shared_ptr<UMPS::Messaging::Context> &context) :
+    pImpl(std::make_unique<SubscriberImpl> (context, nullptr))
+{
+}
+
+Subscriber::Subscriber(std::shared_ptr<UMPS::Logging::ILog> &logger) :
+    pImpl(std::make_unique<SubscriberImpl> (nullptr, logger))
+{
+}
+
+Subscriber::Subscriber(std::shared_ptr<UMPS::Messaging::Context> &context,
+                       std::shared_ptr<UMPS::Logging::ILog> &logger) :
+    pImpl(std::make_unique<SubscriberImpl> (context, logger))
+{
+}
+
+/// Move c'tor
+Subscriber::Subscriber(Subscriber &&subscriber) noexcept
+{
+    *this = std::move(subscriber);
+}
+
+/// Move assignment
+Subscriber& Subscriber::operator=(Subscriber &&subscriber) noexcept
+{
+    if (&subscriber == this){return *this;}
+    pImpl = std::move(subscriber.pImpl);
+    return *this;
+}
+
+/// Initialize
+void Subscriber::initialize(const UDP::SubscriberOptions &options,
+                            const std::unordered_set<std::string> &sensors)
+{
+    if (!options.haveAddress())
+    {
+        throw std::invalid_argument("Address not set");
+    }
+    if (sensors.empty()){throw std::invalid_argument("No sensors");}
+    // Each sensor is its own message type so the broadcast only sends
+    // this subscriber the sensors it asked for
+    UMPS::MessageFormats::Messages messageTypes;
+    for (const auto &sensor : sensors)
+    {
+        auto packet = std::make_unique<SubscriptionPacket> ();
+        packet->setTopic(sensor);
+        std::unique_ptr<UMPS::MessageFormats::IMessage> messageType
+            = std::move(packet);
+        messageTypes.add(messageType);
+    }
+    if (pImpl->mLogger != nullptr)
+    {
+        pImpl->mLogger->debug("Packet cache subscriber connecting to "
+                            + options.getAddress());
+    }
+    UPubSub::SubscriberOptions subscriberOptions;
+    subscriberOptions.setAddress(options.getAddress());
+    subscriberOptions.setZAPOptions(options.getZAPOptions());
+    subscriberOptions.setReceiveTimeOut(options.getTimeOut());
+    subscriberOptions.setReceiveHighWaterMark(options.getHighWaterMark());
+    subscriberOptions.setMessageTypes(messageTypes);
+    pImpl->mSubscriber->initialize(subscriberOptions);
+    pImpl->mLastSequenceNumber.clear();
+    pImpl->mGapRequests.clear();
+    pImpl->mGaps = 0;
+}
+
+/// Initialized?
+bool Subscriber::isInitialized() const noexcept
+{
+    return pImpl->mSubscriber->isInitialized();
+}
+
+/// Receive
+std::unique_ptr<SubscriptionPacket> Subscriber::receive()
+{
+    if (!isInitialized())
+    {
+        throw std::runtime_error("Subscriber not initialized");
+    }
+    auto message = pImpl->mSubscriber->receive();
+    if (message == nullptr){return nullptr;} // Time out
+    std::unique_ptr<SubscriptionPacket> packet{nullptr};
+    try
+    {
+        packet = static_unique_pointer_cast<SubscriptionPacket>
+                 (std::move(message));
+    }
+    catch (const std::exception &e)
+    {
+        throw std::runtime_error(
+            "Error deserializing subscription packet.  Failed with "
+          + std::string {e.what()});
+    }
+    pImpl->track(*packet);
+    return packet;
+}
+
+/// Gaps
+std::vector<DataRequest> Subscriber::popGapRequests()
+{
+    std::vector<DataRequest> result;
+    std::swap(result, pImpl->mGapRequests);
+    return result;
+}
+
+int64_t Subscriber::getNumberOfGaps() const noexcept
+{
+    return pImpl->mGaps;
+}
+
+/// Destructor
+Subscriber::~Subscriber() = default;
@@ -0,0 +1,297 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <nlohmann/json.hpp>
+#include "urts/services/scalable/packetCache/subscriptionPacket.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "private/cborWriter.hpp"
+
+#define MESSAGE_TYPE "URTS::Services::Scalable::PacketCache::SubscriptionPacket"
+#define MESSAGE_VERSION "1.0.0"
+
+using namespace URTS::Services::Scalable::PacketCache;
+namespace UDP = URTS::Broadcasts::Internal::DataPacket;
+
+namespace
+{
+
+void checkPacket(const UDP::DataPacket &packet)
+{
+    if (!packet.haveNetwork()){throw std::invalid_argument("Network not set");}
+    if (!packet.haveStation()){throw std::invalid_argument("Station not set");}
+    if (!packet.haveChannel()){throw std::invalid_argument("Channel not set");}
+    if (!packet.haveLocationCode())
+    {
+        throw std::invalid_argument("Location code not set");
+    }
+    if (!packet.haveSamplingRate())
+    {
+        throw std::invalid_argument("Sampling rate not set");
+    }
+}
+
+SubscriptionPacket objectToSubscriptionPacket(const nlohmann::json &obj)
+{
+    SubscriptionPacket result;
+    if (obj["MessageType"] != MESSAGE_TYPE)
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    UDP::DataPacket packet;
+    packet.setNetwork(obj["Network"].get<std::string> ());
+    packet.setStation(obj["Station"].get<std::string> ());
+    packet.setChannel(obj["Channel"].get<std::string> ());
+    packet.setLocationCode(obj["LocationCode"].get<std::string> ());
+    packet.setSamplingRate(obj["SamplingRate"].get<double> ());
+    packet.setStartTime(
+        std::chrono::microseconds {obj["StartTime"].get<int64_t> ()});
+    if (!obj["Data"].is_null())
+    {
+        packet.setData(obj["Data"].get<std::vector<double>> ());
+    }
+    result.setPacket(std::move(packet));
+    result.setSensorIdentifier(obj["SensorIdentifier"].get<uint64_t> ());
+    result.setSequenceNumber(obj["SequenceNumber"].get<uint64_t> ());
+    return result;
+}
+
+SubscriptionPacket fromCBORMessage(const uint8_t *message, const size_t length)
+{
+    auto obj = nlohmann::json::from_cbor(message, message + length);
+    return objectToSubscriptionPacket(obj);
+}
+
+}
+
+class SubscriptionPacket::SubscriptionPacketImpl
+{
+public:
+    UDP::DataPacket mPacket;
+    std::string mTopic;
+    uint64_t mSensorIdentifier{0};
+    uint64_t mSequenceNumber{0};
+    bool mHavePacket{false};
+};
+
+/// C'tor
+SubscriptionPacket::SubscriptionPacket() :
+    pImpl(std::make_unique<SubscriptionPacketImpl> ())
+{
+}
+
+/// Copy c'tor
+SubscriptionPacket::SubscriptionPacket(const SubscriptionPacket &packet)
+{
+    *this = packet;
+}
+
+/// Move c'tor
+SubscriptionPacket::SubscriptionPacket(SubscriptionPacket &&packet) noexcept
+{
+    *this = std::move(packet);
+}
+
+/// Copy assignment
+SubscriptionPacket&
+SubscriptionPacket::operator=(const SubscriptionPacket &packet)
+{
+    if (&packet == this){return *this;}
+    pImpl = std::make_unique<SubscriptionPacketImpl> (*packet.pImpl);
+    return *this;
+}
+
+/// Move assignment
+SubscriptionPacket&
+SubscriptionPacket::operator=(SubscriptionPacket &&packet) noexcept
+{
+    if (&packet == this){return *this;}
+    pImpl = std::move(packet.pImpl);
+    return *this;
+}
+
+/// Reset class
+void SubscriptionPacket::clear() noexcept
+{
+    pImpl = std::make_unique<SubscriptionPacketImpl> ();
+}
+
+/// Destructor
+SubscriptionPacket::~SubscriptionPacket() = default;
+
+/// Message type
+std::string SubscriptionPacket::getMessageType() const noexcept
+{
+    if (pImpl->mTopic.empty()){return MESSAGE_TYPE;}
+    return MESSAGE_TYPE "::" + pImpl->mTopic + ".";
+}
+
+/// Message version
+std::string SubscriptionPacket::getMessageVersion() const noexcept
+{
+    return MESSAGE_VERSION;
+}
+
+/// Packet
+void SubscriptionPacket::setPacket(const UDP::DataPacket &packet)
+{
+    auto work = packet;
+    setPacket(std::move(work));
+}
+
+void SubscriptionPacket::setPacket(UDP::DataPacket &&packet)
+{
+    ::checkPacket(packet);
+    pImpl->mTopic = packet.getNetwork() + "."
+                  + packet.getStation() + "."
+                  + packet.getChannel() + "."
+                  + packet.getLocationCode();
+    pImpl->mPacket = std::move(packet);
+    pImpl->mHavePacket = true;
+}
+
+UDP::DataPacket SubscriptionPacket::getPacket() const
+{
+    return getPacketReference();
+}
+
+const UDP::DataPacket &SubscriptionPacket::getPacketReference() const
+{
+    if (!havePacket()){throw std::runtime_error("Packet not set");}
+    return pImpl->mPacket;
+}
+
+bool SubscriptionPacket::havePacket() const noexcept
+{
+    return pImpl->mHavePacket;
+}
+
+/// Topic
+void SubscriptionPacket::setTopic(const std::string &sensor)
+{
+    if (sensor.empty()){throw std::invalid_argument("Sensor is empty");}
+    pImpl->mTopic = sensor;
+}
+
+std::string SubscriptionPacket::getTopic() const noexcept
+{
+    return pImpl->mTopic;
+}
+
+/// Sensor identifier
+void SubscriptionPacket::setSensorIdentifier(const uint64_t identifier) noexcept
+{
+    pImpl->mSensorIdentifier = identifier;
+}
+
+uint64_t SubscriptionPacket::getSensorIdentifier() const noexcept
+{
+    return pImpl->mSensorIdentifier;
+}
+
+/// Sequence number
+void SubscriptionPacket::setSequenceNumber(
+    const uint64_t sequenceNumber) noexcept
+{
+    pImpl->mSequenceNumber = sequenceNumber;
+}
+
+uint64_t SubscriptionPacket::getSequenceNumber() const noexcept
+{
+    return pImpl->mSequenceNumber;
+}
+
+/// Create CBOR.  This is written directly from the packet.
+std::string SubscriptionPacket::toCBOR() const
+{
+    const auto &packet = getPacketReference();
+    auto nSamples = static_cast<size_t> (packet.getNumberOfSamples());
+    std::string result;
+    result.reserve(256 + 9*nSamples);
+    CBORWriter writer(&result);
+    writer.startMap(11);
+    writer.write("MessageType");
+    writer.write(MESSAGE_TYPE);
+    writer.write("MessageVersion");
+    writer.write(getMessageVersion());
+    writer.write("Network");
+    writer.write(packet.getNetwork());
+    writer.write("Station");
+    writer.write(packet.getStation());
+    writer.write("Channel");
+    writer.write(packet.getChannel());
+    writer.write("LocationCode");
+    writer.write(packet.getLocationCode());
+    writer.write("SamplingRate");
+    writer.write(packet.getSamplingRate());
+    writer.write("StartTime");
+    writer.write(static_cast<int64_t> (packet.getStartTime().count()));
+    writer.write("Data");
+    if (nSamples > 0)
+    {
+        writer.write(packet.getDataPointer(), nSamples);
+    }
+    else
+    {
+        writer.writeNull();
+    }
+    writer.write("SensorIdentifier");
+    writer.write(static_cast<uint64_t> (getSensorIdentifier()));
+    writer.write("SequenceNumber");
+    writer.write(static_cast<uint64_t> (getSequenceNumber()));
+    return result;
+}
+
+/// From CBOR
+void SubscriptionPacket::fromCBOR(const std::string &data)
+{
+    fromCBOR(reinterpret_cast<const uint8_t *> (data.data()), data.size());
+}
+
+void SubscriptionPacket::fromCBOR(const uint8_t *data, const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr)
+    {
+        throw std::invalid_argument("data is NULL");
+    }
+    *this = fromCBORMessage(data, length);
+}
+
+///  Convert message
+std::string SubscriptionPacket::toMessage() const
+{
+    return toCBOR();
+}
+
+void SubscriptionPacket::fromMessage(const std::string &message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    fromMessage(message.data(), message.size());
+}
+
+void SubscriptionPacket::fromMessage(const char *messageIn, const size_t length)
+{
+    auto message = reinterpret_cast<const uint8_t *> (messageIn);
+    fromCBOR(message, length);
+}
+
+/// Copy this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    SubscriptionPacket::clone() const
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<SubscriptionPacket> (*this);
+    return result;
+}
+
+/// Create an instance of this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    SubscriptionPacket::createInstance() const noexcept
+{
+    // Instances keep the topic so they have this message type
+    auto instance = std::make_unique<SubscriptionPacket> ();
+    instance->pImpl->mTopic = pImpl->mTopic;
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::move(instance);
+    return result;
+}
@@ -332,9 +332,10 @@ void ThreeComponentWaveform::set(const DataResponse &verticalComponent,
     }
     // Do some checks and figure out the start/end time to interpolate
     const auto &verticalPacketsReference
-         = verticalComponent.getPacketsReference();
-    const auto &northPacketsReference = northComponent.getPacketsReference();
-    const auto &eastPacketsReference = eastComponent.getPacketsReference();
+         = verticalComponent.getPacketViewsReference();
+    const auto &northPacketsReference
+         = northComponent.getPacketViewsReference();
+    const auto &eastPacketsReference = eastComponent.getPacketViewsReference();
     auto [t0VerticalPackets, t1VerticalPackets]
         = ::checkPacketsAndGetStartEndTime(verticalPacketsReference);
     auto [t0NorthPackets, t1NorthPackets]
@@ -343,28 +344,28 @@ void ThreeComponentWaveform::set(const DataResponse &verticalComponent,
         = ::checkPacketsAndGetStartEndTime(eastPacketsReference);
     // Ensure names make sense -> indicative that the nominal sampling rate
     // will be potentially problematic
-    auto network = verticalPacketsReference.at(0).getNetwork();
-    auto station = verticalPacketsReference.at(0).getStation();
-    auto channel = verticalPacketsReference.at(0).getChannel();
-    auto locationCode = verticalPacketsReference.at(0).getLocationCode();
-    if (network != northPacketsReference.at(0).getNetwork() ||
-        network != eastPacketsReference.at(0).getNetwork())
+    auto network = verticalComponent.getNetwork();
+    auto station = verticalComponent.getStation();
+    auto channel = verticalComponent.getChannel();
+    auto locationCode = verticalComponent.getLocationCode();
+    if (network != northComponent.getNetwork() ||
+        network != eastComponent.getNetwork())
     {
         throw std::invalid_argument("Vertical/north/east network codes differ");
     }
-    if (station != northPacketsReference.at(0).getStation() ||
-        station != eastPacketsReference.at(0).getStation())
+    if (station != northComponent.getStation() ||
+        station != eastComponent.getStation())
     {
         throw std::invalid_argument("Vertical/north/east station names differ");
     }
-    if (locationCode != northPacketsReference.at(0).getLocationCode() ||
-        locationCode != eastPacketsReference.at(0).getLocationCode())
+    if (locationCode != northComponent.getLocationCode() ||
+        locationCode != eastComponent.getLocationCode())
     {
         throw std::invalid_argument(
             "Vertical/north/east location codes differ");
     }
-    if (channel == northPacketsReference.at(0).getChannel() ||
-        channel == eastPacketsReference.at(0).getChannel())
+    if (channel == northComponent.getChannel() ||
+        channel == eastComponent.getChannel())
     {
         throw std::invalid_argument(
             "Vertical/north/east channel codes are the same");
@@ -0,0 +1,264 @@
+#ifndef PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_MEMO_HPP
+#define PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_THREE_COMPONENT_WAVEFORM_MEMO_HPP
+#ifdef URTS_SRC
+#include <array>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include "urts/services/scalable/packetCache/cappedCollection.hpp"
+#include "urts/services/scalable/packetCache/dataResponse.hpp"
+#include "urts/services/scalable/packetCache/packetSummary.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveform.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "utilities.hpp"
+namespace
+{
+/// @brief Computes aligned three-component waveforms from the capped
+///        collection and remembers the most recently used results.
+///        A result is reused when the same window is requested and the
+///        packets in that window have not changed.  Concurrent callers
+///        asking for the same window wait on a single computation.
+/// @note Entries are keyed on the packets' summaries, i.e., their sequence
+///       numbers, start times, and sample counts, and on the window clipped
+///       to the data.  Checking for a result therefore neither decodes
+///       compressed samples nor holds views that would keep the collection
+///       from recycling its storage.  A request whose end time runs past the
+///       latest sample reuses the result until new samples arrive.
+class ThreeComponentWaveformMemo
+{
+public:
+    /// @param[in] capacity  The maximum number of results to remember.
+    explicit ThreeComponentWaveformMemo(const size_t capacity = 128) :
+        mCapacity(capacity)
+    {
+    }
+    /// @result The aligned waveform for the request.  Note, the identifier
+    ///         is not set.
+    [[nodiscard]]
+    URTS::Services::Scalable::PacketCache::ThreeComponentWaveformResponse
+        get(const URTS::Services::Scalable::PacketCache::ThreeComponentWaveformRequest &request,
+            const URTS::Services::Scalable::PacketCache::CappedCollection &collection)
+    {
+        namespace UPC = URTS::Services::Scalable::PacketCache;
+        const auto network = request.getNetwork();
+        const auto station = request.getStation();
+        const auto locationCode = request.getLocationCode();
+        const std::array<std::string, 3> channels{request.getVerticalChannel(),
+                                                  request.getNorthChannel(),
+                                                  request.getEastChannel()};
+        auto [startTime, endTime] = request.getQueryTimes();
+        auto t0 = ::secondsToMicroSeconds(startTime);
+        auto t1 = ::secondsToMicroSeconds(endTime);
+        // Describe the packets in the window; this does not touch samples
+        std::array<uint64_t, 3> identifiers{0, 0, 0};
+        std::array<std::vector<UPC::PacketSummary>, 3> summaries;
+        std::string key;
+        for (int i = 0; i < 3; ++i)
+        {
+            auto name = ::makeName(network, station, channels[i], locationCode);
+            if (!collection.haveSensor(name))
+            {
+                UPC::ThreeComponentWaveformResponse response;
+                response.setReturnCode(
+                    UPC::ThreeComponentWaveformResponse::ReturnCode::NoSensor);
+                return response;
+            }
+            identifiers[i] = collection.getSensorIdentifier(name);
+            summaries[i] = collection.getPacketSummaries(identifiers[i],
+                                                         t0, t1);
+            key = key + name + "|";
+        }
+        // The waveform is interpolated over the window clipped to the data
+        // so requests differing only outside the data yield the same result
+        auto [t0Key, t1Key] = clipWindow(summaries, t0, t1);
+        key = key + std::to_string(t0Key.count()) + "|"
+            + std::to_string(t1Key.count()) + "|"
+            + std::to_string(request.getSamplingRate()) + "|"
+            + std::to_string(request.getGapTolerance().count());
+        // Reuse the result or claim the computation
+        std::shared_future<UPC::ThreeComponentWaveformResponse> result;
+        std::promise<UPC::ThreeComponentWaveformResponse> promise;
+        {
+            std::lock_guard<std::mutex> lockGuard(mMutex);
+            mClock = mClock + 1;
+            auto idx = mEntries.find(key);
+            if (idx != mEntries.end() &&
+                samePackets(idx->second.mPackets, summaries))
+            {
+                idx->second.mLastUsed = mClock;
+                result = idx->second.mResponse;
+                mHits = mHits + 1;
+            }
+            else
+            {
+                Entry entry;
+                entry.mPackets = std::move(summaries);
+                entry.mResponse = promise.get_future().share();
+                entry.mLastUsed = mClock;
+                mEntries.insert_or_assign(key, std::move(entry));
+                evict();
+            }
+        }
+        if (result.valid()){return result.get();}
+        // Only now fetch (and, if compressed, decode) the samples.  Should a
+        // packet arrive in the meantime the entry merely misses next time.
+        std::array<std::vector<UPC::PacketView>, 3> packets;
+        try
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                packets[i] = collection.getPacketViews(identifiers[i], t0, t1);
+            }
+        }
+        catch (const std::exception &)
+        {
+            UPC::ThreeComponentWaveformResponse response;
+            response.setReturnCode(
+             UPC::ThreeComponentWaveformResponse::ReturnCode::AlgorithmicFailure);
+            promise.set_value(response);
+            return response;
+        }
+        // Interpolate the packets onto a common time grid
+        UPC::ThreeComponentWaveformResponse response;
+        response.setSamplingRate(request.getSamplingRate());
+        try
+        {
+            std::array<UPC::DataResponse, 3> dataResponses;
+            for (int i = 0; i < 3; ++i)
+            {
+                dataResponses[i].setPacketViews(network, station, channels[i],
+                                                locationCode,
+                                                std::move(packets[i]));
+            }
+            UPC::ThreeComponentWaveform waveform;
+            waveform.setNominalSamplingRate(request.getSamplingRate());
+            waveform.setGapTolerance(request.getGapTolerance());
+            waveform.set(dataResponses[0], dataResponses[1], dataResponses[2],
+                         t0, t1);
+            if (waveform.getNumberOfSamples() > 0)
+            {
+                response.setStartTime(waveform.getStartTime());
+                response.setSignals(waveform.getVerticalSignalReference(),
+                                    waveform.getNorthSignalReference(),
+                                    waveform.getEastSignalReference(),
+                                    waveform.getGapIndicatorReference());
+            }
+        }
+        catch (const std::invalid_argument &)
+        {
+            response.setReturnCode(
+              UPC::ThreeComponentWaveformResponse::ReturnCode::InvalidTimeQuery);
+        }
+        catch (const std::exception &)
+        {
+            response.setReturnCode(
+             UPC::ThreeComponentWaveformResponse::ReturnCode::AlgorithmicFailure);
+        }
+        promise.set_value(response);
+        return response;
+    }
+    /// @brief Forgets all results.
+    void clear() noexcept
+    {
+        std::lock_guard<std::mutex> lockGuard(mMutex);
+        mEntries.clear();
+        mHits = 0;
+    }
+    /// @result The number of requests answered with a remembered result.
+    [[nodiscard]] uint64_t getNumberOfHits() const noexcept
+    {
+        std::lock_guard<std::mutex> lockGuard(mMutex);
+        return mHits;
+    }
+private:
+    using Summaries
+        = std::array<std::vector<URTS::Services::Scalable::PacketCache::PacketSummary>, 3>;
+    struct Entry
+    {
+        Summaries mPackets;
+        std::shared_future<URTS::Services::Scalable::PacketCache::ThreeComponentWaveformResponse> mResponse;
+        uint64_t mLastUsed{0};
+    };
+    /// @result The query window clipped to the latest first sample and the
+    ///         earliest last sample of the components, as is done when
+    ///         interpolating.  If that is empty the window is returned as is.
+    [[nodiscard]] static std::pair<std::chrono::microseconds,
+                                   std::chrono::microseconds>
+        clipWindow(const Summaries &summaries,
+                   const std::chrono::microseconds &t0,
+                   const std::chrono::microseconds &t1) noexcept
+    {
+        auto t0Data = std::chrono::microseconds
+                      {std::numeric_limits<int64_t>::lowest()};
+        auto t1Data = std::chrono::microseconds
+                      {std::numeric_limits<int64_t>::max()};
+        for (const auto &component : summaries)
+        {
+            if (component.empty()){return std::pair {t0, t1};}
+            auto t0Component = component.front().startTime;
+            auto t1Component = component.front().endTime;
+            for (const auto &packet : component)
+            {
+                t0Component = std::min(t0Component, packet.startTime);
+                t1Component = std::max(t1Component, packet.endTime);
+            }
+            t0Data = std::max(t0Data, t0Component);
+            t1Data = std::min(t1Data, t1Component);
+        }
+        auto t0Clipped = std::max(t0, t0Data);
+        auto t1Clipped = std::min(t1, t1Data);
+        if (t0Clipped > t1Clipped){return std::pair {t0, t1};}
+        return std::pair {t0Clipped, t1Clipped};
+    }
+    /// @result True indicates the summaries describe the same packets.
+    [[nodiscard]] static bool samePackets(const Summaries &lhs,
+                                          const Summaries &rhs) noexcept
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (lhs[i].size() != rhs[i].size()){return false;}
+            for (size_t j = 0; j < lhs[i].size(); ++j)
+            {
+                if (lhs[i][j].sequence != rhs[i][j].sequence ||
+                    lhs[i][j].startTime != rhs[i][j].startTime ||
+                    lhs[i][j].nSamples != rhs[i][j].nSamples)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    /// @brief Removes the least recently used entries.
+    void evict()
+    {
+        while (mEntries.size() > mCapacity)
+        {
+            auto oldest = mEntries.begin();
+            for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+            {
+                if (it->second.mLastUsed < oldest->second.mLastUsed)
+                {
+                    oldest = it;
+                }
+            }
+            mEntries.erase(oldest);
+        }
+    }
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, Entry> mEntries;
+    uint64_t mClock{0};
+    uint64_t mHits{0};
+    size_t mCapacity{128};
+};
+}
+#endif
+#endif
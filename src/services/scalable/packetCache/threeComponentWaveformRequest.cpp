@@ -0,0 +1,429 @@
+#include <string>
+#include <chrono>
+#include <nlohmann/json.hpp>
+#include "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+#include "private/isEmpty.hpp"
+
+#define MESSAGE_TYPE "URTS::Services::Scalable::PacketCache::ThreeComponentWaveformRequest"
+#define MESSAGE_VERSION "1.0.0"
+
+using namespace URTS::Services::Scalable::PacketCache;
+
+namespace
+{
+
+nlohmann::json toJSONObject(const ThreeComponentWaveformRequest &request)
+{
+    nlohmann::json obj;
+    // Essential stuff (this will throw):
+    obj["MessageType"] = request.getMessageType();
+    obj["MessageVersion"] = request.getMessageVersion();
+    obj["Network"] = request.getNetwork();
+    obj["Station"] = request.getStation();
+    obj["VerticalChannel"] = request.getVerticalChannel();
+    obj["NorthChannel"] = request.getNorthChannel();
+    obj["EastChannel"] = request.getEastChannel();
+    obj["LocationCode"] = request.getLocationCode();
+    auto [startTime, endTime] = request.getQueryTimes();
+    obj["StartTime"] = startTime;
+    obj["EndTime"] = endTime;
+    // Other stuff
+    obj["SamplingRate"] = request.getSamplingRate();
+    obj["GapTolerance"] = request.getGapTolerance().count();
+    obj["Identifier"] = request.getIdentifier();
+    return obj;
+}
+
+ThreeComponentWaveformRequest
+    objectToThreeComponentWaveformRequest(const nlohmann::json &obj)
+{
+    ThreeComponentWaveformRequest request;
+    if (obj["MessageType"] != request.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    // Essential stuff
+    request.setNetwork(obj["Network"].get<std::string> ());
+    request.setStation(obj["Station"].get<std::string> ());
+    request.setVerticalChannel(obj["VerticalChannel"].get<std::string> ());
+    request.setNorthChannel(obj["NorthChannel"].get<std::string> ());
+    request.setEastChannel(obj["EastChannel"].get<std::string> ());
+    request.setLocationCode(obj["LocationCode"].get<std::string> ());
+    auto startTime = obj["StartTime"].get<double> ();
+    auto endTime = obj["EndTime"].get<double> ();
+    request.setQueryTimes(std::pair(startTime, endTime));
+    // Other stuff
+    request.setSamplingRate(obj["SamplingRate"].get<double> ());
+    request.setGapTolerance(
+        std::chrono::microseconds {obj["GapTolerance"].get<int64_t> ()});
+    request.setIdentifier(obj["Identifier"].get<uint64_t> ());
+    return request;
+}
+
+ThreeComponentWaveformRequest fromJSONMessage(const std::string &message)
+{
+    auto obj = nlohmann::json::parse(message);
+    return objectToThreeComponentWaveformRequest(obj);
+}
+
+ThreeComponentWaveformRequest fromCBORMessage(const uint8_t *message,
+                                              const size_t length)
+{
+    auto obj = nlohmann::json::from_cbor(message, message + length);
+    return objectToThreeComponentWaveformRequest(obj);
+}
+
+}
+
+class ThreeComponentWaveformRequest::ThreeComponentWaveformRequestImpl
+{
+public:
+    std::string mNetwork;
+    std::string mStation;
+    std::string mVerticalChannel;
+    std::string mNorthChannel;
+    std::string mEastChannel;
+    std::string mLocationCode;
+    std::chrono::microseconds mGapTolerance{50000};
+    uint64_t mIdentifier{0};
+    double mStartTime{0};
+    double mEndTime{0};
+    double mSamplingRate{100};
+    bool mHaveQueryTimes{false};
+};
+
+/// C'tor
+ThreeComponentWaveformRequest::ThreeComponentWaveformRequest() :
+    pImpl(std::make_unique<ThreeComponentWaveformRequestImpl> ())
+{
+}
+
+/// Copy c'tor
+ThreeComponentWaveformRequest::ThreeComponentWaveformRequest(
+    const ThreeComponentWaveformRequest &request)
+{
+    *this = request;
+}
+
+/// Move c'tor
+ThreeComponentWaveformRequest::ThreeComponentWaveformRequest(
+    ThreeComponentWaveformRequest &&request) noexcept
+{
+    *this = std::move(request);
+}
+
+/// Copy assignment
+ThreeComponentWaveformRequest&
+ThreeComponentWaveformRequest::operator=(
+    const ThreeComponentWaveformRequest &request)
+{
+    if (&request == this){return *this;}
+    pImpl = std::make_unique<ThreeComponentWaveformRequestImpl>
+            (*request.pImpl);
+    return *this;
+}
+
+/// Move assignment
+ThreeComponentWaveformRequest&
+ThreeComponentWaveformRequest::operator=(
+    ThreeComponentWaveformRequest &&request) noexcept
+{
+    if (&request == this){return *this;}
+    pImpl = std::move(request.pImpl);
+    return *this;
+}
+
+/// Reset class
+void ThreeComponentWaveformRequest::clear() noexcept
+{
+    pImpl = std::make_unique<ThreeComponentWaveformRequestImpl> ();
+}
+
+/// Destructor
+ThreeComponentWaveformRequest::~ThreeComponentWaveformRequest() = default;
+
+/// Message type
+std::string ThreeComponentWaveformRequest::getMessageType() const noexcept
+{
+    return MESSAGE_TYPE;
+}
+
+/// Message version
+std::string ThreeComponentWaveformRequest::getMessageVersion() const noexcept
+{
+    return MESSAGE_VERSION;
+}
+
+/// Network
+void ThreeComponentWaveformRequest::setNetwork(const std::string &network)
+{
+    if (::isEmpty(network)){throw std::invalid_argument("Network is empty");}
+    pImpl->mNetwork = network;
+}
+
+std::string ThreeComponentWaveformRequest::getNetwork() const
+{
+    if (!haveNetwork()){throw std::runtime_error("Network not set yet");}
+    return pImpl->mNetwork;
+}
+
+bool ThreeComponentWaveformRequest::haveNetwork() const noexcept
+{
+    return !pImpl->mNetwork.empty();
+}
+
+/// Station
+void ThreeComponentWaveformRequest::setStation(const std::string &station)
+{
+    if (::isEmpty(station)){throw std::invalid_argument("Station is empty");}
+    pImpl->mStation = station;
+}
+
+std::string ThreeComponentWaveformRequest::getStation() const
+{
+    if (!haveStation()){throw std::runtime_error("Station not set yet");}
+    return pImpl->mStation;
+}
+
+bool ThreeComponentWaveformRequest::haveStation() const noexcept
+{
+    return !pImpl->mStation.empty();
+}
+
+/// Vertical channel
+void ThreeComponentWaveformRequest::setVerticalChannel(
+    const std::string &channel)
+{
+    if (::isEmpty(channel))
+    {
+        throw std::invalid_argument("Vertical channel is empty");
+    }
+    pImpl->mVerticalChannel = channel;
+}
+
+std::string ThreeComponentWaveformRequest::getVerticalChannel() const
+{
+    if (!haveVerticalChannel())
+    {
+        throw std::runtime_error("Vertical channel not set yet");
+    }
+    return pImpl->mVerticalChannel;
+}
+
+bool ThreeComponentWaveformRequest::haveVerticalChannel() const noexcept
+{
+    return !pImpl->mVerticalChannel.empty();
+}
+
+/// North channel
+void ThreeComponentWaveformRequest::setNorthChannel(const std::string &channel)
+{
+    if (::isEmpty(channel))
+    {
+        throw std::invalid_argument("North channel is empty");
+    }
+    pImpl->mNorthChannel = channel;
+}
+
+std::string ThreeComponentWaveformRequest::getNorthChannel() const
+{
+    if (!haveNorthChannel())
+    {
+        throw std::runtime_error("North channel not set yet");
+    }
+    return pImpl->mNorthChannel;
+}
+
+bool ThreeComponentWaveformRequest::haveNorthChannel() const noexcept
+{
+    return !pImpl->mNorthChannel.empty();
+}
+
+/// East channel
+void ThreeComponentWaveformRequest::setEastChannel(const std::string &channel)
+{
+    if (::isEmpty(channel))
+    {
+        throw std::invalid_argument("East channel is empty");
+    }
+    pImpl->mEastChannel = channel;
+}
+
+std::string ThreeComponentWaveformRequest::getEastChannel() const
+{
+    if (!haveEastChannel())
+    {
+        throw std::runtime_error("East channel not set yet");
+    }
+    return pImpl->mEastChannel;
+}
+
+bool ThreeComponentWaveformRequest::haveEastChannel() const noexcept
+{
+    return !pImpl->mEastChannel.empty();
+}
+
+/// Location code
+void ThreeComponentWaveformRequest::setLocationCode(
+    const std::string &location)
+{
+    if (::isEmpty(location)){throw std::invalid_argument("location is empty");}
+    pImpl->mLocationCode = location;
+}
+
+std::string ThreeComponentWaveformRequest::getLocationCode() const
+{
+    if (!haveLocationCode())
+    {
+        throw std::runtime_error("Location code not set yet");
+    }
+    return pImpl->mLocationCode;
+}
+
+bool ThreeComponentWaveformRequest::haveLocationCode() const noexcept
+{
+    return !pImpl->mLocationCode.empty();
+}
+
+/// Start/end times
+void ThreeComponentWaveformRequest::setQueryTimes(
+    const std::pair<double, double> &times)
+{
+    if (times.first >= times.second)
+    {
+        throw std::invalid_argument("times.first = "
+                                   + std::to_string(times.first)
+                                   + " must be less than time.second = "
+                                   + std::to_string(times.second));
+    }
+    pImpl->mStartTime = times.first;
+    pImpl->mEndTime = times.second;
+    pImpl->mHaveQueryTimes = true;
+}
+
+std::pair<double, double> ThreeComponentWaveformRequest::getQueryTimes() const
+{
+    if (!haveQueryTimes()){throw std::runtime_error("Query times not set");}
+    return std::pair(pImpl->mStartTime, pImpl->mEndTime);
+}
+
+bool ThreeComponentWaveformRequest::haveQueryTimes() const noexcept
+{
+    return pImpl->mHaveQueryTimes;
+}
+
+/// Sampling rate
+void ThreeComponentWaveformRequest::setSamplingRate(const double samplingRate)
+{
+    if (samplingRate <= 0)
+    {
+        throw std::invalid_argument("Sampling rate must be positive");
+    }
+    pImpl->mSamplingRate = samplingRate;
+}
+
+double ThreeComponentWaveformRequest::getSamplingRate() const noexcept
+{
+    return pImpl->mSamplingRate;
+}
+
+/// Gap tolerance
+void ThreeComponentWaveformRequest::setGapTolerance(
+    const std::chrono::microseconds &gapTolerance) noexcept
+{
+    pImpl->mGapTolerance = gapTolerance;
+}
+
+std::chrono::microseconds
+ThreeComponentWaveformRequest::getGapTolerance() const noexcept
+{
+    return pImpl->mGapTolerance;
+}
+
+/// Identifier
+void ThreeComponentWaveformRequest::setIdentifier(
+    const uint64_t identifier) noexcept
+{
+    pImpl->mIdentifier = identifier;
+}
+
+uint64_t ThreeComponentWaveformRequest::getIdentifier() const noexcept
+{
+    return pImpl->mIdentifier;
+}
+
+/// Create JSON
+std::string ThreeComponentWaveformRequest::toJSON(const int nIndent) const
+{
+    auto obj = toJSONObject(*this);
+    return obj.dump(nIndent);
+}
+
+/// Create CBOR
+std::string ThreeComponentWaveformRequest::toCBOR() const
+{
+    auto obj = toJSONObject(*this);
+    auto v = nlohmann::json::to_cbor(obj);
+    std::string result(v.begin(), v.end());
+    return result;
+}
+
+/// From JSON
+void ThreeComponentWaveformRequest::fromJSON(const std::string &message)
+{
+    *this = fromJSONMessage(message);
+}
+
+/// From CBOR
+void ThreeComponentWaveformRequest::fromCBOR(const std::string &data)
+{
+    fromCBOR(reinterpret_cast<const uint8_t *> (data.data()), data.size());
+}
+
+void ThreeComponentWaveformRequest::fromCBOR(const uint8_t *data,
+                                             const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr)
+    {
+        throw std::invalid_argument("data is NULL");
+    }
+    *this = fromCBORMessage(data, length);
+}
+
+///  Convert message
+std::string ThreeComponentWaveformRequest::toMessage() const
+{
+    return toCBOR();
+}
+
+void ThreeComponentWaveformRequest::fromMessage(const std::string &message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    fromMessage(message.data(), message.size());
+}
+
+void ThreeComponentWaveformRequest::fromMessage(const char *messageIn,
+                                                const size_t length)
+{
+    auto message = reinterpret_cast<const uint8_t *> (messageIn);
+    fromCBOR(message, length);
+}
+
+/// Copy this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    ThreeComponentWaveformRequest::clone() const
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<ThreeComponentWaveformRequest> (*this);
+    return result;
+}
+
+/// Create an instance of this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    ThreeComponentWaveformRequest::createInstance() const noexcept
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<ThreeComponentWaveformRequest> ();
+    return result;
+}
@@ -0,0 +1,437 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
+#include "private/cborWriter.hpp"
+
+#define MESSAGE_TYPE "URTS::Services::Scalable::PacketCache::ThreeComponentWaveformResponse"
+#define MESSAGE_VERSION "1.0.0"
+
+using namespace URTS::Services::Scalable::PacketCache;
+
+namespace
+{
+
+/// The interpolated signals.  These are immutable once set so that copies
+/// of a response, e.g., the packet cache's memoized responses, can share them.
+struct Signals
+{
+    std::vector<double> mVertical;
+    std::vector<double> mNorth;
+    std::vector<double> mEast;
+    std::vector<int8_t> mGapIndicator;
+};
+
+const std::vector<double> EMPTY_SIGNAL;
+const std::vector<int8_t> EMPTY_GAP_INDICATOR;
+
+nlohmann::json toJSONObject(const ThreeComponentWaveformResponse &response)
+{
+    nlohmann::json obj;
+    obj["MessageType"] = response.getMessageType();
+    obj["MessageVersion"] = response.getMessageVersion();
+    obj["StartTime"] = response.getStartTime().count();
+    obj["SamplingRate"] = response.getSamplingRate();
+    if (response.getNumberOfSamples() > 0)
+    {
+        obj["VerticalSignal"] = response.getVerticalSignalReference();
+        obj["NorthSignal"] = response.getNorthSignalReference();
+        obj["EastSignal"] = response.getEastSignalReference();
+        obj["GapIndicator"] = response.getGapIndicatorReference();
+    }
+    else
+    {
+        obj["VerticalSignal"] = nullptr;
+        obj["NorthSignal"] = nullptr;
+        obj["EastSignal"] = nullptr;
+        obj["GapIndicator"] = nullptr;
+    }
+    obj["Identifier"] = response.getIdentifier();
+    obj["ReturnCode"] = static_cast<int> (response.getReturnCode());
+    return obj;
+}
+
+ThreeComponentWaveformResponse
+    objectToThreeComponentWaveformResponse(const nlohmann::json &obj)
+{
+    ThreeComponentWaveformResponse response;
+    if (obj["MessageType"] != response.getMessageType())
+    {
+        throw std::invalid_argument("Message has invalid message type");
+    }
+    response.setStartTime(
+        std::chrono::microseconds {obj["StartTime"].get<int64_t> ()});
+    response.setSamplingRate(obj["SamplingRate"].get<double> ());
+    if (!obj["VerticalSignal"].is_null())
+    {
+        // The gap indicator is a byte string in CBOR and an array in JSON
+        std::vector<int8_t> gapIndicator;
+        const auto &gapObject = obj["GapIndicator"];
+        if (gapObject.is_binary())
+        {
+            const auto &bytes = gapObject.get_binary();
+            gapIndicator.resize(bytes.size());
+            std::copy(bytes.begin(), bytes.end(), gapIndicator.begin());
+        }
+        else
+        {
+            gapIndicator = gapObject.get<std::vector<int8_t>> ();
+        }
+        response.setSignals(obj["VerticalSignal"].get<std::vector<double>> (),
+                            obj["NorthSignal"].get<std::vector<double>> (),
+                            obj["EastSignal"].get<std::vector<double>> (),
+                            std::move(gapIndicator));
+    }
+    response.setIdentifier(obj["Identifier"].get<uint64_t> ());
+    response.setReturnCode(
+        static_cast<ThreeComponentWaveformResponse::ReturnCode>
+        (obj["ReturnCode"].get<int> ()));
+    return response;
+}
+
+ThreeComponentWaveformResponse fromJSONMessage(const std::string &message)
+{
+    auto obj = nlohmann::json::parse(message);
+    return objectToThreeComponentWaveformResponse(obj);
+}
+
+ThreeComponentWaveformResponse fromCBORMessage(const uint8_t *message,
+                                               const size_t length)
+{
+    auto obj = nlohmann::json::from_cbor(message, message + length);
+    return objectToThreeComponentWaveformResponse(obj);
+}
+
+}
+
+class ThreeComponentWaveformResponse::ThreeComponentWaveformResponseImpl
+{
+public:
+    std::shared_ptr<const ::Signals> mSignals{nullptr};
+    std::chrono::microseconds mStartTime{0};
+    uint64_t mIdentifier{0};
+    double mSamplingRate{100};
+    ReturnCode mReturnCode{ReturnCode::Success};
+};
+
+/// C'tor
+ThreeComponentWaveformResponse::ThreeComponentWaveformResponse() :
+    pImpl(std::make_unique<ThreeComponentWaveformResponseImpl> ())
+{
+}
+
+/// Copy c'tor
+ThreeComponentWaveformResponse::ThreeComponentWaveformResponse(
+    const ThreeComponentWaveformResponse &response)
+{
+    *this = response;
+}
+
+/// Move c'tor
+ThreeComponentWaveformResponse::ThreeComponentWaveformResponse(
+    ThreeComponentWaveformResponse &&response) noexcept
+{
+    *this = std::move(response);
+}
+
+/// Copy assignment.  The signals are shared.
+ThreeComponentWaveformResponse&
+ThreeComponentWaveformResponse::operator=(
+    const ThreeComponentWaveformResponse &response)
+{
+    if (&response == this){return *this;}
+    pImpl = std::make_unique<ThreeComponentWaveformResponseImpl>
+            (*response.pImpl);
+    return *this;
+}
+
+/// Move assignment
+ThreeComponentWaveformResponse&
+ThreeComponentWaveformResponse::operator=(
+    ThreeComponentWaveformResponse &&response) noexcept
+{
+    if (&response == this){return *this;}
+    pImpl = std::move(response.pImpl);
+    return *this;
+}
+
+/// Reset class
+void ThreeComponentWaveformResponse::clear() noexcept
+{
+    pImpl = std::make_unique<ThreeComponentWaveformResponseImpl> ();
+}
+
+/// Destructor
+ThreeComponentWaveformResponse::~ThreeComponentWaveformResponse() = default;
+
+/// Message type
+std::string ThreeComponentWaveformResponse::getMessageType() const noexcept
+{
+    return MESSAGE_TYPE;
+}
+
+/// Message version
+std::string ThreeComponentWaveformResponse::getMessageVersion() const noexcept
+{
+    return MESSAGE_VERSION;
+}
+
+/// Signals
+void ThreeComponentWaveformResponse::setSignals(
+    const std::vector<double> &verticalSignal,
+    const std::vector<double> &northSignal,
+    const std::vector<double> &eastSignal,
+    const std::vector<int8_t> &gapIndicator)
+{
+    auto verticalWork = verticalSignal;
+    auto northWork = northSignal;
+    auto eastWork = eastSignal;
+    auto gapIndicatorWork = gapIndicator;
+    setSignals(std::move(verticalWork),
+               std::move(northWork),
+               std::move(eastWork),
+               std::move(gapIndicatorWork));
+}
+
+void ThreeComponentWaveformResponse::setSignals(
+    std::vector<double> &&verticalSignal,
+    std::vector<double> &&northSignal,
+    std::vector<double> &&eastSignal,
+    std::vector<int8_t> &&gapIndicator)
+{
+    if (verticalSignal.size() != northSignal.size() ||
+        verticalSignal.size() != eastSignal.size())
+    {
+        throw std::invalid_argument("Signals have different lengths");
+    }
+    if (verticalSignal.size() != gapIndicator.size())
+    {
+        throw std::invalid_argument(
+            "Gap indicator and signals have different lengths");
+    }
+    auto signals = std::make_shared<::Signals> ();
+    signals->mVertical = std::move(verticalSignal);
+    signals->mNorth = std::move(northSignal);
+    signals->mEast = std::move(eastSignal);
+    signals->mGapIndicator = std::move(gapIndicator);
+    pImpl->mSignals = std::move(signals);
+}
+
+int ThreeComponentWaveformResponse::getNumberOfSamples() const noexcept
+{
+    if (pImpl->mSignals == nullptr){return 0;}
+    return static_cast<int> (pImpl->mSignals->mVertical.size());
+}
+
+const std::vector<double>
+    &ThreeComponentWaveformResponse::getVerticalSignalReference() const noexcept
+{
+    if (pImpl->mSignals == nullptr){return ::EMPTY_SIGNAL;}
+    return pImpl->mSignals->mVertical;
+}
+
+const std::vector<double>
+    &ThreeComponentWaveformResponse::getNorthSignalReference() const noexcept
+{
+    if (pImpl->mSignals == nullptr){return ::EMPTY_SIGNAL;}
+    return pImpl->mSignals->mNorth;
+}
+
+const std::vector<double>
+    &ThreeComponentWaveformResponse::getEastSignalReference() const noexcept
+{
+    if (pImpl->mSignals == nullptr){return ::EMPTY_SIGNAL;}
+    return pImpl->mSignals->mEast;
+}
+
+const std::vector<int8_t>
+    &ThreeComponentWaveformResponse::getGapIndicatorReference() const noexcept
+{
+    if (pImpl->mSignals == nullptr){return ::EMPTY_GAP_INDICATOR;}
+    return pImpl->mSignals->mGapIndicator;
+}
+
+bool ThreeComponentWaveformResponse::haveGaps() const noexcept
+{
+    const auto &gapIndicator = getGapIndicatorReference();
+    return std::any_of(gapIndicator.begin(), gapIndicator.end(),
+                       [](const int8_t gap){return gap != 0;});
+}
+
+/// Start time
+void ThreeComponentWaveformResponse::setStartTime(
+    const std::chrono::microseconds &startTime) noexcept
+{
+    pImpl->mStartTime = startTime;
+}
+
+std::chrono::microseconds
+    ThreeComponentWaveformResponse::getStartTime() const noexcept
+{
+    return pImpl->mStartTime;
+}
+
+/// End time
+std::chrono::microseconds ThreeComponentWaveformResponse::getEndTime() const
+{
+    auto nSamples = getNumberOfSamples();
+    if (nSamples < 1){throw std::runtime_error("No samples");}
+    auto duration
+        = std::round(((nSamples - 1)/pImpl->mSamplingRate)*1000000);
+    return pImpl->mStartTime
+         + std::chrono::microseconds {static_cast<int64_t> (duration)};
+}
+
+/// Sampling rate
+void ThreeComponentWaveformResponse::setSamplingRate(const double samplingRate)
+{
+    if (samplingRate <= 0)
+    {
+        throw std::invalid_argument("Sampling rate must be positive");
+    }
+    pImpl->mSamplingRate = samplingRate;
+}
+
+double ThreeComponentWaveformResponse::getSamplingRate() const noexcept
+{
+    return pImpl->mSamplingRate;
+}
+
+/// Return code
+void ThreeComponentWaveformResponse::setReturnCode(
+    const ReturnCode code) noexcept
+{
+    pImpl->mReturnCode = code;
+}
+
+ThreeComponentWaveformResponse::ReturnCode
+    ThreeComponentWaveformResponse::getReturnCode() const noexcept
+{
+    return pImpl->mReturnCode;
+}
+
+/// Identifier
+void ThreeComponentWaveformResponse::setIdentifier(
+    const uint64_t identifier) noexcept
+{
+    pImpl->mIdentifier = identifier;
+}
+
+uint64_t ThreeComponentWaveformResponse::getIdentifier() const noexcept
+{
+    return pImpl->mIdentifier;
+}
+
+/// Create JSON
+std::string ThreeComponentWaveformResponse::toJSON(const int nIndent) const
+{
+    auto obj = toJSONObject(*this);
+    return obj.dump(nIndent);
+}
+
+/// Create CBOR.  This is written directly from the signals.
+std::string ThreeComponentWaveformResponse::toCBOR() const
+{
+    auto nSamples = static_cast<size_t> (getNumberOfSamples());
+    std::string result;
+    result.reserve(512 + 28*nSamples);
+    CBORWriter writer(&result);
+    writer.startMap(10);
+    writer.write("MessageType");
+    writer.write(getMessageType());
+    writer.write("MessageVersion");
+    writer.write(getMessageVersion());
+    writer.write("StartTime");
+    writer.write(static_cast<int64_t> (getStartTime().count()));
+    writer.write("SamplingRate");
+    writer.write(getSamplingRate());
+    writer.write("VerticalSignal");
+    if (nSamples > 0)
+    {
+        writer.write(getVerticalSignalReference().data(), nSamples);
+        writer.write("NorthSignal");
+        writer.write(getNorthSignalReference().data(), nSamples);
+        writer.write("EastSignal");
+        writer.write(getEastSignalReference().data(), nSamples);
+        writer.write("GapIndicator");
+        writer.writeBytes(getGapIndicatorReference().data(), nSamples);
+    }
+    else
+    {
+        writer.writeNull();
+        writer.write("NorthSignal");
+        writer.writeNull();
+        writer.write("EastSignal");
+        writer.writeNull();
+        writer.write("GapIndicator");
+        writer.writeNull();
+    }
+    writer.write("Identifier");
+    writer.write(static_cast<uint64_t> (getIdentifier()));
+    writer.write("ReturnCode");
+    writer.write(static_cast<int> (getReturnCode()));
+    return result;
+}
+
+/// From JSON
+void ThreeComponentWaveformResponse::fromJSON(const std::string &message)
+{
+    *this = fromJSONMessage(message);
+}
+
+/// From CBOR
+void ThreeComponentWaveformResponse::fromCBOR(const std::string &data)
+{
+    fromCBOR(reinterpret_cast<const uint8_t *> (data.data()), data.size());
+}
+
+void ThreeComponentWaveformResponse::fromCBOR(const uint8_t *data,
+                                              const size_t length)
+{
+    if (length == 0){throw std::invalid_argument("No data");}
+    if (data == nullptr)
+    {
+        throw std::invalid_argument("data is NULL");
+    }
+    *this = fromCBORMessage(data, length);
+}
+
+///  Convert message
+std::string ThreeComponentWaveformResponse::toMessage() const
+{
+    return toCBOR();
+}
+
+void ThreeComponentWaveformResponse::fromMessage(const std::string &message)
+{
+    if (message.empty()){throw std::invalid_argument("Message is empty");}
+    fromMessage(message.data(), message.size());
+}
+
+void ThreeComponentWaveformResponse::fromMessage(const char *messageIn,
+                                                 const size_t length)
+{
+    auto message = reinterpret_cast<const uint8_t *> (messageIn);
+    fromCBOR(message, length);
+}
+
+/// Copy this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    ThreeComponentWaveformResponse::clone() const
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<ThreeComponentWaveformResponse> (*this);
+    return result;
+}
+
+/// Create an instance of this class
+std::unique_ptr<UMPS::MessageFormats::IMessage>
+    ThreeComponentWaveformResponse::createInstance() const noexcept
+{
+    std::unique_ptr<UMPS::MessageFormats::IMessage> result
+        = std::make_unique<ThreeComponentWaveformResponse> ();
+    return result;
+}
@@ -2,6 +2,7 @@
 #define PRIVATE_SERVICES_SCALABLE_PACKET_CACHE_UTILITIES_HPP
 #ifdef URTS_SRC
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <cmath>
 #include <numeric>
@@ -41,6 +42,25 @@ std::string makeName(
                     packet.getChannel(), packet.getLocationCode());
 
 }
+/// @result True indicates the packet's name is the given name.  Unlike
+///         comparing to makeName(packet), this does not allocate.
+[[maybe_unused]] [[nodiscard]]
+bool haveName(const URTS::Broadcasts::Internal::DataPacket::DataPacket &packet,
+              std::string_view name)
+{
+    for (const auto *part : {&packet.getNetwork(), &packet.getStation(),
+                             &packet.getChannel(), &packet.getLocationCode()})
+    {
+        if (name.substr(0, part->size()) != *part){return false;}
+        name.remove_prefix(part->size());
+        if (part != &packet.getLocationCode())
+        {
+            if (name.empty() || name.front() != '.'){return false;}
+            name.remove_prefix(1);
+        }
+    }
+    return name.empty();
+}
 /// @result True indicates all necessary information to set a data packet
 ///         in the circular buffer is present.
 [[maybe_unused]] [[nodiscard]]
@@ -3,6 +3,7 @@
 #include <cstdbool>
 #include <algorithm>
 #include "urts/services/scalable/packetCache/wigginsInterpolator.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include "wiggins.hpp"
 
@@ -139,7 +140,17 @@ void fillGapPointer(const size_t nNewSamples,
         }
     }
 }
-                
+
+[[nodiscard]] bool haveSamplingRate(const UDP::DataPacket &packet) noexcept
+{
+    return packet.haveSamplingRate();
+}
+
+[[nodiscard]] bool haveSamplingRate(const PacketView &packet) noexcept
+{
+    return packet.getSamplingRate() > 0;
+}
+
 }
 
 class WigginsInterpolator::WigginsInterpolatorImpl
@@ -153,6 +164,176 @@ public:
         mEndTime = std::chrono::microseconds{0};
         mHaveGaps = false;
     }
+    /// Interpolates data packets or packet views
+    template<typename T>
+    void interpolate(
+        const int nPackets, const T packets[],
+        const std::chrono::microseconds &desiredInterpolationStartTime,
+        const std::chrono::microseconds &desiredInterpolationEndTime)
+    {
+        clearSignal();
+        if (nPackets < 1){return;} // Nothing to do
+        if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
+        if (desiredInterpolationStartTime > desiredInterpolationEndTime)
+        {
+            throw std::invalid_argument(
+                "Desired interpolation start time exceeds end time");
+        }
+        // Do all packets have sampling rates
+        for (int ip = 0; ip < nPackets; ++ip)
+        {
+            if (!::haveSamplingRate(packets[ip]))
+            {
+                throw std::invalid_argument(
+                   "Sampling rate must be set for all packets");
+            }
+        }
+        // Is there data?
+        std::vector<int> packetSamplePtr(nPackets + 1);
+        int nSamples = 0;
+        packetSamplePtr[0] = 0;
+        for (int iPacket = 0; iPacket < nPackets; ++iPacket)
+        {
+            nSamples = nSamples + packets[iPacket].getNumberOfSamples();
+            packetSamplePtr[iPacket + 1] = nSamples;
+        }
+        if (nSamples < 1)
+        {
+            throw std::invalid_argument("No samples in packets");
+        }
+        if (nSamples < 2)
+        {
+            throw std::invalid_argument("At least two samples required");
+        }
+        // Are the packets in order?
+        auto isSorted
+            = std::is_sorted(packets, packets + nPackets,
+                             [](const T &lhs, const T &rhs)
+                             {
+                                return lhs.getEndTime() < rhs.getStartTime();
+                             });
+        // Create abscissas and values at abscissas
+        std::vector<double> data(nSamples);
+        std::vector<int64_t> times(nSamples);
+        std::vector<std::pair<int64_t, int64_t>> startEndTimes;
+        startEndTimes.reserve(nPackets);
+        for (int iPacket = 0; iPacket < nPackets; ++iPacket)
+        {   
+            const auto *__restrict__ dataPtr = packets[iPacket].getDataPointer();
+            auto i0 = packetSamplePtr[iPacket];
+            auto i1 = packetSamplePtr[iPacket + 1]; // Exclusive
+            auto nSamplesInPacket = i1 - i0; 
+            if (nSamplesInPacket > 0)
+            {
+                std::copy(dataPtr, dataPtr + nSamplesInPacket, &data[i0]);
+                auto samplingRate = packets[iPacket].getSamplingRate();
+                auto samplingPeriodMicroSeconds
+                    = static_cast<double> (1000000./samplingRate);
+                auto t0 = packets[iPacket].getStartTime().count();
+                auto t1 = packets[iPacket].getEndTime().count();
+                startEndTimes.push_back(std::pair{t0, t1});
+                auto *__restrict__ timesPtr = &times[i0];
+                for (int i = 0; i < nSamplesInPacket; ++i)
+                {
+                    timesPtr[i] = t0 + i*samplingPeriodMicroSeconds;
+                }
+            }
+        }
+        // Create the interpolation times
+        int64_t time0, time1;
+        if (isSorted)
+        {
+            time0 = times.front();
+            time1 = times.back();
+        }
+        else
+        {
+            auto tMinMax = std::minmax_element(times.begin(), times.end());
+            time0 = *tMinMax.first;
+            time1 = *tMinMax.second;
+        }
+        if (desiredInterpolationStartTime.count() > time0 &&
+            desiredInterpolationStartTime.count() < time1)
+        {
+
+        }
+        // Prevent user from trying to start interpolation after signal ends
+        if (desiredInterpolationStartTime.count() < time1)
+        {
+            time0 = std::max(time0, desiredInterpolationStartTime.count());
+        }
+        // Prevent user from trying to end interpolation before signal starts
+        if (desiredInterpolationEndTime.count() >= time0)
+        {
+            time1 = std::min(time1, desiredInterpolationEndTime.count()); 
+        }
+        auto targetSamplingRate = mTargetSamplingRate;
+        auto targetSamplingPeriodMicroSeconds
+            = static_cast<int64_t> (std::round(1000000./targetSamplingRate));
+        auto spaceEstimate
+            = static_cast<int>
+              (std::round((time1 - time0)
+                         /static_cast<double> (targetSamplingPeriodMicroSeconds)));
+        std::vector<int64_t> timesToEvaluate;
+        // Now figure out the actual end time.  The idea is after the space estimate
+        // to start the next loop definitely before the end of the desired 
+        // interpolation time.  When we exceed that desired time we call it a day
+        // and break.  Barring weird overflow, we won't spend much time in this
+        // loop.
+        int nNewSamples = spaceEstimate - 1;
+        while (true)
+        {
+            auto interpolationTime
+                = time0 + nNewSamples*targetSamplingPeriodMicroSeconds;
+            if (interpolationTime > time1){break;}
+            nNewSamples = nNewSamples + 1;
+        }
+        nNewSamples = std::max(nNewSamples, 1); // Interpolate at `start point'
+        // Fill the interpolation times 
+        timesToEvaluate.resize(nNewSamples);
+        auto *__restrict__ timesToEvaluatePtr = timesToEvaluate.data();
+        for (int i = 0; i < nNewSamples; ++i)
+        {
+            timesToEvaluatePtr[i] = time0 + i*targetSamplingPeriodMicroSeconds;
+        }
+    #ifndef NDEBUG
+        assert(timesToEvaluate.front() >= time0);
+        assert(timesToEvaluate.back() <= time1);
+        assert(timesToEvaluate.front() <= timesToEvaluate.back());
+    #endif
+        /* 
+        // A very crude way to do this
+        timesToEvaluate.reserve(std::max(1, spaceEstimate));
+        int i = 0;
+        while (true)
+        {
+           auto interpolationTime = time0 + i*targetSamplingPeriodMicroSeconds;
+           if (interpolationTime > time1){break;}
+           timesToEvaluate.push_back(interpolationTime);
+           i = i + 1;
+        }
+        */
+        // Package into the result
+        auto checkSorting = !isSorted;
+        mSignal = ::weightedAverageSlopes(times, data, timesToEvaluate,
+                                                 checkSorting);
+        if (!mSignal.empty())
+        {
+            auto nNewSamples = mSignal.size(); 
+            mStartTime = std::chrono::microseconds{time0};
+            mEndTime   = std::chrono::microseconds{timesToEvaluate.back()}; 
+            // Perform gap check
+            auto gapStartEnd = ::createGapStartEnd(mGapTolerance.count(),
+                                                   startEndTimes,
+                                                   isSorted);
+            ::fillGapPointer(nNewSamples,
+                             targetSamplingPeriodMicroSeconds,
+                             timesToEvaluate,
+                             gapStartEnd,
+                             &mGapIndicator,
+                             &mHaveGaps);
+        }
+    }
     std::vector<double> mSignal;
     std::vector<int8_t> mGapIndicator;
     double mTargetSamplingRate{100};
@@ -257,172 +438,26 @@ void WigginsInterpolator::interpolate(
 
 void WigginsInterpolator::interpolate(
     const int nPackets, const UDP::DataPacket packets[],
-    const std::chrono::microseconds &desiredInterpolationStartTime,
-    const std::chrono::microseconds &desiredInterpolationEndTime)
+    const std::chrono::microseconds &startTime,
+    const std::chrono::microseconds &endTime)
 {
-    clearSignal();
-    if (nPackets < 1){return;} // Nothing to do
-    if (packets == nullptr){throw std::invalid_argument("packets is NULL");}
-    if (desiredInterpolationStartTime > desiredInterpolationEndTime)
-    {
-        throw std::invalid_argument(
-            "Desired interpolation start time exceeds end time");
-    }
-    // Do all packets have sampling rates
-    for (int ip = 0; ip < nPackets; ++ip)
-    {
-        if (!packets[ip].haveSamplingRate())
-        {
-            throw std::invalid_argument(
-               "Sampling rate must be set for all packets");
-        }
-    }
-    // Is there data?
-    std::vector<int> packetSamplePtr(nPackets + 1);
-    int nSamples = 0;
-    packetSamplePtr[0] = 0;
-    for (int iPacket = 0; iPacket < nPackets; ++iPacket)
-    {
-        nSamples = nSamples + packets[iPacket].getNumberOfSamples();
-        packetSamplePtr[iPacket + 1] = nSamples;
-    }
-    if (nSamples < 1)
-    {
-        throw std::invalid_argument("No samples in packets");
-    }
-    if (nSamples < 2)
-    {
-        throw std::invalid_argument("At least two samples required");
-    }
-    // Are the packets in order?
-    auto isSorted
-        = std::is_sorted(packets, packets + nPackets,
-                         [](const UDP::DataPacket &lhs,
-                            const UDP::DataPacket &rhs)
-                         {
-                            return lhs.getEndTime() < rhs.getStartTime();
-                         });
-    // Create abscissas and values at abscissas
-    std::vector<double> data(nSamples);
-    std::vector<int64_t> times(nSamples);
-    std::vector<std::pair<int64_t, int64_t>> startEndTimes;
-    startEndTimes.reserve(nPackets);
-    for (int iPacket = 0; iPacket < nPackets; ++iPacket)
-    {   
-        const auto *__restrict__ dataPtr = packets[iPacket].getDataPointer();
-        auto i0 = packetSamplePtr[iPacket];
-        auto i1 = packetSamplePtr[iPacket + 1]; // Exclusive
-        auto nSamplesInPacket = i1 - i0; 
-        if (nSamplesInPacket > 0)
-        {
-            std::copy(dataPtr, dataPtr + nSamplesInPacket, &data[i0]);
-            auto samplingRate = packets[iPacket].getSamplingRate();
-            auto samplingPeriodMicroSeconds
-                = static_cast<double> (1000000./samplingRate);
-            auto t0 = packets[iPacket].getStartTime().count();
-            auto t1 = packets[iPacket].getEndTime().count();
-            startEndTimes.push_back(std::pair{t0, t1});
-            auto *__restrict__ timesPtr = &times[i0];
-            for (int i = 0; i < nSamplesInPacket; ++i)
-            {
-                timesPtr[i] = t0 + i*samplingPeriodMicroSeconds;
-            }
-        }
-    }
-    // Create the interpolation times
-    int64_t time0, time1;
-    if (isSorted)
-    {
-        time0 = times.front();
-        time1 = times.back();
-    }
-    else
-    {
-        auto tMinMax = std::minmax_element(times.begin(), times.end());
-        time0 = *tMinMax.first;
-        time1 = *tMinMax.second;
-    }
-    if (desiredInterpolationStartTime.count() > time0 &&
-        desiredInterpolationStartTime.count() < time1)
-    {
+    pImpl->interpolate(nPackets, packets, startTime, endTime);
+}
 
-    }
-    // Prevent user from trying to start interpolation after signal ends
-    if (desiredInterpolationStartTime.count() < time1)
-    {
-        time0 = std::max(time0, desiredInterpolationStartTime.count());
-    }
-    // Prevent user from trying to end interpolation before signal starts
-    if (desiredInterpolationEndTime.count() >= time0)
-    {
-        time1 = std::min(time1, desiredInterpolationEndTime.count()); 
-    }
-    auto targetSamplingRate = pImpl->mTargetSamplingRate;
-    auto targetSamplingPeriodMicroSeconds
-        = static_cast<int64_t> (std::round(1000000./targetSamplingRate));
-    auto spaceEstimate
-        = static_cast<int>
-          (std::round((time1 - time0)
-                     /static_cast<double> (targetSamplingPeriodMicroSeconds)));
-    std::vector<int64_t> timesToEvaluate;
-    // Now figure out the actual end time.  The idea is after the space estimate
-    // to start the next loop definitely before the end of the desired 
-    // interpolation time.  When we exceed that desired time we call it a day
-    // and break.  Barring weird overflow, we won't spend much time in this
-    // loop.
-    int nNewSamples = spaceEstimate - 1;
-    while (true)
-    {
-        auto interpolationTime
-            = time0 + nNewSamples*targetSamplingPeriodMicroSeconds;
-        if (interpolationTime > time1){break;}
-        nNewSamples = nNewSamples + 1;
-    }
-    nNewSamples = std::max(nNewSamples, 1); // Interpolate at `start point'
-    // Fill the interpolation times 
-    timesToEvaluate.resize(nNewSamples);
-    auto *__restrict__ timesToEvaluatePtr = timesToEvaluate.data();
-    for (int i = 0; i < nNewSamples; ++i)
-    {
-        timesToEvaluatePtr[i] = time0 + i*targetSamplingPeriodMicroSeconds;
-    }
-#ifndef NDEBUG
-    assert(timesToEvaluate.front() >= time0);
-    assert(timesToEvaluate.back() <= time1);
-    assert(timesToEvaluate.front() <= timesToEvaluate.back());
-#endif
-    /* 
-    // A very crude way to do this
-    timesToEvaluate.reserve(std::max(1, spaceEstimate));
-    int i = 0;
-    while (true)
-    {
-       auto interpolationTime = time0 + i*targetSamplingPeriodMicroSeconds;
-       if (interpolationTime > time1){break;}
-       timesToEvaluate.push_back(interpolationTime);
-       i = i + 1;
-    }
-    */
-    // Package into the result
-    auto checkSorting = !isSorted;
-    pImpl->mSignal = ::weightedAverageSlopes(times, data, timesToEvaluate,
-                                             checkSorting);
-    if (!pImpl->mSignal.empty())
-    {
-        auto nNewSamples = pImpl->mSignal.size(); 
-        pImpl->mStartTime = std::chrono::microseconds{time0};
-        pImpl->mEndTime   = std::chrono::microseconds{timesToEvaluate.back()}; 
-        // Perform gap check
-        auto gapStartEnd = ::createGapStartEnd(pImpl->mGapTolerance.count(),
-                                               startEndTimes,
-                                               isSorted);
-        ::fillGapPointer(nNewSamples,
-                         targetSamplingPeriodMicroSeconds,
-                         timesToEvaluate,
-                         gapStartEnd,
-                         &pImpl->mGapIndicator,
-                         &pImpl->mHaveGaps);
-    }
+void WigginsInterpolator::interpolate(
+    const std::vector<PacketView> &packets,
+    const std::chrono::microseconds &startTime,
+    const std::chrono::microseconds &endTime)
+{
+    interpolate(packets.size(), packets.data(), startTime, endTime);
+}
+
+void WigginsInterpolator::interpolate(
+    const int nPackets, const PacketView packets[],
+    const std::chrono::microseconds &startTime,
+    const std::chrono::microseconds &endTime)
+{
+    pImpl->interpolate(nPackets, packets, startTime, endTime);
 }
 
 // Get signal
@@ -0,0 +1,183 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <benchmark/benchmark.h>
+#include "urts/services/scalable/packetCache/cappedCollection.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+
+namespace
+{
+
+using namespace URTS::Services::Scalable::PacketCache;
+namespace UDP = URTS::Broadcasts::Internal::DataPacket;
+
+constexpr int N_CHANNELS{1500};
+constexpr int N_PACKETS{60};
+constexpr int N_SAMPLES_PER_PACKET{100};
+constexpr double SAMPLING_RATE{100};
+constexpr std::chrono::microseconds PACKET_DURATION{1000000};
+constexpr int N_COMPRESSION_CHANNELS{100};
+
+std::string makeStation(const int i)
+{
+    return "S" + std::to_string(i);
+}
+
+UDP::DataPacket makePacket(const int iChannel,
+                           const std::chrono::microseconds &startTime)
+{
+    UDP::DataPacket packet;
+    packet.setNetwork("UU");
+    packet.setStation(makeStation(iChannel));
+    packet.setChannel("HHZ");
+    packet.setLocationCode("01");
+    packet.setSamplingRate(SAMPLING_RATE);
+    packet.setStartTime(startTime);
+    std::vector<double> data(N_SAMPLES_PER_PACKET, iChannel);
+    packet.setData(std::move(data));
+    return packet;
+}
+
+/// A collection filled with N_PACKETS seconds of data on N_CHANNELS.
+CappedCollection &getCollection()
+{
+    static CappedCollection collection;
+    if (!collection.isInitialized())
+    {
+        collection.initialize(N_PACKETS);
+        for (int iPacket = 0; iPacket < N_PACKETS; ++iPacket)
+        {
+            for (int iChannel = 0; iChannel < N_CHANNELS; ++iChannel)
+            {
+                collection.addPacket(makePacket(iChannel,
+                                                iPacket*PACKET_DURATION));
+            }
+        }
+    }
+    return collection;
+}
+
+std::vector<std::string> getNames()
+{
+    std::vector<std::string> names;
+    names.reserve(N_CHANNELS);
+    for (int i = 0; i < N_CHANNELS; ++i)
+    {
+        names.push_back("UU." + makeStation(i) + ".HHZ.01");
+    }
+    return names;
+}
+
+/// Queries the last 10 seconds of a random channel.
+void query(const CappedCollection &collection,
+           const std::vector<std::string> &names, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<int> distribution(0, N_CHANNELS - 1);
+    constexpr std::chrono::microseconds t1{N_PACKETS*PACKET_DURATION};
+    constexpr std::chrono::microseconds t0{t1 - 10*PACKET_DURATION};
+    const auto &name = names[distribution(generator)];
+    auto packets = collection.getPackets(name, t0, t1);
+    benchmark::DoNotOptimize(packets);
+}
+
+/// Query throughput as a function of the number of reader threads.
+void BM_Query(benchmark::State &state)
+{
+    const auto &collection = getCollection();
+    auto names = getNames();
+    std::mt19937 generator(state.thread_index());
+    for (auto _ : state)
+    {
+        query(collection, names, generator);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Query throughput while thread 0 continually ingests packets.
+void BM_QueryWithIngest(benchmark::State &state)
+{
+    auto &collection = getCollection();
+    auto names = getNames();
+    std::mt19937 generator(state.thread_index());
+    int iChannel = 0;
+    auto startTime = N_PACKETS*PACKET_DURATION;
+    int64_t nQueries = 0;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            collection.addPacket(makePacket(iChannel, startTime));
+            iChannel = iChannel + 1;
+            if (iChannel == N_CHANNELS)
+            {
+                iChannel = 0;
+                startTime = startTime + PACKET_DURATION;
+            }
+        }
+        else
+        {
+            query(collection, names, generator);
+            nQueries = nQueries + 1;
+        }
+    }
+    state.SetItemsProcessed(nQueries);
+}
+
+/// Sample memory and query (decode) throughput with and without compression.
+/// The samples are a random walk which resembles a digitizer's counts.
+void BM_SampleCompression(benchmark::State &state)
+{
+    const bool compress = state.range(0) != 0;
+    CappedCollection collection;
+    collection.initialize(N_PACKETS, std::set<std::string> {}, compress);
+    std::mt19937 generator(86);
+    std::normal_distribution<double> noise(0, 200);
+    for (int iChannel = 0; iChannel < N_COMPRESSION_CHANNELS; ++iChannel)
+    {
+        double count = 0;
+        for (int iPacket = 0; iPacket < N_PACKETS; ++iPacket)
+        {
+            auto packet = makePacket(iChannel, iPacket*PACKET_DURATION);
+            std::vector<double> data(N_SAMPLES_PER_PACKET);
+            for (auto &x : data)
+            {
+                count = std::round(count + noise(generator));
+                x = count;
+            }
+            packet.setData(std::move(data));
+            collection.addPacket(std::move(packet));
+        }
+    }
+    auto names = getNames();
+    constexpr std::chrono::microseconds t0{0};
+    constexpr std::chrono::microseconds t1{N_PACKETS*PACKET_DURATION};
+    int64_t nSamples = 0;
+    int iChannel = 0;
+    for (auto _ : state)
+    {
+        auto views = collection.getPacketViews(names[iChannel], t0, t1);
+        for (const auto &view : views)
+        {
+            benchmark::DoNotOptimize(view.getDataPointer());
+            nSamples = nSamples + view.getNumberOfSamples();
+        }
+        iChannel = (iChannel + 1)%N_COMPRESSION_CHANNELS;
+    }
+    constexpr double nStored
+        = N_COMPRESSION_CHANNELS*N_PACKETS*N_SAMPLES_PER_PACKET;
+    state.counters["bytes_per_sample"]
+        = static_cast<double> (collection.getSampleMemoryUsage())/nStored;
+    state.counters["samples_per_second"]
+        = benchmark::Counter(static_cast<double> (nSamples),
+                             benchmark::Counter::kIsRate);
+}
+
+}
+
+BENCHMARK(BM_SampleCompression)->ArgName("compress")->Arg(0)->Arg(1);
+BENCHMARK(BM_Query)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_QueryWithIngest)->ThreadRange(2, 16)->UseRealTime();
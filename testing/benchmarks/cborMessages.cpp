@@ -0,0 +1,319 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <nlohmann/json.hpp>
+#include <benchmark/benchmark.h>
+#include "urts/services/scalable/detectors/uNetOneComponentP/processingRequest.hpp"
+#include "urts/services/scalable/detectors/uNetThreeComponentP/inferenceRequest.hpp"
+#include "urts/services/scalable/detectors/uNetThreeComponentP/preprocessingRequest.hpp"
+#include "urts/services/scalable/detectors/uNetThreeComponentP/processingRequest.hpp"
+#include "urts/services/scalable/detectors/uNetThreeComponentP/processingResponse.hpp"
+#include "urts/services/scalable/packetCache/bulkDataResponse.hpp"
+#include "urts/services/scalable/packetCache/dataResponse.hpp"
+#ifdef WITH_ULOCATOR
+#include "urts/services/scalable/associators/massociate/associationRequest.hpp"
+#include "urts/services/scalable/associators/massociate/pick.hpp"
+#include "urts/services/scalable/locators/uLocator/locationResponse.hpp"
+#include "urts/services/scalable/locators/uLocator/origin.hpp"
+#include "urts/services/scalable/locators/uLocator/arrival.hpp"
+#endif
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+
+// Compares the streaming CBOR codec used by the messages to the previous
+// path which expanded every message into a nlohmann::json document.
+
+namespace
+{
+
+namespace UNet1P = URTS::Services::Scalable::Detectors::UNetOneComponentP;
+namespace UNet3P = URTS::Services::Scalable::Detectors::UNetThreeComponentP;
+namespace UPC = URTS::Services::Scalable::PacketCache;
+namespace UDP = URTS::Broadcasts::Internal::DataPacket;
+
+constexpr int N_SIGNAL_SAMPLES{6000}; // 60 seconds at 100 Hz
+constexpr int N_CHANNELS{3};
+constexpr int N_PACKETS{60};
+constexpr int N_SAMPLES_PER_PACKET{100};
+constexpr int N_PICKS{50};
+constexpr int N_ARRIVALS{30};
+
+/// @result A message of the given type to encode and decode.
+template<typename T> T makeMessage();
+
+std::vector<double> makeSignal(const int n, const double phase)
+{
+    std::vector<double> signal(n);
+    for (int i = 0; i < n; ++i)
+    {
+        signal[i] = std::round(1000*std::sin(0.01*i + phase));
+    }
+    return signal;
+}
+
+template<>
+UNet1P::ProcessingRequest makeMessage()
+{
+    UNet1P::ProcessingRequest request;
+    request.setIdentifier(1);
+    request.setSignal(makeSignal(N_SIGNAL_SAMPLES, 0));
+    return request;
+}
+
+template<>
+UNet3P::PreprocessingRequest makeMessage()
+{
+    UNet3P::PreprocessingRequest request;
+    request.setIdentifier(2);
+    request.setSamplingRate(100);
+    request.setVerticalNorthEastSignal(makeSignal(N_SIGNAL_SAMPLES, 0),
+                                       makeSignal(N_SIGNAL_SAMPLES, 1),
+                                       makeSignal(N_SIGNAL_SAMPLES, 2));
+    return request;
+}
+
+template<>
+UNet3P::InferenceRequest makeMessage()
+{
+    UNet3P::InferenceRequest request;
+    request.setIdentifier(3);
+    request.setVerticalNorthEastSignal(makeSignal(N_SIGNAL_SAMPLES, 0),
+                                       makeSignal(N_SIGNAL_SAMPLES, 1),
+                                       makeSignal(N_SIGNAL_SAMPLES, 2));
+    return request;
+}
+
+template<>
+UNet3P::ProcessingRequest makeMessage()
+{
+    UNet3P::ProcessingRequest request;
+    request.setIdentifier(4);
+    request.setVerticalNorthEastSignal(makeSignal(N_SIGNAL_SAMPLES, 0),
+                                       makeSignal(N_SIGNAL_SAMPLES, 1),
+                                       makeSignal(N_SIGNAL_SAMPLES, 2));
+    return request;
+}
+
+template<>
+UNet3P::ProcessingResponse makeMessage()
+{
+    UNet3P::ProcessingResponse response;
+    response.setIdentifier(5);
+    response.setSamplingRate(100);
+    std::vector<double> probability(N_SIGNAL_SAMPLES);
+    for (int i = 0; i < N_SIGNAL_SAMPLES; ++i)
+    {
+        probability[i] = 0.5 + 0.5*std::sin(0.001*i);
+    }
+    response.setProbabilitySignal(std::move(probability));
+    response.setReturnCode(UNet3P::ProcessingResponse::ReturnCode::Success);
+    return response;
+}
+
+UPC::DataResponse makeDataResponse(const int iChannel)
+{
+    std::vector<UDP::DataPacket> packets;
+    for (int iPacket = 0; iPacket < N_PACKETS; ++iPacket)
+    {
+        UDP::DataPacket packet;
+        packet.setNetwork("UU");
+        packet.setStation("FORK");
+        packet.setChannel("HH" + std::string {"ZNE"[iChannel % 3]});
+        packet.setLocationCode("01");
+        packet.setSamplingRate(100);
+        packet.setStartTime(std::chrono::microseconds {iPacket*1000000});
+        packet.setData(makeSignal(N_SAMPLES_PER_PACKET, iPacket));
+        packets.push_back(std::move(packet));
+    }
+    UPC::DataResponse response;
+    response.setPackets(std::move(packets));
+    response.setIdentifier(iChannel);
+    response.setReturnCode(UPC::DataResponse::ReturnCode::Success);
+    return response;
+}
+
+template<>
+UPC::DataResponse makeMessage()
+{
+    return makeDataResponse(0);
+}
+
+template<>
+UPC::BulkDataResponse makeMessage()
+{
+    UPC::BulkDataResponse response;
+    for (int iChannel = 0; iChannel < N_CHANNELS; ++iChannel)
+    {
+        response.addDataResponse(makeDataResponse(iChannel));
+    }
+    response.setIdentifier(6);
+    response.setReturnCode(UPC::BulkDataResponse::ReturnCode::Success);
+    return response;
+}
+
+#ifdef WITH_ULOCATOR
+namespace UMASS = URTS::Services::Scalable::Associators::MAssociate;
+namespace ULOC = URTS::Services::Scalable::Locators::ULocator;
+
+template<>
+UMASS::AssociationRequest makeMessage()
+{
+    std::vector<UMASS::Pick> picks;
+    for (int i = 0; i < N_PICKS; ++i)
+    {
+        UMASS::Pick pick;
+        pick.setNetwork("UU");
+        pick.setStation("S" + std::to_string(i));
+        pick.setChannel("HHZ");
+        pick.setLocationCode("01");
+        pick.setTime(1714951814 + 0.1*i);
+        pick.setPhaseHint(i % 2 == 0 ? UMASS::Pick::PhaseHint::P :
+                                       UMASS::Pick::PhaseHint::S);
+        pick.setStandardError(0.1);
+        pick.setIdentifier(static_cast<uint64_t> (i));
+        picks.push_back(std::move(pick));
+    }
+    UMASS::AssociationRequest request;
+    request.setIdentifier(7);
+    request.setPicks(picks);
+    return request;
+}
+
+template<>
+ULOC::LocationResponse makeMessage()
+{
+    std::vector<ULOC::Arrival> arrivals;
+    for (int i = 0; i < N_ARRIVALS; ++i)
+    {
+        ULOC::Arrival arrival;
+        arrival.setNetwork("UU");
+        arrival.setStation("S" + std::to_string(i));
+        arrival.setTime(1714951814 + 0.1*i);
+        arrival.setPhase(i % 2 == 0 ? ULOC::Arrival::Phase::P :
+                                      ULOC::Arrival::Phase::S);
+        arrival.setStandardError(0.1);
+        arrival.setIdentifier(i);
+        arrival.setTravelTime(2 + 0.1*i);
+        arrivals.push_back(std::move(arrival));
+    }
+    ULOC::Origin origin;
+    origin.setLatitude(40.5);
+    origin.setLongitude(-111.9);
+    origin.setDepth(5000);
+    origin.setTime(1714951812.0);
+    origin.setIdentifier(8);
+    origin.setArrivals(arrivals);
+    ULOC::LocationResponse response;
+    response.setIdentifier(9);
+    response.setOrigin(origin);
+    response.setReturnCode(ULOC::LocationResponse::ReturnCode::Success);
+    return response;
+}
+#endif
+
+/// Copies the numeric arrays out of a document as the previous
+/// fromCBORMessage implementations did.
+void extractArrays(const nlohmann::json &document)
+{
+    if (document.is_object() || document.is_array())
+    {
+        if (document.is_array() && !document.empty() &&
+            document.front().is_number())
+        {
+            auto values = document.get<std::vector<double>> ();
+            benchmark::DoNotOptimize(values.data());
+            return;
+        }
+        for (const auto &item : document)
+        {
+            extractArrays(item);
+        }
+    }
+}
+
+/// The message as nlohmann::json::to_cbor would write it.  This has sorted
+/// keys and compact numbers so decoding it also checks that the streaming
+/// reader accepts messages from the previous implementation.
+std::string toDOMMessage(const std::string &message)
+{
+    auto v = nlohmann::json::to_cbor(nlohmann::json::from_cbor(message));
+    return std::string(v.begin(), v.end());
+}
+
+template<typename T>
+void BM_EncodeDOM(benchmark::State &state)
+{
+    auto document = nlohmann::json::from_cbor(makeMessage<T> ().toMessage());
+    for (auto _ : state)
+    {
+        // Building the document dominates so copy an equivalent one
+        nlohmann::json copy = document;
+        auto v = nlohmann::json::to_cbor(copy);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+template<typename T>
+void BM_EncodeStreaming(benchmark::State &state)
+{
+    auto object = makeMessage<T> ();
+    for (auto _ : state)
+    {
+        auto message = object.toMessage();
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+
+template<typename T>
+void BM_DecodeDOM(benchmark::State &state)
+{
+    const auto message = makeMessage<T> ().toMessage();
+    for (auto _ : state)
+    {
+        auto document = nlohmann::json::from_cbor(message);
+        extractArrays(document);
+    }
+    state.SetBytesProcessed(state.iterations()*message.size());
+}
+
+template<typename T>
+void BM_DecodeStreaming(benchmark::State &state)
+{
+    const auto message = makeMessage<T> ().toMessage();
+    try
+    {
+        T check;
+        check.fromMessage(toDOMMessage(message));
+    }
+    catch (const std::exception &e)
+    {
+        state.SkipWithError(e.what());
+    }
+    for (auto _ : state)
+    {
+        T object;
+        object.fromMessage(message);
+        benchmark::DoNotOptimize(&object);
+    }
+    state.SetBytesProcessed(state.iterations()*message.size());
+}
+
+}
+
+#define URTS_MESSAGE_BENCHMARKS(Type) \
+    BENCHMARK_TEMPLATE(BM_EncodeDOM, Type); \
+    BENCHMARK_TEMPLATE(BM_EncodeStreaming, Type); \
+    BENCHMARK_TEMPLATE(BM_DecodeDOM, Type); \
+    BENCHMARK_TEMPLATE(BM_DecodeStreaming, Type)
+
+URTS_MESSAGE_BENCHMARKS(UNet1P::ProcessingRequest);
+URTS_MESSAGE_BENCHMARKS(UNet3P::PreprocessingRequest);
+URTS_MESSAGE_BENCHMARKS(UNet3P::InferenceRequest);
+URTS_MESSAGE_BENCHMARKS(UNet3P::ProcessingRequest);
+URTS_MESSAGE_BENCHMARKS(UNet3P::ProcessingResponse);
+URTS_MESSAGE_BENCHMARKS(UPC::DataResponse);
+URTS_MESSAGE_BENCHMARKS(UPC::BulkDataResponse);
+#ifdef WITH_ULOCATOR
+URTS_MESSAGE_BENCHMARKS(UMASS::AssociationRequest);
+URTS_MESSAGE_BENCHMARKS(ULOC::LocationResponse);
+#endif
@@ -0,0 +1,112 @@
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include "private/traceBuf2Samples.hpp"
+
+// Compares the bulk TraceBuf2 sample conversion to the previous path which
+// converted, and possibly byte swapped, one sample at a time.
+
+namespace
+{
+
+constexpr int MAX_TRACE_SIZE{4096 - 64};
+
+/// The previous scalar unpacking.
+template<typename T> T scalarUnpack(const char *__restrict__ cIn,
+                                    const bool swap = false)
+{
+    union
+    {
+        char c[sizeof(T)];
+        T value;
+    };
+    if (!swap)
+    {
+        std::copy(cIn, cIn + sizeof(T), c);
+    }
+    else
+    {
+        std::reverse_copy(cIn, cIn + sizeof(T), c);
+    }
+    return value;
+}
+
+template<typename T, typename U> std::vector<T>
+scalarUnpack(const char *__restrict__ cIn, const int nSamples, const bool swap)
+{
+    std::vector<T> result(nSamples);
+    if (!swap)
+    {
+        auto dPtr = reinterpret_cast<const U *__restrict__> (cIn);
+        std::copy(dPtr, dPtr + nSamples, result.data());
+    }
+    else
+    {
+        const auto nBytes = sizeof(U);
+        auto resultPtr = result.data();
+        for (int i = 0; i < nSamples; ++i)
+        {
+            resultPtr[i] = static_cast<T> (scalarUnpack<U>(cIn + i*nBytes,
+                                                           swap));
+        }
+    }
+    return result;
+}
+
+/// A full TraceBuf2 payload of samples of type U.
+template<typename U>
+std::vector<char> makePayload()
+{
+    constexpr int nSamples{MAX_TRACE_SIZE/static_cast<int> (sizeof(U))};
+    std::vector<char> payload(MAX_TRACE_SIZE);
+    for (int i = 0; i < nSamples; ++i)
+    {
+        auto value = static_cast<U> (i%1000 - 500);
+        std::copy(reinterpret_cast<const char *> (&value),
+                  reinterpret_cast<const char *> (&value) + sizeof(U),
+                  payload.data() + i*sizeof(U));
+    }
+    return payload;
+}
+
+template<typename U, bool Swap>
+void BM_Scalar(benchmark::State &state)
+{
+    constexpr int nSamples{MAX_TRACE_SIZE/static_cast<int> (sizeof(U))};
+    const auto payload = makePayload<U> ();
+    for (auto _ : state)
+    {
+        auto samples = scalarUnpack<double, U>(payload.data(), nSamples, Swap);
+        benchmark::DoNotOptimize(samples.data());
+    }
+    state.SetBytesProcessed(state.iterations()*payload.size());
+}
+
+template<typename U, bool Swap>
+void BM_Bulk(benchmark::State &state)
+{
+    constexpr int nSamples{MAX_TRACE_SIZE/static_cast<int> (sizeof(U))};
+    const auto payload = makePayload<U> ();
+    for (auto _ : state)
+    {
+        std::vector<double> samples(nSamples);
+        ::convertSamples<double, U, Swap>(payload.data(), nSamples,
+                                          samples.data());
+        benchmark::DoNotOptimize(samples.data());
+    }
+    state.SetBytesProcessed(state.iterations()*payload.size());
+}
+
+}
+
+#define URTS_TRACEBUF2_BENCHMARKS(Type) \
+    BENCHMARK_TEMPLATE(BM_Scalar, Type, false); \
+    BENCHMARK_TEMPLATE(BM_Bulk, Type, false); \
+    BENCHMARK_TEMPLATE(BM_Scalar, Type, true); \
+    BENCHMARK_TEMPLATE(BM_Bulk, Type, true)
+
+URTS_TRACEBUF2_BENCHMARKS(int16_t);
+URTS_TRACEBUF2_BENCHMARKS(int32_t);
+URTS_TRACEBUF2_BENCHMARKS(float);
+URTS_TRACEBUF2_BENCHMARKS(double);
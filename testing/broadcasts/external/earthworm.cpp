@@ -2,8 +2,12 @@
 #include <cstring>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include "urts/broadcasts/external/earthworm/traceBuf2.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "private/traceBuf2Slab.hpp"
 #include <gtest/gtest.h>
 namespace
 {
@@ -219,4 +223,224 @@ TEST(BroadcastsExternalEarthwormTraceBuf2Test, FromEarthworm)
     } 
 }
 
+/// Copies a value into the message in big or little endian byte order.
+template<typename V>
+void packValue(const V value, const bool bigEndian, char *msg)
+{
+    std::array<char, sizeof(V)> c;
+    std::memcpy(c.data(), &value, sizeof(V));
+    if (bigEndian != (std::endian::native == std::endian::big))
+    {
+        std::reverse(c.begin(), c.end());
+    }
+    std::copy(c.begin(), c.end(), msg);
+}
+
+/// Packs a TraceBuf2 message with the given datatype, e.g., "s4", whose
+/// samples are -100, -99, ..., in the datatype's byte order.
+template<typename U>
+std::vector<char> packMessage(const std::string &dataType, const int nSamples)
+{
+    std::vector<char> msg(MAX_TRACEBUF_SIZ, '\0');
+    const bool bigEndian = (dataType[0] == 's' || dataType[0] == 't');
+    packValue(static_cast<int> (3), bigEndian, msg.data());
+    packValue(nSamples, bigEndian, msg.data() + 4);
+    packValue(10., bigEndian, msg.data() + 8);
+    packValue(10 + (nSamples - 1)/100., bigEndian, msg.data() + 16);
+    packValue(100., bigEndian, msg.data() + 24);
+    strcpy(msg.data() + 32, "FAKE");
+    strcpy(msg.data() + 39, "FK");
+    strcpy(msg.data() + 48, "HHZ");
+    strcpy(msg.data() + 52, "01");
+    msg[55] = '2';
+    msg[56] = '0';
+    msg[57] = dataType[0];
+    msg[58] = dataType[1];
+    for (int i = 0; i < nSamples; ++i)
+    {
+        packValue(static_cast<U> (i - 100), bigEndian,
+                  msg.data() + 64 + i*sizeof(U));
+    }
+    return msg;
+}
+
+template<typename U>
+void checkDataType(const std::string &dataType)
+{
+    constexpr int nSamples{(MAX_TRACEBUF_SIZ - 64)/sizeof(U)};
+    auto msg = packMessage<U>(dataType, nSamples);
+    TraceBuf2<double> tb;
+    tb.fromEarthworm(msg.data());
+    EXPECT_EQ(tb.getPinNumber(), 3);
+    EXPECT_EQ(tb.getStation(), "FAKE");
+    EXPECT_NEAR(tb.getStartTime(), 10, 1.e-14);
+    EXPECT_NEAR(tb.getSamplingRate(), 100, 1.e-14);
+    auto data = tb.getData();
+    ASSERT_EQ(tb.getNumberOfSamples(), nSamples);
+    for (int i = 0; i < nSamples; ++i)
+    {
+        EXPECT_NEAR(data[i], static_cast<double> (i - 100), 1.e-14)
+            << dataType;
+    }
+}
+
+TEST(BroadcastsExternalEarthwormTraceBuf2Test, FromEarthwormDataTypes)
+{
+    checkDataType<int16_t>("i2");
+    checkDataType<int32_t>("i4");
+    checkDataType<int64_t>("i8");
+    checkDataType<float>("f4");
+    checkDataType<double>("f8");
+    checkDataType<int16_t>("s2");
+    checkDataType<int32_t>("s4");
+    checkDataType<int64_t>("s8");
+    checkDataType<float>("t4");
+    checkDataType<double>("t8");
+    // Too many samples
+    auto msg = packMessage<int32_t>("i4", 10);
+    auto nSamples = (MAX_TRACEBUF_SIZ - 64)/4 + 1;
+    std::copy(reinterpret_cast<const char *> (&nSamples),
+              reinterpret_cast<const char *> (&nSamples) + 4,
+              msg.data() + 4);
+    TraceBuf2<double> tb;
+    EXPECT_THROW(tb.fromEarthworm(msg.data()), std::invalid_argument);
+}
+
+
+TEST(BroadcastsExternalEarthwormTraceBuf2Test, WorkerPool)
+{
+    ::WorkerPool pool;
+    EXPECT_EQ(pool.getNumberOfWorkers(), 0);
+    EXPECT_THROW(pool.start(-1), std::invalid_argument);
+    std::vector<int> counts(4, 0);
+    auto task = [&](const int part){counts[part] = counts[part] + 1;};
+    // Without workers only the calling thread runs
+    EXPECT_NO_THROW(pool.run(1, task));
+    EXPECT_THROW(pool.run(2, task), std::invalid_argument);
+    pool.start(3);
+    EXPECT_THROW(pool.run(0, task), std::invalid_argument);
+    EXPECT_THROW(pool.run(5, task), std::invalid_argument);
+    // Every part of every run finishes before run returns
+    constexpr int nRuns{1000};
+    for (int i = 0; i < nRuns; ++i){pool.run(1 + i%4, task);}
+    EXPECT_EQ(counts[0], 1 + nRuns);
+    EXPECT_EQ(counts[1], 3*nRuns/4);
+    EXPECT_EQ(counts[2], nRuns/2);
+    EXPECT_EQ(counts[3], nRuns/4);
+    // Restarting replaces the workers
+    pool.start(1);
+    EXPECT_EQ(pool.getNumberOfWorkers(), 1);
+    pool.run(2, task);
+    EXPECT_EQ(counts[1], 3*nRuns/4 + 1);
+}
+
+TEST(BroadcastsExternalEarthwormTraceBuf2Test, UnpackSlab)
+{
+    constexpr size_t slotSize{MAX_TRACEBUF_SIZ};
+    constexpr unsigned char traceBuf2Type{19};
+    constexpr unsigned char otherType{9};
+    // Not divisible by the thread counts below
+    constexpr int nMessages{1001};
+    std::vector<char> slab(nMessages*slotSize, 'Z');
+    std::vector<long> messageSizes(nMessages);
+    std::vector<unsigned char> messageTypes(nMessages);
+    std::vector<int> nSamples(nMessages);
+    // Writes the messages into the slab on top of whatever was there
+    auto fill = [&](const int maxSamples)
+    {
+        for (int i = 0; i < nMessages; ++i)
+        {
+            nSamples[i] = 1 + i%maxSamples;
+            auto msg = packMessage<int32_t>("i4", nSamples[i]);
+            messageSizes[i] = 64 + 4*nSamples[i];
+            std::copy(msg.data(), msg.data() + messageSizes[i],
+                      slab.data() + i*slotSize);
+            messageTypes[i] = (i%10 == 9) ? otherType : traceBuf2Type;
+        }
+    };
+    std::vector<TraceBuf2<double>> messages;
+    auto check = [&](const std::vector<bool> &failed)
+    {
+        ASSERT_EQ(static_cast<int> (messages.size()), nMessages);
+        for (int i = 0; i < nMessages; ++i)
+        {
+            if (messageTypes[i] != traceBuf2Type || failed[i])
+            {
+                EXPECT_EQ(messages[i].getNumberOfSamples(), 0);
+                continue;
+            }
+            ASSERT_EQ(messages[i].getNumberOfSamples(), nSamples[i]);
+            EXPECT_EQ(messages[i].getStation(), "FAKE");
+            auto data = messages[i].getData();
+            for (int j = 0; j < nSamples[i]; ++j)
+            {
+                EXPECT_NEAR(data[j], j - 100, 1.e-14);
+            }
+        }
+    };
+    const std::vector<bool> noFailures(nMessages, false);
+    fill(100);
+    // The pool's threads are reused by every unpack.  Thread counts beyond
+    // the pool's size are limited to it.
+    ::WorkerPool pool;
+    pool.start(6);
+    EXPECT_EQ(pool.getNumberOfWorkers(), 6);
+    for (const int nThreads : {1, 2, 3, 4, 7, 16})
+    {
+        auto nFailed = ::unpackTraceBuf2Slab(slab, slotSize, messageSizes,
+                                             messageTypes, traceBuf2Type,
+                                             nThreads, &pool, &messages);
+        EXPECT_EQ(nFailed, 0);
+        check(noFailures);
+    }
+    // Reuse the slab with shorter messages.  The samples left over from the
+    // previous messages must not be read.
+    fill(7);
+    auto nFailed = ::unpackTraceBuf2Slab(slab, slotSize, messageSizes,
+                                         messageTypes, traceBuf2Type,
+                                         3, &pool, &messages);
+    EXPECT_EQ(nFailed, 0);
+    check(noFailures);
+    // Truncated messages and messages with more samples than were copied
+    // are rejected
+    std::vector<bool> failed(nMessages, false);
+    int nExpectedFailures{0};
+    for (int i = 0; i < nMessages; i = i + 17)
+    {
+        if (messageTypes[i] != traceBuf2Type){continue;}
+        if (i%2 == 0)
+        {
+            messageSizes[i] = 63;
+        }
+        else
+        {
+            auto nTooMany = nSamples[i] + 1;
+            std::memcpy(slab.data() + i*slotSize + 4, &nTooMany, 4);
+        }
+        failed[i] = true;
+        nExpectedFailures = nExpectedFailures + 1;
+    }
+    nFailed = ::unpackTraceBuf2Slab(slab, slotSize, messageSizes,
+                                    messageTypes, traceBuf2Type,
+                                    4, &pool, &messages);
+    EXPECT_EQ(nFailed, nExpectedFailures);
+    check(failed);
+    // Without a pool the calling thread unpacks everything
+    nFailed = ::unpackTraceBuf2Slab(slab, slotSize, messageSizes,
+                                    messageTypes, traceBuf2Type,
+                                    4, nullptr, &messages);
+    EXPECT_EQ(nFailed, nExpectedFailures);
+    check(failed);
+    pool.stop();
+    EXPECT_EQ(pool.getNumberOfWorkers(), 0);
+    // Too short for the header
+    auto msg = packMessage<int32_t>("i4", 10);
+    TraceBuf2<double> tb;
+    EXPECT_THROW(tb.fromEarthworm(msg.data(), 63), std::invalid_argument);
+    EXPECT_THROW(tb.fromEarthworm(msg.data(), 64 + 4*9),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(tb.fromEarthworm(msg.data(), 64 + 4*10));
+    EXPECT_EQ(tb.getNumberOfSamples(), 10);
+}
+
 }
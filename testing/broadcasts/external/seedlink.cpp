@@ -1,5 +1,7 @@
 #include <string>
 #include <vector>
+#include <chrono>
+#include "urts/broadcasts/external/seedlink/client.hpp"
 #include "urts/broadcasts/external/seedlink/clientOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
 #include <gtest/gtest.h>
@@ -51,4 +53,23 @@ TEST(BroadcastsExternalSEEDLink, ClientOptions)
     EXPECT_EQ(options.getNetworkReconnectDelay(), std::chrono::seconds {30});
 }
 
+TEST(BroadcastsExternalSEEDLink, ClientQueue)
+{
+    // The ring, wake up, and overflow count are tested with the data packet
+    // tests.  Without a server the client's queue stays empty.
+    Client client;
+    EXPECT_FALSE(client.isInitialized());
+    EXPECT_TRUE(client.empty());
+    EXPECT_EQ(client.size(), 0U);
+    EXPECT_EQ(client.getNumberOfOverflowedPackets(), 0U);
+    EXPECT_THROW(client.waitForPackets(std::chrono::milliseconds {-1}),
+                 std::invalid_argument);
+    EXPECT_FALSE(client.waitForPackets(std::chrono::milliseconds {10}));
+    std::vector<URTS::Broadcasts::Internal::DataPacket::DataPacket> packets;
+    EXPECT_THROW(client.getPackets(nullptr), std::invalid_argument);
+    EXPECT_THROW(client.getPackets(&packets, 0), std::invalid_argument);
+    EXPECT_EQ(client.getPackets(&packets), 0);
+    EXPECT_TRUE(packets.empty());
+}
+
 }
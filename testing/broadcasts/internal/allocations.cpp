@@ -0,0 +1,147 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <catch2/catch_test_macros.hpp>
+#include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/services/scalable/packetCache/cappedCollection.hpp"
+#include "private/threadSafeQueue.hpp"
+
+// The global allocation functions are replaced so this lives in its own
+// test executable.
+
+using namespace URTS::Broadcasts::Internal::DataPacket;
+
+namespace
+{
+// Counts the heap allocations made while counting is enabled.  Every
+// replaceable form is defined so that they all use the same allocator.
+std::atomic<bool> countAllocations{false};
+std::atomic<int64_t> nAllocations{0};
+void *allocate(const size_t size) noexcept
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+    {
+        nAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+}
+
+void *operator new(const size_t size)
+{
+    auto result = ::allocate(size);
+    if (result == nullptr){throw std::bad_alloc {};}
+    return result;
+}
+void *operator new[](const size_t size)
+{
+    auto result = ::allocate(size);
+    if (result == nullptr){throw std::bad_alloc {};}
+    return result;
+}
+void *operator new(const size_t size, const std::nothrow_t &) noexcept
+{
+    return ::allocate(size);
+}
+void *operator new[](const size_t size, const std::nothrow_t &) noexcept
+{
+    return ::allocate(size);
+}
+void operator delete(void *pointer) noexcept{std::free(pointer);}
+void operator delete[](void *pointer) noexcept{std::free(pointer);}
+void operator delete(void *pointer, size_t) noexcept{std::free(pointer);}
+void operator delete[](void *pointer, size_t) noexcept{std::free(pointer);}
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    std::free(pointer);
+}
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    std::free(pointer);
+}
+
+TEST_CASE("URTS::Broadcasts::Internal::DataPacket::QueueAndCollectionAllocations",
+          "[Allocations]")
+{
+    // Covers the packet cache's ingest after the message is received:
+    // decode the message into a packet, pass it through the queue, and
+    // store it in the collection.  The UMPS receive, which makes a new
+    // message for every frame, is not exercised.
+    const std::vector<std::string> channels{"HHZ", "HHN", "HHE"};
+    const int nSamples{250};
+    const int nWarmUp{300};
+    const int nMeasured{300};
+    const int64_t startTime{1628803598000000};
+    std::vector<std::string> messages;
+    for (int i = 0; i < nWarmUp + nMeasured; ++i)
+    {
+        for (const auto &channel : channels)
+        {
+            DataPacket packet;
+            packet.setNetwork("UU");
+            packet.setStation("MOUNTAIN");
+            packet.setChannel(channel);
+            packet.setLocationCode("01");
+            packet.setSamplingRate(100);
+            packet.setStartTime(std::chrono::microseconds
+                                {startTime + i*2500000});
+            packet.setData(std::vector<double> (nSamples, i));
+            messages.push_back(packet.toMessage());
+        }
+    }
+    URTS::Services::Scalable::PacketCache::CappedCollection collection;
+    collection.initialize(100);
+    ::ThreadSafeQueue<DataPacket> queue;
+    DataPacket popped;
+    int nStored{0};
+    auto ingest = [&](const std::string &message)
+    {
+        DataPacket packet;
+        packet.fromMessage(message);
+        queue.push(std::move(packet));
+        if (queue.wait_until_and_pop(&popped))
+        {
+            collection.addPacket(std::move(popped));
+            nStored = nStored + 1;
+        }
+    };
+    auto nWarmUpMessages = static_cast<int> (channels.size())*nWarmUp;
+    for (int i = 0; i < nWarmUpMessages; ++i){ingest(messages[i]);}
+    // The pool, queue, and collection are warm so nothing more is needed
+    nAllocations.store(0);
+    countAllocations.store(true);
+    for (int i = nWarmUpMessages; i < static_cast<int> (messages.size()); ++i)
+    {
+        ingest(messages[i]);
+    }
+    countAllocations.store(false);
+    CHECK(nAllocations.load() == 0);
+    CHECK(nStored == static_cast<int> (messages.size()));
+    CHECK(collection.getTotalNumberOfPackets() ==
+          100*static_cast<int> (channels.size()));
+
+    SECTION("Copies reuse storage")
+    {
+    DataPacket source;
+    source.fromMessage(messages.back());
+    DataPacket copy;
+    copy = source;
+    nAllocations.store(0);
+    countAllocations.store(true);
+    for (int i = 0; i < 10; ++i)
+    {
+        source.fromMessage(messages[i]);
+        copy = source;
+    }
+    countAllocations.store(false);
+    CHECK(nAllocations.load() == 0);
+    CHECK(copy.getData() == source.getData());
+    DataPacket moved;
+    moved = std::move(copy);
+    CHECK(moved.getData() == source.getData());
+    CHECK(copy.getNumberOfSamples() == 0);
+    }
+}
@@ -1,15 +1,23 @@
 #include <string>
 #include <cmath>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <chrono>
 #include <limits>
+#include <atomic>
+#include <thread>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <umps/authentication/zapOptions.hpp>
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/broadcasts/internal/dataPacket/dataPacketBatch.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
+#include "private/threadSafeQueue.hpp"
+#include "private/spscRing.hpp"
+#include "private/packetHandoff.hpp"
+#include "private/receiveBatch.hpp"
 
 using namespace URTS::Broadcasts::Internal::DataPacket;
 
@@ -80,6 +88,118 @@ TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[DataPacket]")
         CHECK(std::abs(res) < tol);
     }
     }
+
+    SECTION("Binary")
+    {
+    std::string message;
+    packetCopy.toBinary(&message);
+    CHECK(message == packetCopy.toMessage());
+    CHECK(message.size() == 32 + 2 + 4 + 3 + 2 + 8*timeSeries.size());
+    DataPacket binaryPacket;
+    binaryPacket.setData(std::vector<double> (1000, 1));
+    REQUIRE_NOTHROW(binaryPacket.fromBinary(
+        reinterpret_cast<const uint8_t *> (message.data()), message.size()));
+    CHECK(binaryPacket.getNetwork() == network);
+    CHECK(binaryPacket.getStation() == station);
+    CHECK(binaryPacket.getChannel() == channel);
+    CHECK(binaryPacket.getLocationCode() == locationCode);
+    CHECK(binaryPacket.getStartTime() == startTimeMuS);
+    CHECK(binaryPacket.getEndTime() == endTimeMuS);
+    CHECK(binaryPacket.getSamplingRate() == samplingRate);
+    CHECK(binaryPacket.getData() == timeSeries);
+    // Version 1 (CBOR) messages are still understood
+    binaryPacket.clear();
+    REQUIRE_NOTHROW(binaryPacket.fromMessage(packetCopy.toCBOR()));
+    CHECK(binaryPacket.getData() == timeSeries);
+    CHECK(binaryPacket.getEndTime() == endTimeMuS);
+    // Truncated or unknown versions are rejected and leave the packet be
+    auto truncated = message.substr(0, message.size() - 1);
+    CHECK_THROWS_AS(binaryPacket.fromMessage(truncated), std::runtime_error);
+    auto futureVersion = message;
+    futureVersion[4] = 3;
+    CHECK_THROWS_AS(binaryPacket.fromMessage(futureVersion),
+                    std::runtime_error);
+    CHECK(binaryPacket.getData() == timeSeries);
+    // Reusing the buffer
+    auto capacity = message.capacity();
+    DataPacket shortPacket(packetCopy);
+    shortPacket.setData(std::vector<double> {1, 2});
+    shortPacket.toBinary(&message);
+    CHECK(message.capacity() == capacity);
+    binaryPacket.fromMessage(message);
+    CHECK(binaryPacket.getNumberOfSamples() == 2);
+    }
+
+    SECTION("Compressed")
+    {
+    // Digitizer counts compress losslessly
+    std::vector<double> counts(400);
+    for (int i = 0; i < static_cast<int> (counts.size()); ++i)
+    {
+        counts[i] = std::round(1000*std::sin(0.05*i)) - 2000000;
+    }
+    counts[17] =-8388608;
+    counts[18] = 8388607;
+    DataPacket countsPacket(packetCopy);
+    countsPacket.setData(counts);
+    CHECK(countsPacket.getEncoding() == DataPacket::Encoding::Float64);
+    auto rawMessage = countsPacket.toMessage();
+    countsPacket.setEncoding(DataPacket::Encoding::IntegerDelta);
+    auto message = countsPacket.toMessage();
+    CHECK(message[9] == 1);
+    CHECK(3*message.size() < rawMessage.size());
+    // The encoding can be chosen when serializing without copying
+    std::string encodedMessage;
+    countsPacket.toBinary(&encodedMessage, DataPacket::Encoding::Float64);
+    CHECK(encodedMessage == rawMessage);
+    countsPacket.toBinary(&encodedMessage, DataPacket::Encoding::IntegerDelta);
+    CHECK(encodedMessage == message);
+    DataPacket decoded;
+    REQUIRE_NOTHROW(decoded.fromMessage(message));
+    CHECK(decoded.getEncoding() == DataPacket::Encoding::IntegerDelta);
+    CHECK(decoded.getData() == counts);
+    CHECK(decoded.getNetwork() == network);
+    CHECK(decoded.getLocationCode() == locationCode);
+    CHECK(decoded.getStartTime() == startTimeMuS);
+    CHECK(decoded.getSamplingRate() == samplingRate);
+    // Truncated or padded messages are rejected and leave the packet be
+    auto truncated = message.substr(0, message.size() - 1);
+    CHECK_THROWS_AS(decoded.fromMessage(truncated), std::runtime_error);
+    CHECK_THROWS_AS(decoded.fromMessage(message + '\x01'),
+                    std::runtime_error);
+    auto unknownEncoding = message;
+    unknownEncoding[9] = 7;
+    CHECK_THROWS_AS(decoded.fromMessage(unknownEncoding), std::runtime_error);
+    CHECK(decoded.getData() == counts);
+    // Non-integer samples fall back to doubles
+    const std::vector<double> reals{0.5, -1.25, 3, 4.75};
+    DataPacket realPacket(packetCopy);
+    realPacket.setData(reals);
+    auto floatMessage = realPacket.toMessage();
+    realPacket.setEncoding(DataPacket::Encoding::IntegerDelta);
+    message = realPacket.toMessage();
+    CHECK(message[9] == 0);
+    CHECK(message == floatMessage);
+    REQUIRE_NOTHROW(decoded.fromMessage(message));
+    CHECK(decoded.getEncoding() == DataPacket::Encoding::Float64);
+    CHECK(decoded.getData() == reals);
+    // Batches carry compressed packets
+    DataPacketBatch batch;
+    batch.addPacket(countsPacket);
+    batch.addPacket(realPacket);
+    DataPacketBatch batchCopy;
+    REQUIRE_NOTHROW(batchCopy.fromMessage(batch.toMessage()));
+    REQUIRE(batchCopy.getNumberOfPackets() == 2);
+    CHECK(batchCopy.getPacketsReference()[0].getData() == counts);
+    CHECK(batchCopy.getPacketsReference()[1].getData() == reals);
+    std::string batchMessage;
+    batch.toBinary(&batchMessage, DataPacket::Encoding::Float64);
+    REQUIRE_NOTHROW(batchCopy.fromMessage(batchMessage));
+    REQUIRE(batchCopy.getNumberOfPackets() == 2);
+    CHECK(batchCopy.getPacketsReference()[0].getEncoding() ==
+          DataPacket::Encoding::Float64);
+    CHECK(batchCopy.getPacketsReference()[0].getData() == counts);
+    }
 }
 
 TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[SubscriberOptions]")
@@ -127,6 +247,10 @@ TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[PublisherOptions]")
     REQUIRE_NOTHROW(options.setHighWaterMark(sendHWM));
     REQUIRE_NOTHROW(options.setTimeOut(sendTimeOut));
     REQUIRE_NOTHROW(options.setZAPOptions(zapOptions));
+    REQUIRE_NOTHROW(options.setMaximumBatchSize(50));
+    REQUIRE_NOTHROW(options.setMaximumBatchAge(std::chrono::milliseconds {20}));
+    CHECK_THROWS(options.setMaximumBatchSize(0));
+    CHECK_THROWS(options.setMaximumBatchAge(std::chrono::milliseconds {-1}));
 
     PublisherOptions copy(options);
     CHECK(options.getAddress() == address);
@@ -134,6 +258,11 @@ TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[PublisherOptions]")
     CHECK(options.getTimeOut() == sendTimeOut);
     CHECK(options.getZAPOptions().getSecurityLevel() ==
           zapOptions.getSecurityLevel());    
+    CHECK(copy.getMaximumBatchSize() == 50);
+    CHECK(copy.getMaximumBatchAge() == std::chrono::milliseconds {20});
+    CHECK(copy.getSampleEncoding() == DataPacket::Encoding::Float64);
+    options.setSampleEncoding(DataPacket::Encoding::IntegerDelta);
+    CHECK(options.getSampleEncoding() == DataPacket::Encoding::IntegerDelta);
 
     options.clear();
     SECTION("clear")
@@ -143,5 +272,432 @@ TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[PublisherOptions]")
     CHECK(options.getTimeOut() == std::chrono::milliseconds {1000});
     CHECK(options.getZAPOptions().getSecurityLevel() ==
           UMPS::Authentication::SecurityLevel::Grasslands);
+    CHECK(options.getMaximumBatchSize() == 1);
+    CHECK(options.getMaximumBatchAge() == std::chrono::milliseconds {100});
+    CHECK(options.getSampleEncoding() == DataPacket::Encoding::Float64);
+    }
+}
+
+TEST_CASE("URTS::Private::SPSCRing", "[SPSCRing]")
+{
+    auto makePacket = [](const int i)
+    {
+        DataPacket packet;
+        packet.setNetwork("UU");
+        packet.setStation("STA" + std::to_string(i%7));
+        packet.setChannel("HHZ");
+        packet.setLocationCode("01");
+        packet.setSamplingRate(100);
+        packet.setStartTime(std::chrono::microseconds {i});
+        packet.setData(std::vector<double> (10, i));
+        return packet;
+    };
+    ::SPSCRing<DataPacket> ring(5);
+    REQUIRE(ring.capacity() == 8);
+    REQUIRE(ring.empty());
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(ring.try_push(makePacket(i)));
+    }
+    // A full ring rejects the packet and leaves it intact
+    auto rejected = makePacket(8);
+    REQUIRE(!ring.try_push(std::move(rejected)));
+    REQUIRE(rejected.getNumberOfSamples() == 10);
+    REQUIRE(ring.size() == 8);
+    std::vector<DataPacket> packets;
+    REQUIRE(ring.pop_all(&packets, 3) == 3);
+    REQUIRE(ring.pop_all(&packets) == 5);
+    REQUIRE(ring.empty());
+    REQUIRE(ring.pop_all(&packets) == 0);
+    REQUIRE(packets.size() == 8);
+    for (int i = 0; i < 8; ++i)
+    {
+        REQUIRE(packets[i].getStation() == "STA" + std::to_string(i%7));
+        REQUIRE(packets[i].getStartTime() == std::chrono::microseconds {i});
+        REQUIRE(packets[i].getData() == std::vector<double> (10, i));
+    }
+
+    SECTION("Threads")
+    {
+        // Packets arrive in order and exactly once between two threads
+        const int nPackets{20000};
+        std::vector<DataPacket> received;
+        std::thread producer([&]()
+        {
+            for (int i = 0; i < nPackets; ++i)
+            {
+                auto packet = makePacket(i);
+                while (!ring.try_push(std::move(packet)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        while (static_cast<int> (received.size()) < nPackets)
+        {
+            if (ring.pop_all(&received, 3) == 0){std::this_thread::yield();}
+        }
+        producer.join();
+        REQUIRE(ring.empty());
+        REQUIRE(ring.pop_all(&received) == 0);
+        REQUIRE(static_cast<int> (received.size()) == nPackets);
+        // Nothing is lost or duplicated and the packets are in order
+        std::vector<bool> seen(nPackets, false);
+        int nDuplicated{0};
+        bool inRange{true};
+        bool inOrder{true};
+        for (int i = 0; i < nPackets; ++i)
+        {
+            auto index = static_cast<int> (received[i].getStartTime().count());
+            if (index < 0 || index >= nPackets)
+            {
+                inRange = false;
+                continue;
+            }
+            if (seen[index]){nDuplicated = nDuplicated + 1;}
+            seen[index] = true;
+            if (index != i || received[i].getData()[0] != i)
+            {
+                inOrder = false;
+            }
+        }
+        REQUIRE(inRange);
+        REQUIRE(nDuplicated == 0);
+        REQUIRE(std::all_of(seen.begin(), seen.end(),
+                            [](const bool s){return s;}));
+        REQUIRE(inOrder);
+    }
+}
+
+TEST_CASE("URTS::Private::PacketHandoff", "[PacketHandoff]")
+{
+    auto makePacket = [](const int i)
+    {
+        DataPacket packet;
+        packet.setNetwork("UU");
+        packet.setStation("FORK");
+        packet.setChannel("HHZ");
+        packet.setLocationCode("01");
+        packet.setSamplingRate(100);
+        packet.setStartTime(std::chrono::microseconds {i});
+        packet.setData(std::vector<double> (10, i));
+        return packet;
+    };
+    ::PacketHandoff<DataPacket> handoff(4);
+    REQUIRE(handoff.capacity() == 4);
+    REQUIRE(handoff.getNumberOfOverflowedValues() == 0);
+    // Nothing arrives so the wait times out
+    REQUIRE(!handoff.waitFor(std::chrono::milliseconds {10}));
+
+    SECTION("Overflow")
+    {
+        // The packets that arrive while the ring is full are counted and
+        // the queued packets are untouched
+        for (int i = 0; i < 10; ++i)
+        {
+            auto accepted = handoff.try_push(makePacket(i));
+            REQUIRE(accepted == (i < 4));
+        }
+        REQUIRE(handoff.getNumberOfOverflowedValues() == 6);
+        REQUIRE(handoff.waitFor(std::chrono::milliseconds {0}));
+        std::vector<DataPacket> packets;
+        REQUIRE(handoff.pop_all(&packets) == 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(packets[i].getStartTime() == std::chrono::microseconds {i});
+        }
+        // Draining makes room again
+        REQUIRE(handoff.try_push(makePacket(10)));
+        REQUIRE(handoff.getNumberOfOverflowedValues() == 6);
+        // Clearing discards the packets and resets the count in place
+        handoff.clear();
+        REQUIRE(handoff.empty());
+        REQUIRE(handoff.capacity() == 4);
+        REQUIRE(handoff.getNumberOfOverflowedValues() == 0);
+        for (int i = 0; i < 4; ++i){REQUIRE(handoff.try_push(makePacket(i)));}
+        REQUIRE(!handoff.try_push(makePacket(4)));
+        REQUIRE(handoff.getNumberOfOverflowedValues() == 1);
+        // Resizing resets the count
+        handoff.setCapacity(8);
+        REQUIRE(handoff.empty());
+        REQUIRE(handoff.getNumberOfOverflowedValues() == 0);
+    }
+
+    SECTION("Wake Up")
+    {
+        // A sleeping consumer is woken by the producer long before its
+        // time out
+        std::atomic<bool> waiting{false};
+        bool accepted{false};
+        std::thread producer([&]()
+        {
+            while (!waiting.load()){std::this_thread::yield();}
+            std::this_thread::sleep_for(std::chrono::milliseconds {20});
+            accepted = handoff.try_push(makePacket(1));
+        });
+        auto startTime = std::chrono::steady_clock::now();
+        waiting.store(true);
+        auto haveData = handoff.waitFor(std::chrono::seconds {30});
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        producer.join();
+        REQUIRE(accepted);
+        REQUIRE(haveData);
+        REQUIRE(elapsed < std::chrono::seconds {10});
+        std::vector<DataPacket> packets;
+        REQUIRE(handoff.pop_all(&packets) == 1);
+        REQUIRE(packets[0].getStartTime() == std::chrono::microseconds {1});
+    }
+
+    SECTION("Threads")
+    {
+        // A slow consumer drops packets.  Every packet is either received,
+        // once and in order, or counted as overflowed.
+        const int nPackets{20000};
+        std::atomic<bool> done{false};
+        std::thread producer([&]()
+        {
+            for (int i = 0; i < nPackets; ++i)
+            {
+                auto accepted = handoff.try_push(makePacket(i));
+                if (i%64 == 0 && accepted){std::this_thread::yield();}
+            }
+            done.store(true);
+        });
+        std::vector<DataPacket> received;
+        while (!done.load() || !handoff.empty())
+        {
+            if (handoff.waitFor(std::chrono::milliseconds {1}))
+            {
+                handoff.pop_all(&received, 3);
+            }
+        }
+        producer.join();
+        REQUIRE(handoff.pop_all(&received) == 0);
+        auto nReceived = static_cast<uint64_t> (received.size());
+        REQUIRE(nReceived + handoff.getNumberOfOverflowedValues()
+             == static_cast<uint64_t> (nPackets));
+        bool increasing{true};
+        for (size_t i = 1; i < received.size(); ++i)
+        {
+            if (received[i].getStartTime() <= received[i - 1].getStartTime())
+            {
+                increasing = false;
+            }
+        }
+        REQUIRE(increasing);
+    }
+}
+
+TEST_CASE("URTS::Private::ReceiveBatch", "[ReceiveBatch]")
+{
+    // The frames on the wire.  The third cannot be deserialized.
+    std::vector<std::string> frames;
+    for (int i = 0; i < 5; ++i)
+    {
+        DataPacket packet;
+        packet.setNetwork("UU");
+        packet.setStation("STA" + std::to_string(i));
+        packet.setChannel("HHZ");
+        packet.setLocationCode("01");
+        packet.setSamplingRate(100);
+        packet.setStartTime(std::chrono::microseconds {i});
+        packet.setData(std::vector<double> (10, i));
+        frames.push_back(packet.toMessage());
+    }
+    frames[2] = "not a data packet";
+    size_t nextFrame{0};
+    std::vector<DataPacket> packets;
+    auto receive = [&](const int)
+    {
+        if (nextFrame == frames.size()){return 0;} // Time out
+        // Like a subscriber, the frame is consumed before it is deserialized
+        const auto &frame = frames.at(nextFrame);
+        nextFrame = nextFrame + 1;
+        DataPacket packet;
+        packet.fromMessage(frame);
+        packets.push_back(std::move(packet));
+        return 1;
+    };
+    std::vector<std::string> errors;
+    auto onError = [&](const std::exception &e)
+    {
+        errors.push_back(e.what());
+    };
+
+    SECTION("Bad frame among good ones")
+    {
+        auto nReceived = ::receiveBatch(receive, onError, 100,
+                                        std::chrono::seconds {10});
+        REQUIRE(nReceived == 4);
+        REQUIRE(errors.size() == 1);
+        REQUIRE(nextFrame == frames.size());
+        REQUIRE(packets.size() == 4);
+        const std::vector<int> expected{0, 1, 3, 4};
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            REQUIRE(packets[i].getStation() ==
+                    "STA" + std::to_string(expected[i]));
+            REQUIRE(packets[i].getData() ==
+                    std::vector<double> (10, expected[i]));
+        }
+    }
+
+    SECTION("Limit")
+    {
+        // The bad frame counts toward the limit but is not returned
+        auto nReceived = ::receiveBatch(receive, onError, 3,
+                                        std::chrono::seconds {10});
+        REQUIRE(nReceived == 2);
+        REQUIRE(errors.size() == 1);
+        REQUIRE(nextFrame == 3);
+        nReceived = ::receiveBatch(receive, onError, 3,
+                                   std::chrono::seconds {10});
+        REQUIRE(nReceived == 2);
+        REQUIRE(errors.size() == 1);
+        REQUIRE(packets.size() == 4);
+        REQUIRE(packets.back().getStation() == "STA4");
+        REQUIRE(::receiveBatch(receive, onError, 3,
+                               std::chrono::seconds {10}) == 0);
+    }
+
+    SECTION("Multiple messages per receive")
+    {
+        // E.g., a data packet batch spread over several receives
+        int nAvailable{7};
+        auto receiveMany = [&](const int nRemaining)
+        {
+            auto n = std::min(std::min(nRemaining, 3), nAvailable);
+            nAvailable = nAvailable - n;
+            return n;
+        };
+        REQUIRE(::receiveBatch(receiveMany, onError, 5,
+                               std::chrono::seconds {10}) == 5);
+        REQUIRE(::receiveBatch(receiveMany, onError, 5,
+                               std::chrono::seconds {10}) == 2);
+        REQUIRE(errors.empty());
+    }
+
+    REQUIRE_THROWS(::receiveBatch(receive, onError, 0,
+                                  std::chrono::seconds {10}));
+}
+
+TEST_CASE("URTS::Private::ThreadSafeQueue", "[ThreadSafeQueue]")
+{
+    ::ThreadSafeQueue<std::vector<double>> queue;
+    std::vector<std::vector<double>> values;
+    for (int i = 0; i < 5; ++i)
+    {
+        values.push_back(std::vector<double> (3, i));
+    }
+    const auto capacity = values.capacity();
+    queue.push(std::vector<double> (3, -1));
+    queue.push_all(&values);
+    REQUIRE(values.empty());
+    REQUIRE(values.capacity() == capacity);
+    // An empty push does nothing
+    queue.push_all(&values);
+    REQUIRE(queue.size() == 6);
+    std::vector<double> value;
+    for (int i = -1; i < 5; ++i)
+    {
+        queue.wait_and_pop(&value);
+        REQUIRE(value == std::vector<double> (3, i));
+    }
+    REQUIRE(queue.empty());
+
+    SECTION("Threads")
+    {
+        // A consumer sees every value of every batch once and in order
+        const int nBatches{2000};
+        const int batchSize{7};
+        std::thread producer([&]()
+        {
+            std::vector<std::vector<double>> batch;
+            for (int iBatch = 0; iBatch < nBatches; ++iBatch)
+            {
+                for (int i = 0; i < batchSize; ++i)
+                {
+                    batch.push_back(
+                        std::vector<double> (1, iBatch*batchSize + i));
+                }
+                queue.push_all(&batch);
+            }
+        });
+        bool inOrder{true};
+        for (int i = 0; i < nBatches*batchSize; ++i)
+        {
+            queue.wait_and_pop(&value);
+            if (value.size() != 1 || value[0] != i){inOrder = false;}
+        }
+        producer.join();
+        REQUIRE(inOrder);
+        REQUIRE(queue.empty());
+    }
+}
+
+TEST_CASE("URTS::Broadcasts::Internal::DataPacket", "[DataPacketBatch]")
+{
+    const std::string messageType{"URTS::Broadcasts::Internal::DataPacket::DataPacketBatch"};
+    const int nPackets{25};
+    std::vector<DataPacket> packets;
+    for (int i = 0; i < nPackets; ++i)
+    {
+        DataPacket packet;
+        packet.setNetwork("UU");
+        packet.setStation("STA" + std::to_string(i));
+        packet.setChannel("HHZ");
+        packet.setLocationCode("01");
+        packet.setSamplingRate(100);
+        packet.setStartTime(std::chrono::microseconds {1628803598000000 + i});
+        packet.setData(std::vector<double> (i, i)); // First packet is empty
+        packets.push_back(std::move(packet));
+    }
+
+    DataPacketBatch batch;
+    CHECK(batch.getMessageType() == messageType);
+    CHECK(batch.empty());
+    for (const auto &packet : packets)
+    {
+        REQUIRE_NOTHROW(batch.addPacket(packet));
+    }
+    CHECK(batch.getNumberOfPackets() == nPackets);
+    CHECK_THROWS_AS(batch.addPacket(DataPacket {}), std::invalid_argument);
+    CHECK(batch.getNumberOfPackets() == nPackets);
+
+    auto message = batch.toMessage();
+    DataPacketBatch batchBack;
+    REQUIRE_NOTHROW(batchBack.fromMessage(message));
+    const auto &packetsBack = batchBack.getPacketsReference();
+    REQUIRE(static_cast<int> (packetsBack.size()) == nPackets);
+    for (int i = 0; i < nPackets; ++i)
+    {
+        CHECK(packetsBack[i].getStation() == packets[i].getStation());
+        CHECK(packetsBack[i].getStartTime() == packets[i].getStartTime());
+        CHECK(packetsBack[i].getSamplingRate() ==
+              packets[i].getSamplingRate());
+        CHECK(packetsBack[i].getData() == packets[i].getData());
+    }
+
+    SECTION("Invalid messages")
+    {
+    // Corrupt messages are rejected and leave the batch be
+    auto truncated = message.substr(0, message.size() - 1);
+    CHECK_THROWS_AS(batchBack.fromMessage(truncated), std::runtime_error);
+    auto hugeCount = message;
+    hugeCount[11] = static_cast<char> (0x7F);
+    CHECK_THROWS_AS(batchBack.fromMessage(hugeCount), std::runtime_error);
+    CHECK_THROWS_AS(batchBack.fromMessage(packets[1].toMessage()),
+                    std::runtime_error);
+    CHECK(batchBack.getNumberOfPackets() == nPackets);
+    }
+
+    SECTION("Move packets")
+    {
+    auto moved = batchBack.movePackets();
+    CHECK(static_cast<int> (moved.size()) == nPackets);
+    CHECK(batchBack.empty());
+    DataPacketBatch emptyBatch;
+    REQUIRE_NOTHROW(emptyBatch.fromMessage(DataPacketBatch {}.toMessage()));
+    CHECK(emptyBatch.empty());
     }
 }
@@ -214,6 +214,41 @@ TEST_CASE("URTS::Broadcasts::Internal::Origin", "[origin]")
                            - *arrivals[i].getSignalToNoiseRatio()) < 1.e-10);
         }
     }
+
+    SECTION("serialize into buffer")
+    {
+        URTS::Broadcasts::Internal::Pick::UncertaintyBound lowerBound;
+        lowerBound.setPercentile(5);
+        lowerBound.setPerturbation(std::chrono::microseconds {-1500});
+        URTS::Broadcasts::Internal::Pick::UncertaintyBound upperBound;
+        upperBound.setPercentile(95);
+        upperBound.setPerturbation(std::chrono::microseconds {2500});
+        arrivals[0].setLowerAndUpperUncertaintyBound(
+            std::pair {lowerBound, upperBound});
+        origin.setArrivals(arrivals);
+
+        std::string buffer(8192, 'x');
+        REQUIRE_THROWS(origin.serializeInto(nullptr));
+        origin.serializeInto(&buffer);
+        REQUIRE(buffer == origin.toMessage());
+        auto capacity = buffer.capacity();
+        origin.serializeInto(&buffer);
+        REQUIRE(buffer.capacity() == capacity);
+
+        Origin copy;
+        copy.fromMessage(buffer);
+        auto arrivalsBack = copy.getArrivals();
+        REQUIRE(arrivalsBack.size() == arrivals.size());
+        auto bounds = arrivalsBack[0].getLowerAndUpperUncertaintyBound();
+        REQUIRE(bounds);
+        REQUIRE(std::abs(bounds->first.getPercentile() - 5) < 1.e-14);
+        REQUIRE(bounds->first.getPerturbation() == 
+                lowerBound.getPerturbation());
+        REQUIRE(std::abs(bounds->second.getPercentile() - 95) < 1.e-14);
+        REQUIRE(bounds->second.getPerturbation() ==
+                upperBound.getPerturbation());
+        REQUIRE(!arrivalsBack[1].getLowerAndUpperUncertaintyBound());
+    }
 }
 
 TEST_CASE("URTS::Broadcasts::Internal::Origin", "[subscriber_options]")
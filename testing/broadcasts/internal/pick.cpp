@@ -120,6 +120,36 @@ TEST_CASE("URTS::Broadcasts::Internal::Pick", "[pick]")
         REQUIRE(upperBoundRef.getPerturbation() ==
                 upperBound.getPerturbation());
     }
+
+    SECTION("serialize into buffer")
+    {
+        std::string buffer(4096, 'x');
+        REQUIRE_THROWS(pick.serializeInto(nullptr));
+        pick.serializeInto(&buffer);
+        REQUIRE(buffer == pick.toMessage());
+        auto capacity = buffer.capacity();
+        pick.serializeInto(&buffer);
+        REQUIRE(buffer.capacity() == capacity);
+
+        // Optional information is written as null
+        Pick minimalPick;
+        minimalPick.setIdentifier(pickID);
+        minimalPick.setTime(time);
+        minimalPick.setNetwork(network);
+        minimalPick.setStation(station);
+        minimalPick.setChannel(channel);
+        minimalPick.setLocationCode(locationCode);
+        minimalPick.serializeInto(&buffer);
+        Pick copy;
+        REQUIRE_NOTHROW(copy.fromMessage(buffer));
+        REQUIRE(copy.getIdentifier() == pickID);
+        REQUIRE(copy.getTime() == timeRef);
+        REQUIRE(copy.getStation() == station);
+        REQUIRE(!copy.haveSignalToNoiseRatio());
+        REQUIRE(!copy.haveLowerAndUpperUncertaintyBound());
+        REQUIRE(copy.getPhaseHint().empty());
+        REQUIRE(copy.getOriginalChannels().empty());
+    }
 }
 
 TEST_CASE("URTS::Broadcasts::Internal::Pick", "[subscriber_options]")
@@ -4,10 +4,12 @@
 #include <vector>
 #include <chrono>
 #include <limits>
+#include <bit>
 #include <umps/authentication/zapOptions.hpp>
 #include "urts/broadcasts/internal/probabilityPacket/probabilityPacket.hpp"
 #include "urts/broadcasts/internal/probabilityPacket/subscriberOptions.hpp"
 #include "urts/broadcasts/internal/probabilityPacket/publisherOptions.hpp"
+#include "private/cborReader.hpp"
 #include <gtest/gtest.h>
 namespace
 {
@@ -97,6 +99,147 @@ TEST(BroadcastsInternalProbabilityPacket, probabilityPacket)
     }
 }
 
+TEST(BroadcastsInternalProbabilityPacket, CompactEncoding)
+{
+    const std::vector<double> probabilities{0, 1.e-6, 0.1, 0.25, 0.5,
+                                            0.75, 0.9, 0.999999, 1};
+    ProbabilityPacket packet;
+    packet.setNetwork("UU");
+    packet.setStation("FORK");
+    packet.setChannel("HHP");
+    packet.setLocationCode("01");
+    packet.setStartTime(1628803598.);
+    packet.setAlgorithm("UNet");
+    packet.setOriginalChannels(std::vector<std::string> {"HHZ"});
+    packet.setPositiveClassName("P");
+    packet.setNegativeClassName("Noise");
+    packet.setSamplingRate(100);
+    packet.setData(probabilities);
+    EXPECT_EQ(packet.getEncoding(), ProbabilityPacket::Encoding::Float64);
+    EXPECT_EQ(packet.getMessageVersion(), "1.0.0");
+    auto float64Message = packet.toMessage();
+
+    for (const auto encoding : {ProbabilityPacket::Encoding::Float32,
+                                ProbabilityPacket::Encoding::UInt16})
+    {
+        packet.setEncoding(encoding);
+        EXPECT_EQ(packet.getMessageVersion(), "2.0.0");
+        auto message = packet.toMessage();
+        EXPECT_LT(message.size(), float64Message.size());
+        ProbabilityPacket packetBack;
+        EXPECT_NO_THROW(packetBack.fromMessage(message));
+        EXPECT_EQ(packetBack.getEncoding(), encoding);
+        EXPECT_EQ(packetBack.getStartTime(), packet.getStartTime());
+        EXPECT_EQ(packetBack.getEndTime(), packet.getEndTime());
+        EXPECT_EQ(packetBack.getOriginalChannels(),
+                  packet.getOriginalChannels());
+        auto tol = (encoding == ProbabilityPacket::Encoding::UInt16) ?
+                   0.5/65535 : 1.e-7;
+        const auto &dataBack = packetBack.getDataReference();
+        ASSERT_EQ(dataBack.size(), probabilities.size());
+        for (int i = 0; i < static_cast<int> (dataBack.size()); ++i)
+        {
+            EXPECT_NEAR(dataBack[i], probabilities[i], tol);
+        }
+        // End points are exact
+        EXPECT_EQ(dataBack.front(), 0.0);
+        EXPECT_EQ(dataBack.back(), 1.0);
+    }
+
+    // Fixed-point values are clamped to [0,1]
+    packet.setEncoding(ProbabilityPacket::Encoding::UInt16);
+    packet.setData(std::vector<double> {-0.1, 1.1});
+    ProbabilityPacket packetBack;
+    packetBack.fromMessage(packet.toMessage());
+    EXPECT_EQ(packetBack.getData(), (std::vector<double> {0, 1}));
+
+    // The Float64 encoding is still the version 1 message
+    packetBack.fromMessage(float64Message);
+    EXPECT_EQ(packetBack.getEncoding(), ProbabilityPacket::Encoding::Float64);
+    EXPECT_EQ(packetBack.getData(), probabilities);
+
+    // Serializing into a buffer matches the message and reuses the buffer
+    std::string buffer(4096, 'x');
+    EXPECT_THROW(packet.serializeInto(nullptr), std::invalid_argument);
+    packet.serializeInto(&buffer);
+    EXPECT_EQ(buffer, packet.toMessage());
+    auto capacity = buffer.capacity();
+    packet.setEncoding(ProbabilityPacket::Encoding::Float64);
+    packet.serializeInto(&buffer);
+    EXPECT_EQ(buffer, packet.toMessage());
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST(BroadcastsInternalProbabilityPacket, CBORReader)
+{
+    // Nested single element arrays around an integer
+    auto nest = [](const int depth)
+    {
+        std::vector<uint8_t> message(depth, 0x81);
+        message.push_back(0x00);
+        return message;
+    };
+    auto message = nest(64);
+    ::CBORReader reader(message.data(), message.size());
+    EXPECT_NO_THROW(reader.skip());
+    EXPECT_TRUE(reader.atEnd());
+    message = nest(100000);
+    ::CBORReader deepReader(message.data(), message.size());
+    EXPECT_THROW(deepReader.skip(), std::runtime_error);
+
+    // A map with 2^63 pairs would overflow the number of items to skip
+    message = {0xBB, 0x80, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x00};
+    ::CBORReader hugeMapReader(message.data(), message.size());
+    EXPECT_THROW(hugeMapReader.skip(), std::runtime_error);
+
+    // Bytes after the root map are rejected but nested maps are fine
+    auto readMap = [](const std::vector<uint8_t> &message)
+    {
+        ::CBORReader reader(message.data(), message.size());
+        int nKeys = 0;
+        reader.readMap([&](const std::string_view &key)
+        {
+            nKeys = nKeys + 1;
+            if (key != "m"){return false;}
+            reader.readMap([&](const std::string_view &)
+            {
+                nKeys = nKeys + 1;
+                return false;
+            });
+            return true;
+        });
+        return nKeys;
+    };
+    // {"a": 1, "m": {"b": 2}}
+    message = {0xA2, 0x61, 'a', 0x01, 0x61, 'm', 0xA1, 0x61, 'b', 0x02};
+    EXPECT_EQ(readMap(message), 3);
+    message.push_back(0x00);
+    EXPECT_THROW(readMap(message), std::runtime_error);
+
+    // Floating point integers must be finite and fit in an int64_t
+    auto readInteger = [](const double value)
+    {
+        std::vector<uint8_t> message{0xFB};
+        auto bits = std::bit_cast<uint64_t> (value);
+        for (int i = 7; i >= 0; --i)
+        {
+            message.push_back(static_cast<uint8_t> (bits >> (8*i)));
+        }
+        ::CBORReader reader(message.data(), message.size());
+        return reader.readInteger();
+    };
+    EXPECT_EQ(readInteger(3), 3);
+    EXPECT_EQ(readInteger(-3), -3);
+    EXPECT_EQ(readInteger(-9223372036854775808.0),
+              std::numeric_limits<int64_t>::lowest());
+    EXPECT_THROW(readInteger(9223372036854775808.0), std::runtime_error);
+    EXPECT_THROW(readInteger(-1.e19), std::runtime_error);
+    EXPECT_THROW(readInteger(std::numeric_limits<double>::quiet_NaN()),
+                 std::runtime_error);
+    EXPECT_THROW(readInteger(std::numeric_limits<double>::infinity()),
+                 std::runtime_error);
+}
+
 TEST(BroadcastsInternalProbabilityPacket, SubscriberOptions)
 {
     const std::string address{"tcp://127.0.0.1:5550"};
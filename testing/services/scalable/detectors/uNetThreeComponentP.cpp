@@ -303,6 +303,20 @@ TEST(ServicesScalableDetectorsUNetThreeComponentP, ProcessingResponse)
     {
         EXPECT_NEAR(probabilitySignal.at(i), p.at(i), 1.e-7);
     }
+    auto view = copy.getProbabilitySignalView();
+    ASSERT_EQ(view.size(), probabilitySignal.size());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(),
+                           probabilitySignal.begin()));
+    const auto &reference = copy.getProbabilitySignalReference();
+    EXPECT_EQ(reference, probabilitySignal);
+    EXPECT_EQ(&copy.getProbabilitySignalReference(), &reference);
+    auto copyOfCopy = copy;
+    EXPECT_EQ(&copyOfCopy.getProbabilitySignalReference(), &reference);
+
+    // Unaligned messages are copied rather than viewed
+    auto message = std::string(1, '\0') + response.toMessage();
+    EXPECT_NO_THROW(copy.fromMessage(message.data() + 1, message.size() - 1));
+    EXPECT_EQ(copy.getProbabilitySignal(), probabilitySignal);
 
     response.clear();
     EXPECT_NEAR(response.getSamplingRate(), 100, 1.e-14);
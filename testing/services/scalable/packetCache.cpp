@@ -1,10 +1,21 @@
 #include <fstream>
+#include <filesystem>
 #include <cmath>
+#include <cstring>
 #include <random>
 #include <limits>
+#include <numeric>
+#include <tuple>
+#include <array>
+#include <set>
+#include <bit>
+#include <nlohmann/json.hpp>
 #include <umps/authentication/zapOptions.hpp>
 #include "urts/services/scalable/packetCache/bulkDataRequest.hpp"
 #include "urts/services/scalable/packetCache/bulkDataResponse.hpp"
+#include "urts/services/scalable/packetCache/cappedCollection.hpp"
+#include "urts/services/scalable/packetCache/circularBuffer.hpp"
+#include "urts/services/scalable/packetCache/packetView.hpp"
 #include "urts/services/scalable/packetCache/dataRequest.hpp"
 #include "urts/services/scalable/packetCache/dataResponse.hpp"
 #include "urts/services/scalable/packetCache/requestorOptions.hpp"
@@ -13,10 +24,17 @@
 #include "urts/services/scalable/packetCache/serviceOptions.hpp"
 #include "urts/services/scalable/packetCache/service.hpp"
 #include "urts/services/scalable/packetCache/singleComponentWaveform.hpp"
+#include "urts/services/scalable/packetCache/subscriptionPacket.hpp"
 #include "urts/services/scalable/packetCache/threeComponentWaveform.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformRequest.hpp"
+#include "urts/services/scalable/packetCache/threeComponentWaveformResponse.hpp"
 #include "urts/services/scalable/packetCache/wigginsInterpolator.hpp"
 #include "urts/broadcasts/internal/dataPacket/dataPacket.hpp"
+#include "urts/broadcasts/internal/dataPacket/publisherOptions.hpp"
 #include "urts/broadcasts/internal/dataPacket/subscriberOptions.hpp"
+#include "urts/services/scalable/packetCache/packetSummary.hpp"
+#include "private/sampleCodec.hpp"
+#include "services/scalable/packetCache/threeComponentWaveformMemo.hpp"
 #include <gtest/gtest.h>
 
 namespace
@@ -233,6 +251,31 @@ TEST(ServicesScalablePacketCache, DataRequest)
     auto [timeStart, timeEnd] = requestCopy.getQueryTimes();
     EXPECT_NEAR(timeStart, t0, 1.e-5);
     EXPECT_NEAR(timeEnd,   t1, 1.e-5);
+    EXPECT_FALSE(requestCopy.haveSensorIdentifier());
+
+    const uint64_t sensorIdentifier{(static_cast<uint64_t> (7) << 32) | 3};
+    request.setSensorIdentifier(sensorIdentifier);
+    message = request.toMessage();
+    EXPECT_NO_THROW(requestCopy.fromMessage(message));
+    EXPECT_TRUE(requestCopy.haveSensorIdentifier());
+    EXPECT_EQ(requestCopy.getSensorIdentifier(), sensorIdentifier);
+    EXPECT_FALSE(requestCopy.haveCursor());
+
+    request.setCursor(43);
+    EXPECT_NO_THROW(requestCopy.fromMessage(request.toMessage()));
+    EXPECT_EQ(requestCopy.getCursor(), 43);
+    EXPECT_FALSE(requestCopy.haveCursorEndTime());
+
+    const std::chrono::microseconds cursorEndTime{1629737865250000};
+    request.setCursor(44, cursorEndTime);
+    EXPECT_NO_THROW(requestCopy.fromMessage(request.toMessage()));
+    EXPECT_EQ(requestCopy.getCursor(), 44);
+    EXPECT_TRUE(requestCopy.haveCursorEndTime());
+    EXPECT_EQ(requestCopy.getCursorEndTime(), cursorEndTime);
+    request.setCursor(45);
+    EXPECT_FALSE(request.haveCursorEndTime());
+    EXPECT_THROW(auto endTime = request.getCursorEndTime(),
+                 std::runtime_error);
 }
 
 TEST(ServicesScalablePacketCache, DataResponse)
@@ -297,6 +340,47 @@ TEST(ServicesScalablePacketCache, DataResponse)
         EXPECT_TRUE(packetsBack.at(i) == dataPackets.at(i));
     }
 
+    // Set the packets as shared views
+    std::vector<PacketView> views;
+    for (auto it = dataPackets.rbegin(); it != dataPackets.rend(); ++it)
+    {
+        auto data = std::make_shared<std::vector<double>> (it->getData());
+        views.emplace_back(it->getStartTime(), it->getSamplingRate(),
+                           it->getNumberOfSamples(),
+                           std::shared_ptr<const double> (data, data->data()));
+    }
+    EXPECT_THROW(response.setPacketViews("", station, channel, locationCode,
+                                         std::vector<PacketView> (views)),
+                 std::invalid_argument);
+    response.setPacketViews(network, station, channel, locationCode,
+                            std::move(views));
+    EXPECT_EQ(response.getNetwork(), network);
+    EXPECT_EQ(response.getStation(), station);
+    EXPECT_EQ(response.getChannel(), channel);
+    EXPECT_EQ(response.getLocationCode(), locationCode);
+    EXPECT_EQ(response.getNumberOfPackets(),
+              static_cast<int> (dataPackets.size()));
+    packetsBack = response.getPackets();
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack.at(i) == dataPackets.at(i));
+    }
+    EXPECT_NO_THROW(responseCopy.fromMessage(response.toMessage()));
+    packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack.at(i) == dataPackets.at(i));
+    }
+    EXPECT_FALSE(responseCopy.haveSensorIdentifier());
+    const uint64_t sensorIdentifier{(static_cast<uint64_t> (9) << 32) | 12};
+    response.setSensorIdentifier(sensorIdentifier);
+    EXPECT_NO_THROW(responseCopy.fromMessage(response.toMessage()));
+    EXPECT_TRUE(responseCopy.haveSensorIdentifier());
+    EXPECT_EQ(responseCopy.getSensorIdentifier(), sensorIdentifier);
+    EXPECT_EQ(responseCopy.getNumberOfPackets(),
+              static_cast<int> (dataPackets.size()));
+
     // See what happens when multiple packets start at same time.
     // This shouldn't result in a sort.
     dataPackets[0].setStartTime(0);
@@ -309,6 +393,317 @@ TEST(ServicesScalablePacketCache, DataResponse)
     }
 }
 
+TEST(ServicesScalablePacketCache, DataResponseViews)
+{
+    const std::string network{"UU"};
+    const std::string station{"VRUT"};
+    const std::string locationCode{"01"};
+    const uint64_t id{594382};
+    std::vector<UDP::DataPacket> dataPackets;
+    int64_t startTime{1700000000000000};
+    for (const auto &nSamples : std::vector<int> {100, 37, 1, 250})
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel("EHZ");
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(std::chrono::microseconds {startTime});
+        std::vector<double> data(nSamples);
+        std::iota(data.begin(), data.end(), -0.5*nSamples);
+        dataPacket.setData(std::move(data));
+        dataPackets.push_back(std::move(dataPacket));
+        startTime = startTime + nSamples*10000;
+    }
+    DataResponse response;
+    response.setPackets(dataPackets);
+    response.setIdentifier(id);
+    response.setReturnCode(DataResponse::ReturnCode::Success);
+
+    // Adopting the message lets the packets point into it
+    auto message = response.toMessage();
+    const auto messageBegin = reinterpret_cast<uintptr_t> (message.data());
+    const auto messageEnd = messageBegin + message.size();
+    DataResponse responseCopy;
+    EXPECT_NO_THROW(responseCopy.fromMessage(std::move(message)));
+    const auto &views = responseCopy.getPacketViewsReference();
+    ASSERT_EQ(views.size(), dataPackets.size());
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        auto data = dataPackets[i].getData();
+        ASSERT_EQ(views[i].getNumberOfSamples(),
+                  static_cast<int> (data.size()));
+        EXPECT_TRUE(std::equal(data.begin(), data.end(),
+                               views[i].getDataPointer()));
+        auto pointer = reinterpret_cast<uintptr_t> (views[i].getDataPointer());
+        EXPECT_EQ(pointer%alignof(double), 0);
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            EXPECT_TRUE(pointer >= messageBegin && pointer < messageEnd);
+        }
+    }
+    // The views outlive the response
+    auto viewsCopy = views;
+    responseCopy.clear();
+    EXPECT_TRUE(std::equal(viewsCopy.back().getDataPointer(),
+                           viewsCopy.back().getDataPointer()
+                         + viewsCopy.back().getNumberOfSamples(),
+                           dataPackets.back().getData().begin()));
+
+    // Unaligned messages are copied
+    message = std::string(1, '\0') + response.toMessage();
+    EXPECT_NO_THROW(responseCopy.fromMessage(message.data() + 1,
+                                             message.size() - 1));
+    auto packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+    }
+
+    // The previous version wrote the samples as arrays of doubles
+    nlohmann::json legacy;
+    legacy["MessageType"] = response.getMessageType();
+    legacy["MessageVersion"] = "1.0.0";
+    legacy["NumberOfPackets"] = dataPackets.size();
+    legacy["Network"] = network;
+    legacy["Station"] = station;
+    legacy["Channel"] = "EHZ";
+    legacy["LocationCode"] = locationCode;
+    for (const auto &dataPacket : dataPackets)
+    {
+        nlohmann::json packet;
+        packet["StartTime"] = dataPacket.getStartTime().count();
+        packet["SamplingRate"] = dataPacket.getSamplingRate();
+        packet["Data"] = dataPacket.getData();
+        legacy["Packets"].push_back(std::move(packet));
+    }
+    legacy["Identifier"] = id;
+    legacy["ReturnCode"] = static_cast<int> (DataResponse::ReturnCode::Success);
+    auto legacyMessage = nlohmann::json::to_cbor(legacy);
+    EXPECT_NO_THROW(responseCopy.fromMessage(
+        std::string(legacyMessage.begin(), legacyMessage.end())));
+    packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+    }
+
+    // Bulk responses also adopt the message
+    BulkDataResponse bulkResponse;
+    bulkResponse.addDataResponse(response);
+    bulkResponse.addDataResponse(response);
+    bulkResponse.setIdentifier(id);
+    bulkResponse.setReturnCode(BulkDataResponse::ReturnCode::Success);
+    message = bulkResponse.toMessage();
+    const auto bulkBegin = reinterpret_cast<uintptr_t> (message.data());
+    const auto bulkEnd = bulkBegin + message.size();
+    BulkDataResponse bulkCopy;
+    EXPECT_NO_THROW(bulkCopy.fromMessage(std::move(message)));
+    ASSERT_EQ(bulkCopy.getNumberOfDataResponses(), 2);
+    for (const auto &r : bulkCopy.getDataResponses())
+    {
+        packetsBack = r.getPackets();
+        ASSERT_EQ(packetsBack.size(), dataPackets.size());
+        for (size_t i = 0; i < packetsBack.size(); ++i)
+        {
+            EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+            auto pointer = reinterpret_cast<uintptr_t>
+                           (r.getPacketViewsReference()[i].getDataPointer());
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                EXPECT_TRUE(pointer >= bulkBegin && pointer < bulkEnd);
+            }
+        }
+    }
+}
+
+TEST(ServicesScalablePacketCache, CompressedDataResponse)
+{
+    const uint64_t id{594383};
+    std::vector<UDP::DataPacket> dataPackets;
+    int64_t startTime{1700000000000000};
+    for (const auto &nSamples : std::vector<int> {200, 37, 1, 250})
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork("UU");
+        dataPacket.setStation("VRUT");
+        dataPacket.setChannel("HHZ");
+        dataPacket.setLocationCode("01");
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(std::chrono::microseconds {startTime});
+        std::vector<double> data(nSamples);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            data[i] = std::round(5000*std::sin(0.1*i)) + 1200000;
+        }
+        // Real-valued samples are written as doubles
+        if (nSamples == 37){data[3] = 0.25;}
+        dataPacket.setData(std::move(data));
+        dataPackets.push_back(std::move(dataPacket));
+        startTime = startTime + nSamples*10000;
+    }
+    DataResponse response;
+    response.setPackets(dataPackets);
+    response.setIdentifier(id);
+    response.setReturnCode(DataResponse::ReturnCode::Success);
+    EXPECT_FALSE(response.useSampleCompression());
+    auto rawMessage = response.toMessage();
+    response.setSampleCompression(true);
+    auto message = response.toMessage();
+    EXPECT_LT(2*message.size(), rawMessage.size());
+
+    DataResponse responseCopy;
+    EXPECT_NO_THROW(responseCopy.fromMessage(std::move(message)));
+    EXPECT_TRUE(responseCopy.useSampleCompression());
+    EXPECT_EQ(responseCopy.getIdentifier(), id);
+    auto packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+    }
+    EXPECT_NO_THROW(responseCopy.fromMessage(rawMessage));
+    EXPECT_FALSE(responseCopy.useSampleCompression());
+
+    // The bulk response's setting applies to all its responses
+    response.setSampleCompression(false);
+    BulkDataResponse bulkResponse;
+    bulkResponse.addDataResponse(response);
+    bulkResponse.addDataResponse(response);
+    bulkResponse.setIdentifier(id);
+    bulkResponse.setReturnCode(BulkDataResponse::ReturnCode::Success);
+    auto rawBulkMessage = bulkResponse.toMessage();
+    bulkResponse.setSampleCompression(true);
+    EXPECT_TRUE(bulkResponse.useSampleCompression());
+    message = bulkResponse.toMessage();
+    EXPECT_LT(2*message.size(), rawBulkMessage.size());
+    BulkDataResponse bulkCopy;
+    EXPECT_NO_THROW(bulkCopy.fromMessage(std::move(message)));
+    ASSERT_EQ(bulkCopy.getNumberOfDataResponses(), 2);
+    for (const auto &r : bulkCopy.getDataResponses())
+    {
+        EXPECT_TRUE(r.useSampleCompression());
+        packetsBack = r.getPackets();
+        ASSERT_EQ(packetsBack.size(), dataPackets.size());
+        for (size_t i = 0; i < packetsBack.size(); ++i)
+        {
+            EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+        }
+    }
+}
+
+TEST(ServicesScalablePacketCache, CompactDataResponse)
+{
+    const uint64_t id{594384};
+    std::vector<UDP::DataPacket> dataPackets;
+    int64_t startTime{1700000000000000};
+    for (const auto &nSamples : std::vector<int> {200, 37, 0, 1, 250})
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork("UU");
+        dataPacket.setStation("VRUT");
+        dataPacket.setChannel("HHZ");
+        dataPacket.setLocationCode("01");
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(std::chrono::microseconds {startTime});
+        std::vector<double> data(nSamples);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            data[i] = std::round(5000*std::sin(0.1*i)) - 1200000;
+        }
+        dataPacket.setData(std::move(data));
+        dataPackets.push_back(std::move(dataPacket));
+        startTime = startTime + std::max(1, nSamples)*10000;
+    }
+    DataResponse response;
+    response.setPackets(dataPackets);
+    response.setIdentifier(id);
+    response.setCursor(8, std::chrono::microseconds {-4000000});
+    response.setReturnCode(DataResponse::ReturnCode::Success);
+    EXPECT_FALSE(response.useCompactLayout());
+    auto rawMessage = response.toMessage();
+    response.setCompactLayout(true);
+    EXPECT_TRUE(response.useCompactLayout());
+    auto message = response.toMessage();
+    EXPECT_LT(message.size(), rawMessage.size());
+
+    DataResponse responseCopy;
+    EXPECT_NO_THROW(responseCopy.fromMessage(std::move(message)));
+    EXPECT_TRUE(responseCopy.useCompactLayout());
+    EXPECT_FALSE(responseCopy.useSampleCompression());
+    EXPECT_EQ(responseCopy.getIdentifier(), id);
+    EXPECT_EQ(responseCopy.getCursor(), 8);
+    EXPECT_EQ(responseCopy.getCursorEndTime(),
+              std::chrono::microseconds {-4000000});
+    EXPECT_EQ(responseCopy.getNetwork(), "UU");
+    EXPECT_EQ(responseCopy.getLocationCode(), "01");
+    auto packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+    }
+    // The views are contiguous in the single block of samples
+    const auto &views = responseCopy.getPacketViewsReference();
+    EXPECT_EQ(views[0].getDataPointer() + views[0].getNumberOfSamples(),
+              views[1].getDataPointer());
+    EXPECT_NO_THROW(responseCopy.fromMessage(rawMessage));
+    EXPECT_FALSE(responseCopy.useCompactLayout());
+
+    // Compressed compact layout
+    response.setSampleCompression(true);
+    message = response.toMessage();
+    EXPECT_LT(2*message.size(), rawMessage.size());
+    EXPECT_NO_THROW(responseCopy.fromMessage(std::move(message)));
+    EXPECT_TRUE(responseCopy.useCompactLayout());
+    EXPECT_TRUE(responseCopy.useSampleCompression());
+    packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), dataPackets.size());
+    for (size_t i = 0; i < packetsBack.size(); ++i)
+    {
+        EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+    }
+
+    // Differing sampling rates fall back to the packet layout
+    response.setSampleCompression(false);
+    auto mixedPackets = dataPackets;
+    mixedPackets.back().setSamplingRate(40);
+    response.setPackets(mixedPackets);
+    EXPECT_NO_THROW(responseCopy.fromMessage(response.toMessage()));
+    EXPECT_FALSE(responseCopy.useCompactLayout());
+    packetsBack = responseCopy.getPackets();
+    ASSERT_EQ(packetsBack.size(), mixedPackets.size());
+    EXPECT_TRUE(packetsBack.back() == mixedPackets.back());
+
+    // The bulk response's setting applies to all its responses
+    response.setPackets(dataPackets);
+    response.setCompactLayout(false);
+    BulkDataResponse bulkResponse;
+    bulkResponse.addDataResponse(response);
+    bulkResponse.addDataResponse(response);
+    bulkResponse.setIdentifier(id);
+    bulkResponse.setReturnCode(BulkDataResponse::ReturnCode::Success);
+    EXPECT_FALSE(bulkResponse.useCompactLayout());
+    bulkResponse.setCompactLayout(true);
+    EXPECT_TRUE(bulkResponse.useCompactLayout());
+    BulkDataResponse bulkCopy;
+    EXPECT_NO_THROW(bulkCopy.fromMessage(bulkResponse.toMessage()));
+    ASSERT_EQ(bulkCopy.getNumberOfDataResponses(), 2);
+    for (const auto &r : bulkCopy.getDataResponses())
+    {
+        EXPECT_TRUE(r.useCompactLayout());
+        packetsBack = r.getPackets();
+        ASSERT_EQ(packetsBack.size(), dataPackets.size());
+        for (size_t i = 0; i < packetsBack.size(); ++i)
+        {
+            EXPECT_TRUE(packetsBack[i] == dataPackets[i]);
+        }
+    }
+}
+
 TEST(ServicesScalablePacketCache, BulkDataRequest)
 {
     BulkDataRequest bulkRequest;
@@ -331,6 +726,7 @@ TEST(ServicesScalablePacketCache, BulkDataRequest)
     {
         EXPECT_NO_THROW(request.setChannel(channels.at(i)));
         request.setIdentifier(id + i); 
+        request.setCursor(10 + i, std::chrono::microseconds {1629737864000000});
         bulkRequest.addDataRequest(request);
     }   
     bulkRequest.setIdentifier(id);
@@ -358,6 +754,9 @@ TEST(ServicesScalablePacketCache, BulkDataRequest)
         auto [timeStart, timeEnd] = requestsPtr[i].getQueryTimes();
         EXPECT_NEAR(timeStart, t0, 1.e-5);
         EXPECT_NEAR(timeEnd,   t1, 1.e-5);
+        EXPECT_EQ(requestsPtr[i].getCursor(), 10 + i);
+        EXPECT_EQ(requestsPtr[i].getCursorEndTime(),
+                  std::chrono::microseconds {1629737864000000});
     }
 }
 
@@ -464,6 +863,1015 @@ TEST(ServicesScalablePacketCache, BulkDataResponse)
         }
         i = i + 1;
     }
+
+    // Empty responses (e.g., nothing new since the cursor) are retained
+    DataResponse emptyResponse;
+    emptyResponse.setIdentifier(id + 4);
+    emptyResponse.setCursor(12, std::chrono::microseconds {1629737865000000});
+    bulkResponse.addDataResponse(emptyResponse);
+    EXPECT_NO_THROW(brCopy.fromMessage(bulkResponse.toMessage()));
+    ASSERT_EQ(brCopy.getNumberOfDataResponses(), 4);
+    EXPECT_EQ(brCopy.getDataResponsesPointer()[3].getNumberOfPackets(), 0);
+    EXPECT_EQ(brCopy.getDataResponsesPointer()[3].getIdentifier(), id + 4);
+    EXPECT_EQ(brCopy.getDataResponsesPointer()[3].getCursor(), 12);
+    EXPECT_EQ(brCopy.getDataResponsesPointer()[3].getCursorEndTime(),
+              std::chrono::microseconds {1629737865000000});
+    EXPECT_FALSE(brCopy.getDataResponsesPointer()[0].haveCursorEndTime());
+}
+
+TEST(ServicesScalablePacketCache, ThreeComponentWaveformRequest)
+{
+    ThreeComponentWaveformRequest request;
+    const std::string network{"UU"};
+    const std::string station{"FORK"};
+    const std::string verticalChannel{"HHZ"};
+    const std::string northChannel{"HHN"};
+    const std::string eastChannel{"HHE"};
+    const std::string locationCode{"01"};
+    const std::pair<double, double> queryTimes{1600000000, 1600000010};
+    const double samplingRate{40};
+    const std::chrono::microseconds gapTolerance{30000};
+    const uint64_t id{5021};
+    EXPECT_NO_THROW(request.setNetwork(network));
+    EXPECT_NO_THROW(request.setStation(station));
+    EXPECT_NO_THROW(request.setVerticalChannel(verticalChannel));
+    EXPECT_NO_THROW(request.setNorthChannel(northChannel));
+    EXPECT_NO_THROW(request.setEastChannel(eastChannel));
+    EXPECT_NO_THROW(request.setLocationCode(locationCode));
+    EXPECT_THROW(request.setQueryTimes(std::pair {queryTimes.second,
+                                                  queryTimes.first}),
+                 std::invalid_argument);
+    EXPECT_FALSE(request.haveQueryTimes());
+    EXPECT_THROW(request.toMessage(), std::runtime_error);
+    EXPECT_NO_THROW(request.setQueryTimes(queryTimes));
+    EXPECT_NEAR(request.getSamplingRate(), 100, 1.e-14);
+    EXPECT_EQ(request.getGapTolerance(), std::chrono::microseconds {50000});
+    EXPECT_THROW(request.setSamplingRate(0), std::invalid_argument);
+    EXPECT_NO_THROW(request.setSamplingRate(samplingRate));
+    request.setGapTolerance(gapTolerance);
+    request.setIdentifier(id);
+    EXPECT_EQ(request.getMessageType(),
+         "URTS::Services::Scalable::PacketCache::ThreeComponentWaveformRequest");
+
+    auto message = request.toMessage();
+    ThreeComponentWaveformRequest requestCopy;
+    EXPECT_NO_THROW(requestCopy.fromMessage(message));
+    EXPECT_EQ(requestCopy.getNetwork(), network);
+    EXPECT_EQ(requestCopy.getStation(), station);
+    EXPECT_EQ(requestCopy.getVerticalChannel(), verticalChannel);
+    EXPECT_EQ(requestCopy.getNorthChannel(), northChannel);
+    EXPECT_EQ(requestCopy.getEastChannel(), eastChannel);
+    EXPECT_EQ(requestCopy.getLocationCode(), locationCode);
+    EXPECT_NEAR(requestCopy.getQueryTimes().first, queryTimes.first, 1.e-6);
+    EXPECT_NEAR(requestCopy.getQueryTimes().second, queryTimes.second, 1.e-6);
+    EXPECT_NEAR(requestCopy.getSamplingRate(), samplingRate, 1.e-14);
+    EXPECT_EQ(requestCopy.getGapTolerance(), gapTolerance);
+    EXPECT_EQ(requestCopy.getIdentifier(), id);
+}
+
+TEST(ServicesScalablePacketCache, ThreeComponentWaveformResponse)
+{
+    const std::vector<double> vertical{1, 2, 3, 4, 5};
+    const std::vector<double> north{6, 7, 8, 9, 10};
+    const std::vector<double> east{-1, -2, -3, -4, -5};
+    const std::vector<int8_t> gapIndicator{0, 0, 1, 1, 0};
+    const std::chrono::microseconds startTime{1600000000250000};
+    const double samplingRate{40};
+    const uint64_t id{5021};
+    ThreeComponentWaveformResponse response;
+    EXPECT_EQ(response.getNumberOfSamples(), 0);
+    EXPECT_THROW(response.setSignals(vertical, north,
+                                     std::vector<double> {1, 2},
+                                     gapIndicator),
+                 std::invalid_argument);
+    EXPECT_THROW(response.setSignals(vertical, north, east,
+                                     std::vector<int8_t> {0}),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(response.setSignals(vertical, north, east, gapIndicator));
+    response.setStartTime(startTime);
+    EXPECT_NO_THROW(response.setSamplingRate(samplingRate));
+    response.setIdentifier(id);
+    response.setReturnCode(ThreeComponentWaveformResponse::ReturnCode::Success);
+    EXPECT_EQ(response.getEndTime(), startTime + std::chrono::microseconds {100000});
+    EXPECT_TRUE(response.haveGaps());
+    EXPECT_EQ(response.getMessageType(),
+        "URTS::Services::Scalable::PacketCache::ThreeComponentWaveformResponse");
+
+    // Copies share the signals
+    auto responseCopy = response;
+    EXPECT_EQ(responseCopy.getVerticalSignalReference().data(),
+              response.getVerticalSignalReference().data());
+
+    auto message = response.toMessage();
+    ThreeComponentWaveformResponse responseBack;
+    EXPECT_NO_THROW(responseBack.fromMessage(message));
+    EXPECT_EQ(responseBack.getNumberOfSamples(),
+              static_cast<int> (vertical.size()));
+    EXPECT_EQ(responseBack.getStartTime(), startTime);
+    EXPECT_NEAR(responseBack.getSamplingRate(), samplingRate, 1.e-14);
+    EXPECT_EQ(responseBack.getIdentifier(), id);
+    EXPECT_EQ(responseBack.getReturnCode(),
+              ThreeComponentWaveformResponse::ReturnCode::Success);
+    EXPECT_EQ(responseBack.getVerticalSignalReference(), vertical);
+    EXPECT_EQ(responseBack.getNorthSignalReference(), north);
+    EXPECT_EQ(responseBack.getEastSignalReference(), east);
+    EXPECT_EQ(responseBack.getGapIndicatorReference(), gapIndicator);
+
+    // JSON should also work
+    EXPECT_NO_THROW(responseBack.fromJSON(response.toJSON()));
+    EXPECT_EQ(responseBack.getGapIndicatorReference(), gapIndicator);
+
+    // No data
+    response.clear();
+    response.setReturnCode(ThreeComponentWaveformResponse::ReturnCode::NoSensor);
+    message = response.toMessage();
+    EXPECT_NO_THROW(responseBack.fromMessage(message.data(), message.size()));
+    EXPECT_EQ(responseBack.getNumberOfSamples(), 0);
+    EXPECT_FALSE(responseBack.haveGaps());
+    EXPECT_THROW(auto t1 = responseBack.getEndTime(), std::runtime_error);
+    EXPECT_EQ(responseBack.getReturnCode(),
+              ThreeComponentWaveformResponse::ReturnCode::NoSensor);
+}
+
+TEST(ServicesScalablePacketCache, SubscriptionPacket)
+{
+    const std::string network{"UU"};
+    const std::string station{"CTU"};
+    const std::string channel{"HHZ"};
+    const std::string locationCode{"01"};
+    const std::chrono::microseconds startTime{1628803598000000};
+    const uint64_t sensorIdentifier{(uint64_t {7} << 32) | 3};
+    const uint64_t sequenceNumber{84};
+    const std::vector<double> data{1, 2, 3, 4.5, -6};
+    UDP::DataPacket dataPacket;
+    dataPacket.setNetwork(network);
+    dataPacket.setStation(station);
+    dataPacket.setChannel(channel);
+    SubscriptionPacket packet;
+    EXPECT_FALSE(packet.havePacket());
+    EXPECT_THROW(packet.setPacket(dataPacket), std::invalid_argument);
+    dataPacket.setLocationCode(locationCode);
+    EXPECT_THROW(packet.setPacket(dataPacket), std::invalid_argument);
+    dataPacket.setSamplingRate(100);
+    dataPacket.setStartTime(startTime);
+    dataPacket.setData(data);
+    EXPECT_NO_THROW(packet.setPacket(dataPacket));
+    packet.setSensorIdentifier(sensorIdentifier);
+    packet.setSequenceNumber(sequenceNumber);
+    // The sensor is the topic so subscribers only receive their sensors
+    EXPECT_EQ(packet.getTopic(), "UU.CTU.HHZ.01");
+    EXPECT_EQ(packet.getMessageType(),
+              "URTS::Services::Scalable::PacketCache::SubscriptionPacket::UU.CTU.HHZ.01.");
+    EXPECT_EQ(packet.createInstance()->getMessageType(),
+              packet.getMessageType());
+    SubscriptionPacket prototype;
+    EXPECT_EQ(prototype.getMessageType(),
+              "URTS::Services::Scalable::PacketCache::SubscriptionPacket");
+    EXPECT_THROW(prototype.setTopic(""), std::invalid_argument);
+    prototype.setTopic("UU.CTU.HHZ.");
+    // An empty location code's topic is not a prefix of another's
+    EXPECT_NE(packet.getMessageType().find(prototype.getMessageType()), 0U);
+    prototype.setTopic("UU.CTU.HHZ.01");
+    EXPECT_EQ(prototype.getMessageType(), packet.getMessageType());
+
+    SubscriptionPacket copy;
+    EXPECT_NO_THROW(copy.fromMessage(packet.toMessage()));
+    EXPECT_TRUE(copy.havePacket());
+    EXPECT_EQ(copy.getMessageType(), packet.getMessageType());
+    EXPECT_EQ(copy.getSensorIdentifier(), sensorIdentifier);
+    EXPECT_EQ(copy.getSequenceNumber(), sequenceNumber);
+    const auto &packetCopy = copy.getPacketReference();
+    EXPECT_EQ(packetCopy.getNetwork(), network);
+    EXPECT_EQ(packetCopy.getStation(), station);
+    EXPECT_EQ(packetCopy.getChannel(), channel);
+    EXPECT_EQ(packetCopy.getLocationCode(), locationCode);
+    EXPECT_NEAR(packetCopy.getSamplingRate(), 100, 1.e-14);
+    EXPECT_EQ(packetCopy.getStartTime(), startTime);
+    EXPECT_EQ(packetCopy.getData(), data);
+
+    copy.clear();
+    EXPECT_FALSE(copy.havePacket());
+    EXPECT_THROW(auto message = copy.toMessage(), std::runtime_error);
+}
+
+TEST(ServicesScalablePacketCache, CircularBuffer)
+{
+    const std::string network{"UU"};
+    const std::string station{"VRUT"};
+    const std::string channel{"EHZ"};
+    const std::string locationCode{"01"};
+    const double samplingRate = 100;
+    const int maxPackets = 4;
+    // Make packets of varying size so the sample ring has to grow and wrap
+    const std::vector<int> samplesPerPacket{100, 200, 100, 300, 100, 250, 50};
+    std::vector<UDP::DataPacket> dataPackets;
+    std::chrono::microseconds t0{1000000};
+    for (size_t i = 0; i < samplesPerPacket.size(); ++i)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel(channel);
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(samplingRate);
+        dataPacket.setStartTime(t0);
+        std::vector<double> data(samplesPerPacket[i]);
+        std::iota(data.begin(), data.end(), static_cast<double> (1000*i));
+        dataPacket.setData(std::move(data));
+        t0 = dataPacket.getEndTime() + std::chrono::microseconds {10000};
+        dataPackets.push_back(std::move(dataPacket));
+    }
+
+    CircularBuffer cb;
+    EXPECT_THROW(cb.initialize(network, station, channel, locationCode, 0),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(cb.initialize(network, station, channel, locationCode,
+                                  maxPackets));
+    EXPECT_EQ(cb.getMaximumNumberOfPackets(), maxPackets);
+    EXPECT_EQ(cb.getNumberOfPackets(), 0);
+    // Wrong channel
+    auto badPacket = dataPackets.at(0);
+    badPacket.setChannel("EHN");
+    EXPECT_THROW(cb.addPacket(badPacket), std::invalid_argument);
+
+    // Fill the buffer in order and let it roll over
+    for (size_t i = 0; i < dataPackets.size(); ++i)
+    {
+        EXPECT_NO_THROW(cb.addPacket(dataPackets[i]));
+        auto nExpected = std::min(static_cast<int> (i) + 1, maxPackets);
+        EXPECT_EQ(cb.getNumberOfPackets(), nExpected);
+        auto i0 = static_cast<int> (i) + 1 - nExpected;
+        EXPECT_EQ(cb.getEarliestStartTime(), dataPackets[i0].getStartTime());
+        auto packetsBack = cb.getPackets();
+        ASSERT_EQ(static_cast<int> (packetsBack.size()), nExpected);
+        for (int j = 0; j < nExpected; ++j)
+        {
+            EXPECT_TRUE(packetsBack.at(j) == dataPackets.at(i0 + j));
+        }
+    }
+    auto nPackets = static_cast<int> (dataPackets.size());
+    // Query a window that straddles packets 4 and 5
+    auto t0Query = dataPackets[4].getStartTime() + std::chrono::microseconds {500000};
+    auto t1Query = dataPackets[5].getStartTime() + std::chrono::microseconds {500000};
+    auto packetsBack = cb.getPackets(t0Query, t1Query);
+    ASSERT_EQ(static_cast<int> (packetsBack.size()), 2);
+    EXPECT_TRUE(packetsBack.at(0) == dataPackets.at(4));
+    EXPECT_TRUE(packetsBack.at(1) == dataPackets.at(5));
+    // Query from a time to now
+    packetsBack = cb.getPackets(t0Query);
+    ASSERT_EQ(static_cast<int> (packetsBack.size()), 3);
+    EXPECT_TRUE(packetsBack.at(2) == dataPackets.at(nPackets - 1));
+    EXPECT_THROW(auto p = cb.getPackets(t1Query, t0Query),
+                 std::invalid_argument);
+    // Views share the samples and must survive the buffer rolling over
+    auto views = cb.getPacketViews(t0Query, t1Query);
+    ASSERT_EQ(static_cast<int> (views.size()), 2);
+    for (int i = 0; i < 2*maxPackets; ++i)
+    {
+        auto packet = dataPackets.back();
+        packet.setStartTime(t0 + i*std::chrono::microseconds {5000000});
+        std::vector<double> data(500, -1);
+        packet.setData(std::move(data));
+        cb.addPacket(std::move(packet));
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto &packet = dataPackets.at(4 + i);
+        EXPECT_EQ(views[i].getStartTime(), packet.getStartTime());
+        EXPECT_EQ(views[i].getEndTime(), packet.getEndTime());
+        ASSERT_EQ(views[i].getNumberOfSamples(), packet.getNumberOfSamples());
+        const auto *data = views[i].getDataPointer();
+        const auto &reference = packet.getDataReference();
+        EXPECT_TRUE(std::equal(reference.begin(), reference.end(), data));
+    }
+    EXPECT_EQ(cb.getEarliestStartTime(),
+              t0 + maxPackets*std::chrono::microseconds {5000000});
+
+    // Expired data is not backfilled
+    EXPECT_NO_THROW(cb.addPacket(dataPackets[0]));
+    EXPECT_EQ(cb.getEarliestStartTime(),
+              t0 + maxPackets*std::chrono::microseconds {5000000});
+
+    // Backfill: drop a packet from the middle then add it back
+    cb.clear();
+    EXPECT_FALSE(cb.isInitialized());
+    cb.initialize(network, station, channel, locationCode, nPackets);
+    for (int i = nPackets - 1; i >= 0; --i)
+    {
+        if (i == 2){continue;}
+        cb.addPacket(dataPackets[i]);
+    }
+    EXPECT_EQ(cb.getNumberOfPackets(), nPackets - 1);
+    cb.addPacket(dataPackets[2]);
+    // Overwrite an existing packet in place
+    auto replacement = dataPackets[3];
+    std::vector<double> replacementData(50, 9);
+    replacement.setData(replacementData);
+    cb.addPacket(replacement);
+    EXPECT_EQ(cb.getNumberOfPackets(), nPackets);
+    packetsBack = cb.getPackets();
+    ASSERT_EQ(static_cast<int> (packetsBack.size()), nPackets);
+    for (int i = 0; i < nPackets; ++i)
+    {
+        if (i == 3)
+        {
+            EXPECT_TRUE(packetsBack.at(i) == replacement);
+        }
+        else
+        {
+            EXPECT_TRUE(packetsBack.at(i) == dataPackets.at(i));
+        }
+    }
+    // Copy
+    CircularBuffer cbCopy(cb);
+    EXPECT_EQ(cbCopy.getNumberOfPackets(), nPackets);
+    EXPECT_EQ(cbCopy.getChannel(), channel);
+    packetsBack = cbCopy.getPackets();
+    EXPECT_TRUE(packetsBack.at(0) == dataPackets.at(0));
+}
+
+TEST(ServicesScalablePacketCache, CircularBufferCursor)
+{
+    const std::string network{"UU"};
+    const std::string station{"CTU"};
+    const std::string channel{"HHZ"};
+    const std::string locationCode{"01"};
+    const std::chrono::microseconds oneSecond{1000000};
+    auto makePacket = [&](const int k, const double value)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel(channel);
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(k*oneSecond);
+        dataPacket.setData(std::vector<double> (100, value));
+        return dataPacket;
+    };
+    auto getStartTimes = [](const std::vector<PacketView> &views)
+    {
+        std::vector<int64_t> result;
+        for (const auto &view : views)
+        {
+            result.push_back(view.getStartTime().count()/1000000);
+        }
+        return result;
+    };
+    CircularBuffer cb;
+    cb.initialize(network, station, channel, locationCode, 10);
+    for (const auto k : std::vector<int> {1, 2, 4, 5})
+    {
+        cb.addPacket(makePacket(k, k));
+    }
+    const std::chrono::microseconds t0{0};
+    const std::chrono::microseconds t1{100*oneSecond};
+    // A cursor of 0 is everything
+    auto [views, cursor] = cb.getPacketViews(t0, t1, 0);
+    EXPECT_EQ(getStartTimes(views), (std::vector<int64_t> {1, 2, 4, 5}));
+    EXPECT_EQ(cursor, 4);
+    // Nothing new
+    std::tie(views, cursor) = cb.getPacketViews(t0, t1, cursor);
+    EXPECT_TRUE(views.empty());
+    EXPECT_EQ(cursor, 4);
+    // New and backfilled data
+    cb.addPacket(makePacket(6, 6));
+    cb.addPacket(makePacket(3, 3));
+    std::tie(views, cursor) = cb.getPacketViews(t0, t1, cursor);
+    EXPECT_EQ(getStartTimes(views), (std::vector<int64_t> {3, 6}));
+    EXPECT_EQ(cursor, 6);
+    // Overwritten data
+    cb.addPacket(makePacket(4, -4));
+    std::tie(views, cursor) = cb.getPacketViews(t0, t1, cursor);
+    ASSERT_EQ(getStartTimes(views), (std::vector<int64_t> {4}));
+    EXPECT_NEAR(views[0].getDataPointer()[0], -4, 1.e-14);
+    // Data beyond the query window is picked up by a later query
+    cb.addPacket(makePacket(7, 7));
+    cb.addPacket(makePacket(9, 9));
+    std::tie(views, cursor) = cb.getPacketViews(t0, 8*oneSecond, cursor);
+    EXPECT_EQ(getStartTimes(views), (std::vector<int64_t> {7}));
+    EXPECT_EQ(cursor, 8);
+    cb.addPacket(makePacket(8, 8));
+    std::tie(views, cursor) = cb.getPacketViews(t0, t1, cursor);
+    EXPECT_EQ(getStartTimes(views), (std::vector<int64_t> {8, 9}));
+    EXPECT_EQ(cursor, 10);
+
+    // Reassemble the window from incremental responses
+    auto [allViews, allCursor] = cb.getPacketViews(t0, t1, 0);
+    DataResponse full;
+    full.setPacketViews(network, station, channel, locationCode,
+                        std::vector<PacketView> (allViews.begin(),
+                                                 allViews.begin() + 5));
+    DataResponse increment;
+    increment.setPacketViews(network, station, channel, locationCode,
+                             std::vector<PacketView> (allViews.begin() + 3,
+                                                      allViews.end()));
+    increment.setCursor(allCursor);
+    full.merge(increment, 3*oneSecond);
+    EXPECT_EQ(getStartTimes(full.getPacketViewsReference()),
+              (std::vector<int64_t> {3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(full.getCursor(), allCursor);
+    DataResponse other;
+    other.setPacketViews(network, "FORK", channel, locationCode,
+                         std::vector<PacketView> (allViews));
+    EXPECT_THROW(full.merge(other, t0), std::invalid_argument);
+}
+
+TEST(ServicesScalablePacketCache, CircularBufferCursorNoDuplicates)
+{
+    const std::chrono::microseconds oneSecond{1000000};
+    auto makePacket = [&](const int k)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork("UU");
+        dataPacket.setStation("CTU");
+        dataPacket.setChannel("HHZ");
+        dataPacket.setLocationCode("01");
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(k*oneSecond);
+        dataPacket.setData(std::vector<double> (100, k));
+        return dataPacket;
+    };
+    CircularBuffer cb;
+    cb.initialize("UU", "CTU", "HHZ", "01", 100);
+    // Packets arrive alternately inside and beyond the query window, and
+    // out of order, while a client polls with its cursor
+    const std::chrono::microseconds t0{0};
+    const std::chrono::microseconds t1{50*oneSecond};
+    const std::vector<std::vector<int>> arrivals{{60, 10},
+                                                 {70},
+                                                 {20, 80, 30},
+                                                 {},
+                                                 {90, 5, 95},
+                                                 {40, 99, 45, 1}};
+    std::set<int64_t> delivered;
+    std::set<int64_t> expected;
+    uint64_t cursor{0};
+    for (const auto &batch : arrivals)
+    {
+        for (const auto k : batch)
+        {
+            cb.addPacket(makePacket(k));
+            if (k*oneSecond <= t1){expected.insert(k);}
+        }
+        auto [views, newCursor] = cb.getPacketViews(t0, t1, cursor);
+        EXPECT_GE(newCursor, cursor);
+        for (const auto &view : views)
+        {
+            auto k = view.getStartTime().count()/oneSecond.count();
+            EXPECT_LE(view.getStartTime(), t1);
+            EXPECT_TRUE(delivered.insert(k).second)
+                << "Packet " << k << " delivered twice";
+        }
+        cursor = newCursor;
+    }
+    // Every packet in the window was delivered exactly once
+    EXPECT_EQ(delivered, expected);
+    auto [views, newCursor] = cb.getPacketViews(t0, t1, cursor);
+    EXPECT_TRUE(views.empty());
+    EXPECT_EQ(newCursor, cursor);
+}
+
+TEST(ServicesScalablePacketCache, CircularBufferCursorMovingWindow)
+{
+    const std::chrono::microseconds oneSecond{1000000};
+    auto makePacket = [&](const int k)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork("UU");
+        dataPacket.setStation("CTU");
+        dataPacket.setChannel("HHZ");
+        dataPacket.setLocationCode("01");
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(k*oneSecond);
+        dataPacket.setData(std::vector<double> (100, k));
+        return dataPacket;
+    };
+    CircularBuffer cb;
+    cb.initialize("UU", "CTU", "HHZ", "01", 100);
+    // The window widens and then trails the data while packets arrive out
+    // of order and beyond the window.  In particular, 12 is stored before
+    // 9 but is outside of the first window so a cursor alone would skip it.
+    struct Step
+    {
+        std::vector<int> arrivals;
+        int t0;
+        int t1;
+    };
+    const std::vector<Step> steps{{{0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 9}, 0, 10},
+                                  {{10, 11}, 0, 15},
+                                  {{14, 13, 25}, 5, 20},
+                                  {{16, 15}, 8, 30},
+                                  {{}, 10, 30},
+                                  {{40, 31, 35}, 20, 45}};
+    std::set<int> stored;
+    std::set<int> delivered;
+    std::set<int> expected;
+    uint64_t cursor{0};
+    std::chrono::microseconds cursorEndTime{0};
+    for (const auto &step : steps)
+    {
+        for (const auto k : step.arrivals)
+        {
+            cb.addPacket(makePacket(k));
+            stored.insert(k);
+        }
+        for (const auto k : stored)
+        {
+            if (k >= step.t0 && k <= step.t1){expected.insert(k);}
+        }
+        auto [views, newCursor, newCursorEndTime]
+            = cb.getPacketViews(step.t0*oneSecond, step.t1*oneSecond,
+                                cursor, cursorEndTime);
+        EXPECT_GE(newCursor, cursor);
+        EXPECT_GE(newCursorEndTime, step.t1*oneSecond);
+        for (const auto &view : views)
+        {
+            auto k = static_cast<int>
+                     (view.getStartTime().count()/oneSecond.count());
+            EXPECT_GE(k, step.t0);
+            EXPECT_LE(k, step.t1);
+            EXPECT_TRUE(delivered.insert(k).second)
+                << "Packet " << k << " delivered twice";
+        }
+        cursor = newCursor;
+        cursorEndTime = newCursorEndTime;
+    }
+    // Every packet that was in a window was delivered exactly once
+    EXPECT_EQ(delivered, expected);
+    EXPECT_TRUE(delivered.contains(12));
+    auto [views, newCursor, newCursorEndTime]
+        = cb.getPacketViews(20*oneSecond, 45*oneSecond, cursor, cursorEndTime);
+    EXPECT_TRUE(views.empty());
+    EXPECT_EQ(newCursor, cursor);
+    EXPECT_EQ(newCursorEndTime, cursorEndTime);
+}
+
+TEST(ServicesScalablePacketCache, SampleCodecMalformedDeltas)
+{
+    // Deltas from a malformed message that overflow an int64_t wrap
+    // rather than invoking undefined behavior
+    const auto maximum = std::numeric_limits<int64_t>::max();
+    std::vector<uint8_t> encoded;
+    ::writeVarint(::zigZagEncode(maximum), &encoded);
+    ::writeVarint(::zigZagEncode(maximum), &encoded);
+    ::writeVarint(::zigZagEncode(3), &encoded);
+    std::vector<double> x;
+    ::decodeIntegerDeltas(encoded.data(), encoded.size(), &x);
+    ASSERT_EQ(x.size(), 3);
+    EXPECT_EQ(x[0], static_cast<double> (maximum));
+    EXPECT_EQ(x[1], -2);
+    EXPECT_EQ(x[2], 1);
+    std::vector<double> y(3);
+    const auto *data = encoded.data();
+    ::decodeIntegerDeltas(&data, encoded.data() + encoded.size(), 3,
+                          y.data());
+    EXPECT_EQ(x, y);
+}
+
+TEST(ServicesScalablePacketCache, CircularBufferCompression)
+{
+    const std::string network{"UU"};
+    const std::string station{"MOUT"};
+    const std::string channel{"HHZ"};
+    const std::string locationCode{"01"};
+    const int maxPackets = 6;
+    const int nSamples = 200;
+    std::mt19937 generator(8675309);
+    std::uniform_int_distribution<int> counts(-2000, 2000);
+    std::normal_distribution<double> noise(0, 1);
+    // Integer counts, arbitrary floats, and special values
+    std::vector<UDP::DataPacket> dataPackets;
+    for (int i = 0; i < maxPackets; ++i)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel(channel);
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(std::chrono::microseconds {i*2000000});
+        std::vector<double> data(nSamples);
+        double count = 0;
+        for (auto &x : data)
+        {
+            if (i%2 == 0)
+            {
+                count = count + counts(generator);
+                x = count;
+            }
+            else
+            {
+                x = noise(generator);
+            }
+        }
+        if (i == 3)
+        {
+            data[0] =-0.0;
+            data[1] = std::numeric_limits<double>::quiet_NaN();
+            data[2] = std::numeric_limits<double>::infinity();
+            data[3] = 1.e300;
+        }
+        if (i == 4){data[0] = 9007199254740992.0; data[1] =-data[0];}
+        dataPackets.push_back(std::move(dataPacket));
+        dataPackets.back().setData(std::move(data));
+    }
+    auto sameBits = [](const double *x, const double *y, const int n)
+    {
+        return std::memcmp(x, y, n*sizeof(double)) == 0;
+    };
+
+    CircularBuffer raw;
+    raw.initialize(network, station, channel, locationCode, maxPackets);
+    EXPECT_FALSE(raw.isCompressed());
+    CircularBuffer cb;
+    cb.initialize(network, station, channel, locationCode, maxPackets, true);
+    EXPECT_TRUE(cb.isCompressed());
+    // Backfill out of order
+    for (const auto i : std::vector<int> {0, 2, 1, 5, 4, 3})
+    {
+        raw.addPacket(dataPackets[i]);
+        cb.addPacket(dataPackets[i]);
+    }
+    ASSERT_EQ(cb.getNumberOfPackets(), maxPackets);
+    auto views = cb.getPacketViews(std::chrono::microseconds {0});
+    auto packets = cb.getPackets();
+    ASSERT_EQ(static_cast<int> (views.size()), maxPackets);
+    ASSERT_EQ(static_cast<int> (packets.size()), maxPackets);
+    for (int i = 0; i < maxPackets; ++i)
+    {
+        const auto *reference = dataPackets[i].getDataPointer();
+        EXPECT_EQ(views[i].getStartTime(), dataPackets[i].getStartTime());
+        ASSERT_EQ(views[i].getNumberOfSamples(), nSamples);
+        EXPECT_TRUE(sameBits(views[i].getDataPointer(), reference, nSamples));
+        EXPECT_TRUE(sameBits(packets[i].getDataPointer(), reference,
+                             nSamples));
+    }
+    // Integer data shrinks and noise is never stored larger than raw
+    EXPECT_LT(cb.getSampleMemoryUsage(), raw.getSampleMemoryUsage());
+    // Counts should compress by at least a factor of three
+    CircularBuffer integers;
+    integers.initialize(network, station, channel, locationCode, 3, true);
+    for (const auto i : std::vector<int> {0, 2, 4})
+    {
+        integers.addPacket(dataPackets[i]);
+    }
+    EXPECT_LT(3*integers.getSampleMemoryUsage(), 3*nSamples*sizeof(double));
+    // Copies share the compressed samples
+    CircularBuffer cbCopy(cb);
+    EXPECT_TRUE(cbCopy.isCompressed());
+    auto copyViews = cbCopy.getPacketViews(std::chrono::microseconds {0});
+    ASSERT_EQ(copyViews.size(), views.size());
+    EXPECT_TRUE(sameBits(copyViews.back().getDataPointer(),
+                         dataPackets.back().getDataPointer(), nSamples));
+    cb.clear();
+    EXPECT_FALSE(cb.isCompressed());
+
+    // The collection propagates the option to its buffers
+    CappedCollection collection;
+    collection.initialize(maxPackets, std::set<std::string> {}, true);
+    EXPECT_TRUE(collection.isCompressed());
+    for (const auto &dataPacket : dataPackets)
+    {
+        collection.addPacket(dataPacket);
+    }
+    auto name = network + "." + station + "." + channel + "." + locationCode;
+    packets = collection.getPackets(name, 0., 4.e9);
+    ASSERT_EQ(static_cast<int> (packets.size()), maxPackets);
+    EXPECT_TRUE(sameBits(packets[2].getDataPointer(),
+                         dataPackets[2].getDataPointer(), nSamples));
+    EXPECT_LT(collection.getSampleMemoryUsage(), raw.getSampleMemoryUsage());
+}
+
+TEST(ServicesScalablePacketCache, CappedCollection)
+{
+    const std::string network{"UU"};
+    const std::vector<std::string> stations{"ARUT", "CTU", "FORK"};
+    const std::vector<std::string> channels{"HHZ", "HHN", "HHE", "LCQ"};
+    const std::string locationCode{"01"};
+    const int maxPackets = 3;
+    CappedCollection collection;
+    EXPECT_NO_THROW(collection.initialize(maxPackets,
+                                          std::set<std::string> {"LC*"}));
+    std::chrono::microseconds t0{1000000};
+    for (int k = 0; k < 2*maxPackets; ++k)
+    {
+        for (const auto &station : stations)
+        {
+            for (const auto &channel : channels)
+            {
+                UDP::DataPacket dataPacket;
+                dataPacket.setNetwork(network);
+                dataPacket.setStation(station);
+                dataPacket.setChannel(channel);
+                dataPacket.setLocationCode(locationCode);
+                dataPacket.setSamplingRate(100);
+                dataPacket.setStartTime(t0 + k*std::chrono::microseconds {1000000});
+                dataPacket.setData(std::vector<double> (100, k));
+                EXPECT_NO_THROW(collection.addPacket(dataPacket));
+            }
+        }
+    }
+    // The blacklisted LCQ channels are not in the collection 
+    auto names = collection.getSensorNames();
+    EXPECT_EQ(names.size(), stations.size()*(channels.size() - 1));
+    EXPECT_EQ(collection.getTotalNumberOfPackets(),
+              static_cast<int> (names.size())*maxPackets);
+    EXPECT_FALSE(collection.haveSensor(network, "ARUT", "LCQ", locationCode));
+    EXPECT_THROW(auto id = collection.getSensorIdentifier("UU.ARUT.LCQ.01"),
+                 std::invalid_argument);
+    EXPECT_THROW(auto id = collection.getSensorIdentifier("UU.XXX.HHZ.01"),
+                 std::invalid_argument);
+    // Look sensors up by their interned identifiers
+    std::set<uint64_t> identifiers;
+    for (const auto &name : names)
+    {
+        auto identifier = collection.getSensorIdentifier(name);
+        EXPECT_TRUE(collection.haveSensor(identifier));
+        EXPECT_EQ(collection.getSensorName(identifier), name);
+        identifiers.insert(identifier);
+        auto views
+            = collection.getPacketViews(identifier,
+                                        std::chrono::microseconds {0},
+                                        std::chrono::microseconds {100000000});
+        auto packets
+            = collection.getPackets(name,
+                                    std::chrono::microseconds {0},
+                                    std::chrono::microseconds {100000000});
+        ASSERT_EQ(views.size(), packets.size());
+        EXPECT_EQ(static_cast<int> (views.size()), maxPackets);
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            EXPECT_EQ(views[i].getStartTime(), packets[i].getStartTime());
+            EXPECT_EQ(views[i].getDataPointer()[0],
+                      static_cast<double> (maxPackets + i));
+        }
+    }
+    EXPECT_EQ(identifiers.size(), names.size());
+    // Identifiers do not survive a reinitialization
+    auto identifier = *identifiers.begin();
+    collection.initialize(maxPackets);
+    EXPECT_FALSE(collection.haveSensor(identifier));
+    EXPECT_THROW(auto views
+                     = collection.getPacketViews(
+                          identifier,
+                          std::chrono::microseconds {0},
+                          std::chrono::microseconds {100000000}),
+                 std::runtime_error);
+}
+
+TEST(ServicesScalablePacketCache, CappedCollectionInsertionCallback)
+{
+    const std::string network{"UU"};
+    const std::string station{"CTU"};
+    const std::string locationCode{"01"};
+    const std::chrono::microseconds oneSecond{1000000};
+    const int maxPackets = 3;
+    auto makePacket = [&](const std::string &channel, const int k)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel(channel);
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(k*oneSecond);
+        dataPacket.setData(std::vector<double> (100, k));
+        return dataPacket;
+    };
+    // Sequence numbers are what the circular buffer reports
+    CircularBuffer cb;
+    cb.initialize(network, station, "HHZ", locationCode, maxPackets);
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 2)), 1);
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 3)), 2);
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 1)), 3);
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 4)), 4);
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 0)), 0); // Expired
+    EXPECT_EQ(cb.addPacket(makePacket("HHZ", 3)), 5); // Overwritten
+
+    CappedCollection collection;
+    collection.initialize(maxPackets + 1, std::set<std::string> {"LC*"});
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>> inserted;
+    collection.setInsertionCallback(
+        [&](const UDP::DataPacket &packet,
+            const uint64_t sensorIdentifier,
+            const uint64_t sequenceNumber)
+        {
+            inserted.push_back(std::tuple {packet.getChannel(),
+                                           sensorIdentifier,
+                                           sequenceNumber});
+        });
+    collection.addPacket(makePacket("HHZ", 2));
+    collection.addPacket(makePacket("HHN", 2));
+    collection.addPacket(makePacket("LCQ", 2)); // Blacklisted
+    collection.addPacket(makePacket("HHZ", 3));
+    collection.addPacket(makePacket("HHZ", 1)); // Backfilled
+    collection.addPacket(makePacket("HHZ", 4));
+    collection.addPacket(makePacket("HHZ", 0)); // Expired
+    auto zIdentifier = collection.getSensorIdentifier("UU.CTU.HHZ.01");
+    auto nIdentifier = collection.getSensorIdentifier("UU.CTU.HHN.01");
+    ASSERT_EQ(inserted.size(), 5);
+    EXPECT_EQ(inserted[0], std::tuple("HHZ", zIdentifier, uint64_t {1}));
+    EXPECT_EQ(inserted[1], std::tuple("HHN", nIdentifier, uint64_t {1}));
+    EXPECT_EQ(inserted[2], std::tuple("HHZ", zIdentifier, uint64_t {2}));
+    EXPECT_EQ(inserted[3], std::tuple("HHZ", zIdentifier, uint64_t {3}));
+    EXPECT_EQ(inserted[4], std::tuple("HHZ", zIdentifier, uint64_t {4}));
+    // A subscriber that missed a packet recovers it with the cursor
+    auto [views, cursor]
+        = collection.getPacketViews(zIdentifier,
+                                    std::chrono::microseconds {0},
+                                    100*oneSecond,
+                                    2);
+    ASSERT_EQ(views.size(), 2);
+    EXPECT_EQ(views[0].getStartTime(), oneSecond);
+    EXPECT_EQ(views[1].getStartTime(), 4*oneSecond);
+    EXPECT_EQ(cursor, 4);
+    // The callback survives a reinitialization
+    inserted.clear();
+    collection.initialize(maxPackets);
+    collection.addPacket(makePacket("HHZ", 2));
+    ASSERT_EQ(inserted.size(), 1);
+    EXPECT_EQ(std::get<1> (inserted[0]),
+              collection.getSensorIdentifier("UU.CTU.HHZ.01"));
+    EXPECT_EQ(std::get<2> (inserted[0]), 1);
+}
+
+TEST(ServicesScalablePacketCache, CappedCollectionSnapshot)
+{
+    const std::string network{"UU"};
+    const std::vector<std::string> stations{"ARUT", "CTU"};
+    const std::vector<std::string> channels{"HHZ", "EHZ", "LCQ"};
+    const std::string locationCode{"01"};
+    const std::string snapshotFile{"packetCacheSnapshot.bin"};
+    const int maxPackets = 4;
+    CappedCollection collection;
+    collection.initialize(maxPackets, std::set<std::string> {"LC*"});
+    EXPECT_EQ(collection.writeSnapshot(snapshotFile), 0);
+    std::chrono::microseconds t0{1628803598000000};
+    for (int k = 0; k < maxPackets + 2; ++k)
+    {
+        for (const auto &station : stations)
+        {
+            for (const auto &channel : channels)
+            {
+                UDP::DataPacket dataPacket;
+                dataPacket.setNetwork(network);
+                dataPacket.setStation(station);
+                dataPacket.setChannel(channel);
+                dataPacket.setLocationCode(locationCode);
+                dataPacket.setSamplingRate(channel == "EHZ" ? 40 : 100);
+                dataPacket.setStartTime(t0 + k*std::chrono::microseconds {1000000});
+                std::vector<double> data(50 + k);
+                std::iota(data.begin(), data.end(), k);
+                dataPacket.setData(std::move(data));
+                collection.addPacket(std::move(dataPacket));
+            }
+        }
+    }
+    auto nWritten = collection.writeSnapshot(snapshotFile);
+    EXPECT_EQ(nWritten, collection.getTotalNumberOfPackets());
+    EXPECT_FALSE(std::filesystem::exists(snapshotFile + ".tmp"));
+
+    CappedCollection restored;
+    restored.initialize(maxPackets);
+    EXPECT_EQ(restored.loadSnapshot(snapshotFile), nWritten);
+    EXPECT_EQ(restored.getSensorNames(), collection.getSensorNames());
+    for (const auto &name : collection.getSensorNames())
+    {
+        auto packets = collection.getPackets(name, 0., 4.e9);
+        auto restoredPackets = restored.getPackets(name, 0., 4.e9);
+        ASSERT_EQ(packets.size(), restoredPackets.size());
+        for (size_t i = 0; i < packets.size(); ++i)
+        {
+            EXPECT_EQ(packets[i].getNetwork(),
+                      restoredPackets[i].getNetwork());
+            EXPECT_EQ(packets[i].getStation(),
+                      restoredPackets[i].getStation());
+            EXPECT_EQ(packets[i].getChannel(),
+                      restoredPackets[i].getChannel());
+            EXPECT_EQ(packets[i].getLocationCode(),
+                      restoredPackets[i].getLocationCode());
+            EXPECT_NEAR(packets[i].getSamplingRate(),
+                        restoredPackets[i].getSamplingRate(), 1.e-14);
+            EXPECT_EQ(packets[i].getStartTime(),
+                      restoredPackets[i].getStartTime());
+            EXPECT_EQ(packets[i].getData(), restoredPackets[i].getData());
+        }
+    }
+    // A smaller cache keeps the most recent packets
+    CappedCollection smaller;
+    smaller.initialize(2);
+    EXPECT_EQ(smaller.loadSnapshot(snapshotFile), nWritten);
+    EXPECT_EQ(smaller.getTotalNumberOfPackets(),
+              2*static_cast<int> (smaller.getSensorNames().size()));
+    // Corrupt snapshots are detected
+    auto size = std::filesystem::file_size(snapshotFile);
+    std::filesystem::resize_file(snapshotFile, size - 8);
+    CappedCollection truncated;
+    truncated.initialize(maxPackets);
+    EXPECT_THROW(truncated.loadSnapshot(snapshotFile), std::runtime_error);
+    {
+    std::ofstream file(snapshotFile, std::ios::binary | std::ios::trunc);
+    file << "This is not a snapshot but is long enough to have a header";
+    }
+    EXPECT_THROW(truncated.loadSnapshot(snapshotFile), std::runtime_error);
+    std::filesystem::remove(snapshotFile);
+    EXPECT_THROW(truncated.loadSnapshot(snapshotFile), std::invalid_argument);
+}
+
+TEST(ServicesScalablePacketCache, ThreeComponentWaveformMemo)
+{
+    const std::string network{"UU"};
+    const std::string station{"FORK"};
+    const std::array<std::string, 3> channels{"HHZ", "HHN", "HHE"};
+    const std::string locationCode{"01"};
+    const int nPackets{5};
+    const double t0{1600000000};
+    // The memo must work off of compressed samples too
+    CappedCollection collection;
+    collection.initialize(10, std::set<std::string> {}, true);
+    EXPECT_TRUE(collection.isCompressed());
+    auto addPacket = [&](const std::string &channel, const int k,
+                         const double offset)
+    {
+        UDP::DataPacket dataPacket;
+        dataPacket.setNetwork(network);
+        dataPacket.setStation(station);
+        dataPacket.setChannel(channel);
+        dataPacket.setLocationCode(locationCode);
+        dataPacket.setSamplingRate(100);
+        dataPacket.setStartTime(std::chrono::microseconds
+                                {static_cast<int64_t> ((t0 + k)*1000000)});
+        std::vector<double> data(100);
+        std::iota(data.begin(), data.end(), offset + 100*k);
+        dataPacket.setData(std::move(data));
+        collection.addPacket(std::move(dataPacket));
+    };
+    for (int k = 0; k < nPackets; ++k)
+    {
+        for (const auto &channel : channels){addPacket(channel, k, 0);}
+    }
+    auto identifier = collection.getSensorIdentifier("UU.FORK.HHZ.01");
+    auto summaries
+        = collection.getPacketSummaries(identifier,
+                                        std::chrono::microseconds {0},
+                                        std::chrono::microseconds
+                                        {std::numeric_limits<int64_t>::max()});
+    ASSERT_EQ(static_cast<int> (summaries.size()), nPackets);
+    EXPECT_EQ(summaries[1].nSamples, 100);
+    EXPECT_EQ(summaries[1].startTime,
+              std::chrono::microseconds {static_cast<int64_t> ((t0 + 1)*1000000)});
+    EXPECT_LT(summaries[0].sequence, summaries[1].sequence);
+
+    ThreeComponentWaveformRequest request;
+    request.setNetwork(network);
+    request.setStation(station);
+    request.setVerticalChannel(channels[0]);
+    request.setNorthChannel(channels[1]);
+    request.setEastChannel(channels[2]);
+    request.setLocationCode(locationCode);
+    request.setSamplingRate(100);
+    request.setQueryTimes(std::pair {t0 + 0.5, t0 + 3.5});
+    ::ThreeComponentWaveformMemo memo;
+    auto response = memo.get(request, collection);
+    EXPECT_EQ(response.getReturnCode(),
+              ThreeComponentWaveformResponse::ReturnCode::Success);
+    EXPECT_FALSE(response.getVerticalSignalReference().empty());
+    EXPECT_EQ(memo.getNumberOfHits(), 0);
+    // Same window and packets
+    auto hit = memo.get(request, collection);
+    EXPECT_EQ(memo.getNumberOfHits(), 1);
+    EXPECT_EQ(hit.getStartTime(), response.getStartTime());
+    EXPECT_EQ(hit.getVerticalSignalReference(),
+              response.getVerticalSignalReference());
+    // Windows running past the data are clipped to the same window
+    request.setQueryTimes(std::pair {t0 + 0.5, t0 + 100});
+    auto open = memo.get(request, collection);
+    EXPECT_EQ(memo.getNumberOfHits(), 1);
+    request.setQueryTimes(std::pair {t0 + 0.5, t0 + 200});
+    hit = memo.get(request, collection);
+    EXPECT_EQ(memo.getNumberOfHits(), 2);
+    EXPECT_EQ(hit.getVerticalSignalReference(),
+              open.getVerticalSignalReference());
+    // New data extends the clipped window
+    for (const auto &channel : channels){addPacket(channel, nPackets, 0);}
+    auto extended = memo.get(request, collection);
+    EXPECT_EQ(memo.getNumberOfHits(), 2);
+    EXPECT_GT(extended.getVerticalSignalReference().size(),
+              open.getVerticalSignalReference().size());
+    // Replacing a packet in the window invalidates the result
+    addPacket(channels[0], 1, 1000);
+    request.setQueryTimes(std::pair {t0 + 0.5, t0 + 3.5});
+    auto replaced = memo.get(request, collection);
+    EXPECT_EQ(memo.getNumberOfHits(), 2);
+    EXPECT_EQ(replaced.getReturnCode(),
+              ThreeComponentWaveformResponse::ReturnCode::Success);
+    EXPECT_NE(replaced.getVerticalSignalReference(),
+              response.getVerticalSignalReference());
+    EXPECT_EQ(replaced.getNorthSignalReference(),
+              response.getNorthSignalReference());
+    memo.clear();
+    EXPECT_EQ(memo.getNumberOfHits(), 0);
 }
 
 TEST(ServicesStandalonePacketCache, RequestorOptions)
@@ -528,8 +1936,39 @@ TEST(ServicesStandalonePacketCache, ServiceOptions)
     EXPECT_NO_THROW(options.setDataPacketSubscriberOptions(sOptions));
     options.setReplierPollingTimeOut(pollTimeOut);
     options.setReplierZAPOptions(zapOptions);
+    EXPECT_FALSE(options.haveSubscriptionPublisherOptions());
+    URTS::Broadcasts::Internal::DataPacket::PublisherOptions pOptions;
+    EXPECT_THROW(options.setSubscriptionPublisherOptions(pOptions),
+                 std::invalid_argument);
+    pOptions.setAddress(address);
+    EXPECT_NO_THROW(options.setSubscriptionPublisherOptions(pOptions));
+    EXPECT_FALSE(options.haveSnapshotFile());
+    EXPECT_THROW(options.setSnapshotFile(""), std::invalid_argument);
+    EXPECT_THROW(options.setSnapshotFile("/this/does/not/exist/cache.bin"),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(options.setSnapshotFile("packetCache.bin"));
+    EXPECT_EQ(options.getSnapshotInterval(), std::chrono::seconds {60});
+    EXPECT_THROW(options.setSnapshotInterval(std::chrono::seconds {0}),
+                 std::invalid_argument);
+    options.setSnapshotInterval(std::chrono::seconds {30});
+    EXPECT_FALSE(options.useSampleCompression());
+    options.setSampleCompression(true);
+    EXPECT_FALSE(options.useResponseCompression());
+    options.setResponseCompression(true);
+    EXPECT_FALSE(options.useCompactResponses());
+    options.setCompactResponses(true);
+    EXPECT_EQ(options.getNumberOfReplierThreads(), 1);
+    EXPECT_THROW(options.setNumberOfReplierThreads(0), std::invalid_argument);
+    options.setNumberOfReplierThreads(4);
   
     ServiceOptions copy(options);
+    EXPECT_TRUE(copy.useSampleCompression());
+    EXPECT_TRUE(copy.useResponseCompression());
+    EXPECT_TRUE(copy.useCompactResponses());
+    EXPECT_EQ(copy.getNumberOfReplierThreads(), 4);
+    EXPECT_EQ(copy.getSubscriptionPublisherOptions().getAddress(), address);
+    EXPECT_EQ(copy.getSnapshotFile(), "packetCache.bin");
+    EXPECT_EQ(copy.getSnapshotInterval(), std::chrono::seconds {30});
     EXPECT_EQ(options.getReplierAddress(), address);
     EXPECT_EQ(options.getReplierSendHighWaterMark(), sendHWM);
     EXPECT_EQ(options.getReplierReceiveHighWaterMark(), recvHWM);
@@ -545,6 +1984,11 @@ TEST(ServicesStandalonePacketCache, ServiceOptions)
 
     options.clear();
     EXPECT_FALSE(options.haveReplierAddress());
+    EXPECT_FALSE(options.haveSubscriptionPublisherOptions());
+    EXPECT_FALSE(options.haveSnapshotFile());
+    EXPECT_FALSE(options.useSampleCompression());
+    EXPECT_FALSE(options.useResponseCompression());
+    EXPECT_EQ(options.getNumberOfReplierThreads(), 1);
     EXPECT_EQ(options.getReplierSendHighWaterMark(), 8192);
     EXPECT_EQ(options.getReplierReceiveHighWaterMark(), 4096);     
     EXPECT_EQ(options.getReplierPollingTimeOut(),
@@ -823,6 +2267,18 @@ TEST(ServicesScalablePacketCache, SingleComponent)
     {
         EXPECT_EQ(g, 0);
     }
+
+    // The waveform is built directly from a received compact response
+    response.setIdentifier(1);
+    response.setCompactLayout(true);
+    DataResponse compactResponse;
+    compactResponse.fromMessage(response.toMessage());
+    EXPECT_TRUE(compactResponse.useCompactLayout());
+    SingleComponentWaveform compactWaveform(targetSamplingRate, gapTolerance);
+    EXPECT_NO_THROW(compactWaveform.set(compactResponse));
+    EXPECT_EQ(compactWaveform.getStation(), station);
+    EXPECT_EQ(compactWaveform.getStartTime(), t0MuSec);
+    EXPECT_EQ(compactWaveform.getSignalReference(), y);
 }
 
 